@@ -0,0 +1,248 @@
+/**
+*   Search of the acquisition settings on the simulated device.
+*
+*   The simulated device runs in SpO2 mode at 100 samples/s with a light
+*   model (MAX30101_Sim_SetLight): 150 nA of light per mA of LED current,
+*   a 50 nA pulse at 72 bpm and 20 nA rms of noise at 69 us without
+*   averaging. For each LED power budget, MAX30101_AutoConfig_Search
+*   selects pulse width, sample averaging, LED amplitude and ADC range.
+*
+*   For each budget it reports the selected setting, its estimated power,
+*   the measured SNR, the SNR of the light model for that setting and
+*   the best SNR of the light model over every setting within the budget
+*   (exhaustive), the captures taken, the time the device would spend
+*   acquiring them and the host time of the search. A budget passes if
+*   the setting is within the budget and its model SNR is at least 80% of
+*   the best one.
+*
+*   Then the last result is packed, the device is powered on again and
+*   the cached setting is applied: it reports the bus time of the re-apply
+*   and checks the registers, and that a corrupted cache is rejected.
+*
+*   Usage: max30101_autoconfigbench
+*/
+
+#include "MAX30101.h"
+#include "MAX30101_AutoConfig.h"
+#include "MAX30101_Rate.h"
+#include "MAX30101_Sim.h"
+#include "MAX30101_HostTime.h"
+#include <math.h>
+#include <stdio.h>
+
+/**
+*   \brief Output sample rate, in samples/s.
+*/
+#define ABENCH_RATE 100
+
+/**
+*   \brief Light model: nA per mA of LED current, pulse, noise at 69 us, in nA.
+*/
+#define ABENCH_NA_PER_MA 150
+#define ABENCH_PULSE_NA 50
+#define ABENCH_NOISE_NA 20
+
+/**
+*   \brief I2C clock of the PSoC project, in Hz.
+*/
+#define ABENCH_I2C_CLOCK_HZ 400000
+
+/**
+*   \brief Pass threshold: model SNR of the selected setting over the best one.
+*/
+#define ABENCH_MIN_SNR_RATIO 0.8
+
+// LED power budgets, in uW
+static const uint32_t abench_budgets[] = {200, 500, 1000, 2000, 5000, 10000, 20000, 50000};
+
+// Candidate LED amplitudes (0.2 mA per LSB)
+static const uint8_t abench_led_pa[] = {0x04, 0x08, 0x10, 0x18, 0x20, 0x30, 0x40, 0x60, 0x80, 0xC0, 0xFF};
+
+// Noise factors of the simulated device (MAX30101_Sim.c), Q10
+static const uint16_t abench_noise_pw[4] = {1024, 783, 580, 419};
+static const uint16_t abench_noise_avg[6] = {1024, 724, 512, 362, 256, 181};
+
+static uint64_t abench_pending_us;
+
+static void ABench_Boot(void);
+
+static void ABench_Wait(uint32_t us);
+
+static double ABench_ModelSNR(uint8_t pw, uint8_t avg, uint8_t led_pa, uint8_t* range);
+
+static double ABench_BestSNR(uint32_t budget_uw);
+
+static int ABench_Cache(const MAX30101_AutoConfigResult* result);
+
+int main(void)
+{
+    MAX30101_AutoConfigParams params = {
+        .sample_rate = ABENCH_RATE,
+        .active_leds = 2,
+        .led_pa = abench_led_pa,
+        .num_led_pa = sizeof(abench_led_pa),
+        .wait = ABench_Wait,
+    };
+    MAX30101_AutoConfigResult result = {0};
+    int failed = 0;
+
+    printf("SpO2 mode, %u samples/s, %u nA/mA, noise %u nA rms at 69 us, LED supply %u mV\n", ABENCH_RATE,
+           ABENCH_NA_PER_MA, ABENCH_NOISE_NA, MAX30101_AUTOCFG_VLED_MV);
+    printf("%9s %7s %4s %8s %9s %9s %7s %9s %9s %8s %10s %8s %s\n", "Budget", "Pulse", "Avg", "LED", "Range",
+           "Power", "SNR", "Model", "Best", "Captures", "Device", "Host", "Result");
+    for (uint8_t b = 0; b < sizeof(abench_budgets) / sizeof(abench_budgets[0]); b++)
+    {
+        params.budget_uw = abench_budgets[b];
+        ABench_Boot();
+        uint64_t start = MAX30101_HostTime_Now();
+        uint8_t error = MAX30101_AutoConfig_Search(&params, &result);
+        double host_ms = (MAX30101_HostTime_Now() - start) / 1e6;
+        if (error != MAX30101_OK)
+        {
+            printf("%6u uW  no setting\n", params.budget_uw);
+            failed = 1;
+            continue;
+        }
+
+        uint8_t pw = result.spo2_conf & 0x03;
+        uint8_t avg = result.sample_avg >> MAX30101_SAMPLE_AVG_SHIFT;
+        uint8_t range;
+        double model = ABench_ModelSNR(pw, avg, result.led_pa, &range);
+        double best = ABench_BestSNR(params.budget_uw);
+        int ok = (result.power_uw <= params.budget_uw) && (model >= ABENCH_MIN_SNR_RATIO * best);
+        failed |= !ok;
+        printf("%6u uW %4u us %4u %5.1f mA %6u nA %6u uW %7u %9.0f %9.0f %8u %8.2f s %5.1f ms %s\n",
+               params.budget_uw, MAX30101_Rate_PulseWidth(pw), 1u << avg, result.led_pa / 5.0,
+               2048u << (result.spo2_conf >> MAX30101_ADC_RANGE_SHIFT), result.power_uw, result.snr, model, best,
+               result.captures, result.capture_us / 1e6, host_ms, ok ? "ok" : "FAILED");
+    }
+
+    failed |= ABench_Cache(&result);
+    return failed;
+}
+
+// Power on and boot the simulated device in SpO2 mode
+static void ABench_Boot(void)
+{
+    MAX30101_Config config = {
+        .fifo_conf = MAX30101_SAMPLE_AVG_1 | MAX30101_CONF_FIFO_A_FULL(32),
+        .mode_conf = MAX30101_SPO2_MODE,
+        .spo2_conf = MAX30101_ADC_RANGE_4096 | MAX30101_SAMPLE_RATE_100 | MAX30101_PULSEWIDTH_69,
+        .led_pa = {0x1F, 0x1F, 0x1F, 0x1F},
+    };
+    MAX30101_SimLight light = {
+        .pulse_na = ABENCH_PULSE_NA,
+        .period = ABENCH_RATE * 60 / 72,
+        .na_per_ma = ABENCH_NA_PER_MA,
+        .noise_na = ABENCH_NOISE_NA,
+    };
+    MAX30101_Sim_PowerOn();
+    MAX30101_Sim_SetLight(&light);
+    MAX30101_Boot(&config, NULL);
+    abench_pending_us = 0;
+}
+
+// Acquire the samples of the waited time
+static void ABench_Wait(uint32_t us)
+{
+    abench_pending_us += us;
+    uint64_t samples = abench_pending_us * ABENCH_RATE / 1000000u;
+    abench_pending_us -= samples * 1000000u / ABENCH_RATE;
+    MAX30101_Sim_Generate((uint16_t)samples);
+}
+
+// SNR of the light model for a setting, with the range the search would select
+static double ABench_ModelSNR(uint8_t pw, uint8_t avg, uint8_t led_pa, uint8_t* range)
+{
+    double light = ABENCH_NA_PER_MA * led_pa / 5.0;
+    double noise = ABENCH_NOISE_NA * abench_noise_pw[pw] / 1024.0 * abench_noise_avg[avg] / 1024.0;
+    double peak = light + ABENCH_PULSE_NA / 2.0 + 3.0 * noise;
+    *range = 0;
+    while ((*range < 3) && (peak >= 0.75 * (2048u << *range)))
+    {
+        (*range)++;
+    }
+    if (light + ABENCH_PULSE_NA / 2.0 >= 15.0 / 16.0 * 16384)
+    {
+        return 0.0;
+    }
+    // Quantization noise of the range and resolution
+    double lsb = (2048u << *range) / (double)(1u << (15 + pw));
+    return light / sqrt(noise * noise + lsb * lsb / 12.0);
+}
+
+// Best model SNR over every setting within the budget
+static double ABench_BestSNR(uint32_t budget_uw)
+{
+    double best = 0.0;
+    for (uint8_t pw = 0; pw < 4; pw++)
+    {
+        for (uint8_t avg = 0; avg < 6; avg++)
+        {
+            uint32_t adc_rate = ABENCH_RATE << avg;
+            uint8_t rate = 0;
+            while ((rate < 8) && (MAX30101_Rate_SampleRate(rate) != adc_rate))
+            {
+                rate++;
+            }
+            if ((rate == 8) || (rate > MAX30101_RATE_MAX_SETTING(2, pw)))
+            {
+                continue;
+            }
+            for (uint8_t k = 0; k < sizeof(abench_led_pa); k++)
+            {
+                uint8_t range;
+                uint8_t spo2_conf = (rate << MAX30101_SAMPLE_RATE_SHIFT) | pw;
+                if (MAX30101_AutoConfig_Power(spo2_conf, abench_led_pa[k], 2) > budget_uw)
+                {
+                    continue;
+                }
+                double snr = ABench_ModelSNR(pw, avg, abench_led_pa[k], &range);
+                best = (snr > best) ? snr : best;
+            }
+        }
+    }
+    return best;
+}
+
+// Pack a result, boot again and apply it from the cache, return 1 on error
+static int ABench_Cache(const MAX30101_AutoConfigResult* result)
+{
+    uint8_t cache[MAX30101_AUTOCFG_CACHE_SIZE];
+    MAX30101_AutoConfigResult cached;
+    MAX30101_AutoConfig_Pack(result, cache);
+
+    ABench_Boot();
+    MAX30101_SimStats stats;
+    MAX30101_Sim_ResetStats();
+    uint64_t start = MAX30101_HostTime_Now();
+    uint8_t error = MAX30101_AutoConfig_Unpack(cache, &cached);
+    if (error == MAX30101_OK)
+    {
+        error = MAX30101_AutoConfig_Apply(&cached);
+    }
+    double host_us = (MAX30101_HostTime_Now() - start) / 1e3;
+    MAX30101_Sim_GetStats(&stats);
+
+    uint8_t spo2_conf, fifo_conf, led1, led2;
+    MAX30101_ReadRegister(MAX30101_SPO2_CONF, &spo2_conf);
+    MAX30101_ReadRegister(MAX30101_FIFO_CONF, &fifo_conf);
+    MAX30101_ReadRegister(MAX30101_LED1_PA, &led1);
+    MAX30101_ReadRegister(MAX30101_LED2_PA, &led2);
+    int failed = (error != MAX30101_OK) || ((spo2_conf & 0x7F) != result->spo2_conf) ||
+                 ((fifo_conf & 0xE0) != result->sample_avg) || (led1 != result->led_pa) || (led2 != result->led_pa);
+
+    // A corrupted cache must be rejected
+    cache[4] ^= 0x01;
+    if (MAX30101_AutoConfig_Unpack(cache, &cached) == MAX30101_OK)
+    {
+        failed = 1;
+    }
+    printf("\nCached setting (%u bytes) applied at boot: %u us on the bus at %u kHz, %.1f us on the host "
+           "(search: %.2f s of captures) %s\n", MAX30101_AUTOCFG_CACHE_SIZE,
+           MAX30101_Sim_BusTime(&stats, ABENCH_I2C_CLOCK_HZ), ABENCH_I2C_CLOCK_HZ / 1000, host_us,
+           result->capture_us / 1e6, failed ? "FAILED" : "ok");
+    return failed;
+}
+
+/* [] END OF FILE */
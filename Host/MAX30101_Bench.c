@@ -0,0 +1,300 @@
+/**
+*   Benchmark of the MAX30101 FIFO read paths on the simulated device.
+*
+*   For HR and SpO2 modes and for Multi-LED slot layouts (1 to 4 slots,
+*   the same LED in several slots, disabled slots between enabled ones),
+*   fills the FIFO of the simulated MAX30101 (see MAX30101_Sim.h) and
+*   reads it back with each read path of the library:
+*   - #MAX30101_ReadRawFIFO: one transaction per channel;
+*   - #MAX30101_ReadFIFO: one transaction, unpacked while received (up to
+*     3 channels; with 4 slots it must refuse and leave the FIFO unread);
+*   - #MAX30101_ReadRawFIFOBytes: one burst, no unpack;
+*   - #MAX30101_ReadMultiLEDFIFO: slot and pulse width read, burst, demux
+*     (Multi-LED mode only);
+*   - MAX30101_Fixed_ReadFIFO: burst and specialised unpack (only in the
+*     mode and slots of MAX30101_FixedConfig.h);
+*   - #MAX30101_Trace_ReadFIFO: pointers and data in two bursts.
+*
+*   For each path it reports the host CPU time per burst, the bus usage
+*   per burst and the time the same usage takes on a 400 kHz bus, and
+*   checks that the FIFO is drained and that the last sample of each
+*   channel is the one acquired, so that a layout read with the wrong
+*   number or order of channels is caught.
+*
+*   Each mode is run with bursts of the given size and with bursts of a
+*   full FIFO (32 samples), where the FIFO pointers are equal and the
+*   overflow counter is 0: #MAX30101_Trace_ReadFIFO, which counts the
+*   samples from the pointers, must then rely on the A_FULL interrupt.
+*
+*   Usage: max30101_bench [bursts] [samples_per_burst]
+*/
+
+#include "MAX30101.h"
+#include "MAX30101_Fixed.h"
+#include "MAX30101_Trace.h"
+#include "MAX30101_Sim.h"
+#include "MAX30101_HostTime.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+*   \brief I2C clock used to convert bus usage to time.
+*/
+#define BENCH_I2C_CLOCK_HZ 400000
+
+/**
+*   \brief Read paths.
+*/
+#define BENCH_PATH_RAW_FIFO     0
+#define BENCH_PATH_FIFO         1
+#define BENCH_PATH_RAW_BYTES    2
+#define BENCH_PATH_MULTI_LED    3
+#define BENCH_PATH_FIXED        4
+#define BENCH_PATH_TRACE        5
+#define BENCH_PATHS             6
+
+/**
+*   \brief Settings of a benchmarked mode.
+*/
+typedef struct
+{
+    const char* name;       ///< Name of the mode.
+    uint8_t mode_conf;      ///< Value of MODE_CONF.
+    uint8_t multi_led[2];   ///< Values of MULTI_LED_1 and MULTI_LED_2.
+    uint8_t leds;           ///< Number of channels.
+} Bench_Mode;
+
+static const Bench_Mode bench_modes[] = {
+    {"HR", MAX30101_HR_MODE, {0x00, 0x00}, 1},
+    {"SpO2", MAX30101_SPO2_MODE, {0x00, 0x00}, 2},
+    {"Multi-LED", MAX30101_MULTI_MODE,
+     {MAX30101_CONF_SLOTS(MAX30101_SLOT_RED, MAX30101_SLOT_IR), MAX30101_CONF_SLOTS(MAX30101_SLOT_GREEN, MAX30101_SLOT_NONE)}, 3},
+    {"R", MAX30101_MULTI_MODE,
+     {MAX30101_CONF_SLOTS(MAX30101_SLOT_RED, MAX30101_SLOT_NONE), MAX30101_CONF_SLOTS(MAX30101_SLOT_NONE, MAX30101_SLOT_NONE)}, 1},
+    {"R,IR", MAX30101_MULTI_MODE,
+     {MAX30101_CONF_SLOTS(MAX30101_SLOT_RED, MAX30101_SLOT_IR), MAX30101_CONF_SLOTS(MAX30101_SLOT_NONE, MAX30101_SLOT_NONE)}, 2},
+    {"R,IR,G,R", MAX30101_MULTI_MODE,
+     {MAX30101_CONF_SLOTS(MAX30101_SLOT_RED, MAX30101_SLOT_IR), MAX30101_CONF_SLOTS(MAX30101_SLOT_GREEN, MAX30101_SLOT_RED)}, 4},
+    {"G,G,G,G", MAX30101_MULTI_MODE,
+     {MAX30101_CONF_SLOTS(MAX30101_SLOT_GREEN, MAX30101_SLOT_GREEN), MAX30101_CONF_SLOTS(MAX30101_SLOT_GREEN, MAX30101_SLOT_GREEN)}, 4},
+    {"IR,IR", MAX30101_MULTI_MODE,
+     {MAX30101_CONF_SLOTS(MAX30101_SLOT_IR, MAX30101_SLOT_IR), MAX30101_CONF_SLOTS(MAX30101_SLOT_NONE, MAX30101_SLOT_NONE)}, 2},
+    {"R,-,IR", MAX30101_MULTI_MODE,
+     {MAX30101_CONF_SLOTS(MAX30101_SLOT_RED, MAX30101_SLOT_NONE), MAX30101_CONF_SLOTS(MAX30101_SLOT_IR, MAX30101_SLOT_NONE)}, 2},
+    {"-,G,-,R", MAX30101_MULTI_MODE,
+     {MAX30101_CONF_SLOTS(MAX30101_SLOT_NONE, MAX30101_SLOT_GREEN), MAX30101_CONF_SLOTS(MAX30101_SLOT_NONE, MAX30101_SLOT_RED)}, 2},
+};
+
+static const char* bench_path_names[BENCH_PATHS] = {
+    "ReadRawFIFO", "ReadFIFO", "ReadRawFIFOBytes", "ReadMultiLEDFIFO", "Fixed_ReadFIFO", "Trace_ReadFIFO"
+};
+
+static uint8_t Bench_Read(uint8_t path, const Bench_Mode* mode, uint8_t num_samples, uint32_t* last);
+
+static uint8_t Bench_HasPath(uint8_t path, const Bench_Mode* mode);
+
+static uint8_t Bench_Refused(const Bench_Mode* mode, uint8_t num_samples);
+
+static void Bench_LastRaw(const uint8_t* raw, uint8_t num_samples, uint8_t leds, uint32_t* last);
+
+int main(int argc, char** argv)
+{
+    uint32_t bursts = (argc > 1) ? (uint32_t)strtoul(argv[1], NULL, 0) : 20000;
+    uint8_t num_samples = (argc > 2) ? (uint8_t)strtoul(argv[2], NULL, 0) : 16;
+    if ((bursts == 0) || (num_samples == 0) || (num_samples > 32))
+    {
+        fprintf(stderr, "Usage: %s [bursts] [samples_per_burst (1-32)]\n", argv[0]);
+        return 1;
+    }
+
+    MAX30101_Config config = {
+        .int_en_1 = MAX30101_CONF_INT_A_FULL,
+        .fifo_conf = MAX30101_FIXED_FIFO_CONF | MAX30101_CONF_FIFO_ROLLOVER | MAX30101_CONF_FIFO_A_FULL(32),
+        .spo2_conf = MAX30101_FIXED_SPO2_CONF,
+        .led_pa = {0x1F, 0x1F, 0x1F, 0x1F},
+    };
+    MAX30101_Sim_PowerOn();
+    if (MAX30101_Boot(&config, NULL) != MAX30101_OK)
+    {
+        fprintf(stderr, "Boot failed\n");
+        return 1;
+    }
+    uint8_t shift = 3 - (MAX30101_FIXED_SPO2_CONF & 0x03);
+
+    // Bursts of the given size, then of a full FIFO
+    uint8_t sizes[2] = {num_samples, 32};
+    uint8_t num_sizes = (num_samples == 32) ? 1 : 2;
+
+    printf("%u bursts per run, bus time at %u kHz\n", bursts, BENCH_I2C_CLOCK_HZ / 1000);
+    printf("Slots of Multi-LED layouts: R(ed), IR, G(reen), - (disabled)\n");
+    printf("%-10s %-17s %7s %10s %6s %7s %7s %10s %s\n", "Mode", "Path", "Samples", "CPU/burst", "Starts",
+           "Written", "Read", "Bus/burst", "Check");
+    int failed = 0;
+    for (uint8_t m = 0; m < sizeof(bench_modes) / sizeof(bench_modes[0]); m++)
+    {
+        const Bench_Mode* mode = &bench_modes[m];
+        config.mode_conf = mode->mode_conf;
+        config.multi_led[0] = mode->multi_led[0];
+        config.multi_led[1] = mode->multi_led[1];
+        if (MAX30101_ApplyConfig(&config) != MAX30101_OK)
+        {
+            printf("%-10s configuration refused\n", mode->name);
+            failed = 1;
+            continue;
+        }
+
+        for (uint8_t run = 0; run < num_sizes * BENCH_PATHS; run++)
+        {
+            uint8_t path = run % BENCH_PATHS;
+            num_samples = sizes[run / BENCH_PATHS];
+            if (!Bench_HasPath(path, mode))
+            {
+                continue;
+            }
+
+            MAX30101_FlushFIFO();
+            MAX30101_Sim_ResetStats();
+            uint64_t cpu_ns = 0;
+            uint8_t ok = 1;
+            MAX30101_SimStats stats;
+            for (uint32_t b = 0; b < bursts; b++)
+            {
+                MAX30101_Sim_Generate(num_samples);
+                uint32_t last[MAX30101_MAX_SLOTS];
+                uint64_t start = MAX30101_HostTime_Now();
+                uint8_t read = Bench_Read(path, mode, num_samples, last);
+                cpu_ns += MAX30101_HostTime_Now() - start;
+
+                if (!read || (MAX30101_Sim_GetFIFOCount() != 0))
+                {
+                    ok = 0;
+                    continue;
+                }
+                for (uint8_t ch = 0; ch < mode->leds; ch++)
+                {
+                    uint32_t expected = MAX30101_Sim_GetLastSample(ch);
+                    // Raw values are not shifted
+                    if ((path != BENCH_PATH_RAW_FIFO) && (path != BENCH_PATH_RAW_BYTES) && (path != BENCH_PATH_TRACE))
+                    {
+                        expected >>= shift;
+                    }
+                    if (last[ch] != expected)
+                    {
+                        ok = 0;
+                    }
+                }
+            }
+            MAX30101_Sim_GetStats(&stats);
+            failed |= !ok;
+
+            printf("%-10s %-17s %7u %7.2f us %6.1f %7.1f %7.1f %7.0f us %s\n", mode->name, bench_path_names[path],
+                   num_samples, cpu_ns / 1e3 / bursts, (double)stats.starts / bursts, (double)stats.bytes_written / bursts,
+                   (double)stats.bytes_read / bursts, (double)MAX30101_Sim_BusTime(&stats, BENCH_I2C_CLOCK_HZ) / bursts,
+                   ok ? "ok" : "FAILED");
+        }
+
+        if (!Bench_HasPath(BENCH_PATH_FIFO, mode))
+        {
+            uint8_t ok = Bench_Refused(mode, sizes[0]);
+            failed |= !ok;
+            printf("%-10s %-17s %7u %10s %6s %7s %7s %10s %s\n", mode->name, bench_path_names[BENCH_PATH_FIFO],
+                   sizes[0], "-", "-", "-", "-", "-", ok ? "refused" : "FAILED");
+        }
+    }
+    return failed;
+}
+
+// Read the FIFO with a path, return 1 if all the samples were read; last holds the last sample of each channel
+static uint8_t Bench_Read(uint8_t path, const Bench_Mode* mode, uint8_t num_samples, uint32_t* last)
+{
+    static uint32_t raw_values[32*MAX30101_MAX_SLOTS];
+    static uint8_t raw_bytes[32*MAX30101_MAX_SLOTS*3];
+    static MAX30101_Data data;
+    static MAX30101_MultiData multi_data;
+    static MAX30101_Fixed_Data fixed_data;
+    uint8_t read;
+
+    switch (path)
+    {
+        case BENCH_PATH_RAW_FIFO:
+            MAX30101_ReadRawFIFO(num_samples, mode->leds, raw_values);
+            for (uint8_t ch = 0; ch < mode->leds; ch++)
+            {
+                last[ch] = raw_values[(num_samples - 1) * mode->leds + ch];
+            }
+            return 1;
+        case BENCH_PATH_FIFO:
+            MAX30101_ReadFIFO(num_samples, mode->leds, &data);
+            last[0] = data.red[data.head];
+            last[1] = data.IR[data.head];
+            last[2] = data.green[data.head];
+            return 1;
+        case BENCH_PATH_RAW_BYTES:
+            MAX30101_ReadRawFIFOBytes(num_samples, mode->leds, raw_bytes);
+            Bench_LastRaw(raw_bytes, num_samples, mode->leds, last);
+            return 1;
+        case BENCH_PATH_MULTI_LED:
+            MAX30101_ReadMultiLEDFIFO(num_samples, &multi_data);
+            for (uint8_t ch = 0; ch < mode->leds; ch++)
+            {
+                last[ch] = multi_data.slot[ch][multi_data.head];
+            }
+            return 1;
+        case BENCH_PATH_FIXED:
+            MAX30101_Fixed_ReadFIFO(num_samples, &fixed_data);
+            for (uint8_t ch = 0; ch < MAX30101_FIXED_LEDS; ch++)
+            {
+                last[ch] = fixed_data.channel[ch][fixed_data.head];
+            }
+            return 1;
+        default:
+            // Read after an A_FULL interrupt, as in the trace build of the example
+            if ((MAX30101_Trace_ReadFIFO(mode->leds, 1, raw_bytes, &read) != MAX30101_OK) || (read != num_samples))
+            {
+                return 0;
+            }
+            Bench_LastRaw(raw_bytes, num_samples, mode->leds, last);
+            return 1;
+    }
+}
+
+// 1 if the read path handles the mode
+static uint8_t Bench_HasPath(uint8_t path, const Bench_Mode* mode)
+{
+    switch (path)
+    {
+        case BENCH_PATH_FIFO:
+            // Red, IR and green buffers only
+            return mode->leds <= 3;
+        case BENCH_PATH_MULTI_LED:
+            return mode->mode_conf == MAX30101_MULTI_MODE;
+        case BENCH_PATH_FIXED:
+            return (mode->mode_conf == MAX30101_FIXED_MODE) &&
+                   ((mode->mode_conf != MAX30101_MULTI_MODE) ||
+                    ((mode->multi_led[0] == MAX30101_FIXED_MULTI_LED_1) && (mode->multi_led[1] == MAX30101_FIXED_MULTI_LED_2)));
+        default:
+            return 1;
+    }
+}
+
+// Check that ReadFIFO refuses a layout it cannot unpack and leaves the FIFO unread
+static uint8_t Bench_Refused(const Bench_Mode* mode, uint8_t num_samples)
+{
+    static MAX30101_Data data;
+    MAX30101_FlushFIFO();
+    MAX30101_Sim_Generate(num_samples);
+    return (MAX30101_ReadFIFO(num_samples, mode->leds, &data) == MAX30101_ERROR) &&
+           (MAX30101_Sim_GetFIFOCount() == num_samples);
+}
+
+static void Bench_LastRaw(const uint8_t* raw, uint8_t num_samples, uint8_t leds, uint32_t* last)
+{
+    const uint8_t* p = &raw[(num_samples - 1) * leds * 3];
+    for (uint8_t ch = 0; ch < leds; ch++)
+    {
+        last[ch] = (((uint32_t)p[3*ch] & 0x03) << 16) | ((uint32_t)p[3*ch + 1] << 8) | p[3*ch + 2];
+    }
+}
+
+/* [] END OF FILE */
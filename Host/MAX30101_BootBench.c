@@ -0,0 +1,206 @@
+/**
+*   Time from power-on to the first FIFO interrupt on the simulated device.
+*
+*   Two start-up sequences bring the simulated device (see MAX30101_Sim.h)
+*   from power-on to the configuration of the library example (SpO2 mode,
+*   200 samples/s, A_FULL interrupt at 32 samples):
+*   - legacy: the sequence of the library example before MAX30101_Boot,
+*     a reset not waited for and a fixed 100 ms delay, a second reset and
+*     delay, then one read-modify-write per setting and a FIFO clear;
+*   - boot: MAX30101_Boot, which polls for the device and for the end of
+*     the reset, and writes the configuration in bursts, then a FIFO flush.
+*
+*   The simulated time of a sequence is its I2C bus time at 400 kHz plus
+*   the delays it requests (the host delays return at once and only add up
+*   their duration). The device then runs until the A_FULL interrupt. For
+*   each sequence the bench reports the time to configure the device, the
+*   time to the first interrupt and the bus usage, and prints the boot
+*   trace of MAX30101_Boot. Fails if the boot sequence is not ready in
+*   1 ms, or if its first interrupt is not at least 150 ms earlier than
+*   with the legacy sequence.
+*
+*   Usage: max30101_bootbench
+*/
+
+#include "MAX30101.h"
+#include "MAX30101_Fixed.h"
+#include "MAX30101_Sim.h"
+#include "CyLib.h"
+#include "I2C_Interface.h"
+#include <stdio.h>
+
+/**
+*   \brief I2C clock used to convert bus usage to time.
+*/
+#define BBENCH_I2C_CLOCK_HZ 400000
+
+/**
+*   \brief Step of the simulated device while waiting for the interrupt, in us.
+*/
+#define BBENCH_STEP_US 100
+
+/**
+*   \brief Longest wait for the interrupt, in us.
+*/
+#define BBENCH_TIMEOUT_US 2000000
+
+/**
+*   \brief Longest time to configure the device with MAX30101_Boot, in us.
+*/
+#define BBENCH_BOOT_MAX_US 1000
+
+/**
+*   \brief Smallest gain of MAX30101_Boot on the first interrupt, in us.
+*/
+#define BBENCH_MIN_GAIN_US 150000
+
+/**
+*   \brief Results of a start-up sequence.
+*/
+typedef struct
+{
+    uint8_t error;              ///< Error code of the sequence.
+    uint32_t delay_us;          ///< Fixed delays.
+    uint32_t bus_us;            ///< I2C bus time.
+    uint32_t ready_us;          ///< Time to configure the device (bus time and delays).
+    uint32_t interrupt_us;      ///< Time to the first A_FULL interrupt, 0 if none.
+    MAX30101_SimStats bus;      ///< Bus usage.
+} BBench_Result;
+
+// Simulated time since the start of the sequence, in us
+static uint32_t BBench_Now(void)
+{
+    MAX30101_SimStats stats;
+    MAX30101_Sim_GetStats(&stats);
+    return MAX30101_Sim_BusTime(&stats, BBENCH_I2C_CLOCK_HZ) + CyDelay_GetTotalUs();
+}
+
+// Start-up of the library example before MAX30101_Boot
+static uint8_t BBench_Legacy(void)
+{
+    // Start issued a reset without waiting for it
+    I2C_Peripheral_Start();
+    MAX30101_Reset();
+    CyDelay(100);
+    if (MAX30101_IsDevicePresent() != MAX30101_OK)
+    {
+        return MAX30101_DEV_NOT_FOUND;
+    }
+    MAX30101_Reset();
+    CyDelay(100);
+    MAX30101_WakeUp();
+    MAX30101_DisableALCOverflowInt();
+    MAX30101_DisableTempReadyInt();
+    MAX30101_DisablePPGReadyInt();
+    MAX30101_EnableFIFOAFullInt();
+    MAX30101_SetFIFOAlmostFull(32);
+    MAX30101_EnableFIFORollover();
+    MAX30101_SetSampleAverage(MAX30101_SAMPLE_AVG_2);
+    MAX30101_SetLEDPulseAmplitude(MAX30101_LED_1, 0x1F);
+    MAX30101_SetLEDPulseAmplitude(MAX30101_LED_2, 0x1F);
+    MAX30101_SetLEDPulseAmplitude(MAX30101_LED_3, 0x1F);
+    MAX30101_SetLEDPulseAmplitude(MAX30101_LED_4, 0x1F);
+    MAX30101_SetSpO2ADCRange(MAX30101_ADC_RANGE_4096);
+    MAX30101_SetSpO2PulseWidth(MAX30101_PULSEWIDTH_69);
+    MAX30101_SetSpO2SampleRate(MAX30101_SAMPLE_RATE_400);
+    MAX30101_SetMode(MAX30101_SPO2_MODE);
+    MAX30101_DisableSlots();
+    return MAX30101_ClearFIFO();
+}
+
+// Start-up of the library example with MAX30101_Boot
+static uint8_t BBench_Boot(MAX30101_BootTrace* trace)
+{
+    MAX30101_Config config = {
+        .int_en_1 = MAX30101_CONF_INT_A_FULL,
+        .int_en_2 = 0x00,
+        .fifo_conf = MAX30101_FIXED_FIFO_CONF | MAX30101_CONF_FIFO_ROLLOVER | MAX30101_CONF_FIFO_A_FULL(32),
+        .mode_conf = MAX30101_FIXED_MODE_CONF,
+        .spo2_conf = MAX30101_FIXED_SPO2_CONF,
+        .led_pa = {0x1F, 0x1F, 0x1F, 0x1F},
+        .pilot_pa = 0x00,
+        .multi_led = {MAX30101_FIXED_MULTI_LED_1, MAX30101_FIXED_MULTI_LED_2},
+        .prox_thresh = 0x00
+    };
+    uint8_t error = MAX30101_Boot(&config, trace);
+    if (error == MAX30101_OK)
+    {
+        error = MAX30101_FlushFIFO();
+    }
+    return error;
+}
+
+// Run the device until the first interrupt
+static uint32_t BBench_WaitInterrupt(void)
+{
+    for (uint32_t waited = 0; waited < BBENCH_TIMEOUT_US; waited += BBENCH_STEP_US)
+    {
+        if (MAX30101_Sim_IsInterrupt())
+        {
+            return waited;
+        }
+        MAX30101_Sim_Run(BBENCH_STEP_US);
+    }
+    return 0;
+}
+
+// Run a start-up sequence from power-on (legacy if trace is NULL)
+static void BBench_Run(MAX30101_BootTrace* trace, BBench_Result* result)
+{
+    MAX30101_Sim_PowerOn();
+    MAX30101_Sim_ResetStats();
+    CyDelay_ResetTotal();
+    result->error = (trace == NULL) ? BBench_Legacy() : BBench_Boot(trace);
+    MAX30101_Sim_GetStats(&result->bus);
+    result->delay_us = CyDelay_GetTotalUs();
+    result->bus_us = MAX30101_Sim_BusTime(&result->bus, BBENCH_I2C_CLOCK_HZ);
+    result->ready_us = result->delay_us + result->bus_us;
+    result->interrupt_us = 0;
+    if (result->error == MAX30101_OK)
+    {
+        uint32_t waited = BBench_WaitInterrupt();
+        result->interrupt_us = (waited > 0) ? result->ready_us + waited : 0;
+    }
+}
+
+// Print a row of the table
+static void BBench_Print(const char* name, const BBench_Result* result)
+{
+    printf("%-8s %6u %9.1f %9.1f %9.1f %12.1f %6u %6u\n", name, result->error, result->delay_us / 1000.0,
+           result->bus_us / 1000.0, result->ready_us / 1000.0, result->interrupt_us / 1000.0,
+           result->bus.starts, result->bus.bytes_written + result->bus.bytes_read);
+}
+
+// Print a line of the boot trace
+static void BBench_PrintLine(const char* line)
+{
+    fputs(line, stdout);
+}
+
+int main(void)
+{
+    BBench_Result legacy, boot;
+    MAX30101_BootTrace trace = { .get_time = BBench_Now };
+
+    BBench_Run(NULL, &legacy);
+    BBench_Run(&trace, &boot);
+
+    printf("Power-on to first A_FULL interrupt (32 samples at 200 samples/s), I2C at %u kHz\n",
+           BBENCH_I2C_CLOCK_HZ / 1000);
+    printf("%-8s %6s %9s %9s %9s %12s %6s %6s\n", "start-up", "error", "delay ms", "bus ms", "ready ms",
+           "interrupt ms", "starts", "bytes");
+    BBench_Print("legacy", &legacy);
+    BBench_Print("boot", &boot);
+    printf("\nBoot trace (us):\n");
+    MAX30101_PrintBootTrace(BBench_PrintLine, &trace);
+
+    int failed = (legacy.error != MAX30101_OK) || (boot.error != MAX30101_OK) ||
+                 (legacy.interrupt_us == 0) || (boot.interrupt_us == 0) ||
+                 (boot.ready_us > BBENCH_BOOT_MAX_US) ||
+                 (boot.interrupt_us + BBENCH_MIN_GAIN_US > legacy.interrupt_us);
+    printf("\nFirst interrupt %.1f ms earlier: %s\n", ((double)legacy.interrupt_us - boot.interrupt_us) / 1000.0,
+           failed ? "FAILED" : "ok");
+    return failed ? 1 : 0;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,364 @@
+/**
+*   Round-trip latency of the binary command channel.
+*
+*   The host client (MAX30101_CmdClient.h) sends each command to the
+*   command channel of MAX30101_Command.h over a simulated UART at
+*   115200 baud, 8N1 (10 bits per byte), in virtual time. The device
+*   side is the same as in the library test project: each byte is fed
+*   to the parser as in the receive interrupt, a complete frame posts
+*   the command to a task (a fixed dispatch cost), which executes it on
+*   the simulated MAX30101 (see MAX30101_Sim.h) and sends the reply.
+*
+*   The round trip is the time from the first request byte on the wire
+*   to the last reply byte received: request bytes, dispatch, I2C
+*   transfers at 400 kHz and reply bytes. The CPU time of the host to
+*   parse and execute each command is reported separately, as well as
+*   checks of the replies (values written are read back, CRC errors,
+*   commands sent too early, reads of FIFO_DATA and configurations with
+*   a sample rate not allowed are rejected, text bytes are kept).
+*
+*   Usage: max30101_cmdbench [rounds]
+*/
+
+#include "MAX30101.h"
+#include "MAX30101_CmdClient.h"
+#include "MAX30101_Command.h"
+#include "MAX30101_Fixed.h"
+#include "MAX30101_Profile.h"
+#include "MAX30101_Sim.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+*   \brief UART: baud rate and bits per byte (start, 8 data, stop).
+*/
+#define CBENCH_BAUD 115200
+#define CBENCH_BITS_PER_BYTE 10
+
+/**
+*   \brief I2C clock used to convert bus usage to time.
+*/
+#define CBENCH_I2C_CLOCK_HZ 400000
+
+/**
+*   \brief Receive interrupt to task: post and dispatch of the scheduler, in us.
+*/
+#define CBENCH_DISPATCH_US 10
+
+/**
+*   \brief A command of the benchmark.
+*/
+typedef struct
+{
+    const char* name;
+    uint8_t command;
+    uint8_t payload[MAX30101_CMD_MAX_PAYLOAD];
+    uint8_t length;
+} CBench_Command;
+
+/**
+*   \brief Result of a round trip.
+*/
+typedef struct
+{
+    double wire_us;     ///< Request and reply bytes on the UART.
+    double bus_us;      ///< I2C transfers.
+    uint64_t cpu_ns;    ///< Host CPU time to parse and execute.
+    uint8_t request_bytes;
+    uint8_t reply_bytes;
+} CBench_Trip;
+
+static MAX30101_CmdChannel cbench_channel;
+static MAX30101_CmdClient cbench_client;
+static uint8_t cbench_reply[MAX30101_CMD_MAX_FRAME];
+static uint8_t cbench_reply_bytes;
+static uint8_t cbench_streaming = 1;
+static uint32_t cbench_configured;
+static uint32_t cbench_failures;
+
+static void CBench_Send(const uint8_t* bytes, uint8_t length);
+
+static void CBench_SetStreaming(uint8_t on);
+
+static uint8_t CBench_GetCounters(uint8_t* payload, uint8_t size);
+
+static void CBench_Configured(void);
+
+static const MAX30101_CmdHandlers cbench_handlers = {
+    .send = CBench_Send,
+    .set_streaming = CBench_SetStreaming,
+    .get_counters = CBench_GetCounters,
+    .configured = CBench_Configured
+};
+
+static void CBench_Boot(void);
+
+static uint8_t CBench_RoundTrip(const uint8_t* request, uint8_t length, MAX30101_CmdReply* reply, CBench_Trip* trip);
+
+static void CBench_Check(uint8_t ok, const char* what);
+
+static void CBench_RunChecks(void);
+
+int main(int argc, char** argv)
+{
+    uint32_t rounds = (argc > 1) ? (uint32_t)strtoul(argv[1], NULL, 0) : 1000;
+    if (rounds == 0)
+    {
+        rounds = 1000;
+    }
+    MAX30101_Profile_Start();
+    CBench_Boot();
+
+    CBench_Command commands[] = {
+        { "read 1", MAX30101_CMD_READ, { MAX30101_MODE_CONF, 1 }, 2 },
+        { "read 32", MAX30101_CMD_READ, { MAX30101_FIFO_CONF, 32 }, 2 },
+        { "write 1", MAX30101_CMD_WRITE, { MAX30101_LED1_PA, 0x24 }, 2 },
+        { "write 4", MAX30101_CMD_WRITE, { MAX30101_LED1_PA, 0x24, 0x24, 0x24, 0x24 }, 5 },
+        { "config", MAX30101_CMD_CONFIG, { 0 }, 0 },
+        { "stream", MAX30101_CMD_STREAM, { 0 }, 1 },
+        { "counters", MAX30101_CMD_COUNTERS, { 0 }, 0 },
+        { "snapshot", MAX30101_CMD_SNAPSHOT, { 0 }, 0 },
+    };
+    // Configuration of the test project, sent as a CONFIG request
+    MAX30101_Config config = {
+        .int_en_1 = MAX30101_CONF_INT_A_FULL,
+        .fifo_conf = MAX30101_FIXED_FIFO_CONF | MAX30101_CONF_FIFO_ROLLOVER | MAX30101_CONF_FIFO_A_FULL(32),
+        .mode_conf = MAX30101_FIXED_MODE_CONF,
+        .spo2_conf = MAX30101_FIXED_SPO2_CONF,
+        .led_pa = {0x1F, 0x1F, 0x1F, 0x1F},
+        .multi_led = {MAX30101_FIXED_MULTI_LED_1, MAX30101_FIXED_MULTI_LED_2},
+    };
+    uint8_t config_frame[MAX30101_CMD_MAX_FRAME];
+    MAX30101_CmdClient_EncodeConfig(&config, config_frame);
+    memcpy(commands[4].payload, &config_frame[3], MAX30101_CMD_CONFIG_SIZE);
+    commands[4].length = MAX30101_CMD_CONFIG_SIZE;
+
+    printf("%u rounds, UART at %u baud, I2C at %u Hz, dispatch %u us\n", rounds, CBENCH_BAUD,
+           CBENCH_I2C_CLOCK_HZ, CBENCH_DISPATCH_US);
+    printf("%-10s %8s %8s %10s %10s %10s %12s\n", "Command", "Request", "Reply", "Wire us", "I2C us",
+           "Trip us", "Host ns/cmd");
+    for (uint8_t c = 0; c < sizeof(commands) / sizeof(commands[0]); c++)
+    {
+        uint8_t frame[MAX30101_CMD_MAX_FRAME];
+        uint8_t length = MAX30101_CmdClient_Encode(commands[c].command, commands[c].payload, commands[c].length,
+                                                   frame);
+        CBench_Trip trip = {0};
+        uint64_t cpu_ns = 0;
+        double bus_us = 0;
+        uint32_t errors = 0;
+        for (uint32_t r = 0; r < rounds; r++)
+        {
+            // Alternate streaming on and off
+            if (commands[c].command == MAX30101_CMD_STREAM)
+            {
+                frame[3] = r & 1;
+                frame[4] = MAX30101_Cmd_Crc8(0, &frame[1], 3);
+            }
+            MAX30101_CmdReply reply;
+            if (!CBench_RoundTrip(frame, length, &reply, &trip) || (reply.status != MAX30101_OK))
+            {
+                errors++;
+            }
+            cpu_ns += trip.cpu_ns;
+            bus_us += trip.bus_us;
+        }
+        CBench_Check(errors == 0, commands[c].name);
+        printf("%-10s %8u %8u %10.1f %10.1f %10.1f %12.0f\n", commands[c].name, trip.request_bytes,
+               trip.reply_bytes, trip.wire_us, bus_us / rounds, trip.wire_us + CBENCH_DISPATCH_US + bus_us / rounds,
+               (double)cpu_ns / rounds);
+    }
+
+    CBench_RunChecks();
+    if (cbench_failures > 0)
+    {
+        printf("%u checks FAILED\n", cbench_failures);
+        return 1;
+    }
+    printf("All checks passed\n");
+    return 0;
+}
+
+// Power on and configure the simulated device, start a channel
+static void CBench_Boot(void)
+{
+    MAX30101_Config config = {
+        .int_en_1 = MAX30101_CONF_INT_A_FULL,
+        .fifo_conf = MAX30101_FIXED_FIFO_CONF | MAX30101_CONF_FIFO_ROLLOVER | MAX30101_CONF_FIFO_A_FULL(32),
+        .mode_conf = MAX30101_FIXED_MODE_CONF,
+        .spo2_conf = MAX30101_FIXED_SPO2_CONF,
+        .led_pa = {0x1F, 0x1F, 0x1F, 0x1F},
+        .multi_led = {MAX30101_FIXED_MULTI_LED_1, MAX30101_FIXED_MULTI_LED_2},
+    };
+    MAX30101_Sim_PowerOn();
+    MAX30101_Boot(&config, NULL);
+    MAX30101_Cmd_Init(&cbench_channel);
+    MAX30101_CmdClient_Init(&cbench_client);
+}
+
+// Send a request byte by byte, execute it, decode the reply; return 1 if a reply was decoded
+static uint8_t CBench_RoundTrip(const uint8_t* request, uint8_t length, MAX30101_CmdReply* reply, CBench_Trip* trip)
+{
+    double byte_us = 1e6 * CBENCH_BITS_PER_BYTE / CBENCH_BAUD;
+    uint8_t posted = 0;
+    uint32_t start = MAX30101_Profile_Now();
+    for (uint8_t i = 0; i < length; i++)
+    {
+        // Receive interrupt
+        posted |= MAX30101_Cmd_Feed(&cbench_channel, request[i]);
+    }
+    MAX30101_Sim_ResetStats();
+    cbench_reply_bytes = 0;
+    if (posted || cbench_channel.ready)
+    {
+        // Task, posted by the interrupt
+        MAX30101_Cmd_Execute(&cbench_channel, &cbench_handlers);
+    }
+    uint32_t end = MAX30101_Profile_Now();
+
+    MAX30101_SimStats stats;
+    MAX30101_Sim_GetStats(&stats);
+    trip->bus_us = MAX30101_Sim_BusTime(&stats, CBENCH_I2C_CLOCK_HZ);
+    trip->cpu_ns = end - start;
+    trip->request_bytes = length;
+    trip->reply_bytes = cbench_reply_bytes;
+    trip->wire_us = (length + cbench_reply_bytes) * byte_us;
+
+    uint8_t decoded = 0;
+    for (uint8_t i = 0; i < cbench_reply_bytes; i++)
+    {
+        if (MAX30101_CmdClient_Feed(&cbench_client, cbench_reply[i]))
+        {
+            *reply = cbench_client.reply;
+            decoded = 1;
+        }
+    }
+    return decoded;
+}
+
+// Checks of the protocol and of the values
+static void CBench_RunChecks(void)
+{
+    uint8_t frame[MAX30101_CMD_MAX_FRAME];
+    uint8_t length;
+    MAX30101_CmdReply reply;
+    CBench_Trip trip;
+
+    // Values written in a burst are read back
+    uint8_t leds[] = { MAX30101_LED1_PA, 0x11, 0x22, 0x33, 0x44 };
+    length = MAX30101_CmdClient_Encode(MAX30101_CMD_WRITE, leds, sizeof(leds), frame);
+    CBench_Check(CBench_RoundTrip(frame, length, &reply, &trip) && (reply.status == MAX30101_OK), "write status");
+    uint8_t read[] = { MAX30101_LED1_PA, 4 };
+    length = MAX30101_CmdClient_Encode(MAX30101_CMD_READ, read, sizeof(read), frame);
+    CBench_Check(CBench_RoundTrip(frame, length, &reply, &trip) && (reply.length == 4) &&
+                 (memcmp(reply.payload, &leds[1], 4) == 0), "read back");
+
+    // Corrupted frame: not executed, counted
+    uint32_t crc_errors = cbench_channel.crc_errors;
+    uint32_t commands = cbench_channel.commands;
+    length = MAX30101_CmdClient_Encode(MAX30101_CMD_READ, read, sizeof(read), frame);
+    frame[3] ^= 0x01;
+    CBench_Check(!CBench_RoundTrip(frame, length, &reply, &trip) && (cbench_channel.crc_errors == crc_errors + 1) &&
+                 (cbench_channel.commands == commands), "CRC error");
+
+    // Text bytes between frames are kept, the next frame is parsed
+    MAX30101_Cmd_Feed(&cbench_channel, 'p');
+    length = MAX30101_CmdClient_Encode(MAX30101_CMD_READ, read, sizeof(read), frame);
+    CBench_Check(CBench_RoundTrip(frame, length, &reply, &trip) && (MAX30101_Cmd_GetText(&cbench_channel) == 'p') &&
+                 (MAX30101_Cmd_GetText(&cbench_channel) == 0), "text byte");
+
+    // A command received before the previous one is executed is dropped
+    uint32_t dropped = cbench_channel.dropped;
+    for (uint8_t i = 0; i < length; i++)
+    {
+        MAX30101_Cmd_Feed(&cbench_channel, frame[i]);
+    }
+    CBench_Check(CBench_RoundTrip(frame, length, &reply, &trip) && (cbench_channel.dropped == dropped + 1) &&
+                 !MAX30101_Cmd_Execute(&cbench_channel, &cbench_handlers), "dropped");
+
+    // Invalid payload and unknown command: error status
+    length = MAX30101_CmdClient_Encode(MAX30101_CMD_READ, read, 1, frame);
+    CBench_Check(CBench_RoundTrip(frame, length, &reply, &trip) && (reply.status == MAX30101_ERROR), "bad length");
+    length = MAX30101_CmdClient_Encode(0x7F, NULL, 0, frame);
+    CBench_Check(CBench_RoundTrip(frame, length, &reply, &trip) && (reply.status == MAX30101_ERROR), "unknown");
+
+    // FIFO_DATA is not read: the samples stay in the FIFO
+    MAX30101_Sim_Generate(4);
+    uint8_t fifo_count = MAX30101_Sim_GetFIFOCount();
+    uint8_t pointers[] = { MAX30101_FIFO_WP, 4 };
+    length = MAX30101_CmdClient_Encode(MAX30101_CMD_READ, pointers, sizeof(pointers), frame);
+    CBench_Check(CBench_RoundTrip(frame, length, &reply, &trip) && (reply.status == MAX30101_ERROR) &&
+                 (MAX30101_Sim_GetFIFOCount() == fifo_count), "FIFO_DATA read");
+
+    // Sample rate not allowed with the pulse width: nothing written
+    MAX30101_Config config = {
+        .fifo_conf = MAX30101_SAMPLE_AVG_1,
+        .mode_conf = MAX30101_SPO2_MODE,
+        .spo2_conf = MAX30101_ADC_RANGE_4096 | MAX30101_SAMPLE_RATE_3200 | MAX30101_PULSEWIDTH_411,
+    };
+    uint8_t spo2_conf, written;
+    MAX30101_ReadRegister(MAX30101_SPO2_CONF, &spo2_conf);
+    length = MAX30101_CmdClient_EncodeConfig(&config, frame);
+    CBench_Check(CBench_RoundTrip(frame, length, &reply, &trip) && (reply.status == MAX30101_ERROR) &&
+                 (MAX30101_ReadRegister(MAX30101_SPO2_CONF, &written) == MAX30101_OK) && (written == spo2_conf),
+                 "config rate");
+
+    // Device removed: writes report it
+    MAX30101_Sim_SetPresent(0);
+    length = MAX30101_CmdClient_Encode(MAX30101_CMD_WRITE, leds, sizeof(leds), frame);
+    CBench_Check(CBench_RoundTrip(frame, length, &reply, &trip) && (reply.status == MAX30101_DEV_NOT_FOUND),
+                 "no device");
+    MAX30101_Sim_SetPresent(1);
+
+    // Counters of the channel and of the application
+    length = MAX30101_CmdClient_Encode(MAX30101_CMD_COUNTERS, NULL, 0, frame);
+    CBench_Check(CBench_RoundTrip(frame, length, &reply, &trip) &&
+                 (MAX30101_CmdClient_Counter(&reply, 1) == cbench_channel.crc_errors) &&
+                 (MAX30101_CmdClient_Counter(&reply, 2) == cbench_channel.dropped) &&
+                 (MAX30101_CmdClient_Counter(&reply, 3) == cbench_configured), "counters");
+    printf("Commands: %u, CRC errors: %u, dropped: %u, streaming: %u, host bytes skipped: %u\n",
+           cbench_channel.commands, cbench_channel.crc_errors, cbench_channel.dropped, cbench_streaming,
+           cbench_client.skipped);
+}
+
+// Record a check
+static void CBench_Check(uint8_t ok, const char* what)
+{
+    if (!ok)
+    {
+        printf("Check failed: %s\n", what);
+        cbench_failures++;
+    }
+}
+
+// UART transmit: keep the reply for the host
+static void CBench_Send(const uint8_t* bytes, uint8_t length)
+{
+    memcpy(&cbench_reply[cbench_reply_bytes], bytes, length);
+    cbench_reply_bytes += length;
+}
+
+// Streaming flag of the application
+static void CBench_SetStreaming(uint8_t on)
+{
+    cbench_streaming = on;
+}
+
+// Counters of the application: configuration changes
+static uint8_t CBench_GetCounters(uint8_t* payload, uint8_t size)
+{
+    if (size < 4)
+    {
+        return 0;
+    }
+    memcpy(payload, &cbench_configured, 4);
+    return 4;
+}
+
+// Registers written
+static void CBench_Configured(void)
+{
+    cbench_configured++;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,124 @@
+/**
+*   Source file for the host side of the binary command channel.
+*/
+
+#include "MAX30101_CmdClient.h"
+#include <string.h>
+
+//==============================================
+//          MACROS
+//==============================================
+
+/**
+*   \brief Position in the reply being received.
+*/
+#define CLIENT_STATE_SYNC       0
+#define CLIENT_STATE_COMMAND    1
+#define CLIENT_STATE_STATUS     2
+#define CLIENT_STATE_LENGTH     3
+#define CLIENT_STATE_PAYLOAD    4
+#define CLIENT_STATE_CRC        5
+
+// Reset decoder
+void MAX30101_CmdClient_Init(MAX30101_CmdClient* client)
+{
+    memset(client, 0, sizeof(*client));
+}
+
+// Build a request
+uint8_t MAX30101_CmdClient_Encode(uint8_t command, const uint8_t* payload, uint8_t length, uint8_t* frame)
+{
+    if (length > MAX30101_CMD_MAX_PAYLOAD)
+    {
+        return 0;
+    }
+    frame[0] = MAX30101_CMD_SYNC;
+    frame[1] = command;
+    frame[2] = length;
+    if (length > 0)
+    {
+        memcpy(&frame[3], payload, length);
+    }
+    frame[3 + length] = MAX30101_Cmd_Crc8(0, &frame[1], 2 + length);
+    return 4 + length;
+}
+
+// Build a configuration request, fields in the order of MAX30101_Config
+uint8_t MAX30101_CmdClient_EncodeConfig(const MAX30101_Config* config, uint8_t* frame)
+{
+    uint8_t payload[MAX30101_CMD_CONFIG_SIZE] = {
+        config->int_en_1, config->int_en_2, config->fifo_conf, config->mode_conf, config->spo2_conf,
+        config->led_pa[0], config->led_pa[1], config->led_pa[2], config->led_pa[3], config->pilot_pa,
+        config->multi_led[0], config->multi_led[1], config->prox_thresh
+    };
+    return MAX30101_CmdClient_Encode(MAX30101_CMD_CONFIG, payload, sizeof(payload), frame);
+}
+
+// Decode a reply byte
+uint8_t MAX30101_CmdClient_Feed(MAX30101_CmdClient* client, uint8_t byte)
+{
+    MAX30101_CmdReply* reply = &client->reply;
+    switch (client->state)
+    {
+        case CLIENT_STATE_SYNC:
+            if (byte == MAX30101_CMD_REPLY_SYNC)
+            {
+                client->crc = 0;
+                client->state = CLIENT_STATE_COMMAND;
+            }
+            else
+            {
+                client->skipped++;
+            }
+            return 0;
+        case CLIENT_STATE_COMMAND:
+            reply->command = byte;
+            client->state = CLIENT_STATE_STATUS;
+            break;
+        case CLIENT_STATE_STATUS:
+            reply->status = byte;
+            client->state = CLIENT_STATE_LENGTH;
+            break;
+        case CLIENT_STATE_LENGTH:
+            if (byte > MAX30101_CMD_MAX_PAYLOAD)
+            {
+                client->crc_errors++;
+                client->state = CLIENT_STATE_SYNC;
+                return 0;
+            }
+            reply->length = byte;
+            client->count = 0;
+            client->state = (byte > 0) ? CLIENT_STATE_PAYLOAD : CLIENT_STATE_CRC;
+            break;
+        case CLIENT_STATE_PAYLOAD:
+            reply->payload[client->count] = byte;
+            if (++client->count == reply->length)
+            {
+                client->state = CLIENT_STATE_CRC;
+            }
+            break;
+        default:
+            client->state = CLIENT_STATE_SYNC;
+            if (byte != client->crc)
+            {
+                client->crc_errors++;
+                return 0;
+            }
+            return 1;
+    }
+    client->crc = MAX30101_Cmd_Crc8(client->crc, &byte, 1);
+    return 0;
+}
+
+// Counter of a COUNTERS reply
+uint32_t MAX30101_CmdClient_Counter(const MAX30101_CmdReply* reply, uint8_t index)
+{
+    const uint8_t* p = &reply->payload[4 * index];
+    if (4 * index + 4 > reply->length)
+    {
+        return 0;
+    }
+    return p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+/* [] END OF FILE */
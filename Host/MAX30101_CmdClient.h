@@ -0,0 +1,87 @@
+/**
+*   \file MAX30101_CmdClient.h
+*
+*   \brief Host side of the binary command channel.
+*
+*   Builds request frames for the commands of MAX30101_Command.h and
+*   decodes the replies byte by byte. Bytes outside reply frames (e.g.,
+*   text telemetry) are skipped; a reply sync byte inside text is
+*   detected by the CRC and the search starts again, but replies are
+*   best read with streaming stopped (#MAX30101_CMD_STREAM).
+*/
+
+#ifndef __MAX30101_CMDCLIENT_H__
+    #define __MAX30101_CMDCLIENT_H__
+
+    #include "MAX30101.h"
+    #include "MAX30101_Command.h"
+
+    /**
+    *   \brief A decoded reply.
+    */
+    typedef struct
+    {
+        uint8_t command;                            ///< Command of the request.
+        uint8_t status;                             ///< #MAX30101_OK, #MAX30101_DEV_NOT_FOUND or #MAX30101_ERROR.
+        uint8_t length;                             ///< Payload length.
+        uint8_t payload[MAX30101_CMD_MAX_PAYLOAD];  ///< Payload.
+    } MAX30101_CmdReply;
+
+    /**
+    *   \brief State of a reply decoder.
+    */
+    typedef struct
+    {
+        uint8_t state;              ///< Position in the frame being received.
+        uint8_t count;              ///< Payload bytes received.
+        uint8_t crc;                ///< CRC of the bytes received.
+        uint32_t skipped;           ///< Bytes outside frames.
+        uint32_t crc_errors;        ///< Frames with a wrong CRC or length.
+        MAX30101_CmdReply reply;    ///< Reply being received.
+    } MAX30101_CmdClient;
+
+    /**
+    *   \brief Reset a reply decoder.
+    */
+    void MAX30101_CmdClient_Init(MAX30101_CmdClient* client);
+
+    /**
+    *   \brief Build a request frame.
+    *
+    *   \param[in] command command code.
+    *   \param[in] payload payload, can be NULL if length is 0.
+    *   \param[in] length payload length, up to #MAX30101_CMD_MAX_PAYLOAD.
+    *   \param[out] frame frame of up to #MAX30101_CMD_MAX_FRAME bytes.
+    *   \return frame length, 0 if the payload is too long.
+    */
+    uint8_t MAX30101_CmdClient_Encode(uint8_t command, const uint8_t* payload, uint8_t length, uint8_t* frame);
+
+    /**
+    *   \brief Build a #MAX30101_CMD_CONFIG request.
+    *
+    *   \param[in] config configuration.
+    *   \param[out] frame frame of up to #MAX30101_CMD_MAX_FRAME bytes.
+    *   \return frame length.
+    */
+    uint8_t MAX30101_CmdClient_EncodeConfig(const MAX30101_Config* config, uint8_t* frame);
+
+    /**
+    *   \brief Feed a received byte.
+    *
+    *   \param[in,out] client reply decoder.
+    *   \param[in] byte received byte.
+    *   \return 1 when a reply is complete in client->reply, 0 otherwise.
+    */
+    uint8_t MAX30101_CmdClient_Feed(MAX30101_CmdClient* client, uint8_t byte);
+
+    /**
+    *   \brief Read a little endian counter of a #MAX30101_CMD_COUNTERS reply.
+    *
+    *   \param[in] reply reply.
+    *   \param[in] index counter index (0: commands, 1: CRC errors, 2: dropped, then the application).
+    *   \return the counter, 0 if missing.
+    */
+    uint32_t MAX30101_CmdClient_Counter(const MAX30101_CmdReply* reply, uint8_t index);
+
+#endif
+/* [] END OF FILE */
@@ -0,0 +1,601 @@
+/**
+*   Multi-threaded decoder of MAX30101 trace streams.
+*
+*   Each input (trace file or serial port streaming a trace, see
+*   MAX30101_Trace.h) is a stream. Streams are handed out to a pool of
+*   worker threads. Each worker decodes and unpacks its stream with the
+*   same code used on target: the bursts go through a pipeline
+*   (MAX30101_Pipeline.h) that unpacks them, keeps the statistics of
+*   each slot over the last second (MAX30101_Stats.h), estimates the
+*   heart rate from the last slot (MAX30101_SpectralHR.h) and writes the
+*   samples to a columnar sample file (see MAX30101_SampleFile.h). Each
+*   worker has its own pool of blocks (MAX30101_Pool.h).
+*
+*   Usage:
+*   - max30101_decode [-j threads] [-o dir] [-b baud] input...
+*   - max30101_decode --bench streams [max_threads] [seconds]
+*
+*   The benchmark decodes synthetic SpO2 streams at 400 Hz with 1 up to
+*   max_threads workers and prints throughput and speed-up.
+*/
+
+#include "MAX30101.h"
+#include "MAX30101_Pipeline.h"
+#include "MAX30101_Pool.h"
+#include "MAX30101_Profile.h"
+#include "MAX30101_SpectralHR.h"
+#include "MAX30101_Stats.h"
+#include "MAX30101_Trace.h"
+#include "MAX30101_TraceDecoder.h"
+#include "MAX30101_SampleFile.h"
+#include "MAX30101_HostTime.h"
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <termios.h>
+#include <unistd.h>
+
+/**
+*   \brief Size of the read buffer of each stream.
+*/
+#define DECODE_BUFFER_SIZE 65536
+
+/**
+*   \brief Largest record: header, payload and checksum.
+*/
+#define DECODE_MAX_RECORD (MAX30101_TRACE_HEADER_SIZE + MAX30101_TRACE_MAX_PAYLOAD + 1)
+
+/**
+*   \brief Longest statistics window, in samples (1 s up to 800 Hz).
+*/
+#define DECODE_MAX_WINDOW 800
+
+/**
+*   \brief Sample rate of the heart rate estimator after decimation, in Hz.
+*/
+#define DECODE_HR_RATE 25
+
+/**
+*   \brief Stages of the pipeline: unpack, statistics, heart rate, output.
+*/
+#define DECODE_STAGES 4
+
+/**
+*   \brief A stream and its results.
+*/
+typedef struct
+{
+    const char* path;               ///< Input path, NULL for a stream in memory.
+    const uint8_t* memory;          ///< Trace in memory.
+    uint32_t memory_size;           ///< Size of the trace in memory.
+    char out_path[512];             ///< Output sample file, empty for no output.
+    uint32_t baud;                  ///< Baud rate used if path is a serial port.
+
+    MAX30101_TraceDecoder decoder;  ///< Trace decoder.
+    MAX30101_Pipeline pipe;         ///< Processing of the bursts.
+    MAX30101_PipeStage stages[DECODE_STAGES];   ///< Stages, for the channels of the first burst.
+    MAX30101_PipeUnpack unpack;     ///< State of the unpack stage.
+    MAX30101_Stats stats[MAX30101_MAX_SLOTS];   ///< Statistics of each channel over the last second.
+    MAX30101_STATS_STORAGE(window, MAX30101_MAX_SLOTS * DECODE_MAX_WINDOW);
+    MAX30101_SpectralHR hr;         ///< Heart rate from the last channel.
+    MAX30101_SampleWriter* writer;  ///< Output of the burst being processed.
+    uint64_t burst_time_us;         ///< Time of the first sample of the burst being processed.
+    uint8_t channels;               ///< Channels of the pipeline, 0 before the first burst.
+    uint32_t dropped;               ///< Bursts with a channel count different from the first burst.
+    int error;                      ///< 0 if the stream was decoded.
+} Decode_Stream;
+
+/**
+*   \brief Streams shared by the workers.
+*/
+typedef struct
+{
+    Decode_Stream* streams;     ///< Streams to be decoded.
+    uint32_t count;             ///< Number of streams.
+    uint32_t next;              ///< Next stream to be decoded.
+    pthread_mutex_t lock;       ///< Protects next.
+} Decode_Pool;
+
+static void* Decode_Worker(void* arg);
+
+static void Decode_Run(Decode_Stream* stream);
+
+static uint32_t Decode_Buffer(Decode_Stream* stream, const uint8_t* buffer, uint32_t size,
+                              MAX30101_SampleWriter* writer);
+
+static void Decode_Burst(Decode_Stream* stream, const MAX30101_TraceBurst* burst, MAX30101_SampleWriter* writer);
+
+static int Decode_Build(Decode_Stream* stream, uint8_t channels, uint32_t rate, MAX30101_SampleWriter* writer);
+
+static uint8_t Decode_Stats(void* state, const MAX30101_Block* in, MAX30101_Block* out);
+
+static uint8_t Decode_HR(void* state, const MAX30101_Block* in, MAX30101_Block* out);
+
+static uint8_t Decode_Output(void* state, const MAX30101_Block* in, MAX30101_Block* out);
+
+static int Decode_OpenInput(const char* path, uint32_t baud);
+
+static void Decode_RunPool(Decode_Stream* streams, uint32_t count, uint32_t threads);
+
+static int Decode_Bench(uint32_t streams, uint32_t max_threads, uint32_t seconds);
+
+static uint8_t* Decode_Synthetic(uint32_t seconds, uint32_t bpm, uint32_t* size);
+
+int main(int argc, char** argv)
+{
+    if ((argc > 2) && (strcmp(argv[1], "--bench") == 0))
+    {
+        uint32_t streams = (uint32_t)strtoul(argv[2], NULL, 0);
+        uint32_t max_threads = (argc > 3) ? (uint32_t)strtoul(argv[3], NULL, 0) : (uint32_t)sysconf(_SC_NPROCESSORS_ONLN);
+        uint32_t seconds = (argc > 4) ? (uint32_t)strtoul(argv[4], NULL, 0) : 600;
+        return Decode_Bench(streams, max_threads, seconds);
+    }
+
+    uint32_t threads = (uint32_t)sysconf(_SC_NPROCESSORS_ONLN);
+    const char* out_dir = NULL;
+    uint32_t baud = 115200;
+    int first = 1;
+    while ((first + 1 < argc) && (argv[first][0] == '-'))
+    {
+        if (strcmp(argv[first], "-j") == 0)
+        {
+            threads = (uint32_t)strtoul(argv[first + 1], NULL, 0);
+        }
+        else if (strcmp(argv[first], "-o") == 0)
+        {
+            out_dir = argv[first + 1];
+        }
+        else if (strcmp(argv[first], "-b") == 0)
+        {
+            baud = (uint32_t)strtoul(argv[first + 1], NULL, 0);
+        }
+        first += 2;
+    }
+    if (first >= argc)
+    {
+        fprintf(stderr, "Usage: %s [-j threads] [-o dir] [-b baud] input...\n"
+                        "       %s --bench streams [max_threads] [seconds]\n", argv[0], argv[0]);
+        return 1;
+    }
+
+    uint32_t count = argc - first;
+    Decode_Stream* streams = calloc(count, sizeof(Decode_Stream));
+    if (streams == NULL)
+    {
+        return 1;
+    }
+    for (uint32_t i = 0; i < count; i++)
+    {
+        streams[i].path = argv[first + i];
+        streams[i].baud = baud;
+        if (out_dir != NULL)
+        {
+            const char* name = strrchr(streams[i].path, '/');
+            name = (name != NULL) ? name + 1 : streams[i].path;
+            snprintf(streams[i].out_path, sizeof(streams[i].out_path), "%s/%s.msf", out_dir, name);
+        }
+    }
+
+    uint64_t start = MAX30101_HostTime_Now();
+    Decode_RunPool(streams, count, threads);
+    uint64_t elapsed = MAX30101_HostTime_Now() - start;
+
+    int result = 0;
+    uint64_t total = 0;
+    for (uint32_t i = 0; i < count; i++)
+    {
+        const Decode_Stream* s = &streams[i];
+        const MAX30101_Stats* last = &s->stats[(s->channels > 0) ? s->channels - 1 : 0];
+        printf("%s: %s, %llu samples, %u overflows, %u lost, %u invalid, %u dropped, HR %.1f BPM, "
+               "last slot DC %u AC %u\n", s->path, (s->error == 0) ? "ok" : "error",
+               (unsigned long long)s->decoder.samples, s->decoder.overflows, s->decoder.lost_samples,
+               s->decoder.invalid, s->dropped, s->hr.valid ? s->hr.bpm_x10 / 10.0 : 0.0,
+               (s->channels > 0) ? MAX30101_Stats_Mean(last) : 0,
+               (s->channels > 0) ? MAX30101_Stats_Max(last) - MAX30101_Stats_Min(last) : 0);
+        total += s->decoder.samples;
+        result |= s->error;
+    }
+    printf("%llu samples in %.1f ms with %u threads\n", (unsigned long long)total, elapsed / 1e6, threads);
+    free(streams);
+    return (result == 0) ? 0 : 1;
+}
+
+// Decode streams until there are none left
+static void* Decode_Worker(void* arg)
+{
+    Decode_Pool* pool = arg;
+    MAX30101_Pool_Init();
+    for (;;)
+    {
+        pthread_mutex_lock(&pool->lock);
+        uint32_t index = pool->next++;
+        pthread_mutex_unlock(&pool->lock);
+        if (index >= pool->count)
+        {
+            return NULL;
+        }
+        Decode_Run(&pool->streams[index]);
+    }
+}
+
+// Decode a whole stream
+static void Decode_Run(Decode_Stream* stream)
+{
+    MAX30101_TraceDecoder_Init(&stream->decoder);
+    stream->channels = 0;
+    stream->hr.valid = 0;
+    stream->dropped = 0;
+    stream->error = 0;
+
+    MAX30101_SampleWriter writer = {NULL, 0, 0};
+
+    if (stream->path == NULL)
+    {
+        Decode_Buffer(stream, stream->memory, stream->memory_size, &writer);
+    }
+    else
+    {
+        int fd = Decode_OpenInput(stream->path, stream->baud);
+        if (fd < 0)
+        {
+            stream->error = 1;
+            return;
+        }
+
+        // Keep the bytes of an incomplete record for the next read
+        static __thread uint8_t buffer[DECODE_BUFFER_SIZE];
+        uint32_t size = 0;
+        ssize_t length;
+        while ((length = read(fd, &buffer[size], sizeof(buffer) - size)) > 0)
+        {
+            size += length;
+            uint32_t used = Decode_Buffer(stream, buffer, size, &writer);
+            memmove(buffer, &buffer[used], size - used);
+            size -= used;
+        }
+        close(fd);
+    }
+
+    if ((writer.file != NULL) && (MAX30101_SampleFile_Finish(&writer) != MAX30101_SAMPLEFILE_OK))
+    {
+        stream->error = 1;
+    }
+}
+
+// Decode all the complete records in a buffer, return number of bytes used
+static uint32_t Decode_Buffer(Decode_Stream* stream, const uint8_t* buffer, uint32_t size,
+                              MAX30101_SampleWriter* writer)
+{
+    MAX30101_TraceRecord record;
+    MAX30101_TraceBurst burst;
+    uint32_t offset = 0;
+    uint32_t last = 0;
+    while (MAX30101_Trace_Next(buffer, size, &offset, &record))
+    {
+        last = offset;
+        if (MAX30101_TraceDecoder_Feed(&stream->decoder, &record, &burst))
+        {
+            Decode_Burst(stream, &burst, writer);
+        }
+    }
+
+    // A record not complete yet starts in the last DECODE_MAX_RECORD - 1 bytes
+    if ((stream->path != NULL) && (size - last >= DECODE_MAX_RECORD))
+    {
+        last = size - (DECODE_MAX_RECORD - 1);
+    }
+    return (stream->path != NULL) ? last : size;
+}
+
+// Process a burst through the pipeline
+static void Decode_Burst(Decode_Stream* stream, const MAX30101_TraceBurst* burst, MAX30101_SampleWriter* writer)
+{
+    uint32_t rate = MAX30101_TraceDecoder_SampleRate(&stream->decoder);
+    if ((stream->channels == 0) && (Decode_Build(stream, burst->active_slots, rate, writer) != 0))
+    {
+        stream->error = 1;
+        return;
+    }
+    if ((burst->num_samples == 0) || (burst->active_slots != stream->channels))
+    {
+        stream->dropped += (burst->num_samples > 0);
+        return;
+    }
+
+    // The stages run before the next burst: the burst is the only block in the pipeline
+    MAX30101_Block* block = MAX30101_Pool_Alloc();
+    if (block == NULL)
+    {
+        stream->error = 1;
+        return;
+    }
+    block->length = burst->num_samples * burst->active_slots * 3;
+    block->num_samples = burst->num_samples;
+    memcpy(block->data, burst->raw, block->length);
+    stream->unpack.shift = burst->shift;
+
+    // The burst is read right after its last sample
+    uint64_t span_us = (rate > 0) ? (uint64_t)(burst->num_samples - 1) * 1000000u / rate : 0;
+    stream->burst_time_us = (burst->time_us > span_us) ? burst->time_us - span_us : 0;
+    stream->writer = writer;
+    if (MAX30101_Pipeline_Push(&stream->pipe, block) != MAX30101_OK)
+    {
+        stream->error = 1;
+        return;
+    }
+    MAX30101_Pipeline_Run(&stream->pipe, 0);
+}
+
+// Build the pipeline and open the output for the first burst
+static int Decode_Build(Decode_Stream* stream, uint8_t channels, uint32_t rate, MAX30101_SampleWriter* writer)
+{
+    uint8_t raw = MAX30101_PIPE_FORMAT(MAX30101_PIPE_RAW, channels);
+    uint8_t samples = MAX30101_PIPE_FORMAT(MAX30101_PIPE_SAMPLES, channels);
+    const MAX30101_PipeStage stages[DECODE_STAGES] = {
+        {"unpack", MAX30101_Pipe_Unpack, &stream->unpack, raw, samples, 0},
+        {"stats", Decode_Stats, stream, samples, samples, 1},
+        {"hr", Decode_HR, stream, samples, samples, 1},
+        {"output", Decode_Output, stream, samples, MAX30101_PIPE_NONE, 0},
+    };
+    memcpy(stream->stages, stages, sizeof(stages));
+    stream->unpack.channels = channels;
+    MAX30101_Pipeline_Init(&stream->pipe, NULL);
+    for (uint8_t s = 0; s < DECODE_STAGES; s++)
+    {
+        if (MAX30101_Pipeline_Add(&stream->pipe, &stream->stages[s]) != MAX30101_OK)
+        {
+            return 1;
+        }
+    }
+
+    // Statistics over a second, heart rate at about 25 Hz after decimation
+    uint32_t window = (rate == 0) ? 1 : (rate > DECODE_MAX_WINDOW) ? DECODE_MAX_WINDOW : rate;
+    for (uint8_t c = 0; c < channels; c++)
+    {
+        MAX30101_Stats_Init(&stream->stats[c], (uint16_t)window, &stream->window_samples[c * window],
+                            &stream->window_queues[2 * c * window]);
+    }
+    uint32_t decimation = (rate + DECODE_HR_RATE / 2) / DECODE_HR_RATE;
+    if ((decimation == 0) || (decimation > 255) ||
+        (MAX30101_SpectralHR_Init(&stream->hr, (uint16_t)rate, (uint8_t)decimation) != MAX30101_OK))
+    {
+        // No estimate for this rate
+        stream->hr.decimation = 0;
+    }
+    stream->channels = channels;
+
+    if ((stream->out_path[0] != '\0') &&
+        (MAX30101_SampleFile_Create(writer, stream->out_path, channels, (rate > 0) ? rate : 1,
+                                    MAX30101_TRACE_MAX_SAMPLES) != MAX30101_SAMPLEFILE_OK))
+    {
+        stream->out_path[0] = '\0';
+        return 1;
+    }
+    return 0;
+}
+
+// Sliding window statistics of each channel
+static uint8_t Decode_Stats(void* state, const MAX30101_Block* in, MAX30101_Block* out)
+{
+    (void)out;
+    Decode_Stream* stream = (Decode_Stream*)state;
+    const uint32_t* frame = in->samples;
+    for (uint8_t i = 0; i < in->num_samples; i++, frame += stream->channels)
+    {
+        for (uint8_t c = 0; c < stream->channels; c++)
+        {
+            MAX30101_Stats_Add(&stream->stats[c], frame[c]);
+        }
+    }
+    return MAX30101_OK;
+}
+
+// Heart rate from the last channel (IR in SpO2 mode)
+static uint8_t Decode_HR(void* state, const MAX30101_Block* in, MAX30101_Block* out)
+{
+    (void)out;
+    Decode_Stream* stream = (Decode_Stream*)state;
+    if (stream->hr.decimation == 0)
+    {
+        return MAX30101_OK;
+    }
+    for (uint8_t i = 0; i < in->num_samples; i++)
+    {
+        MAX30101_SpectralHR_Add(&stream->hr, in->samples[i * stream->channels + stream->channels - 1]);
+    }
+    return MAX30101_OK;
+}
+
+// Write the samples to the output file, one array per channel
+static uint8_t Decode_Output(void* state, const MAX30101_Block* in, MAX30101_Block* out)
+{
+    (void)out;
+    Decode_Stream* stream = (Decode_Stream*)state;
+    if (stream->writer->file == NULL)
+    {
+        return MAX30101_OK;
+    }
+    uint32_t values[MAX30101_MAX_SLOTS][MAX30101_TRACE_MAX_SAMPLES];
+    const uint32_t* channel[MAX30101_MAX_SLOTS] = {values[0], values[1], values[2], values[3]};
+    for (uint8_t i = 0; i < in->num_samples; i++)
+    {
+        for (uint8_t c = 0; c < stream->channels; c++)
+        {
+            values[c][i] = in->samples[i * stream->channels + c];
+        }
+    }
+    if (MAX30101_SampleFile_Write(stream->writer, stream->burst_time_us, channel, in->num_samples) !=
+        MAX30101_SAMPLEFILE_OK)
+    {
+        stream->error = 1;
+    }
+    return MAX30101_OK;
+}
+
+// Open file or serial port
+static int Decode_OpenInput(const char* path, uint32_t baud)
+{
+    int fd = open(path, O_RDONLY | O_NOCTTY);
+    if ((fd < 0) || !isatty(fd))
+    {
+        return fd;
+    }
+
+    // Raw mode, read returns 0 after 2 s without data
+    struct termios tty;
+    if (tcgetattr(fd, &tty) == 0)
+    {
+        speed_t speed = B115200;
+        switch (baud)
+        {
+            case 9600:   speed = B9600;   break;
+            case 57600:  speed = B57600;  break;
+            case 230400: speed = B230400; break;
+            case 460800: speed = B460800; break;
+            case 921600: speed = B921600; break;
+            default: break;
+        }
+        cfmakeraw(&tty);
+        cfsetispeed(&tty, speed);
+        cfsetospeed(&tty, speed);
+        tty.c_cc[VMIN] = 0;
+        tty.c_cc[VTIME] = 20;
+        tcsetattr(fd, TCSANOW, &tty);
+    }
+    return fd;
+}
+
+// Decode all the streams with a pool of threads
+static void Decode_RunPool(Decode_Stream* streams, uint32_t count, uint32_t threads)
+{
+    if (threads == 0)
+    {
+        threads = 1;
+    }
+    if (threads > count)
+    {
+        threads = count;
+    }
+
+    Decode_Pool pool = {streams, count, 0, PTHREAD_MUTEX_INITIALIZER};
+    pthread_t* workers = calloc(threads, sizeof(pthread_t));
+    uint32_t started = 0;
+    while ((workers != NULL) && (started < threads) &&
+           (pthread_create(&workers[started], NULL, Decode_Worker, &pool) == 0))
+    {
+        started++;
+    }
+    if (started == 0)
+    {
+        // No threads available, decode in the caller
+        Decode_Worker(&pool);
+    }
+    for (uint32_t i = 0; i < started; i++)
+    {
+        pthread_join(workers[i], NULL);
+    }
+    free(workers);
+}
+
+// Scaling benchmark on synthetic streams
+static int Decode_Bench(uint32_t count, uint32_t max_threads, uint32_t seconds)
+{
+    if ((count == 0) || (max_threads == 0) || (seconds == 0))
+    {
+        return 1;
+    }
+    Decode_Stream* streams = calloc(count, sizeof(Decode_Stream));
+    uint8_t** traces = calloc(count, sizeof(uint8_t*));
+    if ((streams == NULL) || (traces == NULL))
+    {
+        return 1;
+    }
+    for (uint32_t i = 0; i < count; i++)
+    {
+        traces[i] = Decode_Synthetic(seconds, 60 + 10 * (i % 8), &streams[i].memory_size);
+        streams[i].memory = traces[i];
+        if (traces[i] == NULL)
+        {
+            return 1;
+        }
+    }
+    printf("%u streams, %u s at 400 Hz SpO2, %ld CPUs online\n", count, seconds, sysconf(_SC_NPROCESSORS_ONLN));
+
+    double single = 0;
+    for (uint32_t threads = 1; threads <= max_threads; threads *= 2)
+    {
+        uint64_t start = MAX30101_HostTime_Now();
+        Decode_RunPool(streams, count, threads);
+        uint64_t elapsed = MAX30101_HostTime_Now() - start;
+
+        uint64_t samples = 0;
+        for (uint32_t i = 0; i < count; i++)
+        {
+            samples += streams[i].decoder.samples;
+        }
+        double rate = samples * 1e3 / elapsed;
+        single = (threads == 1) ? rate : single;
+        printf("threads %2u: %8.1f ms, %7.2f Msamples/s, speed-up %.2f\n",
+               threads, elapsed / 1e6, rate, rate / single);
+    }
+
+    printf("Stream 0: HR %.1f BPM (synthetic 60 BPM)\n", streams[0].hr.valid ? streams[0].hr.bpm_x10 / 10.0 : 0.0);
+    for (uint32_t i = 0; i < count; i++)
+    {
+        free(traces[i]);
+    }
+    free(traces);
+    free(streams);
+    return 0;
+}
+
+// Build a SpO2 trace at 400 Hz with a pulse at the given rate
+static uint8_t* Decode_Synthetic(uint32_t seconds, uint32_t bpm, uint32_t* size)
+{
+    const uint32_t samples_per_burst = 32;
+    uint32_t bursts = seconds * 400 / samples_per_burst;
+    uint32_t record_size = MAX30101_TRACE_HEADER_SIZE + MAX30101_TRACE_FIFO_INFO + samples_per_burst * 2 * 3 + 1;
+    uint8_t* trace = malloc((uint64_t)bursts * record_size + 64);
+    if (trace == NULL)
+    {
+        return NULL;
+    }
+
+    // Time stamps in ns, as recorded on the host
+    uint8_t start[4] = {MAX30101_TRACE_VERSION, MAX30101_PROFILE_UNIT_NS, (uint8_t)1000, (uint8_t)(1000 >> 8)};
+    uint32_t pos = MAX30101_Trace_Encode(trace, MAX30101_TRACE_START, 0, start, sizeof(start), NULL, 0);
+
+    // SpO2 mode, 400 Hz, no averaging, 411 us pulse width
+    uint8_t config[3] = {MAX30101_FIFO_CONF, 1, 0x00};
+    pos += MAX30101_Trace_Encode(&trace[pos], MAX30101_TRACE_CONFIG, 0, config, 2, &config[2], 1);
+    uint8_t mode[4] = {MAX30101_MODE_CONF, 2, MAX30101_SPO2_MODE, 0x03 | MAX30101_SAMPLE_RATE_400};
+    pos += MAX30101_Trace_Encode(&trace[pos], MAX30101_TRACE_CONFIG, 0, mode, 2, &mode[2], 2);
+
+    uint32_t period = 400 * 60 / bpm;
+    uint32_t n = 0;
+    uint8_t raw[32 * 2 * 3];
+    for (uint32_t b = 0; b < bursts; b++)
+    {
+        for (uint32_t i = 0; i < samples_per_burst; i++, n++)
+        {
+            // Triangular pulse on a constant baseline
+            uint32_t phase = n % period;
+            uint32_t pulse = (phase < period / 2) ? phase : period - phase;
+            uint32_t red = 90000 - pulse * 10;
+            uint32_t ir = 110000 - pulse * 20;
+            uint8_t* p = &raw[i * 6];
+            p[0] = red >> 16; p[1] = red >> 8; p[2] = red;
+            p[3] = ir >> 16;  p[4] = ir >> 8;  p[5] = ir;
+        }
+        uint8_t info[MAX30101_TRACE_FIFO_INFO] = {(uint8_t)(b * 32), 0, (uint8_t)(b * 32), samples_per_burst, 2};
+        uint32_t time = (uint32_t)((uint64_t)n * 1000000000u / 400);
+        pos += MAX30101_Trace_Encode(&trace[pos], MAX30101_TRACE_FIFO, time, info, sizeof(info),
+                                     raw, samples_per_burst * 2 * 3);
+    }
+    *size = pos;
+    return trace;
+}
+
+/* [] END OF FILE */
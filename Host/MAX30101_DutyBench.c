@@ -0,0 +1,211 @@
+/**
+*   Duty-cycled acquisition on the simulated device.
+*
+*   The duty cycle scheduler (MAX30101_DutyCycle.h) runs the simulated
+*   MAX30101 (see MAX30101_Sim.h) with the settings of
+*   MAX30101_FixedConfig.h (200 samples/s) for several burst and period
+*   lengths, in steps of 1 ms; the FIFO is drained at each A_FULL
+*   interrupt, as in the library example, and the settling samples are
+*   dropped with #MAX30101_Duty_Discard.
+*
+*   For each configuration it reports, measured on the simulated device
+*   and predicted by #MAX30101_Duty_Model:
+*   - the duty cycle (time out of shutdown);
+*   - the valid samples per burst, the settling samples discarded and
+*     the samples lost: left in the FIFO when the sensor shuts down
+*     (flushed at the next burst) or overwritten;
+*   - the average supply current, from the awake and shutdown times and
+*     the charge of the LED pulses counted by the simulated device;
+*   - the time from the start of a burst to the first valid sample,
+*     acquired (model) and read at a drain (simulation).
+*
+*   Fails if the measured duty cycle or current is more than 2% off the
+*   model, or if samples are unaccounted for.
+*
+*   Usage: max30101_dutybench [minutes]
+*/
+
+#include "MAX30101.h"
+#include "MAX30101_DutyCycle.h"
+#include "MAX30101_Fixed.h"
+#include "MAX30101_Sim.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+*   \brief Output and ADC sample rates of MAX30101_FixedConfig.h, in Hz.
+*/
+#define DBENCH_RATE 200
+#define DBENCH_ADC_RATE 400
+
+/**
+*   \brief LED amplitude (7.2 mA) and pulse width (us) while acquiring.
+*/
+#define DBENCH_LED_PA 0x24
+#define DBENCH_PULSE_WIDTH_US 69
+
+/**
+*   \brief Samples discarded at the start of each burst.
+*/
+#define DBENCH_SETTLE 20
+
+/**
+*   \brief Results of a configuration.
+*/
+typedef struct
+{
+    uint32_t awake_ms;          ///< Time out of shutdown.
+    uint32_t valid;             ///< Valid samples read.
+    uint32_t discarded;         ///< Settling samples discarded.
+    uint32_t flushed;           ///< Samples left in the FIFO at shutdown.
+    uint32_t overwritten;       ///< Samples overwritten in the FIFO.
+    uint32_t acquired;          ///< Samples acquired, expected from the awake time.
+    uint64_t first_valid_ms;    ///< Sum over the bursts of the time from burst start to the first valid sample read.
+    uint32_t bursts;            ///< Bursts with a valid sample.
+    uint64_t led_charge_nc;     ///< Charge of the LED pulses.
+} DBench_Result;
+
+static MAX30101_Fixed_Data dbench_data;
+
+static void DBench_Run(const MAX30101_DutyConfig* duty_config, uint32_t total_ms, DBench_Result* result);
+
+int main(int argc, char** argv)
+{
+    uint32_t minutes = (argc > 1) ? (uint32_t)strtoul(argv[1], NULL, 0) : 5;
+    if (minutes == 0)
+    {
+        fprintf(stderr, "Usage: %s [minutes (1 or more)]\n", argv[0]);
+        return 1;
+    }
+    const MAX30101_DutyConfig configs[] = {
+        { .period_ms = 60000, .burst_ms = 60000, .settle_samples = 0, .sample_rate_hz = DBENCH_RATE },
+        { .period_ms = 10000, .burst_ms = 2000, .settle_samples = DBENCH_SETTLE, .sample_rate_hz = DBENCH_RATE },
+        { .period_ms = 60000, .burst_ms = 10000, .settle_samples = DBENCH_SETTLE, .sample_rate_hz = DBENCH_RATE },
+        { .period_ms = 60000, .burst_ms = 2000, .settle_samples = DBENCH_SETTLE, .sample_rate_hz = DBENCH_RATE },
+    };
+    // Supply currents of the datasheet, LED current of the configuration while sampling (2 LEDs)
+    const MAX30101_PowerModel power = {
+        .active_ua = 600.0f,
+        .shutdown_ua = 0.7f,
+        .led_ua = DBENCH_ADC_RATE * 2 * DBENCH_PULSE_WIDTH_US * (DBENCH_LED_PA / 5.0f) / 1000.0f,
+        .wake_ms = 0.0f,
+    };
+    uint32_t total_ms = minutes * 60000u;
+
+    printf("%u min at %u samples/s, %u settling samples, LED %.1f uA while sampling\n", minutes, DBENCH_RATE,
+           DBENCH_SETTLE, power.led_ua);
+    printf("%-12s %13s %9s %9s %8s %8s %17s %17s\n", "Burst/period", "Duty sim/model", "Valid/b", "Discard/b",
+           "Flushed", "Overwr.", "Current sim/model", "First valid acq/read");
+    int failed = 0;
+    for (uint8_t c = 0; c < sizeof(configs) / sizeof(configs[0]); c++)
+    {
+        const MAX30101_DutyConfig* config = &configs[c];
+        DBench_Result result;
+        MAX30101_DutyReport report;
+        DBench_Run(config, total_ms, &result);
+        MAX30101_Duty_Model(config, &power, &report);
+
+        uint32_t bursts = (total_ms + config->period_ms - 1) / config->period_ms;
+        double duty = (double)result.awake_ms / total_ms;
+        double current_ua = (result.awake_ms * (double)power.active_ua +
+                             (total_ms - result.awake_ms) * (double)power.shutdown_ua) / total_ms +
+                            (double)result.led_charge_nc / total_ms;
+        printf("%5.0f/%-5.0fs %6.2f/%5.2f%% %9.1f %9.1f %8u %8u %8.1f/%6.1f uA %7.0f/%6.0f ms\n",
+               config->burst_ms / 1e3, config->period_ms / 1e3, 100.0 * duty, 100.0 * report.duty_cycle,
+               (double)result.valid / bursts, (double)result.discarded / bursts, result.flushed, result.overwritten,
+               current_ua, report.average_ua, report.first_valid_ms,
+               result.bursts ? (double)result.first_valid_ms / result.bursts : 0.0);
+
+        if ((duty > report.duty_cycle * 1.02) || (duty < report.duty_cycle * 0.98) ||
+            (current_ua > report.average_ua * 1.02) || (current_ua < report.average_ua * 0.98))
+        {
+            fprintf(stderr, "Simulation and model differ\n");
+            failed = 1;
+        }
+        // Every sample acquired is read, discarded, flushed or overwritten
+        uint32_t accounted = result.valid + result.discarded + result.flushed + result.overwritten;
+        if ((accounted > result.acquired + bursts) || (accounted + bursts < result.acquired))
+        {
+            fprintf(stderr, "%u samples acquired, %u accounted for\n", result.acquired, accounted);
+            failed = 1;
+        }
+    }
+    printf("%s\n", failed ? "FAILED" : "ok");
+    return failed;
+}
+
+// Run the scheduler for a configuration, in steps of 1 ms
+static void DBench_Run(const MAX30101_DutyConfig* duty_config, uint32_t total_ms, DBench_Result* result)
+{
+    MAX30101_Config config = {
+        .int_en_1 = MAX30101_CONF_INT_A_FULL,
+        .fifo_conf = MAX30101_FIXED_FIFO_CONF | MAX30101_CONF_FIFO_ROLLOVER | MAX30101_CONF_FIFO_A_FULL(32),
+        .mode_conf = MAX30101_FIXED_MODE_CONF,
+        .spo2_conf = MAX30101_FIXED_SPO2_CONF,
+        .led_pa = {DBENCH_LED_PA, DBENCH_LED_PA, 0x00, 0x00},
+        .multi_led = {MAX30101_FIXED_MULTI_LED_1, MAX30101_FIXED_MULTI_LED_2},
+    };
+    MAX30101_Duty duty;
+    memset(result, 0, sizeof(*result));
+    memset(&dbench_data, 0, sizeof(dbench_data));
+    MAX30101_Sim_PowerOn();
+    MAX30101_Boot(&config, NULL);
+    MAX30101_Sim_ResetStats();
+    MAX30101_Duty_Start(&duty, duty_config, 0);
+
+    uint8_t first_valid = 0;
+    for (uint32_t t = 0; t < total_ms; t++)
+    {
+        uint8_t was_acquiring = MAX30101_Duty_IsAcquiring(&duty);
+        uint32_t bursts = duty.bursts;
+        MAX30101_Duty_Update(&duty, t);
+        if (was_acquiring && !MAX30101_Duty_IsAcquiring(&duty))
+        {
+            // Not read before the shutdown, flushed at the next burst
+            result->flushed += MAX30101_Sim_GetFIFOCount();
+        }
+        if (duty.bursts != bursts)
+        {
+            first_valid = 1;
+        }
+        if (MAX30101_Duty_IsAcquiring(&duty))
+        {
+            result->awake_ms++;
+        }
+        MAX30101_Sim_Run(1000);
+        if (!MAX30101_Sim_IsInterrupt())
+        {
+            continue;
+        }
+
+        // Drain, as in the library example
+        uint8_t status, wp, ovf, rp;
+        MAX30101_ReadRegister(MAX30101_INT_ST_1, &status);
+        MAX30101_ReadFIFOPointers(&wp, &ovf, &rp);
+        uint8_t num_samples = ((wp - rp) & 0x1F) ? (wp - rp) & 0x1F : 32;
+        MAX30101_Fixed_ReadFIFO(num_samples, &dbench_data);
+        uint8_t skip = MAX30101_Duty_Discard(&duty, num_samples);
+        if ((skip < num_samples) && first_valid)
+        {
+            result->first_valid_ms += t + 1 - duty.burst_start_ms;
+            result->bursts++;
+            first_valid = 0;
+        }
+    }
+    // Left in the FIFO at the end of the run, if not counted at the last shutdown
+    if (MAX30101_Duty_IsAcquiring(&duty))
+    {
+        result->flushed += MAX30101_Sim_GetFIFOCount();
+    }
+    result->valid = duty.valid;
+    result->discarded = duty.discarded;
+    result->overwritten = MAX30101_Sim_GetLostSamples();
+    result->acquired = (uint32_t)((uint64_t)result->awake_ms * DBENCH_RATE / 1000);
+
+    MAX30101_SimLED led;
+    MAX30101_Sim_GetLED(&led);
+    result->led_charge_nc = led.charge_nc;
+}
+
+/* [] END OF FILE */
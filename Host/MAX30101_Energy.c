@@ -0,0 +1,168 @@
+/**
+*   Model of the PSoC energy per sample with each idle mode.
+*
+*   For each output sample rate of the MAX30101, in the mode of
+*   MAX30101_FixedConfig.h with the almost full interrupt at a given
+*   number of samples, the CPU is active for:
+*   - the wake-up from the idle mode (hardware wake-up and restore);
+*   - the drain of the library example (status, pointers and FIFO
+*     burst), with the bus time measured on the simulated MAX30101 at
+*     400 kHz: the I2C functions wait for the transfer;
+*   - the unpack of each sample;
+*   and idle in the chosen mode for the rest of the burst period.
+*
+*   Energy per sample = VDD * (I_active * t_active + I_idle * t_idle) / samples.
+*
+*   Currents and wake-up times are typical values at 24 MHz and 3.3 V,
+*   to be replaced with the values measured on the board. The model also
+*   checks that the first sample is read within #MAX30101_Sleep_Budget
+*   and that a sample is read faster than it is acquired, i.e., that the
+*   wake-up never causes a FIFO overflow.
+*
+*   Usage: max30101_energy [a_full (17-32)]
+*/
+
+#include "MAX30101.h"
+#include "MAX30101_Fixed.h"
+#include "MAX30101_Rate.h"
+#include "MAX30101_Sleep.h"
+#include "MAX30101_Sim.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+/**
+*   \brief I2C clock, in Hz.
+*/
+#define ENERGY_I2C_CLOCK_HZ 400000
+
+/**
+*   \brief Supply voltage, in V.
+*/
+#define ENERGY_VDD 3.3
+
+/**
+*   \brief Unpack time per sample, in us (about 70 cycles at 24 MHz).
+*/
+#define ENERGY_UNPACK_US 3.0
+
+/**
+*   \brief Current with the CPU running, in mA.
+*/
+#define ENERGY_ACTIVE_MA 6.0
+
+/**
+*   \brief Settings of an idle mode.
+*/
+typedef struct
+{
+    const char* name;   ///< Name of the mode.
+    double idle_ma;     ///< Current while idle, in mA.
+    double wake_us;     ///< Hardware wake-up and restore, in us, at the active current.
+} Energy_Mode;
+
+static const Energy_Mode energy_modes[] = {
+    {"none", ENERGY_ACTIVE_MA, 0.0},
+    {"WFI", 3.5, 0.5},
+    {"alt-active", 1.5, 10.0},
+    {"sleep", 0.002, 15.0 + 100.0},
+};
+
+static MAX30101_Fixed_Data energy_data;
+
+static uint32_t Energy_BusTime(uint8_t num_samples, uint32_t* first_us);
+
+int main(int argc, char** argv)
+{
+    uint8_t a_full = (argc > 1) ? (uint8_t)strtoul(argv[1], NULL, 0) : 32;
+    if ((a_full < 17) || (a_full > 32))
+    {
+        fprintf(stderr, "Usage: %s [a_full (17-32)]\n", argv[0]);
+        return 1;
+    }
+
+    MAX30101_Config config = {
+        .int_en_1 = MAX30101_CONF_INT_A_FULL,
+        .fifo_conf = MAX30101_FIXED_FIFO_CONF | MAX30101_CONF_FIFO_ROLLOVER | MAX30101_CONF_FIFO_A_FULL(a_full),
+        .mode_conf = MAX30101_FIXED_MODE_CONF,
+        .spo2_conf = MAX30101_FIXED_SPO2_CONF,
+        .led_pa = {0x1F, 0x1F, 0x1F, 0x1F},
+        .multi_led = {MAX30101_FIXED_MULTI_LED_1, MAX30101_FIXED_MULTI_LED_2},
+    };
+    MAX30101_Sim_PowerOn();
+    if (MAX30101_Boot(&config, NULL) != MAX30101_OK)
+    {
+        fprintf(stderr, "Boot failed\n");
+        return 1;
+    }
+
+    uint32_t first_us;
+    uint32_t drain_us = Energy_BusTime(a_full, &first_us);
+    double sample_read_us = MAX30101_FIXED_LEDS * MAX30101_FIXED_BYTES_PER_CHANNEL * 9 * 1e6 / ENERGY_I2C_CLOCK_HZ;
+    uint8_t num_modes = sizeof(energy_modes) / sizeof(energy_modes[0]);
+
+    printf("%u channels, A_FULL at %u samples, drain %u us on the bus (first sample after %u us)\n",
+           MAX30101_FIXED_LEDS, a_full, drain_us, first_us);
+    printf("Energy per sample in uJ (average current in uA), '!' if samples can be lost\n");
+    printf("%6s %9s", "Rate", "Budget");
+    for (uint8_t m = 0; m < num_modes; m++)
+    {
+        printf(" %20s", energy_modes[m].name);
+    }
+    printf("\n");
+
+    int lost = 0;
+    for (uint8_t r = 0; r <= (MAX30101_SAMPLE_RATE_3200 >> MAX30101_SAMPLE_RATE_SHIFT); r++)
+    {
+        uint16_t rate = MAX30101_Rate_SampleRate(r);
+        double period_us = 1e6 / rate;
+        double burst_us = a_full * period_us;
+        uint32_t budget_us = MAX30101_Sleep_Budget(rate, a_full);
+        printf("%6u %6u us", rate, budget_us);
+        for (uint8_t m = 0; m < num_modes; m++)
+        {
+            const Energy_Mode* mode = &energy_modes[m];
+            double active_us = mode->wake_us + drain_us + a_full * ENERGY_UNPACK_US;
+            double idle_us = (burst_us > active_us) ? burst_us - active_us : 0;
+            // mA * us = nC
+            double charge_nc = ENERGY_ACTIVE_MA * active_us + mode->idle_ma * idle_us;
+            double energy_uj = ENERGY_VDD * charge_nc / a_full / 1000;
+            double current_ua = charge_nc / (active_us + idle_us) * 1000;
+            uint8_t safe = (mode->wake_us + first_us <= budget_us) && (sample_read_us < period_us) &&
+                           (active_us <= burst_us);
+            if (!safe)
+            {
+                lost = 1;
+            }
+            printf(" %8.3f (%8.0f)%c", energy_uj, current_ua, safe ? ' ' : '!');
+        }
+        printf("\n");
+    }
+    if (lost)
+    {
+        printf("! lower the A_FULL threshold or the sample rate\n");
+    }
+    return 0;
+}
+
+// Bus time of a drain of the library example
+static uint32_t Energy_BusTime(uint8_t num_samples, uint32_t* first_us)
+{
+    MAX30101_SimStats stats;
+    MAX30101_FlushFIFO();
+    MAX30101_Sim_Generate(num_samples);
+    MAX30101_Sim_ResetStats();
+
+    uint8_t flag, wp, ovf, rp;
+    MAX30101_IsFIFOAFull(&flag);
+    MAX30101_ReadFIFOPointers(&wp, &ovf, &rp);
+    MAX30101_Fixed_ReadFIFO(num_samples, &energy_data);
+    MAX30101_Sim_GetStats(&stats);
+    uint32_t total_us = MAX30101_Sim_BusTime(&stats, ENERGY_I2C_CLOCK_HZ);
+
+    // The first sample is complete after the register address and its bytes
+    uint32_t sample_us = MAX30101_FIXED_LEDS * MAX30101_FIXED_BYTES_PER_CHANNEL * 9 * 1000000u / ENERGY_I2C_CLOCK_HZ;
+    *first_us = total_us - (num_samples - 1) * sample_us;
+    return total_us;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,209 @@
+/**
+*   Benchmark of the FIFO unpack specialised for a fixed acquisition mode.
+*
+*   For HR (RED, 69 us), SpO2 (RED and IR, 411 us) and Multi-LED (RED, IR
+*   and GREEN, 215 us) modes, unpacks full FIFO bursts with:
+*   - the loop of #MAX30101_ReadFIFO, which tests the number of channels
+*     for each sample and takes the shift at run time;
+*   - #MAX30101_DemuxSlots, used by #MAX30101_ReadMultiLEDFIFO;
+*   - the reader generated by #MAX30101_FIXED_DEFINE for the mode.
+*   The I2C transfer is the same in all cases and is not included.
+*
+*   Usage: max30101_fixedbench [bursts]
+*/
+
+#include "MAX30101_Fixed.h"
+#include "MAX30101_HostTime.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+*   \brief Number of different bursts unpacked in turn.
+*/
+#define BENCH_BURSTS 64
+
+// Specialised readers, one per mode
+MAX30101_FIXED_DECLARE(Bench_HR, 1);
+MAX30101_FIXED_DECLARE(Bench_SpO2, 2);
+MAX30101_FIXED_DECLARE(Bench_Multi, 3);
+MAX30101_FIXED_DEFINE(Bench_HR, 1, 3 - MAX30101_PULSEWIDTH_69)
+MAX30101_FIXED_DEFINE(Bench_SpO2, 2, 3 - MAX30101_PULSEWIDTH_411)
+MAX30101_FIXED_DEFINE(Bench_Multi, 3, 3 - MAX30101_PULSEWIDTH_215)
+
+/**
+*   \brief Settings of a benchmarked mode.
+*/
+typedef struct
+{
+    const char* name;       ///< Name of the mode.
+    uint8_t leds;           ///< Number of channels.
+    uint8_t pulse_width;    ///< Pulse width setting.
+} Bench_Mode;
+
+static const Bench_Mode bench_modes[] = {
+    {"HR", 1, MAX30101_PULSEWIDTH_69},
+    {"SpO2", 2, MAX30101_PULSEWIDTH_411},
+    {"Multi-LED", 3, MAX30101_PULSEWIDTH_215},
+};
+
+// Settings read through a volatile, so that the generic paths are not specialised by the compiler
+static volatile uint8_t bench_runtime_leds;
+static volatile uint8_t bench_runtime_shift;
+
+static uint8_t bench_raw[BENCH_BURSTS][MAX30101_FIXED_FIFO_DEPTH*MAX30101_MAX_SLOTS*MAX30101_FIXED_BYTES_PER_CHANNEL];
+
+static void Bench_GenericUnpack(const uint8_t* raw, uint8_t num_samples, uint8_t active_leds,
+                                uint8_t shift, MAX30101_Data* data);
+
+static void Bench_Specialised(uint8_t leds, uint32_t bursts, uint32_t* last);
+
+int main(int argc, char** argv)
+{
+    uint32_t bursts = (argc > 1) ? (uint32_t)strtoul(argv[1], NULL, 0) : 2000000;
+
+    // Random 18-bit samples, with garbage in the unused bits
+    srand(1);
+    for (uint32_t i = 0; i < sizeof(bench_raw); i++)
+    {
+        ((uint8_t*)bench_raw)[i] = (uint8_t)rand();
+    }
+
+    printf("%-10s %12s %12s %12s %9s\n", "Mode", "ReadFIFO", "DemuxSlots", "Fixed", "Speed-up");
+    for (uint8_t m = 0; m < sizeof(bench_modes) / sizeof(bench_modes[0]); m++)
+    {
+        const Bench_Mode* mode = &bench_modes[m];
+        bench_runtime_leds = mode->leds;
+        bench_runtime_shift = 3 - mode->pulse_width;
+        uint8_t slots[MAX30101_MAX_SLOTS] = {MAX30101_SLOT_RED, MAX30101_SLOT_IR, MAX30101_SLOT_GREEN, MAX30101_SLOT_NONE};
+        uint32_t generic_last[3], demux_last[3], fixed_last[3];
+
+        // Loop of MAX30101_ReadFIFO
+        static MAX30101_Data generic;
+        uint64_t start = MAX30101_HostTime_Now();
+        for (uint32_t b = 0; b < bursts; b++)
+        {
+            Bench_GenericUnpack(bench_raw[b % BENCH_BURSTS], MAX30101_FIXED_FIFO_DEPTH,
+                                bench_runtime_leds, bench_runtime_shift, &generic);
+        }
+        uint64_t generic_ns = MAX30101_HostTime_Now() - start;
+        generic_last[0] = generic.red[generic.head];
+        generic_last[1] = generic.IR[generic.head];
+        generic_last[2] = generic.green[generic.head];
+
+        // Multi-LED demultiplexer
+        static MAX30101_MultiData demux;
+        start = MAX30101_HostTime_Now();
+        for (uint32_t b = 0; b < bursts; b++)
+        {
+            MAX30101_DemuxSlots(bench_raw[b % BENCH_BURSTS], MAX30101_FIXED_FIFO_DEPTH, slots,
+                                bench_runtime_leds, bench_runtime_shift, &demux);
+        }
+        uint64_t demux_ns = MAX30101_HostTime_Now() - start;
+        for (uint8_t ch = 0; ch < mode->leds; ch++)
+        {
+            demux_last[ch] = demux.slot[ch][demux.head];
+        }
+
+        // Specialised reader
+        start = MAX30101_HostTime_Now();
+        Bench_Specialised(mode->leds, bursts, fixed_last);
+        uint64_t fixed_ns = MAX30101_HostTime_Now() - start;
+
+        for (uint8_t ch = 0; ch < mode->leds; ch++)
+        {
+            if ((generic_last[ch] != fixed_last[ch]) || (demux_last[ch] != fixed_last[ch]))
+            {
+                fprintf(stderr, "%s: channel %u differs\n", mode->name, ch);
+                return 1;
+            }
+        }
+
+        double samples = (double)bursts * MAX30101_FIXED_FIFO_DEPTH;
+        printf("%-10s %9.2f ns %9.2f ns %9.2f ns %8.2fx\n", mode->name, generic_ns / samples,
+               demux_ns / samples, fixed_ns / samples, (double)generic_ns / fixed_ns);
+    }
+    printf("Time per sample (all channels), %u bursts of %u samples\n", bursts, MAX30101_FIXED_FIFO_DEPTH);
+    return 0;
+}
+
+// Unpack with the specialised reader of a mode, store last sample of each channel
+static void Bench_Specialised(uint8_t leds, uint32_t bursts, uint32_t* last)
+{
+    static Bench_HR_Data hr;
+    static Bench_SpO2_Data spo2;
+    static Bench_Multi_Data multi;
+
+    switch (leds)
+    {
+        case 1:
+            for (uint32_t b = 0; b < bursts; b++)
+            {
+                Bench_HR_Unpack(bench_raw[b % BENCH_BURSTS], MAX30101_FIXED_FIFO_DEPTH, &hr);
+            }
+            last[0] = hr.channel[0][hr.head];
+            break;
+        case 2:
+            for (uint32_t b = 0; b < bursts; b++)
+            {
+                Bench_SpO2_Unpack(bench_raw[b % BENCH_BURSTS], MAX30101_FIXED_FIFO_DEPTH, &spo2);
+            }
+            last[0] = spo2.channel[0][spo2.head];
+            last[1] = spo2.channel[1][spo2.head];
+            break;
+        default:
+            for (uint32_t b = 0; b < bursts; b++)
+            {
+                Bench_Multi_Unpack(bench_raw[b % BENCH_BURSTS], MAX30101_FIXED_FIFO_DEPTH, &multi);
+            }
+            last[0] = multi.channel[0][multi.head];
+            last[1] = multi.channel[1][multi.head];
+            last[2] = multi.channel[2][multi.head];
+            break;
+    }
+}
+
+// Unpack loop of MAX30101_ReadFIFO, on bytes already read
+static void Bench_GenericUnpack(const uint8_t* raw, uint8_t num_samples, uint8_t active_leds,
+                                uint8_t shift, MAX30101_Data* data)
+{
+    uint16_t bytes_left_ro_read = num_samples * 3 * active_leds;
+    while (bytes_left_ro_read > 0)
+    {
+        bytes_left_ro_read -= active_leds * 3;
+
+        data->head++; //Advance the head of the storage struct
+        data->head %= BUFFER_STORAGE_SIZE; //Wrap condition
+
+        uint8_t temp[sizeof(uint32_t)];
+        uint32_t tempLong;
+
+        temp[3] = 0;
+        temp[2] = *raw++;
+        temp[1] = *raw++;
+        temp[0] = *raw++;
+        memcpy(&tempLong, temp, sizeof(tempLong));
+        data->red[data->head] = (tempLong & 0x3FFFF) >> shift;
+
+        if (active_leds > 1)
+        {
+            temp[3] = 0;
+            temp[2] = *raw++;
+            temp[1] = *raw++;
+            temp[0] = *raw++;
+            memcpy(&tempLong, temp, sizeof(tempLong));
+            data->IR[data->head] = (tempLong & 0x3FFFF) >> shift;
+        }
+        if (active_leds > 2)
+        {
+            temp[3] = 0;
+            temp[2] = *raw++;
+            temp[1] = *raw++;
+            temp[0] = *raw++;
+            memcpy(&tempLong, temp, sizeof(tempLong));
+            data->green[data->head] = (tempLong & 0x3FFFF) >> shift;
+        }
+    }
+}
+
+/* [] END OF FILE */
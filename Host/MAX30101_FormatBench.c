@@ -0,0 +1,195 @@
+/**
+*   Text output with sprintf and with MAX30101_Format.h.
+*
+*   Formats CSV rows of samples (time stamp in ms, then red, IR and
+*   green, 18-bit values with noise as read from the FIFO) and the text
+*   lines of the test project (register dump, heart rate) once with
+*   sprintf and once with the line buffer of MAX30101_Format.h. Reports
+*   the time per row, the rows and bytes per second on this host, and
+*   checks that both outputs are the same, byte for byte.
+*
+*   On target, the cycles spent formatting the telemetry are reported by
+*   the MAX30101_STAGE_FORMAT stage of the profiler ('p' command of the
+*   library test project, with TELEMETRY_CSV).
+*
+*   Usage: max30101_formatbench [rows]
+*/
+
+#include "MAX30101_Format.h"
+#include "MAX30101_Profile.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+*   \brief Channels of a row: red, IR, green.
+*/
+#define FBENCH_CHANNELS 3
+
+/**
+*   \brief Time between two rows, in ms (200 samples/s).
+*/
+#define FBENCH_PERIOD_MS 5
+
+/**
+*   \brief Rows formatted between two reads of the clock.
+*/
+#define FBENCH_BATCH 1024
+
+static uint32_t fbench_seed = 12345;
+static uint32_t fbench_failures;
+
+static uint32_t FBench_Random(void);
+
+static uint32_t FBench_Sprintf(char* out, uint32_t timestamp, const uint32_t* channels);
+
+static void FBench_Check(uint8_t ok, const char* what, const char* expected, const char* got);
+
+static void FBench_CheckLines(void);
+
+int main(int argc, char** argv)
+{
+    uint32_t rows = (argc > 1) ? (uint32_t)strtoul(argv[1], NULL, 0) : 1000000;
+    if (rows < FBENCH_BATCH)
+    {
+        rows = FBENCH_BATCH;
+    }
+    rows -= rows % FBENCH_BATCH;
+    uint32_t* values = malloc(sizeof(uint32_t) * FBENCH_BATCH * FBENCH_CHANNELS);
+    if (values == NULL)
+    {
+        return 1;
+    }
+    // Values around a DC level, as a finger on the sensor, and some small ones
+    for (uint32_t i = 0; i < FBENCH_BATCH * FBENCH_CHANNELS; i++)
+    {
+        values[i] = (i % 16 == 0) ? FBench_Random() % 1000 : 100000 + FBench_Random() % 150000;
+    }
+    MAX30101_Profile_Start();
+
+    // Same output from both
+    MAX30101_Line line;
+    char text[MAX30101_LINE_SIZE];
+    for (uint32_t i = 0; i < FBENCH_BATCH; i++)
+    {
+        uint32_t timestamp = (i < FBENCH_BATCH - 1) ? i * FBENCH_PERIOD_MS : 0xFFFFFFFFu;
+        FBench_Sprintf(text, timestamp, &values[i * FBENCH_CHANNELS]);
+        MAX30101_Format_CsvRow(&line, timestamp, &values[i * FBENCH_CHANNELS], FBENCH_CHANNELS);
+        FBench_Check(strcmp(text, line.text) == 0, "CSV row", text, line.text);
+    }
+    FBench_CheckLines();
+
+    // Time both, a batch of rows per clock read
+    volatile uint32_t sink = 0;
+    uint64_t sprintf_ns = 0;
+    uint64_t format_ns = 0;
+    uint64_t bytes = 0;
+    for (uint32_t r = 0; r < rows; r += FBENCH_BATCH)
+    {
+        uint32_t start = MAX30101_Profile_Now();
+        for (uint32_t i = 0; i < FBENCH_BATCH; i++)
+        {
+            sink += FBench_Sprintf(text, (r + i) * FBENCH_PERIOD_MS, &values[i * FBENCH_CHANNELS]);
+        }
+        uint32_t middle = MAX30101_Profile_Now();
+        for (uint32_t i = 0; i < FBENCH_BATCH; i++)
+        {
+            bytes += MAX30101_Format_CsvRow(&line, (r + i) * FBENCH_PERIOD_MS, &values[i * FBENCH_CHANNELS],
+                                            FBENCH_CHANNELS);
+            sink += line.text[0];
+        }
+        uint32_t end = MAX30101_Profile_Now();
+        sprintf_ns += middle - start;
+        format_ns += end - middle;
+    }
+
+    printf("%u CSV rows of %u channels, %.1f bytes per row\n", rows, FBENCH_CHANNELS, (double)bytes / rows);
+    printf("%-10s %10s %12s %12s\n", "Method", "ns/row", "Rows/s", "MB/s");
+    printf("%-10s %10.1f %12.0f %12.1f\n", "sprintf", (double)sprintf_ns / rows, rows * 1e9 / sprintf_ns,
+           bytes * 1e3 / sprintf_ns);
+    printf("%-10s %10.1f %12.0f %12.1f\n", "format", (double)format_ns / rows, rows * 1e9 / format_ns,
+           bytes * 1e3 / format_ns);
+    printf("Speed-up: %.1fx\n", (double)sprintf_ns / format_ns);
+    free(values);
+    if (fbench_failures > 0)
+    {
+        printf("%u checks FAILED\n", fbench_failures);
+        return 1;
+    }
+    printf("Output identical\n");
+    return 0;
+}
+
+// Row as it would be written with sprintf
+static uint32_t FBench_Sprintf(char* out, uint32_t timestamp, const uint32_t* channels)
+{
+    return (uint32_t)sprintf(out, "%lu,%lu,%lu,%lu\r\n", (unsigned long)timestamp, (unsigned long)channels[0],
+                             (unsigned long)channels[1], (unsigned long)channels[2]);
+}
+
+// Text lines of the test project, limits and truncation
+static void FBench_CheckLines(void)
+{
+    MAX30101_Line line;
+    char text[2 * MAX30101_LINE_SIZE];
+    const uint32_t edges[] = { 0, 9, 10, 99, 100, 101, 999, 1000, 65535, 262143, 999999999, 1000000000, 0xFFFFFFFFu };
+    for (uint8_t i = 0; i < sizeof(edges) / sizeof(edges[0]); i++)
+    {
+        MAX30101_Format_Clear(&line);
+        MAX30101_Format_Dec(&line, edges[i]);
+        MAX30101_Format_Char(&line, ' ');
+        MAX30101_Format_Hex(&line, edges[i], 8);
+        MAX30101_Format_Char(&line, ' ');
+        MAX30101_Format_Fixed(&line, edges[i], 1);
+        MAX30101_Format_Char(&line, ' ');
+        MAX30101_Format_Fixed(&line, edges[i], 3);
+        sprintf(text, "%lu %08lX %lu.%lu %lu.%03lu\r\n", (unsigned long)edges[i], (unsigned long)edges[i],
+                (unsigned long)(edges[i] / 10), (unsigned long)(edges[i] % 10), (unsigned long)(edges[i] / 1000),
+                (unsigned long)(edges[i] % 1000));
+        FBench_Check(strcmp(text, MAX30101_Format_End(&line)) == 0, "numbers", text, line.text);
+    }
+
+    // Register dump line of MAX30101_PrintRegister
+    MAX30101_Format_Clear(&line);
+    MAX30101_Format_String(&line, "[0x");
+    MAX30101_Format_Hex(&line, 0x0A, 2);
+    MAX30101_Format_String(&line, "] - 0x");
+    MAX30101_Format_Hex(&line, 0x27, 2);
+    sprintf(text, "[0x%02X] - 0x%02X\r\n", 0x0A, 0x27);
+    FBench_Check(strcmp(text, MAX30101_Format_End(&line)) == 0, "register", text, line.text);
+
+    // Too long: truncated, still terminated, within the buffer
+    MAX30101_Format_Clear(&line);
+    for (uint8_t i = 0; i < MAX30101_LINE_SIZE; i++)
+    {
+        MAX30101_Format_Dec(&line, 1000000000u + i);
+    }
+    MAX30101_Format_End(&line);
+    FBench_Check(line.truncated && (line.length == MAX30101_LINE_SIZE - 1) &&
+                 (strlen(line.text) == MAX30101_LINE_SIZE - 1) && (line.text[line.length - 1] == '\n'),
+                 "truncated", "", line.text);
+}
+
+// Record a check
+static void FBench_Check(uint8_t ok, const char* what, const char* expected, const char* got)
+{
+    if (!ok)
+    {
+        if (fbench_failures < 10)
+        {
+            printf("Check failed: %s: expected \"%s\", got \"%s\"\n", what, expected, got);
+        }
+        fbench_failures++;
+    }
+}
+
+// Pseudo-random numbers (xorshift)
+static uint32_t FBench_Random(void)
+{
+    fbench_seed ^= fbench_seed << 13;
+    fbench_seed ^= fbench_seed >> 17;
+    fbench_seed ^= fbench_seed << 5;
+    return fbench_seed;
+}
+
+/* [] END OF FILE */
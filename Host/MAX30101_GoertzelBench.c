@@ -0,0 +1,310 @@
+/**
+*   Comparison of the Goertzel filter bank with a brute-force DFT.
+*
+*   Runs the filter bank (MAX30101_Goertzel.h) on synthetic PPG at 200 Hz,
+*   decimated by 8 (same signal as max30101_hrbench), with a steady rate
+*   and with rate ramps, in three configurations:
+*   - brute-force DFT: the decimated, high-passed samples of each block
+*     are computed in double precision the same way as the filter bank,
+*     Hann windowed, and the DFT is evaluated every 0.1 bpm over the whole
+*     band; the peak is the reference estimate;
+*   - Goertzel coarse: every block scans the band every 8 bpm;
+*   - Goertzel coarse-to-fine: fine bins around the last estimate.
+*   Each estimate is compared with the true rate at the center of the
+*   block. For each configuration it reports the mean and maximum error,
+*   the mean distance from the brute-force estimate, the bins evaluated
+*   per decimated sample, the host time per decimated sample and the
+*   estimated Cortex-M3 cycles per decimated sample.
+*
+*   The filter bank passes if its mean error is below 3 bpm and 90% of
+*   its estimates are within 5 bpm.
+*
+*   Usage: max30101_goertzelbench
+*/
+
+#include "MAX30101.h"
+#include "MAX30101_Goertzel.h"
+#include "MAX30101_HostTime.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+/**
+*   \brief Input sample rate of the synthetic PPG, in Hz.
+*/
+#define GBENCH_RATE 200
+
+/**
+*   \brief Decimation of the input.
+*/
+#define GBENCH_DECIMATION 8
+
+/**
+*   \brief Spacing of the brute-force DFT, in bpm.
+*/
+#define GBENCH_DFT_STEP 0.1
+
+/**
+*   \brief Estimated Cortex-M3 cycles per bin and per decimated sample (see MAX30101_Goertzel.h).
+*/
+#define GBENCH_CYCLES_PER_BIN 15
+#define GBENCH_CYCLES_PER_SAMPLE 25
+
+/**
+*   \brief Pass thresholds: mean error and share of estimates within 5 bpm.
+*/
+#define GBENCH_MAX_MEAN_ERROR 3.0
+#define GBENCH_MIN_WITHIN_5 0.9
+
+#ifndef M_PI
+    #define M_PI 3.14159265358979323846
+#endif
+
+/**
+*   \brief A synthetic scenario.
+*/
+typedef struct
+{
+    const char* name;       ///< Name of the scenario.
+    double seconds;         ///< Duration.
+    uint8_t ramps;          ///< 1 for rate ramps, 0 for a steady rate.
+} GBench_Scenario;
+
+/**
+*   \brief Errors of a configuration.
+*/
+typedef struct
+{
+    uint32_t estimates;     ///< Estimates compared.
+    uint32_t within;        ///< Estimates within 5 bpm.
+    double sum_error;       ///< Sum of the errors.
+    double max_error;       ///< Largest error.
+    double sum_dft;         ///< Sum of the distances from the brute-force estimate.
+} GBench_Errors;
+
+static const GBench_Scenario gbench_scenarios[] = {
+    {"steady 72 bpm", 120.0, 0},
+    {"ramps 60-150-90 bpm", 240.0, 1},
+};
+
+static MAX30101_Goertzel gbench_coarse;
+
+static MAX30101_Goertzel gbench_track;
+
+static double GBench_TrueRate(const GBench_Scenario* scenario, double t);
+
+static int GBench_Scenario_Run(const GBench_Scenario* scenario);
+
+static double GBench_Dft(const double* block);
+
+static void GBench_Record(GBench_Errors* errors, double estimate, double expected, double dft);
+
+static int GBench_Print(const char* name, const GBench_Errors* errors, double bins, double ns, uint8_t check);
+
+int main(void)
+{
+    printf("Filter bank: %u bytes, blocks of %u samples at %.2f Hz (%.2f s)\n", (unsigned)sizeof(MAX30101_Goertzel),
+           MAX30101_GOERTZEL_BLOCK, (double)GBENCH_RATE / GBENCH_DECIMATION,
+           (double)MAX30101_GOERTZEL_BLOCK * GBENCH_DECIMATION / GBENCH_RATE);
+    int failed = 0;
+    for (uint8_t s = 0; s < sizeof(gbench_scenarios) / sizeof(gbench_scenarios[0]); s++)
+    {
+        failed |= GBench_Scenario_Run(&gbench_scenarios[s]);
+    }
+    return failed;
+}
+
+// True rate of a scenario at time t, in bpm
+static double GBench_TrueRate(const GBench_Scenario* scenario, double t)
+{
+    if (!scenario->ramps)
+    {
+        return 72.0;
+    }
+    // 60 bpm for 20 s, up to 150 bpm in 80 s, 20 s, down to 90 bpm in 80 s
+    if (t < 20.0)
+    {
+        return 60.0;
+    }
+    if (t < 100.0)
+    {
+        return 60.0 + 90.0 * (t - 20.0) / 80.0;
+    }
+    if (t < 120.0)
+    {
+        return 150.0;
+    }
+    if (t < 200.0)
+    {
+        return 150.0 - 60.0 * (t - 120.0) / 80.0;
+    }
+    return 90.0;
+}
+
+// Run a scenario in the three configurations, return 1 if the filter bank fails
+static int GBench_Scenario_Run(const GBench_Scenario* scenario)
+{
+    if ((MAX30101_Goertzel_Init(&gbench_coarse, GBENCH_RATE, GBENCH_DECIMATION, MAX30101_GOERTZEL_COARSE) != MAX30101_OK) ||
+        (MAX30101_Goertzel_Init(&gbench_track, GBENCH_RATE, GBENCH_DECIMATION, MAX30101_GOERTZEL_TRACK) != MAX30101_OK))
+    {
+        fprintf(stderr, "Init failed\n");
+        return 1;
+    }
+
+    double block_s = (double)MAX30101_GOERTZEL_BLOCK * GBENCH_DECIMATION / GBENCH_RATE;
+    uint32_t num_samples = (uint32_t)(scenario->seconds * GBENCH_RATE);
+    double phase = 0.0;
+    srand(1);
+
+    // Decimation and high-pass of the brute-force DFT, as in the filter bank
+    double block[MAX30101_GOERTZEL_BLOCK];
+    uint32_t dft_sum = 0, dft_n = 0;
+    int32_t dft_dc = 0;
+    uint8_t dft_started = 0;
+    uint64_t dft_ns = 0;
+
+    GBench_Errors dft_errors = {0}, coarse_errors = {0}, track_errors = {0};
+    uint64_t coarse_ns = 0, track_ns = 0;
+    uint64_t coarse_bins = 0, track_bins = 0;
+    uint32_t decimated = 0;
+
+    for (uint32_t i = 0; i < num_samples; i++)
+    {
+        double t = (double)i / GBENCH_RATE;
+        phase += 2.0 * M_PI * GBench_TrueRate(scenario, t) / 60.0 / GBENCH_RATE;
+
+        // Pulse of 600 counts with harmonics on a 120000 baseline, respiration, noise
+        double value = 120000.0 + 600.0 * (sin(phase) + 0.4 * sin(2 * phase + 0.5) + 0.15 * sin(3 * phase + 1.0));
+        value += 2000.0 * sin(2.0 * M_PI * 0.25 * t);
+        value += (rand() % 401) - 200;
+        uint32_t sample = (uint32_t)value & 0x3FFFF;
+        dft_sum += sample;
+
+        // Bins of the decimated sample, if this sample completes one
+        uint8_t coarse_active = gbench_coarse.num_bins;
+        uint8_t track_active = gbench_track.num_bins;
+
+        uint64_t start = MAX30101_HostTime_Now();
+        uint8_t coarse_updated = MAX30101_Goertzel_Add(&gbench_coarse, sample);
+        uint64_t middle = MAX30101_HostTime_Now();
+        uint8_t track_updated = MAX30101_Goertzel_Add(&gbench_track, sample);
+        uint64_t end = MAX30101_HostTime_Now();
+        if (gbench_coarse.count != 0)
+        {
+            continue;
+        }
+        coarse_ns += middle - start;
+        track_ns += end - middle;
+        coarse_bins += coarse_active;
+        track_bins += track_active;
+        decimated++;
+
+        start = MAX30101_HostTime_Now();
+        int32_t x = dft_sum / GBENCH_DECIMATION;
+        dft_sum = 0;
+        if (!dft_started)
+        {
+            dft_dc = x << 8;
+            dft_started = 1;
+        }
+        dft_dc += ((x << 8) - dft_dc) >> 4;
+        double w = 0.5 - 0.5 * cos(2.0 * M_PI * dft_n / MAX30101_GOERTZEL_BLOCK);
+        block[dft_n++] = (x - (dft_dc >> 8)) * w;
+        double dft = 0.0;
+        if (dft_n == MAX30101_GOERTZEL_BLOCK)
+        {
+            dft_n = 0;
+            dft = GBench_Dft(block);
+        }
+        dft_ns += MAX30101_HostTime_Now() - start;
+
+        if (!coarse_updated)
+        {
+            continue;
+        }
+        // Compare with the rate at the center of the block
+        double expected = GBench_TrueRate(scenario, t - block_s / 2.0);
+        GBench_Record(&dft_errors, dft, expected, dft);
+        GBench_Record(&coarse_errors, gbench_coarse.bpm_x10 / 10.0, expected, dft);
+        if (track_updated)
+        {
+            GBench_Record(&track_errors, gbench_track.bpm_x10 / 10.0, expected, dft);
+        }
+    }
+
+    printf("\n%s\n", scenario->name);
+    printf("%-24s %9s %10s %9s %9s %9s %8s %10s %10s %s\n", "Configuration", "Estimates", "Mean err.",
+           "Max err.", "Within 5", "vs DFT", "Bins", "ns/sample", "M3 cycles", "Result");
+    double bins_dft = (MAX30101_GOERTZEL_MAX_BPM - MAX30101_GOERTZEL_MIN_BPM) / GBENCH_DFT_STEP + 1;
+    GBench_Print("brute-force DFT", &dft_errors, bins_dft, decimated ? (double)dft_ns / decimated : 0.0, 0);
+    int failed = GBench_Print("Goertzel coarse", &coarse_errors, decimated ? (double)coarse_bins / decimated : 0.0,
+                              decimated ? (double)coarse_ns / decimated : 0.0, 1);
+    failed |= GBench_Print("Goertzel coarse-to-fine", &track_errors, decimated ? (double)track_bins / decimated : 0.0,
+                           decimated ? (double)track_ns / decimated : 0.0, 1);
+    return failed;
+}
+
+// Peak of the DFT of a windowed block over the band, in bpm
+static double GBench_Dft(const double* block)
+{
+    double rate_hz = (double)GBENCH_RATE / GBENCH_DECIMATION;
+    double best_bpm = 0.0, best_power = -1.0;
+    for (double bpm = MAX30101_GOERTZEL_MIN_BPM; bpm <= MAX30101_GOERTZEL_MAX_BPM + 1e-9; bpm += GBENCH_DFT_STEP)
+    {
+        double re = 0.0, im = 0.0;
+        double omega = 2.0 * M_PI * bpm / 60.0 / rate_hz;
+        for (uint32_t m = 0; m < MAX30101_GOERTZEL_BLOCK; m++)
+        {
+            re += block[m] * cos(omega * m);
+            im -= block[m] * sin(omega * m);
+        }
+        double power = re * re + im * im;
+        if (power > best_power)
+        {
+            best_power = power;
+            best_bpm = bpm;
+        }
+    }
+    return best_bpm;
+}
+
+// Record an estimate
+static void GBench_Record(GBench_Errors* errors, double estimate, double expected, double dft)
+{
+    double error = fabs(estimate - expected);
+    errors->estimates++;
+    errors->sum_error += error;
+    errors->sum_dft += fabs(estimate - dft);
+    if (error > errors->max_error)
+    {
+        errors->max_error = error;
+    }
+    if (error <= 5.0)
+    {
+        errors->within++;
+    }
+}
+
+// Print the results of a configuration, return 1 if checked and failed
+static int GBench_Print(const char* name, const GBench_Errors* errors, double bins, double ns, uint8_t check)
+{
+    double mean_error = errors->estimates ? errors->sum_error / errors->estimates : 0.0;
+    double share = errors->estimates ? (double)errors->within / errors->estimates : 0.0;
+    int failed = check && ((errors->estimates == 0) || (mean_error > GBENCH_MAX_MEAN_ERROR) ||
+                           (share < GBENCH_MIN_WITHIN_5));
+    char cycles[16];
+    if (check)
+    {
+        snprintf(cycles, sizeof(cycles), "%.0f", GBENCH_CYCLES_PER_SAMPLE + GBENCH_CYCLES_PER_BIN * bins);
+    }
+    else
+    {
+        snprintf(cycles, sizeof(cycles), "-");
+    }
+    printf("%-24s %9u %6.2f bpm %5.1f bpm %8.0f%% %5.2f bpm %8.1f %10.1f %10s %s\n", name, errors->estimates,
+           mean_error, errors->max_error, 100.0 * share, errors->estimates ? errors->sum_dft / errors->estimates : 0.0,
+           bins, ns, cycles, check ? (failed ? "FAILED" : "ok") : "reference");
+    return failed;
+}
+
+/* [] END OF FILE */
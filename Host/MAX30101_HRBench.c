@@ -0,0 +1,303 @@
+/**
+*   Validation and benchmark of the spectral heart rate estimator.
+*
+*   Without arguments, runs the estimator (MAX30101_SpectralHR.h) on
+*   synthetic PPG at 200 Hz, decimated by 8: a pulse with harmonics on a
+*   baseline with respiration wander and noise, in three scenarios:
+*   - steady rate;
+*   - rate ramps (60 to 150 to 90 bpm);
+*   - steady rate with a motion artefact stronger than the pulse, at a
+*     rate 45 bpm higher, for 40 s.
+*   Each estimate is compared with the true rate at the center of the
+*   window. A scenario passes if the mean error is below 3 bpm and 90% of
+*   the estimates are within 5 bpm. At the end of each scenario the
+*   accumulators of the sliding DFT are recomputed from the window and
+*   must be equal: the integer sliding DFT does not drift.
+*
+*   It also reports the host time per decimated sample and per estimate
+*   and the size of the estimator.
+*
+*   With a sample file (e.g., written by max30101_decode), prints the
+*   estimates of a channel of the recording. With the heart rate of the
+*   recording, each estimate is also compared with it and the recording
+*   passes with the thresholds of the synthetic scenarios.
+*
+*   Usage: max30101_hrbench [sample_file [channel [expected_bpm]]]
+*/
+
+#include "MAX30101.h"
+#include "MAX30101_SpectralHR.h"
+#include "MAX30101_SampleFile.h"
+#include "MAX30101_HostTime.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+/**
+*   \brief Input sample rate of the synthetic PPG, in Hz.
+*/
+#define HRBENCH_RATE 200
+
+/**
+*   \brief Decimation of the input.
+*/
+#define HRBENCH_DECIMATION 8
+
+/**
+*   \brief Pass thresholds: mean error and share of estimates within 5 bpm.
+*/
+#define HRBENCH_MAX_MEAN_ERROR 3.0
+#define HRBENCH_MIN_WITHIN_5 0.9
+
+#ifndef M_PI
+    #define M_PI 3.14159265358979323846
+#endif
+
+/**
+*   \brief A synthetic scenario.
+*/
+typedef struct
+{
+    const char* name;       ///< Name of the scenario.
+    double seconds;         ///< Duration.
+    uint8_t ramps;          ///< 1 for rate ramps, 0 for a steady rate.
+    uint8_t motion;         ///< 1 to add a motion artefact.
+} HRBench_Scenario;
+
+static const HRBench_Scenario hrbench_scenarios[] = {
+    {"steady 72 bpm", 120.0, 0, 0},
+    {"ramps 60-150-90 bpm", 240.0, 1, 0},
+    {"motion artefact", 120.0, 0, 1},
+};
+
+static MAX30101_SpectralHR hrbench_hr;
+
+static double HRBench_TrueRate(const HRBench_Scenario* scenario, double t);
+
+static int HRBench_Synthetic(const HRBench_Scenario* scenario);
+
+static int HRBench_CheckExact(const MAX30101_SpectralHR* hr);
+
+static int HRBench_File(const char* path, uint8_t channel, double expected);
+
+int main(int argc, char** argv)
+{
+    if (argc > 1)
+    {
+        return HRBench_File(argv[1], (argc > 2) ? (uint8_t)strtoul(argv[2], NULL, 0) : 1,
+                            (argc > 3) ? strtod(argv[3], NULL) : 0.0);
+    }
+
+    MAX30101_SpectralHR_Init(&hrbench_hr, HRBENCH_RATE, HRBENCH_DECIMATION);
+    printf("Estimator: %u bytes, window %u samples at %.2f Hz, %u bins of %.2f bpm (and 2 guard bins)\n",
+           (unsigned)sizeof(MAX30101_SpectralHR), MAX30101_SPECTRAL_N, (double)HRBENCH_RATE / HRBENCH_DECIMATION,
+           hrbench_hr.num_bins - 2, 60.0 * HRBENCH_RATE / HRBENCH_DECIMATION / MAX30101_SPECTRAL_N);
+    printf("%-22s %9s %10s %9s %9s %11s %11s %s\n", "Scenario", "Estimates", "Mean err.", "Max err.",
+           "Within 5", "ns/sample", "ns/estimate", "Result");
+    int failed = 0;
+    for (uint8_t s = 0; s < sizeof(hrbench_scenarios) / sizeof(hrbench_scenarios[0]); s++)
+    {
+        failed |= HRBench_Synthetic(&hrbench_scenarios[s]);
+    }
+    return failed;
+}
+
+// True rate of a scenario at time t, in bpm
+static double HRBench_TrueRate(const HRBench_Scenario* scenario, double t)
+{
+    if (!scenario->ramps)
+    {
+        return 72.0;
+    }
+    // 60 bpm for 20 s, up to 150 bpm in 80 s, 20 s, down to 90 bpm in 80 s
+    if (t < 20.0)
+    {
+        return 60.0;
+    }
+    if (t < 100.0)
+    {
+        return 60.0 + 90.0 * (t - 20.0) / 80.0;
+    }
+    if (t < 120.0)
+    {
+        return 150.0;
+    }
+    if (t < 200.0)
+    {
+        return 150.0 - 60.0 * (t - 120.0) / 80.0;
+    }
+    return 90.0;
+}
+
+// Run a synthetic scenario, return 1 if it fails
+static int HRBench_Synthetic(const HRBench_Scenario* scenario)
+{
+    MAX30101_SpectralHR* hr = &hrbench_hr;
+    if (MAX30101_SpectralHR_Init(hr, HRBENCH_RATE, HRBENCH_DECIMATION) != MAX30101_OK)
+    {
+        fprintf(stderr, "Init failed\n");
+        return 1;
+    }
+
+    double window_s = (double)MAX30101_SPECTRAL_N * HRBENCH_DECIMATION / HRBENCH_RATE;
+    uint32_t num_samples = (uint32_t)(scenario->seconds * HRBENCH_RATE);
+    double phase = 0.0, motion_phase = 0.0;
+    uint32_t estimates = 0, within = 0;
+    double sum_error = 0.0, max_error = 0.0;
+    uint64_t sample_ns = 0, estimate_ns = 0;
+    uint32_t plain = 0;
+    srand(1);
+
+    for (uint32_t i = 0; i < num_samples; i++)
+    {
+        double t = (double)i / HRBENCH_RATE;
+        double rate = HRBench_TrueRate(scenario, t);
+        phase += 2.0 * M_PI * rate / 60.0 / HRBENCH_RATE;
+        motion_phase += 2.0 * M_PI * (rate + 45.0) / 60.0 / HRBENCH_RATE;
+
+        // Pulse of 600 counts with harmonics on a 120000 baseline
+        double value = 120000.0 + 600.0 * (sin(phase) + 0.4 * sin(2 * phase + 0.5) + 0.15 * sin(3 * phase + 1.0));
+        // Respiration, 15 breaths/min
+        value += 2000.0 * sin(2.0 * M_PI * 0.25 * t);
+        value += (rand() % 401) - 200;
+        if (scenario->motion && (t >= 40.0) && (t < 80.0))
+        {
+            value += 900.0 * sin(motion_phase);
+        }
+
+        uint64_t start = MAX30101_HostTime_Now();
+        uint8_t updated = MAX30101_SpectralHR_Add(hr, (uint32_t)value & 0x3FFFF);
+        uint64_t elapsed = MAX30101_HostTime_Now() - start;
+        if (!updated)
+        {
+            if (hr->count == 0)
+            {
+                // A decimated sample went through the sliding DFT
+                sample_ns += elapsed;
+                plain++;
+            }
+            continue;
+        }
+        estimate_ns += elapsed;
+
+        // Compare with the rate at the center of the window
+        double expected = HRBench_TrueRate(scenario, t - window_s / 2.0);
+        double error = fabs(hr->bpm_x10 / 10.0 - expected);
+        estimates++;
+        sum_error += error;
+        if (error > max_error)
+        {
+            max_error = error;
+        }
+        if (error <= 5.0)
+        {
+            within++;
+        }
+    }
+
+    int failed = HRBench_CheckExact(hr);
+    double mean_error = estimates ? sum_error / estimates : 0.0;
+    double share = estimates ? (double)within / estimates : 0.0;
+    if ((estimates == 0) || (mean_error > HRBENCH_MAX_MEAN_ERROR) || (share < HRBENCH_MIN_WITHIN_5))
+    {
+        failed = 1;
+    }
+    printf("%-22s %9u %6.2f bpm %5.1f bpm %8.0f%% %11.1f %11.1f %s\n", scenario->name, estimates, mean_error,
+           max_error, 100.0 * share, plain ? (double)sample_ns / plain : 0.0,
+           estimates ? (double)estimate_ns / estimates : 0.0, failed ? "FAILED" : "ok");
+    return failed;
+}
+
+// Recompute the accumulators from the window, return 1 if they differ
+static int HRBench_CheckExact(const MAX30101_SpectralHR* hr)
+{
+    for (uint8_t b = 0; b < hr->num_bins; b++)
+    {
+        uint32_t k = hr->first_bin + b;
+        int32_t re = 0, im = 0;
+        for (uint32_t m = 0; m < MAX30101_SPECTRAL_N; m++)
+        {
+            uint32_t index = (k * m) % MAX30101_SPECTRAL_N;
+            int32_t c = (int32_t)lround(16384.0 * cos(2.0 * M_PI * index / MAX30101_SPECTRAL_N));
+            int32_t s = (int32_t)lround(16384.0 * sin(2.0 * M_PI * index / MAX30101_SPECTRAL_N));
+            re += (hr->window[m] * c) >> 14;
+            im -= (hr->window[m] * s) >> 14;
+        }
+        if ((re != hr->re[b]) || (im != hr->im[b]))
+        {
+            fprintf(stderr, "Bin %u: accumulators drifted (%d, %d), expected (%d, %d)\n", k, hr->re[b],
+                    hr->im[b], re, im);
+            return 1;
+        }
+    }
+    return 0;
+}
+
+// Estimates of a channel of a sample file, compared with the expected rate if not 0
+static int HRBench_File(const char* path, uint8_t channel, double expected)
+{
+    MAX30101_SampleFile file;
+    if (MAX30101_SampleFile_Open(&file, path) != MAX30101_SAMPLEFILE_OK)
+    {
+        fprintf(stderr, "Cannot open %s\n", path);
+        return 1;
+    }
+    if (channel >= file.channels)
+    {
+        fprintf(stderr, "%s has %u channels\n", path, file.channels);
+        MAX30101_SampleFile_Close(&file);
+        return 1;
+    }
+
+    // About 25 Hz after decimation
+    uint32_t decimation = (file.sample_rate_hz + 12) / 25;
+    if ((decimation == 0) || (decimation > 255) ||
+        (MAX30101_SpectralHR_Init(&hrbench_hr, file.sample_rate_hz, (uint8_t)decimation) != MAX30101_OK))
+    {
+        fprintf(stderr, "Sample rate %u Hz not supported\n", file.sample_rate_hz);
+        MAX30101_SampleFile_Close(&file);
+        return 1;
+    }
+
+    printf("%10s %8s %8s\n", "Time (s)", "bpm", "Quality");
+    uint32_t estimates = 0, within = 0;
+    double sum_error = 0.0, max_error = 0.0;
+    MAX30101_SampleBlock block;
+    int result = MAX30101_SampleFile_First(&file, &block);
+    while (result == MAX30101_SAMPLEFILE_OK)
+    {
+        for (uint32_t i = 0; i < block.num_samples; i++)
+        {
+            if (MAX30101_SpectralHR_Add(&hrbench_hr, block.channel[channel][i]))
+            {
+                double t = (block.time_us + (uint64_t)i * 1000000u / file.sample_rate_hz) / 1e6;
+                printf("%10.2f %8.1f %7u%%\n", t, hrbench_hr.bpm_x10 / 10.0, hrbench_hr.quality);
+                double error = fabs(hrbench_hr.bpm_x10 / 10.0 - expected);
+                estimates++;
+                sum_error += error;
+                if (error > max_error)
+                {
+                    max_error = error;
+                }
+                if (error <= 5.0)
+                {
+                    within++;
+                }
+            }
+        }
+        result = MAX30101_SampleFile_Next(&file, &block);
+    }
+    MAX30101_SampleFile_Close(&file);
+    int failed = (result != MAX30101_SAMPLEFILE_END);
+    if (expected > 0.0)
+    {
+        double mean_error = estimates ? sum_error / estimates : 0.0;
+        double share = estimates ? (double)within / estimates : 0.0;
+        failed |= (estimates == 0) || (mean_error > HRBENCH_MAX_MEAN_ERROR) || (share < HRBENCH_MIN_WITHIN_5);
+        printf("%u estimates against %.1f bpm: mean error %.2f bpm, max %.1f bpm, %.0f%% within 5 bpm: %s\n",
+               estimates, expected, mean_error, max_error, 100.0 * share, failed ? "FAILED" : "ok");
+    }
+    return failed;
+}
+
+/* [] END OF FILE */
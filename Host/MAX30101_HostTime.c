@@ -0,0 +1,16 @@
+/**
+*   Source file for the monotonic clock of the host tools.
+*/
+
+#include "MAX30101_HostTime.h"
+#include <time.h>
+
+// Monotonic time in ns
+uint64_t MAX30101_HostTime_Now(void)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000000u + (uint64_t)now.tv_nsec;
+}
+
+/* [] END OF FILE */
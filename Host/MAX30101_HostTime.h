@@ -0,0 +1,20 @@
+/**
+*   \file MAX30101_HostTime.h
+*
+*   \brief Monotonic clock shared by the host tools and benchmarks.
+*/
+
+#ifndef __MAX30101_HOSTTIME_H__
+    #define __MAX30101_HOSTTIME_H__
+
+    #include "cytypes.h"
+
+    /**
+    *   \brief Current time of the host monotonic clock.
+    *
+    *   \return time in ns from an arbitrary origin.
+    */
+    uint64_t MAX30101_HostTime_Now(void);
+
+#endif
+/* [] END OF FILE */
@@ -0,0 +1,314 @@
+/**
+*   Sample latency and bus usage of the throughput and latency modes.
+*
+*   The simulated MAX30101 (see MAX30101_Sim.h) acquires in the mode of
+*   MAX30101_FixedConfig.h (200 samples/s) in virtual time, in us, and
+*   is read as the library test project does in each acquisition mode:
+*   - throughput: A_FULL interrupt at 32 samples, then status, FIFO
+*     pointers and a burst of 32 samples;
+*   - latency: PPG_RDY interrupt, then one sample with
+*     MAX30101_Fixed_ReadSample (address byte and sample bytes once the
+*     register pointer is parked on FIFO_DATA); status, pointers and a
+*     burst of the samples left behind are read instead every 32 samples
+*     and when the read starts more than a sample period after the
+*     interrupt.
+*
+*   The latency of a sample is the time from its acquisition to the end
+*   of the read that returns it: the dispatch of the interrupt to the
+*   task (a fixed cost) plus the I2C transfers at 400 kHz. CPU time to
+*   unpack is not counted. Each mode runs with an idle CPU, then with a
+*   background job, not synchronised with the sensor, that holds the CPU
+*   for 2 ms about every 10 ms and for 8 ms about every second (e.g., a
+*   report printed on a blocking UART):
+*   - busy: the 8 ms run is not split, the interrupt is served when it ends;
+*   - split: the 8 ms run is split in runs of 2 ms, as scheduler tasks
+*     (MAX30101_Scheduler.h), and the read runs between two of them.
+*
+*   For each case it reports the latency distribution up to the maximum,
+*   the reads and the bus time per second, and the samples lost. Tasks
+*   are not preempted, so a sample waits for the task running when it is
+*   acquired: the latency mode keeps the maximum under a sample period
+*   (5 ms) only if every task is shorter than about 4.5 ms. Fails if the
+*   latency mode misses that bound when idle or with the split job.
+*
+*   Usage: max30101_latencybench [seconds]
+*/
+
+#include "MAX30101.h"
+#include "MAX30101_Fixed.h"
+#include "MAX30101_Sim.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+/**
+*   \brief I2C clock used to convert bus usage to time.
+*/
+#define LBENCH_I2C_CLOCK_HZ 400000
+
+/**
+*   \brief Interrupt to task: ISR, post and dispatch of the scheduler, in us.
+*/
+#define LBENCH_DISPATCH_US 10
+
+/**
+*   \brief Sample period of the fixed mode (400 Hz, 2 samples averaged), in us.
+*/
+#define LBENCH_SAMPLE_PERIOD_US 5000
+
+/**
+*   \brief Time step of the simulation, in us.
+*/
+#define LBENCH_STEP_US 5
+
+/**
+*   \brief Samples between two reads of status and pointers in latency mode.
+*/
+#define LBENCH_RESYNC 32
+
+/**
+*   \brief Background job: short step and its period, long step and its period, in us.
+*/
+#define LBENCH_JOB_US 2000
+#define LBENCH_JOB_PERIOD_US 9973
+#define LBENCH_LONG_JOB_US 8000
+#define LBENCH_LONG_JOB_PERIOD_US 997000
+
+/**
+*   \brief Background loads.
+*/
+#define LBENCH_IDLE  0
+#define LBENCH_BUSY  1
+#define LBENCH_SPLIT 2
+
+/**
+*   \brief Acquisition times of the samples not yet read.
+*/
+#define LBENCH_PENDING 64
+
+static MAX30101_Fixed_Data lbench_data;
+static uint64_t lbench_now;
+static uint64_t lbench_pending[LBENCH_PENDING];
+static uint32_t lbench_pending_head;
+static uint32_t lbench_pending_tail;
+static uint32_t* lbench_latency;
+static uint32_t lbench_samples;
+
+static void LBench_Boot(uint8_t latency_mode);
+
+static void LBench_Advance(uint32_t us);
+
+static uint64_t LBench_Busy(uint8_t load);
+
+static uint8_t LBench_ReadThroughput(void);
+
+static uint8_t LBench_ReadLatency(uint8_t late);
+
+static int LBench_Compare(const void* a, const void* b);
+
+int main(int argc, char** argv)
+{
+    uint32_t seconds = (argc > 1) ? (uint32_t)strtoul(argv[1], NULL, 0) : 60;
+    if (seconds == 0)
+    {
+        seconds = 60;
+    }
+    lbench_latency = malloc(sizeof(uint32_t) * (seconds + 1) * 4000u);
+    if (lbench_latency == NULL)
+    {
+        return 1;
+    }
+
+    static const char* const loads[] = {"idle", "busy", "split"};
+    int failed = 0;
+    printf("%u s at 200 samples/s, I2C at %u Hz, dispatch %u us\n", seconds, LBENCH_I2C_CLOCK_HZ,
+           LBENCH_DISPATCH_US);
+    printf("%-10s %-5s %8s %8s %8s %8s %8s %8s %10s %6s\n", "Mode", "Load", "Min us", "Median", "99%", "Max us",
+           "Reads/s", "Bytes/s", "Bus us/s", "Lost");
+    for (uint8_t latency_mode = 0; latency_mode < 2; latency_mode++)
+    {
+        for (uint8_t load = LBENCH_IDLE; load <= LBENCH_SPLIT; load++)
+        {
+            uint64_t duration_us = (uint64_t)seconds * 1000000u;
+            uint32_t reads = 0;
+            uint64_t bus_us = 0;
+            MAX30101_SimStats total = {0};
+            LBench_Boot(latency_mode);
+
+            while (lbench_now < duration_us)
+            {
+                LBench_Advance(LBENCH_STEP_US);
+                if (!MAX30101_Sim_IsInterrupt())
+                {
+                    continue;
+                }
+                // Served when the background job ends, then dispatched
+                uint64_t raised = lbench_now;
+                uint64_t busy_until = LBench_Busy(load);
+                if (busy_until > lbench_now)
+                {
+                    LBench_Advance((uint32_t)(busy_until - lbench_now));
+                }
+                LBench_Advance(LBENCH_DISPATCH_US);
+
+                // The device answers at once, the data is available after the transfers
+                MAX30101_Sim_ResetStats();
+                uint8_t late = (lbench_now - raised) > LBENCH_SAMPLE_PERIOD_US;
+                uint8_t num_read = latency_mode ? LBench_ReadLatency(late) : LBench_ReadThroughput();
+                MAX30101_SimStats stats;
+                MAX30101_Sim_GetStats(&stats);
+                uint32_t transfer_us = MAX30101_Sim_BusTime(&stats, LBENCH_I2C_CLOCK_HZ);
+                total.bytes_read += stats.bytes_read;
+                bus_us += transfer_us;
+                reads++;
+                for (uint8_t i = 0; (i < num_read) && (lbench_pending_tail != lbench_pending_head); i++)
+                {
+                    uint64_t acquired = lbench_pending[lbench_pending_tail++ % LBENCH_PENDING];
+                    lbench_latency[lbench_samples++] = (uint32_t)(lbench_now + transfer_us - acquired);
+                }
+                LBench_Advance(transfer_us);
+            }
+
+            qsort(lbench_latency, lbench_samples, sizeof(uint32_t), LBench_Compare);
+            if (lbench_samples == 0)
+            {
+                printf("%-10s %-5s no samples\n", latency_mode ? "latency" : "throughput", loads[load]);
+                failed = 1;
+                continue;
+            }
+            printf("%-10s %-5s %8u %8u %8u %8u %8.1f %8.1f %10.1f %6u\n", latency_mode ? "latency" : "throughput",
+                   loads[load], lbench_latency[0], lbench_latency[lbench_samples / 2],
+                   lbench_latency[(uint32_t)((uint64_t)lbench_samples * 99 / 100)],
+                   lbench_latency[lbench_samples - 1], (double)reads / seconds, (double)total.bytes_read / seconds,
+                   (double)bus_us / seconds, (unsigned)MAX30101_Sim_GetLostSamples());
+            if (latency_mode && (load != LBENCH_BUSY) &&
+                (lbench_latency[lbench_samples - 1] >= LBENCH_SAMPLE_PERIOD_US))
+            {
+                fprintf(stderr, "latency %s: maximum over a sample period\n", loads[load]);
+                failed = 1;
+            }
+        }
+    }
+    free(lbench_latency);
+    printf("%s\n", failed ? "FAILED" : "ok");
+    return failed;
+}
+
+// Power on and configure the simulated device as the test project
+static void LBench_Boot(uint8_t latency_mode)
+{
+    MAX30101_Config config = {
+        .int_en_1 = latency_mode ? MAX30101_CONF_INT_PPG_RDY : MAX30101_CONF_INT_A_FULL,
+        .fifo_conf = MAX30101_FIXED_FIFO_CONF | MAX30101_CONF_FIFO_ROLLOVER | MAX30101_CONF_FIFO_A_FULL(32),
+        .mode_conf = MAX30101_FIXED_MODE_CONF,
+        .spo2_conf = MAX30101_FIXED_SPO2_CONF,
+        .led_pa = {0x1F, 0x1F, 0x1F, 0x1F},
+        .multi_led = {MAX30101_FIXED_MULTI_LED_1, MAX30101_FIXED_MULTI_LED_2},
+    };
+    MAX30101_Sim_PowerOn();
+    MAX30101_Boot(&config, NULL);
+    MAX30101_FlushFIFO();
+    uint8_t status;
+    MAX30101_ReadRegister(MAX30101_INT_ST_1, &status);
+    lbench_now = 0;
+    lbench_pending_head = 0;
+    lbench_pending_tail = 0;
+    lbench_samples = 0;
+}
+
+// Advance virtual time, record the acquisition time of new samples
+static void LBench_Advance(uint32_t us)
+{
+    while (us > 0)
+    {
+        uint32_t step = (us < LBENCH_STEP_US) ? us : LBENCH_STEP_US;
+        uint8_t count = MAX30101_Sim_GetFIFOCount();
+        uint32_t lost = MAX30101_Sim_GetLostSamples();
+        MAX30101_Sim_Run(step);
+        lbench_now += step;
+        uint32_t acquired = MAX30101_Sim_GetFIFOCount() - count + MAX30101_Sim_GetLostSamples() - lost;
+        for (uint32_t i = 0; i < acquired; i++)
+        {
+            if (lbench_pending_head - lbench_pending_tail == LBENCH_PENDING)
+            {
+                // Overwritten in the FIFO
+                lbench_pending_tail++;
+            }
+            lbench_pending[lbench_pending_head++ % LBENCH_PENDING] = lbench_now;
+        }
+        // Samples overwritten with rollover are no longer pending
+        while (lbench_pending_head - lbench_pending_tail > MAX30101_Sim_GetFIFOCount())
+        {
+            lbench_pending_tail++;
+        }
+        us -= step;
+    }
+}
+
+// End of the background job (or of its run, if split) running now, or now if none
+static uint64_t LBench_Busy(uint8_t load)
+{
+    if (load == LBENCH_IDLE)
+    {
+        return lbench_now;
+    }
+    uint64_t long_start = lbench_now - lbench_now % LBENCH_LONG_JOB_PERIOD_US;
+    if (lbench_now < long_start + LBENCH_LONG_JOB_US)
+    {
+        if (load == LBENCH_SPLIT)
+        {
+            uint64_t runs = (lbench_now - long_start) / LBENCH_JOB_US + 1;
+            return long_start + runs * LBENCH_JOB_US;
+        }
+        return long_start + LBENCH_LONG_JOB_US;
+    }
+    uint64_t start = lbench_now - lbench_now % LBENCH_JOB_PERIOD_US;
+    return (lbench_now < start + LBENCH_JOB_US) ? start + LBENCH_JOB_US : lbench_now;
+}
+
+// Drain after A_FULL as Task_Drain, return the samples read
+static uint8_t LBench_ReadThroughput(void)
+{
+    uint8_t status, wp, ovf, rp;
+    MAX30101_ReadRegister(MAX30101_INT_ST_1, &status);
+    MAX30101_ReadFIFOPointers(&wp, &ovf, &rp);
+    uint8_t num_samples = (wp - rp) & 0x1F;
+    if (num_samples == 0)
+    {
+        num_samples = 32;
+    }
+    return (MAX30101_Fixed_ReadFIFO(num_samples, &lbench_data) == MAX30101_OK) ? num_samples : 0;
+}
+
+// Read after PPG_RDY as Task_Sample, return the samples read
+static uint8_t LBench_ReadLatency(uint8_t late)
+{
+    static uint8_t since_resync = 0;
+    if ((++since_resync < LBENCH_RESYNC) && !late)
+    {
+        return (MAX30101_Fixed_ReadSample(&lbench_data) == MAX30101_OK) ? 1 : 0;
+    }
+    since_resync = 0;
+    uint8_t status, wp, ovf, rp;
+    MAX30101_ReadRegister(MAX30101_INT_ST_1, &status);
+    MAX30101_ReadFIFOPointers(&wp, &ovf, &rp);
+    uint8_t num_samples = (wp - rp) & 0x1F;
+    if ((num_samples == 0) && (ovf != 0))
+    {
+        num_samples = 32;
+    }
+    if (num_samples == 0)
+    {
+        return 0;
+    }
+    return (MAX30101_Fixed_ReadFIFO(num_samples, &lbench_data) == MAX30101_OK) ? num_samples : 0;
+}
+
+// Comparison for qsort
+static int LBench_Compare(const void* a, const void* b)
+{
+    uint32_t x = *(const uint32_t*)a;
+    uint32_t y = *(const uint32_t*)b;
+    return (x > y) - (x < y);
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,422 @@
+/**
+*   Throughput of a processing pipeline on replayed FIFO data.
+*
+*   The simulated MAX30101 (see MAX30101_Sim.h) acquires a pulse in the
+*   mode of MAX30101_FixedConfig.h (2 channels, 200 samples/s) and its
+*   FIFO bursts are recorded at each A_FULL interrupt. The bursts are
+*   then replayed, as fast as possible, through a pipeline
+*   (MAX30101_Pipeline.h) of five stages:
+*   - unpack: raw FIFO bytes to 32-bit samples (MAX30101_Pipe_Unpack);
+*   - stats: sliding window statistics of each channel, in place;
+*   - hr: spectral heart rate of the last channel, in place;
+*   - compress: delta of each channel, zigzag and variable length bytes;
+*   - output: sink counting the bytes sent.
+*
+*   Reports, for each stage, the time per block and per sample and its
+*   throughput alone, then the end-to-end throughput and the longest
+*   time from push to output.
+*
+*   Then the bursts are pushed faster than the pipeline runs (one stage
+*   step per push): the first queue fills and refuses blocks, and every
+*   sample is either output or counted as refused.
+*
+*   Last, a pipeline of #MAX30101_PIPE_MAX_STAGES stages without a sink
+*   must refuse blocks and not run.
+*
+*   Usage: max30101_pipebench [seconds] [passes]
+*/
+
+#include "MAX30101.h"
+#include "MAX30101_Fixed.h"
+#include "MAX30101_Pipeline.h"
+#include "MAX30101_Profile.h"
+#include "MAX30101_Sim.h"
+#include "MAX30101_SpectralHR.h"
+#include "MAX30101_Stats.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+*   \brief Output sample rate of MAX30101_FixedConfig.h, in Hz.
+*/
+#define PIPEBENCH_RATE 200
+
+/**
+*   \brief Time step of the recording, in us.
+*/
+#define PIPEBENCH_STEP_US 1000
+
+/**
+*   \brief Statistics window, in samples.
+*/
+#define PIPEBENCH_WINDOW PIPEBENCH_RATE
+
+// A recorded FIFO burst
+typedef struct
+{
+    uint8_t num_samples;
+    uint8_t raw[32 * MAX30101_FIXED_LEDS * 3];
+} PipeBench_Burst;
+
+// State of the compression stage
+typedef struct
+{
+    uint32_t last[MAX30101_FIXED_LEDS];
+} PipeBench_Delta;
+
+static PipeBench_Burst* pipebench_bursts;
+static uint32_t pipebench_num_bursts;
+static uint64_t pipebench_output_bytes;
+static uint64_t pipebench_output_samples;
+
+static MAX30101_Stats pipebench_stats[MAX30101_FIXED_LEDS];
+static MAX30101_STATS_STORAGE(pipebench_window, MAX30101_FIXED_LEDS * PIPEBENCH_WINDOW);
+static MAX30101_SpectralHR pipebench_hr;
+static PipeBench_Delta pipebench_delta;
+static MAX30101_PipeUnpack pipebench_unpack = {MAX30101_FIXED_LEDS, MAX30101_FIXED_SHIFT};
+
+static uint8_t PipeBench_Stats(void* state, const MAX30101_Block* in, MAX30101_Block* out);
+
+static uint8_t PipeBench_HR(void* state, const MAX30101_Block* in, MAX30101_Block* out);
+
+static uint8_t PipeBench_Compress(void* state, const MAX30101_Block* in, MAX30101_Block* out);
+
+static uint8_t PipeBench_Output(void* state, const MAX30101_Block* in, MAX30101_Block* out);
+
+static uint8_t PipeBench_Pass(void* state, const MAX30101_Block* in, MAX30101_Block* out);
+
+static const MAX30101_PipeStage pipebench_stages[] = {
+    {"unpack", MAX30101_Pipe_Unpack, &pipebench_unpack, MAX30101_PIPE_FORMAT(MAX30101_PIPE_RAW, MAX30101_FIXED_LEDS),
+     MAX30101_PIPE_FORMAT(MAX30101_PIPE_SAMPLES, MAX30101_FIXED_LEDS), 0},
+    {"stats", PipeBench_Stats, pipebench_stats, MAX30101_PIPE_FORMAT(MAX30101_PIPE_SAMPLES, MAX30101_FIXED_LEDS),
+     MAX30101_PIPE_FORMAT(MAX30101_PIPE_SAMPLES, MAX30101_FIXED_LEDS), 1},
+    {"hr", PipeBench_HR, &pipebench_hr, MAX30101_PIPE_FORMAT(MAX30101_PIPE_SAMPLES, MAX30101_FIXED_LEDS),
+     MAX30101_PIPE_FORMAT(MAX30101_PIPE_SAMPLES, MAX30101_FIXED_LEDS), 1},
+    {"compress", PipeBench_Compress, &pipebench_delta, MAX30101_PIPE_FORMAT(MAX30101_PIPE_SAMPLES, MAX30101_FIXED_LEDS),
+     MAX30101_PIPE_FORMAT(MAX30101_PIPE_BYTES, 0), 0},
+    {"output", PipeBench_Output, NULL, MAX30101_PIPE_FORMAT(MAX30101_PIPE_BYTES, 0), MAX30101_PIPE_NONE, 0},
+};
+
+#define PIPEBENCH_STAGES (sizeof(pipebench_stages) / sizeof(pipebench_stages[0]))
+
+static int PipeBench_Record(uint32_t seconds);
+
+static int PipeBench_Build(MAX30101_Pipeline* pipe);
+
+static int PipeBench_Throughput(uint32_t passes);
+
+static int PipeBench_Backpressure(void);
+
+static int PipeBench_NoSink(void);
+
+int main(int argc, char** argv)
+{
+    uint32_t seconds = (argc > 1) ? (uint32_t)strtoul(argv[1], NULL, 0) : 60;
+    uint32_t passes = (argc > 2) ? (uint32_t)strtoul(argv[2], NULL, 0) : 20;
+    if (seconds == 0)
+    {
+        seconds = 60;
+    }
+    if (passes == 0)
+    {
+        passes = 1;
+    }
+
+    MAX30101_Profile_Start();
+    if (PipeBench_Record(seconds) != 0)
+    {
+        return 1;
+    }
+    int failed = PipeBench_Throughput(passes);
+    failed |= PipeBench_Backpressure();
+    failed |= PipeBench_NoSink();
+    free(pipebench_bursts);
+    return failed;
+}
+
+// Record the FIFO bursts of the simulated device
+static int PipeBench_Record(uint32_t seconds)
+{
+    MAX30101_Config config = {
+        .int_en_1 = MAX30101_CONF_INT_A_FULL,
+        .fifo_conf = MAX30101_FIXED_FIFO_CONF | MAX30101_CONF_FIFO_ROLLOVER | MAX30101_CONF_FIFO_A_FULL(32),
+        .mode_conf = MAX30101_FIXED_MODE_CONF,
+        .spo2_conf = MAX30101_FIXED_SPO2_CONF,
+        .led_pa = {0x1F, 0x1F, 0x1F, 0x1F},
+        .multi_led = {MAX30101_FIXED_MULTI_LED_1, MAX30101_FIXED_MULTI_LED_2},
+    };
+    // 72 bpm pulse with noise
+    MAX30101_SimLight light = {
+        .led_na = 1500,
+        .pulse_na = 30,
+        .period = PIPEBENCH_RATE * 60 / 72,
+        .noise_na = 2,
+    };
+    uint32_t max_bursts = seconds * PIPEBENCH_RATE / 32 + 2;
+    pipebench_bursts = malloc(max_bursts * sizeof(PipeBench_Burst));
+    if (pipebench_bursts == NULL)
+    {
+        return 1;
+    }
+    MAX30101_Sim_PowerOn();
+    MAX30101_Boot(&config, NULL);
+    MAX30101_Sim_SetLight(&light);
+    MAX30101_FlushFIFO();
+
+    pipebench_num_bursts = 0;
+    for (uint32_t t = 0; (t < seconds * 1000000u) && (pipebench_num_bursts < max_bursts); t += PIPEBENCH_STEP_US)
+    {
+        MAX30101_Sim_Run(PIPEBENCH_STEP_US);
+        if (!MAX30101_Sim_IsInterrupt())
+        {
+            continue;
+        }
+        uint8_t status, wp, ovf, rp;
+        MAX30101_ReadRegister(MAX30101_INT_ST_1, &status);
+        MAX30101_ReadFIFOPointers(&wp, &ovf, &rp);
+        uint8_t num_samples = (wp - rp) & 0x1F;
+        if (num_samples == 0)
+        {
+            num_samples = 32;
+        }
+        PipeBench_Burst* burst = &pipebench_bursts[pipebench_num_bursts++];
+        burst->num_samples = num_samples;
+        MAX30101_ReadRawFIFOBytes(num_samples, MAX30101_FIXED_LEDS, burst->raw);
+    }
+    printf("Recorded %u bursts (%u s at %u samples/s, %u channels)\n", pipebench_num_bursts, seconds,
+           PIPEBENCH_RATE, MAX30101_FIXED_LEDS);
+    return 0;
+}
+
+// Reset the stages and build the pipeline, return 1 if a stage is refused
+static int PipeBench_Build(MAX30101_Pipeline* pipe)
+{
+    for (uint8_t c = 0; c < MAX30101_FIXED_LEDS; c++)
+    {
+        MAX30101_Stats_Init(&pipebench_stats[c], PIPEBENCH_WINDOW, &pipebench_window_samples[c * PIPEBENCH_WINDOW],
+                            &pipebench_window_queues[2 * c * PIPEBENCH_WINDOW]);
+    }
+    MAX30101_SpectralHR_Init(&pipebench_hr, PIPEBENCH_RATE, 8);
+    memset(&pipebench_delta, 0, sizeof(pipebench_delta));
+    pipebench_output_bytes = 0;
+    pipebench_output_samples = 0;
+    MAX30101_Pool_Init();
+
+    MAX30101_Pipeline_Init(pipe, MAX30101_Profile_Now);
+    for (uint8_t s = 0; s < PIPEBENCH_STAGES; s++)
+    {
+        if (MAX30101_Pipeline_Add(pipe, &pipebench_stages[s]) != MAX30101_OK)
+        {
+            fprintf(stderr, "Stage %s refused\n", pipebench_stages[s].name);
+            return 1;
+        }
+    }
+    // A stage that does not match the sink is refused
+    return MAX30101_Pipeline_Add(pipe, &pipebench_stages[1]) == MAX30101_OK;
+}
+
+// Replay every burst, running the pipeline after each push, return 1 on error
+static int PipeBench_Throughput(uint32_t passes)
+{
+    MAX30101_Pipeline pipe;
+    if (PipeBench_Build(&pipe) != 0)
+    {
+        return 1;
+    }
+    uint64_t samples = 0;
+    uint32_t start = MAX30101_Profile_Now();
+    uint64_t elapsed = 0;
+    for (uint32_t pass = 0; pass < passes; pass++)
+    {
+        for (uint32_t b = 0; b < pipebench_num_bursts; b++)
+        {
+            MAX30101_Block* block = MAX30101_Pool_Alloc();
+            if (block == NULL)
+            {
+                return 1;
+            }
+            block->num_samples = pipebench_bursts[b].num_samples;
+            memcpy(block->data, pipebench_bursts[b].raw, block->num_samples * MAX30101_FIXED_LEDS * 3);
+            samples += block->num_samples;
+            MAX30101_Pipeline_Push(&pipe, block);
+            MAX30101_Pipeline_Run(&pipe, 0);
+        }
+        uint32_t now = MAX30101_Profile_Now();
+        elapsed += now - start;
+        start = now;
+    }
+
+    printf("\n%u passes, %llu samples\n", passes, (unsigned long long)samples);
+    printf("%-9s %8s %12s %10s %10s %14s %8s\n", "Stage", "Blocks", "ns/block", "Max ns", "ns/sample",
+           "Msamples/s", "Blocked");
+    for (uint8_t s = 0; s < pipe.num_stages; s++)
+    {
+        const MAX30101_PipeStats* stats = &pipe.stats[s];
+        double ns = (double)stats->total_time;
+        printf("%-9s %8u %12.1f %10u %10.2f %14.2f %8u\n", pipe.stages[s]->name, stats->blocks,
+               stats->blocks ? ns / stats->blocks : 0.0, stats->max_time, stats->samples ? ns / stats->samples : 0.0,
+               (ns > 0) ? stats->samples * 1e3 / ns : 0.0, stats->blocked);
+    }
+    printf("End to end: %.2f Msamples/s (%.0fx real time), longest push to output %u ns\n",
+           samples * 1e3 / elapsed, samples * 1e9 / elapsed / PIPEBENCH_RATE, pipe.max_latency);
+    printf("Output: %llu bytes for %llu samples (%.2f bytes/sample), heart rate %u.%u bpm\n",
+           (unsigned long long)pipebench_output_bytes, (unsigned long long)pipebench_output_samples,
+           (double)pipebench_output_bytes / pipebench_output_samples, pipebench_hr.bpm_x10 / 10,
+           pipebench_hr.bpm_x10 % 10);
+
+    // Every sample reaches the output, all blocks are back in the pool
+    MAX30101_PoolStats pool;
+    MAX30101_Pool_GetStats(&pool);
+    return (pipebench_output_samples != samples) || (pool.in_use != 0) || (pipe.refused != 0);
+}
+
+// Push faster than the pipeline runs, return 1 if samples are not accounted for
+static int PipeBench_Backpressure(void)
+{
+    MAX30101_Pipeline pipe;
+    if (PipeBench_Build(&pipe) != 0)
+    {
+        return 1;
+    }
+    uint64_t pushed = 0, refused = 0, no_block = 0;
+    for (uint32_t b = 0; b < pipebench_num_bursts; b++)
+    {
+        MAX30101_Block* block = MAX30101_Pool_Alloc();
+        if (block == NULL)
+        {
+            // Pool exhausted: the producer would leave the samples in the FIFO
+            no_block += pipebench_bursts[b].num_samples;
+        }
+        else
+        {
+            block->num_samples = pipebench_bursts[b].num_samples;
+            memcpy(block->data, pipebench_bursts[b].raw, block->num_samples * MAX30101_FIXED_LEDS * 3);
+            pushed += block->num_samples;
+            if (MAX30101_Pipeline_Push(&pipe, block) != MAX30101_OK)
+            {
+                refused += pipebench_bursts[b].num_samples;
+            }
+        }
+        // One stage step per burst
+        MAX30101_Pipeline_Run(&pipe, 1);
+    }
+    uint16_t pending = MAX30101_Pipeline_Pending(&pipe);
+    MAX30101_Pipeline_Run(&pipe, 0);
+
+    MAX30101_PoolStats pool;
+    MAX30101_Pool_GetStats(&pool);
+    printf("\nBackpressure (1 step per burst): %u blocks refused by the pipeline, %u without a free block, "
+           "%u pending at the end\n", pipe.refused, pool.failures, pending);
+    printf("Samples: %llu pushed, %llu refused, %llu without block, %llu output: %s\n",
+           (unsigned long long)pushed, (unsigned long long)refused, (unsigned long long)no_block,
+           (unsigned long long)pipebench_output_samples,
+           (pushed == refused + pipebench_output_samples) ? "ok" : "FAILED");
+    return (pushed != refused + pipebench_output_samples) || (pool.in_use != 0) || (refused + no_block == 0);
+}
+
+// Fill the pipeline with stages that are not sinks, return 1 if it takes a block or runs
+static int PipeBench_NoSink(void)
+{
+    static const MAX30101_PipeStage pass = {"pass", PipeBench_Pass, NULL,
+        MAX30101_PIPE_FORMAT(MAX30101_PIPE_SAMPLES, MAX30101_FIXED_LEDS),
+        MAX30101_PIPE_FORMAT(MAX30101_PIPE_SAMPLES, MAX30101_FIXED_LEDS), 1};
+    MAX30101_Pipeline pipe;
+    MAX30101_Pool_Init();
+    MAX30101_Pipeline_Init(&pipe, NULL);
+    int failed = (MAX30101_Pipeline_Add(&pipe, &pipebench_stages[0]) != MAX30101_OK);
+    while (!failed && (pipe.num_stages < MAX30101_PIPE_MAX_STAGES))
+    {
+        failed = (MAX30101_Pipeline_Add(&pipe, &pass) != MAX30101_OK);
+    }
+    MAX30101_Block* block = MAX30101_Pool_Alloc();
+    if (!failed && (block != NULL))
+    {
+        block->num_samples = pipebench_bursts[0].num_samples;
+        memcpy(block->data, pipebench_bursts[0].raw, block->num_samples * MAX30101_FIXED_LEDS * 3);
+        failed = (MAX30101_Pipeline_Push(&pipe, block) == MAX30101_OK);
+    }
+    failed |= (MAX30101_Pipeline_Run(&pipe, 0) != 0) || (MAX30101_Pipeline_Pending(&pipe) != 0);
+
+    MAX30101_PoolStats pool;
+    MAX30101_Pool_GetStats(&pool);
+    failed |= (pool.in_use != 0) || (pipe.refused != 1);
+    printf("\nNo sink (%u stages): %u blocks refused, %u blocks in use: %s\n", pipe.num_stages, pipe.refused,
+           pool.in_use, failed ? "FAILED" : "ok");
+    return failed;
+}
+
+// Sliding window statistics of each channel
+static uint8_t PipeBench_Stats(void* state, const MAX30101_Block* in, MAX30101_Block* out)
+{
+    (void)out;
+    MAX30101_Stats* stats = (MAX30101_Stats*)state;
+    const uint32_t* frame = in->samples;
+    for (uint8_t i = 0; i < in->num_samples; i++, frame += MAX30101_FIXED_LEDS)
+    {
+        for (uint8_t c = 0; c < MAX30101_FIXED_LEDS; c++)
+        {
+            MAX30101_Stats_Add(&stats[c], frame[c]);
+        }
+    }
+    return MAX30101_OK;
+}
+
+// Heart rate from the last channel
+static uint8_t PipeBench_HR(void* state, const MAX30101_Block* in, MAX30101_Block* out)
+{
+    (void)out;
+    MAX30101_SpectralHR* hr = (MAX30101_SpectralHR*)state;
+    for (uint8_t i = 0; i < in->num_samples; i++)
+    {
+        MAX30101_SpectralHR_Add(hr, in->samples[i * MAX30101_FIXED_LEDS + MAX30101_FIXED_LEDS - 1]);
+    }
+    return MAX30101_OK;
+}
+
+// Delta of each channel, zigzag, 7 bits per byte
+static uint8_t PipeBench_Compress(void* state, const MAX30101_Block* in, MAX30101_Block* out)
+{
+    PipeBench_Delta* delta = (PipeBench_Delta*)state;
+    uint16_t length = 0;
+    const uint32_t* frame = in->samples;
+    for (uint8_t i = 0; i < in->num_samples; i++, frame += MAX30101_FIXED_LEDS)
+    {
+        for (uint8_t c = 0; c < MAX30101_FIXED_LEDS; c++)
+        {
+            int32_t diff = (int32_t)(frame[c] - delta->last[c]);
+            uint32_t value = ((uint32_t)diff << 1) ^ (uint32_t)(diff >> 31);
+            delta->last[c] = frame[c];
+            // At most 3 bytes for 18 bits of difference and sign
+            while (value >= 0x80)
+            {
+                out->data[length++] = (uint8_t)(value | 0x80);
+                value >>= 7;
+            }
+            out->data[length++] = (uint8_t)value;
+        }
+    }
+    out->length = length;
+    return MAX30101_OK;
+}
+
+// Count the bytes sent
+static uint8_t PipeBench_Output(void* state, const MAX30101_Block* in, MAX30101_Block* out)
+{
+    (void)state;
+    (void)out;
+    pipebench_output_bytes += in->length;
+    pipebench_output_samples += in->num_samples;
+    return MAX30101_OK;
+}
+
+// Leave the samples as they are
+static uint8_t PipeBench_Pass(void* state, const MAX30101_Block* in, MAX30101_Block* out)
+{
+    (void)state;
+    (void)in;
+    (void)out;
+    return MAX30101_OK;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,221 @@
+/**
+*   Benchmark and stress test of the pool of sample blocks.
+*
+*   First, the host time of an allocation and release of a block
+*   (MAX30101_Pool.h) is compared with malloc and free of the same size.
+*
+*   Then a random sequence of allocations, added references and
+*   releases is checked against a model of the references held:
+*   - a block is never given twice and its data is not changed while a
+*     reference is held (each owner fills it with its own pattern);
+*   - allocations fail only when all the blocks are in use;
+*   - blocks in use, largest use and failures match the statistics;
+*   - index and block conversions match;
+*   - releasing a free block is refused and counted.
+*
+*   On the host critical sections do nothing: the sequence is run in a
+*   single thread.
+*
+*   Usage: max30101_poolbench [num_operations]
+*/
+
+#include "MAX30101.h"
+#include "MAX30101_Pool.h"
+#include "MAX30101_HostTime.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+/**
+*   \brief Default number of random operations of the stress test.
+*/
+#define PBENCH_OPERATIONS 2000000u
+
+/**
+*   \brief Allocations and releases timed.
+*/
+#define PBENCH_TIMED 10000000u
+
+// References held on each block by the model
+static uint8_t pbench_refs[MAX30101_POOL_BLOCKS];
+static uint8_t pbench_pattern[MAX30101_POOL_BLOCKS];
+
+static void PBench_Cost(void);
+
+static int PBench_Stress(uint32_t num_operations);
+
+static int PBench_Check(uint8_t index);
+
+int main(int argc, char** argv)
+{
+    uint32_t num_operations = (argc > 1) ? strtoul(argv[1], NULL, 0) : PBENCH_OPERATIONS;
+
+    printf("%u blocks of %u bytes (%u bytes of RAM)\n", MAX30101_POOL_BLOCKS, MAX30101_POOL_BLOCK_SIZE,
+           (unsigned)(MAX30101_POOL_BLOCKS * sizeof(MAX30101_Block)));
+    PBench_Cost();
+    int failed = PBench_Stress(num_operations);
+    return failed;
+}
+
+// Time of an allocation and release, pool and malloc
+static void PBench_Cost(void)
+{
+    volatile uint8_t sink = 0;
+    MAX30101_Pool_Init();
+    uint64_t start = MAX30101_HostTime_Now();
+    for (uint32_t i = 0; i < PBENCH_TIMED; i++)
+    {
+        MAX30101_Block* block = MAX30101_Pool_Alloc();
+        block->data[0] = (uint8_t)i;
+        sink += block->data[0];
+        MAX30101_Pool_Release(block);
+    }
+    double pool_ns = (double)(MAX30101_HostTime_Now() - start) / PBENCH_TIMED;
+
+    start = MAX30101_HostTime_Now();
+    for (uint32_t i = 0; i < PBENCH_TIMED; i++)
+    {
+        uint8_t* buffer = malloc(MAX30101_POOL_BLOCK_SIZE);
+        buffer[0] = (uint8_t)i;
+        sink += buffer[0];
+        free(buffer);
+    }
+    double malloc_ns = (double)(MAX30101_HostTime_Now() - start) / PBENCH_TIMED;
+
+    // Hold every block, then release them: the free list in the other order
+    MAX30101_Block* held[MAX30101_POOL_BLOCKS];
+    start = MAX30101_HostTime_Now();
+    for (uint32_t i = 0; i < PBENCH_TIMED / MAX30101_POOL_BLOCKS; i++)
+    {
+        for (uint8_t b = 0; b < MAX30101_POOL_BLOCKS; b++)
+        {
+            held[b] = MAX30101_Pool_Alloc();
+        }
+        for (uint8_t b = 0; b < MAX30101_POOL_BLOCKS; b++)
+        {
+            MAX30101_Pool_Release(held[b]);
+        }
+    }
+    double full_ns = (double)(MAX30101_HostTime_Now() - start) / (PBENCH_TIMED / MAX30101_POOL_BLOCKS * MAX30101_POOL_BLOCKS);
+
+    printf("Alloc + release: pool %.1f ns, pool with all blocks held %.1f ns, malloc + free %.1f ns\n", pool_ns,
+           full_ns, malloc_ns);
+    (void)sink;
+}
+
+// Random operations against the model, return 1 on a mismatch
+static int PBench_Stress(uint32_t num_operations)
+{
+    uint32_t failures = 0, allocs = 0;
+    uint8_t in_use = 0, max_in_use = 0;
+    int failed = 0;
+
+    MAX30101_Pool_Init();
+    srand(1);
+    for (uint8_t i = 0; i < MAX30101_POOL_BLOCKS; i++)
+    {
+        pbench_refs[i] = 0;
+    }
+
+    for (uint32_t op = 0; (op < num_operations) && !failed; op++)
+    {
+        uint8_t index = rand() % MAX30101_POOL_BLOCKS;
+        // Releases outnumber added references: the pool fills and empties
+        uint8_t action = rand() % 8;
+        switch ((action < 3) ? 0 : (action < 4) ? 1 : 2)
+        {
+            case 0:
+            {
+                MAX30101_Block* block = MAX30101_Pool_Alloc();
+                if (block == NULL)
+                {
+                    failures++;
+                    failed |= in_use != MAX30101_POOL_BLOCKS;
+                    break;
+                }
+                uint32_t got = MAX30101_Pool_Index(block);
+                failed |= (got >= MAX30101_POOL_BLOCKS) || (pbench_refs[got] != 0) ||
+                          (MAX30101_Pool_Block(got) != block) || (block->refs != 1) || (block->length != 0);
+                if (failed)
+                {
+                    fprintf(stderr, "Operation %u: block %u given while in use\n", op, (unsigned)got);
+                    break;
+                }
+                pbench_refs[got] = 1;
+                pbench_pattern[got] = (uint8_t)rand();
+                for (uint16_t i = 0; i < MAX30101_POOL_BLOCK_SIZE; i++)
+                {
+                    block->data[i] = (uint8_t)(pbench_pattern[got] + i);
+                }
+                block->length = MAX30101_POOL_BLOCK_SIZE;
+                allocs++;
+                in_use++;
+                max_in_use = (in_use > max_in_use) ? in_use : max_in_use;
+                break;
+            }
+            case 1:
+                // Another consumer of a block in use
+                if ((pbench_refs[index] > 0) && (pbench_refs[index] < 4))
+                {
+                    failed |= MAX30101_Pool_Retain(MAX30101_Pool_Block(index)) != MAX30101_OK;
+                    pbench_refs[index]++;
+                }
+                break;
+            default:
+                if (pbench_refs[index] > 0)
+                {
+                    failed |= PBench_Check(index);
+                    failed |= MAX30101_Pool_Release(MAX30101_Pool_Block(index)) != MAX30101_OK;
+                    if (--pbench_refs[index] == 0)
+                    {
+                        in_use--;
+                    }
+                }
+                break;
+        }
+    }
+
+    MAX30101_PoolStats stats;
+    MAX30101_Pool_GetStats(&stats);
+    if ((stats.allocs != allocs) || (stats.failures != failures) || (stats.in_use != in_use) ||
+        (stats.max_in_use != max_in_use) || (stats.bad_releases != 0))
+    {
+        fprintf(stderr, "Statistics: %lu allocations, %lu failed, %u in use, largest %u, expected %u %u %u %u\n",
+                (unsigned long)stats.allocs, (unsigned long)stats.failures, stats.in_use, stats.max_in_use, allocs,
+                failures, in_use, max_in_use);
+    }
+    failed |= (stats.allocs != allocs) || (stats.failures != failures) || (stats.in_use != in_use) ||
+              (stats.max_in_use != max_in_use) || (stats.bad_releases != 0);
+
+    // Release of a free block, and of a block already released
+    MAX30101_Pool_Init();
+    MAX30101_Block* block = MAX30101_Pool_Alloc();
+    uint8_t twice = (MAX30101_Pool_Release(block) == MAX30101_OK) && (MAX30101_Pool_Release(block) != MAX30101_OK) &&
+                    (MAX30101_Pool_Release(MAX30101_Pool_Block(MAX30101_POOL_BLOCKS - 1)) != MAX30101_OK) &&
+                    (MAX30101_Pool_Retain(block) != MAX30101_OK) &&
+                    (MAX30101_Pool_Block(MAX30101_POOL_BLOCKS) == NULL);
+    MAX30101_Pool_GetStats(&stats);
+    failed |= !twice || (stats.bad_releases != 2) || (stats.in_use != 0);
+
+    printf("Stress: %u operations, %u allocations, %u failed (pool exhausted), largest use %u of %u, "
+           "bad releases refused: %s\n", num_operations, allocs, failures, max_in_use, MAX30101_POOL_BLOCKS,
+           twice ? "yes" : "no");
+    printf("Result: %s\n", failed ? "FAILED" : "ok");
+    return failed;
+}
+
+// Check that a block held still has the pattern of its owner, return 1 if not
+static int PBench_Check(uint8_t index)
+{
+    const MAX30101_Block* block = MAX30101_Pool_Block(index);
+    for (uint16_t i = 0; i < MAX30101_POOL_BLOCK_SIZE; i++)
+    {
+        if (block->data[i] != (uint8_t)(pbench_pattern[index] + i))
+        {
+            fprintf(stderr, "Block %u changed while in use\n", index);
+            return 1;
+        }
+    }
+    return (block->refs != pbench_refs[index]) || (block->length != MAX30101_POOL_BLOCK_SIZE);
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,241 @@
+/**
+*   Proximity-triggered acquisition on the simulated device.
+*
+*   The simulated device (see MAX30101_Sim.h) runs with the settings of
+*   MAX30101_FixedConfig.h (200 samples/s) and a light model: no finger
+*   on the sensor for the first third of the run, a finger for the
+*   second third, none for the last. Two runs are compared:
+*   - always on: the FIFO is drained at each A_FULL interrupt, as in the
+*     library example;
+*   - proximity: the state machine of MAX30101_Proximity.h keeps the
+*     device in proximity mode (IR LED at the pilot amplitude, no data)
+*     until the finger is detected, drains the FIFO while the IR signal
+*     is present and goes back to proximity mode after a second of
+*     signal loss.
+*
+*   For each run it reports the LED-on time, the LED charge and average
+*   current, the I2C bus usage and the samples read with the finger on
+*   the sensor; for the proximity run, the time to wake up after the
+*   finger is placed and to fall back after it is removed. Fails if the
+*   proximity run does not wake up and fall back once, misses more than
+*   a second of samples with the finger on the sensor, or saves no LED
+*   charge or bus traffic.
+*
+*   Usage: max30101_proxbench [seconds]
+*/
+
+#include "MAX30101.h"
+#include "MAX30101_Fixed.h"
+#include "MAX30101_Proximity.h"
+#include "MAX30101_Sim.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+*   \brief Sample rate of MAX30101_FixedConfig.h, in Hz.
+*/
+#define PBENCH_RATE 200
+
+/**
+*   \brief I2C clock used to convert bus usage to time.
+*/
+#define PBENCH_I2C_CLOCK_HZ 400000
+
+/**
+*   \brief Light reflected per mA of LED current, with and without a finger, in nA.
+*/
+#define PBENCH_FINGER_NA_PER_MA 300
+#define PBENCH_NONE_NA_PER_MA   2
+
+/**
+*   \brief LED amplitude while acquiring (7.2 mA) and pilot amplitude (5 mA).
+*/
+#define PBENCH_LED_PA   0x24
+#define PBENCH_PILOT_PA 0x19
+
+/**
+*   \brief Proximity threshold, 8 MSBs of the IR count (256 nA in the 4096 nA range).
+*/
+#define PBENCH_THRESHOLD 0x10
+
+/**
+*   \brief Signal loss: IR below this level (shifted samples) for a second.
+*/
+#define PBENCH_LOSS_LEVEL 1000
+#define PBENCH_LOSS_SAMPLES PBENCH_RATE
+
+/**
+*   \brief Results of a run.
+*/
+typedef struct
+{
+    MAX30101_SimLED led;        ///< LED usage.
+    MAX30101_SimStats bus;      ///< Bus usage.
+    uint32_t finger_samples;    ///< Samples read that were acquired with the finger on the sensor.
+    uint32_t wake_ups;          ///< Transitions to active.
+    uint32_t fall_backs;        ///< Transitions to proximity mode.
+    uint32_t wake_delay;        ///< Samples from the finger placed to the wake-up.
+    uint32_t idle_delay;        ///< Samples from the finger removed to the fall back.
+} PBench_Result;
+
+static MAX30101_Fixed_Data pbench_data;
+
+static void PBench_Run(uint8_t proximity, uint32_t seconds, PBench_Result* result);
+
+static void PBench_Print(const char* name, const PBench_Result* result, uint32_t seconds);
+
+int main(int argc, char** argv)
+{
+    uint32_t seconds = (argc > 1) ? (uint32_t)strtoul(argv[1], NULL, 0) : 60;
+    if (seconds < 6)
+    {
+        fprintf(stderr, "Usage: %s [seconds (6 or more)]\n", argv[0]);
+        return 1;
+    }
+
+    PBench_Result always, proximity;
+    PBench_Run(0, seconds, &always);
+    PBench_Run(1, seconds, &proximity);
+
+    printf("%u s: no finger, finger from %u s to %u s, %u samples/s\n", seconds, seconds / 3, 2 * seconds / 3,
+           PBENCH_RATE);
+    printf("%-10s %10s %7s %10s %8s %9s %10s %10s %8s\n", "Run", "LED on", "Duty", "Charge", "Current", "Transfers",
+           "Bytes", "Bus time", "Samples");
+    PBench_Print("always on", &always, seconds);
+    PBench_Print("proximity", &proximity, seconds);
+    printf("Proximity: %u wake-ups after %u ms, %u fall backs after %u ms\n", proximity.wake_ups,
+           proximity.wake_delay * 1000u / PBENCH_RATE, proximity.fall_backs, proximity.idle_delay * 1000u / PBENCH_RATE);
+    printf("Saved: LED charge %.1f%%, bus bytes %.1f%%\n",
+           100.0 * (1.0 - (double)proximity.led.charge_nc / always.led.charge_nc),
+           100.0 * (1.0 - (double)(proximity.bus.bytes_written + proximity.bus.bytes_read) /
+                              (always.bus.bytes_written + always.bus.bytes_read)));
+
+    int failed = (proximity.wake_ups != 1) || (proximity.fall_backs != 1) ||
+                 (proximity.finger_samples + PBENCH_RATE < always.finger_samples) ||
+                 (proximity.led.charge_nc >= always.led.charge_nc) ||
+                 (proximity.bus.bytes_read >= always.bus.bytes_read);
+    printf("%s\n", failed ? "FAILED" : "ok");
+    return failed;
+}
+
+// Run the finger on and off phases, always on or with the proximity state machine
+static void PBench_Run(uint8_t proximity, uint32_t seconds, PBench_Result* result)
+{
+    MAX30101_Config config = {
+        .int_en_1 = MAX30101_CONF_INT_A_FULL,
+        .fifo_conf = MAX30101_FIXED_FIFO_CONF | MAX30101_CONF_FIFO_ROLLOVER | MAX30101_CONF_FIFO_A_FULL(32),
+        .mode_conf = MAX30101_FIXED_MODE_CONF,
+        .spo2_conf = MAX30101_FIXED_SPO2_CONF,
+        .led_pa = {PBENCH_LED_PA, PBENCH_LED_PA, PBENCH_LED_PA, PBENCH_LED_PA},
+        .multi_led = {MAX30101_FIXED_MULTI_LED_1, MAX30101_FIXED_MULTI_LED_2},
+    };
+    const MAX30101_ProxConfig prox_config = {
+        .pilot_pa = PBENCH_PILOT_PA,
+        .threshold = PBENCH_THRESHOLD,
+        .loss_level = PBENCH_LOSS_LEVEL,
+        .loss_samples = PBENCH_LOSS_SAMPLES,
+    };
+    MAX30101_SimLight light = {
+        .pulse_na = 100,
+        .period = PBENCH_RATE * 60 / 72,
+    };
+    MAX30101_Prox prox;
+    memset(result, 0, sizeof(*result));
+    memset(&pbench_data, 0, sizeof(pbench_data));
+    MAX30101_Sim_PowerOn();
+    MAX30101_Boot(&config, NULL);
+    MAX30101_FlushFIFO();
+    if (proximity)
+    {
+        MAX30101_Prox_Start(&prox, &prox_config);
+    }
+    MAX30101_Sim_ResetStats();
+
+    uint32_t total = seconds * PBENCH_RATE;
+    uint32_t finger_on = total / 3;
+    uint32_t finger_off = 2 * total / 3;
+    // Acquisition time of the next sample to read, and of the samples in the FIFO
+    uint32_t first_unread = 0;
+    uint8_t was_active = 0;
+    for (uint32_t i = 0; i < total; i++)
+    {
+        uint8_t finger = (i >= finger_on) && (i < finger_off);
+        light.na_per_ma = finger ? PBENCH_FINGER_NA_PER_MA : PBENCH_NONE_NA_PER_MA;
+        MAX30101_Sim_SetLight(&light);
+        MAX30101_Sim_Generate(1);
+
+        uint8_t active = !proximity || (MAX30101_Prox_GetState(&prox) == MAX30101_PROX_ACTIVE);
+        if (active != was_active)
+        {
+            if (active && (i >= finger_on))
+            {
+                result->wake_delay = i - finger_on;
+            }
+            else if (!active && (i >= finger_off))
+            {
+                result->idle_delay = i - finger_off;
+            }
+            was_active = active;
+        }
+        if (!MAX30101_Sim_IsInterrupt())
+        {
+            // Samples acquired while waiting are all read at the next drain
+            if (!active || MAX30101_Sim_IsProximity())
+            {
+                first_unread = i + 1;
+            }
+            continue;
+        }
+        if (!active)
+        {
+            // Proximity interrupt: the FIFO is cleared, samples start now
+            MAX30101_Prox_HandleInterrupt(&prox);
+            first_unread = i + 1;
+            continue;
+        }
+
+        // Drain, as in the library example
+        uint8_t status, wp, ovf, rp;
+        MAX30101_ReadRegister(MAX30101_INT_ST_1, &status);
+        MAX30101_ReadFIFOPointers(&wp, &ovf, &rp);
+        uint8_t num_samples = ((wp - rp) & 0x1F) ? (wp - rp) & 0x1F : 32;
+        MAX30101_Fixed_ReadFIFO(num_samples, &pbench_data);
+        for (uint8_t k = 0; k < num_samples; k++)
+        {
+            uint32_t acquired = first_unread + k;
+            result->finger_samples += (acquired >= finger_on) && (acquired < finger_off);
+        }
+        first_unread += num_samples;
+        if (proximity)
+        {
+            uint32_t ir[32];
+            for (uint8_t k = 0; k < num_samples; k++)
+            {
+                uint8_t index = (pbench_data.head + 1 - num_samples + k) & (BUFFER_STORAGE_SIZE - 1);
+                ir[k] = pbench_data.channel[MAX30101_FIXED_IR][index];
+            }
+            MAX30101_Prox_ProcessSamples(&prox, ir, num_samples);
+        }
+    }
+    MAX30101_Sim_GetLED(&result->led);
+    MAX30101_Sim_GetStats(&result->bus);
+    if (proximity)
+    {
+        result->wake_ups = prox.wake_ups;
+        result->fall_backs = prox.fall_backs;
+    }
+    MAX30101_Sim_SetLight(NULL);
+}
+
+// Print a run
+static void PBench_Print(const char* name, const PBench_Result* result, uint32_t seconds)
+{
+    printf("%-10s %8.2f s %6.2f%% %7.1f mC %5.2f mA %9u %10u %7u ms %8u\n", name, result->led.on_us / 1e6,
+           100.0 * result->led.on_us / (seconds * 1e6), result->led.charge_nc / 1e6,
+           result->led.charge_nc / 1e3 / seconds / 1e3, result->bus.starts,
+           result->bus.starts + result->bus.bytes_written + result->bus.bytes_read,
+           MAX30101_Sim_BusTime(&result->bus, PBENCH_I2C_CLOCK_HZ) / 1000, result->finger_samples);
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,227 @@
+/**
+*   Validation of the automatic ADC range on the simulated device.
+*
+*   The simulated device runs with the settings of MAX30101_FixedConfig.h
+*   (200 samples/s, 15 bits) and a light model (MAX30101_Sim_SetLight):
+*   1000 nA of LED light with a 100 nA pulse at 72 bpm, under ambient
+*   light steps, some beyond the ALC limit. The FIFO is drained at each
+*   A_FULL interrupt, as in the library example, twice:
+*   - fixed: 4096 nA range, as configured at boot;
+*   - automatic: the range monitor (MAX30101_Range.h) checks and scales
+*     each drain and selects the range.
+*
+*   For each ambient segment it reports the clipped samples and the
+*   pulse amplitude in codes (resolution) of both, and for the automatic
+*   range the range at the end of the segment and the recovery time: the
+*   time from the step to the last range change of the segment.
+*
+*   Every scaled sample is compared with the light of the sample, converted
+*   with the lowest range: the units must be continuous across range
+*   changes, including the samples acquired before a change and read
+*   after it. Fails if a sample does not match, a sample is lost, a
+*   sample clips after the recovery, or the automatic range clips as
+*   often as the fixed one.
+*
+*   Usage: max30101_rangebench
+*/
+
+#include "MAX30101.h"
+#include "MAX30101_Fixed.h"
+#include "MAX30101_Range.h"
+#include "MAX30101_Sim.h"
+#include <stdio.h>
+#include <string.h>
+
+/**
+*   \brief Sample rate of MAX30101_FixedConfig.h, in Hz.
+*/
+#define RBENCH_RATE 200
+
+/**
+*   \brief Consecutive dim drains (of 160 ms) before a lower range.
+*/
+#define RBENCH_DOWN_BLOCKS 6
+
+/**
+*   \brief LED light and pulse, in nA.
+*/
+#define RBENCH_LED_NA 1000
+#define RBENCH_PULSE_NA 100
+
+/**
+*   \brief Number of ambient segments.
+*/
+#define RBENCH_SEGMENTS 5
+
+/**
+*   \brief Duration of a segment, in samples.
+*/
+#define RBENCH_SEGMENT (15 * RBENCH_RATE)
+
+/**
+*   \brief Samples of the whole run.
+*/
+#define RBENCH_SAMPLES (RBENCH_SEGMENTS * RBENCH_SEGMENT)
+
+/**
+*   \brief Results of a segment.
+*/
+typedef struct
+{
+    uint32_t clipped;       ///< Clipped samples.
+    uint32_t late_clipped;  ///< Clipped samples after the last range change.
+    uint64_t pulse_codes;   ///< Sum of the pulse amplitude of each sample, in codes.
+    uint32_t last_change;   ///< Sample of the last range change, from the start of the segment.
+    uint8_t range;          ///< Range at the end of the segment.
+} RBench_Segment;
+
+// Ambient light of each segment, in nA (ALC limit: MAX30101_SIM_ALC_LIMIT_NA)
+static const uint32_t rbench_ambient[RBENCH_SEGMENTS] = {0, 30000, 5000, 24000, 0};
+
+static uint32_t rbench_light[RBENCH_SAMPLES];
+
+static uint8_t rbench_range[RBENCH_SAMPLES];
+
+static MAX30101_Fixed_Data rbench_data;
+
+static int RBench_Run(uint8_t automatic, RBench_Segment* segments);
+
+int main(void)
+{
+    RBench_Segment fixed[RBENCH_SEGMENTS], automatic[RBENCH_SEGMENTS];
+    int failed = RBench_Run(0, fixed);
+    failed |= RBench_Run(1, automatic);
+
+    printf("LED %u nA, pulse %u nA, ALC limit %u nA, segments of %u s\n", RBENCH_LED_NA, RBENCH_PULSE_NA,
+           MAX30101_SIM_ALC_LIMIT_NA, RBENCH_SEGMENT / RBENCH_RATE);
+    printf("%8s %10s | %14s %12s | %8s %10s %14s %12s\n", "Segment", "Ambient", "Fixed clipped", "Pulse codes",
+           "Range", "Recovery", "Auto clipped", "Pulse codes");
+    uint32_t fixed_clipped = 0, automatic_clipped = 0;
+    for (uint8_t s = 0; s < RBENCH_SEGMENTS; s++)
+    {
+        printf("%8u %7u nA | %14u %12.0f | %5u nA %7u ms %14u %12.0f\n", s, rbench_ambient[s], fixed[s].clipped,
+               (double)fixed[s].pulse_codes / RBENCH_SEGMENT, 2048u << automatic[s].range,
+               automatic[s].last_change * 1000u / RBENCH_RATE, automatic[s].clipped,
+               (double)automatic[s].pulse_codes / RBENCH_SEGMENT);
+        fixed_clipped += fixed[s].clipped;
+        automatic_clipped += automatic[s].clipped;
+        if (automatic[s].late_clipped > 0)
+        {
+            fprintf(stderr, "Segment %u: %u samples clipped after the recovery\n", s, automatic[s].late_clipped);
+            failed = 1;
+        }
+    }
+    if (automatic_clipped >= fixed_clipped)
+    {
+        failed = 1;
+    }
+    printf("%s\n", failed ? "FAILED" : "ok");
+    return failed;
+}
+
+// Run the ambient segments with the fixed or the automatic range, return 1 on error
+static int RBench_Run(uint8_t automatic, RBench_Segment* segments)
+{
+    MAX30101_Config config = {
+        .int_en_1 = MAX30101_CONF_INT_A_FULL,
+        .fifo_conf = MAX30101_FIXED_FIFO_CONF | MAX30101_CONF_FIFO_ROLLOVER | MAX30101_CONF_FIFO_A_FULL(32),
+        .mode_conf = MAX30101_FIXED_MODE_CONF,
+        .spo2_conf = MAX30101_FIXED_SPO2_CONF,
+        .led_pa = {0x1F, 0x1F, 0x1F, 0x1F},
+        .multi_led = {MAX30101_FIXED_MULTI_LED_1, MAX30101_FIXED_MULTI_LED_2},
+    };
+    MAX30101_SimLight light = {
+        .led_na = RBENCH_LED_NA,
+        .pulse_na = RBENCH_PULSE_NA,
+        .period = RBENCH_RATE * 60 / 72,
+    };
+    MAX30101_Range monitor;
+    MAX30101_Sim_PowerOn();
+    MAX30101_Boot(&config, NULL);
+    MAX30101_FlushFIFO();
+    MAX30101_Range_Init(&monitor, MAX30101_FIXED_ADC_RANGE, MAX30101_ADC_RANGE_2048, MAX30101_ADC_RANGE_16384,
+                        MAX30101_FIXED_SHIFT, RBENCH_DOWN_BLOCKS);
+    memset(&rbench_data, 0, sizeof(rbench_data));
+    memset(segments, 0, RBENCH_SEGMENTS * sizeof(RBench_Segment));
+
+    int failed = 0;
+    uint32_t read = 0;
+    uint8_t range = MAX30101_FIXED_ADC_RANGE >> MAX30101_ADC_RANGE_SHIFT;
+    for (uint32_t i = 0; i < RBENCH_SAMPLES; i++)
+    {
+        uint32_t segment = i / RBENCH_SEGMENT;
+        light.ambient_na = rbench_ambient[segment];
+        MAX30101_Sim_SetLight(&light);
+
+        // Light and range of the sample
+        uint8_t spo2_conf;
+        MAX30101_ReadRegister(MAX30101_SPO2_CONF, &spo2_conf);
+        if (((spo2_conf >> MAX30101_ADC_RANGE_SHIFT) & 0x03) != range)
+        {
+            range = (spo2_conf >> MAX30101_ADC_RANGE_SHIFT) & 0x03;
+            segments[segment].last_change = i % RBENCH_SEGMENT;
+            segments[segment].late_clipped = 0;
+        }
+        MAX30101_Sim_Generate(1);
+        rbench_light[i] = MAX30101_Sim_GetLastLight();
+        rbench_range[i] = range;
+        if (rbench_light[i] >= (2048u << range))
+        {
+            segments[segment].clipped++;
+            segments[segment].late_clipped++;
+        }
+        segments[segment].pulse_codes += ((uint64_t)RBENCH_PULSE_NA << (18 - MAX30101_FIXED_SHIFT)) / (2048u << range);
+        segments[segment].range = range;
+
+        if (!MAX30101_Sim_IsInterrupt())
+        {
+            continue;
+        }
+        // Drain, as in the library example
+        uint8_t status, wp, ovf, rp;
+        MAX30101_ReadRegister(MAX30101_INT_ST_1, &status);
+        MAX30101_ReadFIFOPointers(&wp, &ovf, &rp);
+        uint8_t num_samples = ((wp - rp) & 0x1F) ? (wp - rp) & 0x1F : 32;
+        MAX30101_Fixed_ReadFIFO(num_samples, &rbench_data);
+        if (automatic)
+        {
+            for (uint8_t c = 0; c < MAX30101_FIXED_LEDS; c++)
+            {
+                MAX30101_Range_Scale(&monitor, rbench_data.channel[c], rbench_data.head, num_samples);
+            }
+            MAX30101_Range_Update(&monitor, num_samples, (status & MAX30101_CONF_INT_ALC_OVF) != 0);
+        }
+
+        // Compare with the light converted with the lowest range
+        uint8_t unit = automatic ? 0 : range;
+        for (uint8_t k = 0; k < num_samples; k++, read++)
+        {
+            uint8_t index = (rbench_data.head + 1 - num_samples + k) & (BUFFER_STORAGE_SIZE - 1);
+            uint8_t used = rbench_range[read];
+            if (rbench_light[read] >= (2048u << used))
+            {
+                continue;
+            }
+            uint32_t expected = ((uint64_t)rbench_light[read] << (18 - MAX30101_FIXED_SHIFT)) / (2048u << unit);
+            uint32_t sample = rbench_data.channel[MAX30101_FIXED_IR][index];
+            if ((sample > expected) || (expected - sample >= (1u << (used - unit))))
+            {
+                if (!failed)
+                {
+                    fprintf(stderr, "Sample %u (range %u nA): %u, expected %u\n", read, 2048u << used, sample,
+                            expected);
+                }
+                failed = 1;
+            }
+        }
+    }
+    if (MAX30101_Sim_GetLostSamples() > 0)
+    {
+        fprintf(stderr, "%u samples lost\n", MAX30101_Sim_GetLostSamples());
+        failed = 1;
+    }
+    MAX30101_Sim_SetLight(NULL);
+    return failed;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,262 @@
+/**
+*   Validation of the rate solver against the datasheet and the simulated device.
+*
+*   First, MAX30101_Rate_Check is compared with the allowed settings of
+*   the datasheet for HR mode (1 slot) and SpO2 mode (2 slots), and the
+*   table of the solver is printed for 1 to 4 slots.
+*
+*   Then, for each target output rate and 1 to 4 slots,
+*   MAX30101_Rate_Solve selects a setting, which is applied to the
+*   simulated device in HR, SpO2 or Multi-LED mode. The device runs for
+*   at least 10 s of simulated time, drained at each A_FULL interrupt as
+*   the example firmware does (status, pointers, one burst of data). A
+*   setting passes if it is valid, reaches the target, and the simulated
+*   device delivers the predicted number of samples (within one) with the
+*   predicted bus time per drain (within 1%).
+*
+*   Last, settings refused by the solver must be refused by the driver
+*   too (#MAX30101_ApplyConfig, #MAX30101_SetSpO2PulseWidth and
+*   #MAX30101_SetSpO2SampleRate); written to the simulated device
+*   directly, they do not reach the requested rate.
+*
+*   Usage: max30101_ratebench
+*/
+
+#include "MAX30101.h"
+#include "MAX30101_Rate.h"
+#include "MAX30101_Sim.h"
+#include <stdio.h>
+
+/**
+*   \brief I2C clock of the PSoC project, in Hz.
+*/
+#define RBENCH_I2C_CLOCK_HZ 400000
+
+/**
+*   \brief Unread samples at the A_FULL interrupt.
+*/
+#define RBENCH_A_FULL 24
+
+/**
+*   \brief Shortest simulated time and time step, in us.
+*/
+#define RBENCH_MIN_US 10000000u
+#define RBENCH_STEP_US 50
+
+// Allowed settings of the datasheet, for each sample rate: one character per pulse width (69 to 411 us)
+static const char* const rbench_hr_table[8] = {
+    "OOOO", "OOOO", "OOOO", "OOOO", "OOOO", "OOOO", "OOO-", "O---",
+};
+static const char* const rbench_spo2_table[8] = {
+    "OOOO", "OOOO", "OOOO", "OOOO", "OOO-", "OO--", "O---", "----",
+};
+
+// Target output rates, in samples/s
+static const uint16_t rbench_targets[] = {1, 10, 25, 50, 60, 100, 200, 250, 400, 500, 800, 1000, 1600, 3200};
+
+static uint8_t rbench_raw[32 * MAX30101_MAX_SLOTS * 3];
+
+static int RBench_Datasheet(void);
+
+static int RBench_Solve(uint16_t target, uint8_t slots);
+
+static void RBench_Boot(uint8_t slots);
+
+static void RBench_Run(uint8_t slots, uint32_t duration_us, uint32_t* samples, uint32_t* drains);
+
+static int RBench_Refused(void);
+
+int main(void)
+{
+    int failed = RBench_Datasheet();
+
+    printf("\nI2C at %u Hz, drain at %u samples\n", RBENCH_I2C_CLOCK_HZ, RBENCH_A_FULL);
+    printf("%7s %5s %7s %6s %4s %11s %8s %10s %10s %10s %9s %s\n", "Target", "Slots", "Rate", "Pulse", "Avg",
+           "Output", "Bytes/s", "Bus us/s", "Samples", "Expected", "Drain us", "Result");
+    for (uint8_t t = 0; t < sizeof(rbench_targets) / sizeof(rbench_targets[0]); t++)
+    {
+        for (uint8_t slots = 1; slots <= MAX30101_MAX_SLOTS; slots++)
+        {
+            failed |= RBench_Solve(rbench_targets[t], slots);
+        }
+    }
+
+    failed |= RBench_Refused();
+    return failed;
+}
+
+// Compare the check with the datasheet and print the limits, return 1 on a mismatch
+static int RBench_Datasheet(void)
+{
+    int failed = 0;
+    printf("Allowed settings (O), datasheet for 1 and 2 slots\n%6s", "Rate");
+    for (uint8_t slots = 1; slots <= MAX30101_MAX_SLOTS; slots++)
+    {
+        printf("   %u slot%s", slots, (slots > 1) ? "s" : " ");
+    }
+    printf("\n");
+    for (uint8_t rate = 0; rate < 8; rate++)
+    {
+        printf("%6u", MAX30101_Rate_SampleRate(rate));
+        for (uint8_t slots = 1; slots <= MAX30101_MAX_SLOTS; slots++)
+        {
+            printf("   ");
+            for (uint8_t pw = 0; pw < 4; pw++)
+            {
+                uint8_t valid = MAX30101_Rate_Check(slots, rate << MAX30101_SAMPLE_RATE_SHIFT, pw) == MAX30101_OK;
+                printf("%c", valid ? 'O' : '-');
+                if (slots <= 2)
+                {
+                    const char* expected = (slots == 1) ? rbench_hr_table[rate] : rbench_spo2_table[rate];
+                    if (valid != (expected[pw] == 'O'))
+                    {
+                        failed = 1;
+                    }
+                }
+            }
+            printf("   ");
+        }
+        printf("\n");
+    }
+    printf("Datasheet check: %s\n", failed ? "FAILED" : "ok");
+    return failed;
+}
+
+// Solve a target, check the setting on the simulated device, return 1 if it fails
+static int RBench_Solve(uint16_t target, uint8_t slots)
+{
+    MAX30101_RatePlan plan;
+    if (MAX30101_Rate_Solve(target, slots, RBENCH_A_FULL, RBENCH_I2C_CLOCK_HZ, &plan) != MAX30101_OK)
+    {
+        // Only targets above the fastest setting of the slots are refused
+        uint16_t fastest = MAX30101_Rate_SampleRate(MAX30101_RATE_MAX_SETTING(slots, 0));
+        printf("%7u %5u %7s %6s %4s %11s %8s %10s %10s %10s %9s %s\n", target, slots, "-", "-", "-", "refused",
+               "", "", "", "", "", (target > fastest) ? "ok" : "FAILED");
+        return target <= fastest;
+    }
+
+    uint8_t pw = plan.spo2_conf & 0x03;
+    uint8_t avg = plan.sample_avg >> MAX30101_SAMPLE_AVG_SHIFT;
+    int failed = (MAX30101_Rate_Check(slots, plan.spo2_conf & 0x1C, pw) != MAX30101_OK) ||
+                 (plan.rate_mhz < (uint32_t)target * 1000u);
+
+    // Run long enough for a few drains
+    uint32_t duration_us = (uint32_t)((uint64_t)4 * RBENCH_A_FULL * 1000000000u / plan.rate_mhz);
+    if (duration_us < RBENCH_MIN_US)
+    {
+        duration_us = RBENCH_MIN_US;
+    }
+    RBench_Boot(slots);
+    if (MAX30101_Rate_Apply(&plan) != MAX30101_OK)
+    {
+        failed = 1;
+    }
+    MAX30101_Sim_ResetStats();
+    uint32_t samples, drains;
+    RBench_Run(slots, duration_us, &samples, &drains);
+
+    MAX30101_SimStats stats;
+    MAX30101_Sim_GetStats(&stats);
+    uint32_t expected = (uint32_t)((uint64_t)plan.rate_mhz * duration_us / 1000000000u);
+    double drain_us = drains ? (double)MAX30101_Sim_BusTime(&stats, RBENCH_I2C_CLOCK_HZ) / drains : 0.0;
+    double predicted_us = (double)plan.bus_us_per_s * RBENCH_A_FULL * 1000.0 / plan.rate_mhz;
+    if ((samples + 1 < expected) || (samples > expected + 1) || (drains == 0) ||
+        (drain_us > 1.01 * predicted_us + 1.0) || (drain_us < 0.99 * predicted_us - 1.0))
+    {
+        failed = 1;
+    }
+    printf("%7u %5u %7u %3u us %4u %7.3f Hz %8u %10u %10u %10u %9.1f %s\n", target, slots, plan.adc_rate,
+           MAX30101_Rate_PulseWidth(pw), 1u << avg, plan.rate_mhz / 1000.0, plan.bytes_per_s, plan.bus_us_per_s,
+           samples, expected, drain_us, failed ? "FAILED" : "ok");
+    return failed;
+}
+
+// Power on the simulated device and start it with 1 to 4 slots
+static void RBench_Boot(uint8_t slots)
+{
+    MAX30101_Config config = {
+        .int_en_1 = MAX30101_CONF_INT_A_FULL,
+        .fifo_conf = MAX30101_SAMPLE_AVG_1 | MAX30101_CONF_FIFO_A_FULL(RBENCH_A_FULL),
+        .mode_conf = (slots == 1) ? MAX30101_HR_MODE : (slots == 2) ? MAX30101_SPO2_MODE : MAX30101_MULTI_MODE,
+        .spo2_conf = MAX30101_ADC_RANGE_4096 | MAX30101_SAMPLE_RATE_50 | MAX30101_PULSEWIDTH_69,
+        .led_pa = {0x1F, 0x1F, 0x1F, 0x1F},
+        .multi_led = {MAX30101_CONF_SLOTS(MAX30101_SLOT_RED, MAX30101_SLOT_IR),
+                      MAX30101_CONF_SLOTS(MAX30101_SLOT_GREEN, (slots == 4) ? MAX30101_SLOT_GREEN : MAX30101_SLOT_NONE)},
+    };
+    MAX30101_Sim_PowerOn();
+    MAX30101_Boot(&config, NULL);
+}
+
+// Run the simulated device, drain at each A_FULL interrupt, count the samples acquired
+static void RBench_Run(uint8_t slots, uint32_t duration_us, uint32_t* samples, uint32_t* drains)
+{
+    *samples = 0;
+    *drains = 0;
+    for (uint32_t t = 0; t < duration_us; t += RBENCH_STEP_US)
+    {
+        MAX30101_Sim_Run(RBENCH_STEP_US);
+        if (!MAX30101_Sim_IsInterrupt())
+        {
+            continue;
+        }
+        uint8_t status, wp, ovf, rp;
+        MAX30101_ReadRegister(MAX30101_INT_ST_1, &status);
+        MAX30101_ReadFIFOPointers(&wp, &ovf, &rp);
+        uint8_t num_samples = (wp - rp) & 0x1F;
+        if (num_samples == 0)
+        {
+            num_samples = 32;
+        }
+        MAX30101_ReadRawFIFOBytes(num_samples, slots, rbench_raw);
+        *samples += num_samples;
+        (*drains)++;
+    }
+    *samples += MAX30101_Sim_GetFIFOCount();
+}
+
+// Settings refused by the solver: refused by the driver, rate reached when written anyway; return 1 if the driver accepts one
+static int RBench_Refused(void)
+{
+    static const uint8_t cases[][3] = {
+        // Slots, sample rate, pulse width
+        {1, MAX30101_SAMPLE_RATE_3200, MAX30101_PULSEWIDTH_411},
+        {2, MAX30101_SAMPLE_RATE_3200, MAX30101_PULSEWIDTH_69},
+        {2, MAX30101_SAMPLE_RATE_1000, MAX30101_PULSEWIDTH_411},
+        {4, MAX30101_SAMPLE_RATE_1600, MAX30101_PULSEWIDTH_118},
+    };
+    int failed = 0;
+    printf("\nSettings refused by the solver, on the simulated device\n");
+    printf("%5s %10s %6s %8s %8s %10s\n", "Slots", "Requested", "Pulse", "Check", "Driver", "Reached");
+    for (uint8_t c = 0; c < sizeof(cases) / sizeof(cases[0]); c++)
+    {
+        uint8_t slots = cases[c][0];
+        uint8_t spo2_conf = MAX30101_ADC_RANGE_4096 | cases[c][1] | cases[c][2];
+
+        // Whole configuration, then one setter after the other from a valid setting
+        RBench_Boot(slots);
+        MAX30101_Config config = {0};
+        MAX30101_ReadRegisters(MAX30101_FIFO_CONF, 1, &config.fifo_conf);
+        MAX30101_ReadRegisters(MAX30101_MODE_CONF, 1, &config.mode_conf);
+        MAX30101_ReadRegisters(MAX30101_MULTI_LED_1, 2, config.multi_led);
+        config.spo2_conf = spo2_conf;
+        uint8_t refused = (MAX30101_ApplyConfig(&config) == MAX30101_ERROR);
+        MAX30101_SetSpO2PulseWidth(cases[c][2]);
+        MAX30101_SetSpO2SampleRate(cases[c][1]);
+        uint8_t written;
+        MAX30101_ReadRegister(MAX30101_SPO2_CONF, &written);
+        refused &= (MAX30101_Rate_Check(slots, written & 0x1C, written & 0x03) == MAX30101_OK);
+        failed |= !refused;
+
+        MAX30101_WriteRegisters(MAX30101_SPO2_CONF, 1, &spo2_conf);
+        uint32_t samples, drains;
+        RBench_Run(slots, 1000000u, &samples, &drains);
+        printf("%5u %8u/s %3u us %8s %8s %8u/s\n", slots,
+               MAX30101_Rate_SampleRate(cases[c][1] >> MAX30101_SAMPLE_RATE_SHIFT),
+               MAX30101_Rate_PulseWidth(cases[c][2]),
+               (MAX30101_Rate_Check(slots, cases[c][1], cases[c][2]) == MAX30101_OK) ? "allowed" : "refused",
+               refused ? "refused" : "FAILED", samples);
+    }
+    return failed;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,478 @@
+/**
+*   Host replay of MAX30101 FIFO traces.
+*
+*   Reads a trace recorded with MAX30101_Trace (e.g., captured from the
+*   UART with UART_TRACE enabled in the Library example) and replays it
+*   through the driver: configuration records are written to the
+*   simulated MAX30101 (see MAX30101_Sim.h), the raw bytes of each FIFO
+*   burst are loaded in its FIFO and read back with the read path of the
+*   target (MAX30101_Fixed_ReadFIFO when the recorded mode is the one of
+*   MAX30101_FixedConfig.h, #MAX30101_ReadMultiLEDFIFO in Multi-LED mode,
+*   #MAX30101_ReadFIFO otherwise). On the first pass the last sample of
+*   each slot is checked against the recorded bytes. The trace is
+*   replayed as fast as possible, optionally several times, and the read
+*   time per burst is printed together with the timing of the recording.
+*
+*   Timing check: the FIFO holds 32 samples, so two drains must be less
+*   than 33 sample periods apart and the overflow counter must stay 0.
+*   The longest interval between drains is printed against this budget
+*   and the program exits with 1 if the recording misses it or if a
+*   replayed sample differs.
+*
+*   With --record, a trace is recorded from the simulated device instead,
+*   with the configuration and the A_FULL drain of the Library example
+*   delayed by the given time after the interrupt, in simulated time.
+*   With a heart rate, the device converts a PPG light model (see
+*   MAX30101_Sim_SetLight): a pulse of 2% of the LED light at that rate,
+*   with ambient light and noise, instead of its test pattern.
+*
+*   Usage: max30101_replay trace.bin [repeat] [samples.csv]
+*          max30101_replay --record trace.bin [seconds] [drain_delay_us] [bpm]
+*/
+
+#include "MAX30101.h"
+#include "MAX30101_Fixed.h"
+#include "MAX30101_Profile.h"
+#include "MAX30101_Sim.h"
+#include "MAX30101_Trace.h"
+#include "MAX30101_TraceDecoder.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+*   \brief Step of the simulated time while recording, in us.
+*/
+#define REPLAY_STEP_US 100
+
+/**
+*   \brief Sample rate of MAX30101_FixedConfig.h, in Hz, for the pulse period of the PPG light model.
+*/
+#define REPLAY_PPG_RATE 200
+
+/**
+*   \brief Read paths.
+*/
+#define REPLAY_PATH_FIFO    0
+#define REPLAY_PATH_MULTI   1
+#define REPLAY_PATH_FIXED   2
+
+/**
+*   \brief Replay results.
+*/
+typedef struct
+{
+    MAX30101_TraceDecoder decoder;  ///< Decoder following the recorded configuration.
+    uint8_t path;                   ///< Read path of the current configuration.
+    uint64_t last_fifo_us;          ///< Time of the previous FIFO record.
+    MAX30101_StageStats interval;   ///< Time between two FIFO records, in us.
+    MAX30101_StageStats read;       ///< Time of the driver reads, in ns.
+    uint32_t mismatches;            ///< Bursts whose last sample differs from the trace.
+    uint32_t late;                  ///< Drains later than 33 sample periods after the previous one.
+    uint32_t budget_us;             ///< Time to fill the FIFO at the recorded sample rate, 0 if unknown.
+} Replay_State;
+
+static uint32_t replay_clock_ns;
+
+static FILE* replay_out;
+
+static uint8_t* Replay_Load(const char* path, uint32_t* size);
+
+static void Replay_Run(const uint8_t* trace, uint32_t size, Replay_State* state, FILE* csv);
+
+static void Replay_Burst(Replay_State* state, const MAX30101_TraceBurst* burst, uint8_t check, FILE* csv);
+
+static uint8_t Replay_Path(uint8_t active_leds);
+
+static void Replay_Update(MAX30101_StageStats* stats, uint32_t value);
+
+static int Replay_Record(const char* path, uint32_t seconds, uint32_t delay_us, uint32_t bpm);
+
+static uint32_t Replay_Clock(void);
+
+static void Replay_Write(const uint8_t* data, uint8_t length);
+
+int main(int argc, char** argv)
+{
+    if ((argc > 2) && (strcmp(argv[1], "--record") == 0))
+    {
+        uint32_t seconds = (argc > 3) ? (uint32_t)strtoul(argv[3], NULL, 0) : 2;
+        uint32_t delay_us = (argc > 4) ? (uint32_t)strtoul(argv[4], NULL, 0) : 0;
+        uint32_t bpm = (argc > 5) ? (uint32_t)strtoul(argv[5], NULL, 0) : 0;
+        return Replay_Record(argv[2], (seconds > 0) ? seconds : 1, delay_us, bpm);
+    }
+    if (argc < 2)
+    {
+        fprintf(stderr, "Usage: %s trace.bin [repeat] [samples.csv]\n", argv[0]);
+        fprintf(stderr, "       %s --record trace.bin [seconds] [drain_delay_us] [bpm]\n", argv[0]);
+        return 1;
+    }
+    uint32_t repeat = (argc > 2) ? (uint32_t)strtoul(argv[2], NULL, 0) : 1;
+    if (repeat == 0)
+    {
+        repeat = 1;
+    }
+
+    uint32_t size;
+    uint8_t* trace = Replay_Load(argv[1], &size);
+    if (trace == NULL)
+    {
+        fprintf(stderr, "Cannot read %s\n", argv[1]);
+        return 1;
+    }
+
+    FILE* csv = NULL;
+    if (argc > 3)
+    {
+        csv = fopen(argv[3], "w");
+        if (csv == NULL)
+        {
+            fprintf(stderr, "Cannot write %s\n", argv[3]);
+            free(trace);
+            return 1;
+        }
+        fprintf(csv, "time,slot1,slot2,slot3,slot4\n");
+    }
+
+    MAX30101_Profile_Start();
+    static Replay_State state;
+    uint64_t elapsed = 0;
+    for (uint32_t pass = 0; pass < repeat; pass++)
+    {
+        // Samples are checked and written only once
+        uint32_t start = MAX30101_Profile_Now();
+        Replay_Run(trace, size, &state, (pass == 0) ? csv : NULL);
+        elapsed += MAX30101_Profile_Now() - start;
+        if (pass == 0)
+        {
+            csv = NULL;
+        }
+    }
+
+    const MAX30101_TraceDecoder* decoder = &state.decoder;
+    printf("Trace: %u bytes, %u FIFO records, %u config records, %u invalid\n",
+           size, decoder->fifo_records, decoder->config_records, decoder->invalid);
+    printf("Samples: %llu per pass, %u records with overflow, %u samples lost\n",
+           (unsigned long long)decoder->samples, decoder->overflows, decoder->lost_samples);
+    if (state.interval.count > 0)
+    {
+        printf("Recorded FIFO interval: min %u us, mean %.1f us, max %u us\n", state.interval.min,
+               (double)state.interval.total / state.interval.count, state.interval.max);
+    }
+    if (elapsed > 0)
+    {
+        printf("Replay: %u passes in %.3f ms, %.2f Msamples/s\n", repeat, elapsed / 1e6,
+               (double)decoder->samples * repeat * 1e3 / elapsed);
+    }
+    if (state.read.count > 0)
+    {
+        static const char* path_names[] = {"ReadFIFO", "ReadMultiLEDFIFO", "Fixed_ReadFIFO"};
+        printf("Driver read (%s): %u bursts, mean %.1f ns, max %u ns, %u mismatches\n", path_names[state.path],
+               state.read.count, (double)state.read.total / state.read.count, state.read.max, state.mismatches);
+    }
+
+    int failed = (state.mismatches > 0);
+    if (state.budget_us > 0)
+    {
+        uint8_t ok = (decoder->overflows == 0) && (state.late == 0);
+        printf("Timing: FIFO full in %u us, longest drain interval %u us, %u late drains: %s\n",
+               state.budget_us, (state.interval.count > 0) ? state.interval.max : 0, state.late,
+               ok ? "ok" : "FAILED");
+        failed |= !ok;
+    }
+    else if (decoder->overflows > 0)
+    {
+        printf("Timing: no configuration in the trace, %u records with overflow: FAILED\n", decoder->overflows);
+        failed = 1;
+    }
+
+    free(trace);
+    return failed;
+}
+
+// Read whole trace in memory
+static uint8_t* Replay_Load(const char* path, uint32_t* size)
+{
+    FILE* file = fopen(path, "rb");
+    if (file == NULL)
+    {
+        return NULL;
+    }
+    fseek(file, 0, SEEK_END);
+    long length = ftell(file);
+    fseek(file, 0, SEEK_SET);
+
+    uint8_t* buffer = (length > 0) ? malloc(length) : NULL;
+    if ((buffer != NULL) && (fread(buffer, 1, length, file) != (size_t)length))
+    {
+        free(buffer);
+        buffer = NULL;
+    }
+    fclose(file);
+    *size = (uint32_t)length;
+    return buffer;
+}
+
+// Replay all the records of a trace
+static void Replay_Run(const uint8_t* trace, uint32_t size, Replay_State* state, FILE* csv)
+{
+    MAX30101_TraceDecoder* decoder = &state->decoder;
+    MAX30101_TraceRecord record;
+    MAX30101_TraceBurst burst;
+    uint32_t offset = 0;
+    uint8_t check = (state->read.count == 0);
+
+    MAX30101_TraceDecoder_Init(decoder);
+    MAX30101_Sim_PowerOn();
+    state->last_fifo_us = 0;
+    state->late = 0;
+    memset(&state->interval, 0, sizeof(state->interval));
+    state->interval.min = UINT32_MAX;
+    if (check)
+    {
+        state->read = state->interval;
+    }
+
+    while (MAX30101_Trace_Next(trace, size, &offset, &record))
+    {
+        if (!MAX30101_TraceDecoder_Feed(decoder, &record, &burst))
+        {
+            // Same configuration on the simulated device
+            if ((record.type == MAX30101_TRACE_CONFIG) && (record.length >= 2) && (record.length >= 2 + record.payload[1]))
+            {
+                MAX30101_WriteRegisters(record.payload[0], record.payload[1], &record.payload[2]);
+            }
+            continue;
+        }
+
+        // Budget from the recorded configuration: FIFO depth over sample rate
+        uint32_t rate = MAX30101_TraceDecoder_SampleRate(decoder);
+        state->budget_us = (decoder->config_records > 0) ? 32000000u / rate : 0;
+        if (decoder->fifo_records > 1)
+        {
+            uint32_t interval = (uint32_t)(burst.time_us - state->last_fifo_us);
+            Replay_Update(&state->interval, interval);
+            if ((state->budget_us > 0) && ((uint64_t)interval * rate > 33000000u))
+            {
+                state->late++;
+            }
+        }
+        state->last_fifo_us = burst.time_us;
+
+        Replay_Burst(state, &burst, check, csv);
+    }
+}
+
+// Load a burst in the simulated FIFO and read it back through the driver
+static void Replay_Burst(Replay_State* state, const MAX30101_TraceBurst* burst, uint8_t check, FILE* csv)
+{
+    static uint32_t values[MAX30101_MAX_SLOTS][MAX30101_TRACE_MAX_SAMPLES];
+    static MAX30101_Data data;
+    static MAX30101_MultiData multi_data;
+    static MAX30101_Fixed_Data fixed_data;
+    uint32_t last[MAX30101_MAX_SLOTS];
+
+    state->path = Replay_Path(burst->active_slots);
+    MAX30101_FlushFIFO();
+    MAX30101_Sim_Load(burst->raw, burst->num_samples);
+
+    uint32_t start = MAX30101_Profile_Now();
+    if (state->path == REPLAY_PATH_FIXED)
+    {
+        MAX30101_Fixed_ReadFIFO(burst->num_samples, &fixed_data);
+    }
+    else if (state->path == REPLAY_PATH_MULTI)
+    {
+        MAX30101_ReadMultiLEDFIFO(burst->num_samples, &multi_data);
+    }
+    else
+    {
+        MAX30101_ReadFIFO(burst->num_samples, burst->active_slots, &data);
+    }
+    Replay_Update(&state->read, MAX30101_Profile_Now() - start);
+
+    if (!check && (csv == NULL))
+    {
+        return;
+    }
+
+    // Reference: the recorded bytes unpacked by the decoder
+    MAX30101_TraceDecoder_Unpack(&state->decoder, burst, values);
+    for (uint8_t slot = 0; slot < burst->active_slots; slot++)
+    {
+        if (state->path == REPLAY_PATH_FIXED)
+        {
+            last[slot] = fixed_data.channel[slot][fixed_data.head];
+        }
+        else if (state->path == REPLAY_PATH_MULTI)
+        {
+            last[slot] = multi_data.slot[slot][multi_data.head];
+        }
+        else
+        {
+            last[slot] = (slot == 0) ? data.red[data.head] : (slot == 1) ? data.IR[data.head] : data.green[data.head];
+        }
+    }
+    uint8_t mismatch = 0;
+    for (uint8_t slot = 0; (slot < burst->active_slots) && (burst->num_samples > 0); slot++)
+    {
+        mismatch |= (last[slot] != values[slot][burst->num_samples - 1]);
+    }
+    state->mismatches += mismatch;
+
+    // All the samples of a burst get the time of the burst
+    for (uint8_t sample = 0; (csv != NULL) && (sample < burst->num_samples); sample++)
+    {
+        fprintf(csv, "%llu", (unsigned long long)burst->time_us);
+        for (uint8_t slot = 0; slot < MAX30101_MAX_SLOTS; slot++)
+        {
+            if (slot < burst->active_slots)
+            {
+                fprintf(csv, ",%u", values[slot][sample]);
+            }
+            else
+            {
+                fprintf(csv, ",");
+            }
+        }
+        fprintf(csv, "\n");
+    }
+}
+
+// Read path of the simulated device configuration, configured first if it does not match the trace
+static uint8_t Replay_Path(uint8_t active_leds)
+{
+    uint8_t leds = 0;
+    MAX30101_GetActiveLeds(&leds);
+    if (leds != active_leds)
+    {
+        // Configuration not in the trace: a mode with the recorded number of channels
+        uint8_t slots[2] = {MAX30101_CONF_SLOTS(MAX30101_SLOT_RED, (active_leds > 1) ? MAX30101_SLOT_IR : MAX30101_SLOT_NONE),
+                            MAX30101_CONF_SLOTS((active_leds > 2) ? MAX30101_SLOT_GREEN : MAX30101_SLOT_NONE,
+                                                (active_leds > 3) ? MAX30101_SLOT_GREEN : MAX30101_SLOT_NONE)};
+        uint8_t mode = (active_leds == 1) ? MAX30101_HR_MODE : (active_leds == 2) ? MAX30101_SPO2_MODE : MAX30101_MULTI_MODE;
+        MAX30101_WriteRegisters(MAX30101_MULTI_LED_1, sizeof(slots), slots);
+        MAX30101_WriteRegisters(MAX30101_MODE_CONF, 1, &mode);
+    }
+
+    // MODE_CONF, SPO2_CONF; MULTI_LED_1, MULTI_LED_2
+    uint8_t conf[2];
+    uint8_t multi_led[2];
+    MAX30101_ReadRegisters(MAX30101_MODE_CONF, sizeof(conf), conf);
+    MAX30101_ReadRegisters(MAX30101_MULTI_LED_1, sizeof(multi_led), multi_led);
+    uint8_t mode = conf[0] & 0x07;
+    if ((mode == MAX30101_FIXED_MODE_CONF) && ((conf[1] & 0x03) == MAX30101_FIXED_PULSEWIDTH) &&
+        ((mode != MAX30101_MULTI_MODE) ||
+         ((multi_led[0] == MAX30101_FIXED_MULTI_LED_1) && (multi_led[1] == MAX30101_FIXED_MULTI_LED_2))))
+    {
+        return REPLAY_PATH_FIXED;
+    }
+    return (mode == MAX30101_MULTI_MODE) ? REPLAY_PATH_MULTI : REPLAY_PATH_FIFO;
+}
+
+// Add a value to the statistics
+static void Replay_Update(MAX30101_StageStats* stats, uint32_t value)
+{
+    stats->count++;
+    stats->total += value;
+    if (value < stats->min)
+    {
+        stats->min = value;
+    }
+    if (value > stats->max)
+    {
+        stats->max = value;
+    }
+}
+
+// Record a trace of the simulated device, drained as in the Library example
+static int Replay_Record(const char* path, uint32_t seconds, uint32_t delay_us, uint32_t bpm)
+{
+    static uint8_t raw_bytes[32*MAX30101_MAX_SLOTS*3];
+    replay_out = fopen(path, "wb");
+    if (replay_out == NULL)
+    {
+        fprintf(stderr, "Cannot write %s\n", path);
+        return 1;
+    }
+
+    // Trace time stamps in ns of simulated time
+    replay_clock_ns = 0;
+    MAX30101_Profile_SetClock(Replay_Clock);
+    MAX30101_Sim_PowerOn();
+    MAX30101_Trace_Start(Replay_Write, 1000);
+    if (bpm > 0)
+    {
+        // Pulse period rounded to whole samples
+        MAX30101_SimLight light = {
+            .led_na = 2000,
+            .pulse_na = 40,
+            .period = (uint16_t)((REPLAY_PPG_RATE * 60 + bpm / 2) / bpm),
+            .ambient_na = 500,
+            .noise_na = 10
+        };
+        MAX30101_Sim_SetLight(&light);
+        printf("PPG light model: pulse at %.1f bpm (%u samples)\n", REPLAY_PPG_RATE * 60.0 / light.period,
+               light.period);
+    }
+
+    MAX30101_Config config = {
+        .int_en_1 = MAX30101_CONF_INT_A_FULL,
+        .fifo_conf = MAX30101_FIXED_FIFO_CONF | MAX30101_CONF_FIFO_ROLLOVER | MAX30101_CONF_FIFO_A_FULL(32),
+        .mode_conf = MAX30101_FIXED_MODE_CONF,
+        .spo2_conf = MAX30101_FIXED_SPO2_CONF,
+        .led_pa = {0x1F, 0x1F, 0x1F, 0x1F},
+        .multi_led = {MAX30101_FIXED_MULTI_LED_1, MAX30101_FIXED_MULTI_LED_2},
+    };
+    int failed = (MAX30101_Boot(&config, NULL) != MAX30101_OK);
+
+    uint32_t bursts = 0;
+    uint8_t pending = 0;
+    uint64_t int_us = 0;
+    for (uint64_t now_us = 0; !failed && (now_us < (uint64_t)seconds * 1000000u); now_us += REPLAY_STEP_US)
+    {
+        MAX30101_Sim_Run(REPLAY_STEP_US);
+        replay_clock_ns += REPLAY_STEP_US * 1000;
+        if (!pending && MAX30101_Sim_IsInterrupt())
+        {
+            pending = 1;
+            int_us = now_us;
+        }
+        if (pending && (now_us - int_us >= delay_us))
+        {
+            uint8_t status = 0;
+            uint8_t num_read;
+            MAX30101_ReadRegister(MAX30101_INT_ST_1, &status);
+            MAX30101_Trace_ReadFIFO(MAX30101_FIXED_LEDS, (status & MAX30101_CONF_INT_A_FULL) != 0, raw_bytes, &num_read);
+            pending = 0;
+            bursts++;
+        }
+    }
+
+    MAX30101_Trace_Stop();
+    MAX30101_Profile_SetClock(NULL);
+    MAX30101_Sim_SetLight(NULL);
+    fclose(replay_out);
+    if (failed)
+    {
+        fprintf(stderr, "Boot failed\n");
+        return 1;
+    }
+    printf("Recorded %u bursts in %u s, drain %u us after the interrupt, %u samples lost\n",
+           bursts, seconds, delay_us, MAX30101_Sim_GetLostSamples());
+    return 0;
+}
+
+// Simulated time, in ns
+static uint32_t Replay_Clock(void)
+{
+    return replay_clock_ns;
+}
+
+// Write trace records to the file
+static void Replay_Write(const uint8_t* data, uint8_t length)
+{
+    fwrite(data, 1, length, replay_out);
+}
+
+/* [] END OF FILE */
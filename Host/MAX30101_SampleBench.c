@@ -0,0 +1,285 @@
+/**
+*   Benchmark of the MAX30101 sample file reader.
+*
+*   Writes a synthetic recording (3 channels at 400 Hz, with a gap every
+*   few minutes as with duty-cycled acquisition), then compares the
+*   memory-mapped reader with plain buffered reads for:
+*   - sequential scan of all the channels;
+*   - random seek to a time and read of the sample at that time.
+*
+*   Usage: max30101_samplebench file.msf [size_mb] [seeks]
+*
+*   The file is written only if it does not exist. Results depend on the
+*   page cache: run once after dropping caches for cold numbers.
+*/
+
+#include "MAX30101_SampleFile.h"
+#include "MAX30101_HostTime.h"
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+/**
+*   \brief Samples per block of the synthetic recording.
+*/
+#define BENCH_BLOCK_SAMPLES 256
+
+/**
+*   \brief Sample rate of the synthetic recording.
+*/
+#define BENCH_SAMPLE_RATE 400
+
+/**
+*   \brief Number of channels of the synthetic recording.
+*/
+#define BENCH_CHANNELS 3
+
+/**
+*   \brief Blocks between two gaps of the synthetic recording.
+*/
+#define BENCH_GAP_BLOCKS 100
+
+static int Bench_Generate(const char* path, uint64_t size_mb);
+
+static uint64_t Bench_ScanMapped(const MAX30101_SampleFile* file);
+
+static uint64_t Bench_ScanBuffered(const char* path, uint64_t* bytes);
+
+static int Bench_SeekBuffered(FILE* stream, uint64_t time_us, uint32_t* value);
+
+int main(int argc, char** argv)
+{
+    if (argc < 2)
+    {
+        fprintf(stderr, "Usage: %s file.msf [size_mb] [seeks]\n", argv[0]);
+        return 1;
+    }
+    uint64_t size_mb = (argc > 2) ? strtoull(argv[2], NULL, 0) : 1024;
+    uint32_t seeks = (argc > 3) ? (uint32_t)strtoul(argv[3], NULL, 0) : 100000;
+
+    if ((access(argv[1], F_OK) != 0) && (Bench_Generate(argv[1], size_mb) != MAX30101_SAMPLEFILE_OK))
+    {
+        fprintf(stderr, "Cannot write %s\n", argv[1]);
+        return 1;
+    }
+
+    // Open and index
+    MAX30101_SampleFile file;
+    uint64_t start = MAX30101_HostTime_Now();
+    if (MAX30101_SampleFile_Open(&file, argv[1]) != MAX30101_SAMPLEFILE_OK)
+    {
+        fprintf(stderr, "Cannot open %s\n", argv[1]);
+        return 1;
+    }
+    uint64_t open_ns = MAX30101_HostTime_Now() - start;
+    printf("File: %.1f MB, %llu blocks, %llu samples x %u channels\n", file.size / 1e6,
+           (unsigned long long)file.blocks, (unsigned long long)file.samples, file.channels);
+    printf("Open + index: %.1f ms, %llu index entries (%llu bytes)\n", open_ns / 1e6,
+           (unsigned long long)file.index_entries,
+           (unsigned long long)(file.index_entries * sizeof(MAX30101_SampleIndexEntry)));
+
+    // Sequential scan
+    start = MAX30101_HostTime_Now();
+    uint64_t sum_mapped = Bench_ScanMapped(&file);
+    uint64_t mapped_ns = MAX30101_HostTime_Now() - start;
+    uint64_t bytes;
+    start = MAX30101_HostTime_Now();
+    uint64_t sum_buffered = Bench_ScanBuffered(argv[1], &bytes);
+    uint64_t buffered_ns = MAX30101_HostTime_Now() - start;
+    printf("Scan mmap:     %8.1f MB/s (checksum %llu)\n", file.size * 1e3 / mapped_ns,
+           (unsigned long long)sum_mapped);
+    printf("Scan buffered: %8.1f MB/s (checksum %llu)\n", bytes * 1e3 / buffered_ns,
+           (unsigned long long)sum_buffered);
+
+    // Random seeks over the whole recording
+    MAX30101_SampleBlock last;
+    uint32_t sample;
+    MAX30101_SampleFile_Seek(&file, file.index[file.index_entries - 1].time_us, &last, &sample);
+    while (MAX30101_SampleFile_Next(&file, &last) == MAX30101_SAMPLEFILE_OK)
+    {
+    }
+    uint64_t end_us = last.time_us + (uint64_t)last.num_samples * 1000000u / file.sample_rate_hz;
+    srand(1);
+    uint64_t max_ns = 0;
+    uint64_t total_ns = 0;
+    uint64_t check = 0;
+    for (uint32_t i = 0; i < seeks; i++)
+    {
+        uint64_t time_us = ((uint64_t)rand() * RAND_MAX + rand()) % end_us;
+        MAX30101_SampleBlock block;
+        start = MAX30101_HostTime_Now();
+        if (MAX30101_SampleFile_Seek(&file, time_us, &block, &sample) == MAX30101_SAMPLEFILE_OK)
+        {
+            check += block.channel[0][sample];
+        }
+        uint64_t elapsed = MAX30101_HostTime_Now() - start;
+        total_ns += elapsed;
+        max_ns = (elapsed > max_ns) ? elapsed : max_ns;
+    }
+    printf("Seek mmap + index: mean %8.0f ns, max %8llu ns (%u seeks, checksum %llu)\n",
+           (double)total_ns / seeks, (unsigned long long)max_ns, seeks, (unsigned long long)check);
+
+    // Buffered seeks scan block headers from the beginning: run fewer of them
+    uint32_t slow_seeks = (seeks > 20) ? 20 : seeks;
+    FILE* stream = fopen(argv[1], "rb");
+    srand(1);
+    max_ns = 0;
+    total_ns = 0;
+    check = 0;
+    for (uint32_t i = 0; (stream != NULL) && (i < slow_seeks); i++)
+    {
+        uint64_t time_us = ((uint64_t)rand() * RAND_MAX + rand()) % end_us;
+        uint32_t value;
+        start = MAX30101_HostTime_Now();
+        if (Bench_SeekBuffered(stream, time_us, &value) == MAX30101_SAMPLEFILE_OK)
+        {
+            check += value;
+        }
+        uint64_t elapsed = MAX30101_HostTime_Now() - start;
+        total_ns += elapsed;
+        max_ns = (elapsed > max_ns) ? elapsed : max_ns;
+    }
+    if (stream != NULL)
+    {
+        fclose(stream);
+    }
+    printf("Seek buffered:     mean %8.0f ns, max %8llu ns (%u seeks, checksum %llu)\n",
+           (double)total_ns / slow_seeks, (unsigned long long)max_ns, slow_seeks, (unsigned long long)check);
+
+    MAX30101_SampleFile_Close(&file);
+    return 0;
+}
+
+// Write synthetic recording
+static int Bench_Generate(const char* path, uint64_t size_mb)
+{
+    static uint32_t data[BENCH_CHANNELS][BENCH_BLOCK_SAMPLES];
+    const uint32_t* channel[BENCH_CHANNELS] = {data[0], data[1], data[2]};
+    uint64_t block_bytes = MAX30101_SAMPLEFILE_BLOCK_HEADER_SIZE + BENCH_BLOCK_SAMPLES * BENCH_CHANNELS * 4;
+    uint64_t blocks = size_mb * 1000000u / block_bytes;
+    uint64_t block_us = (uint64_t)BENCH_BLOCK_SAMPLES * 1000000u / BENCH_SAMPLE_RATE;
+
+    MAX30101_SampleWriter writer;
+    int error = MAX30101_SampleFile_Create(&writer, path, BENCH_CHANNELS, BENCH_SAMPLE_RATE, BENCH_BLOCK_SAMPLES);
+    uint64_t time_us = 0;
+    uint32_t n = 0;
+    for (uint64_t b = 0; (b < blocks) && (error == MAX30101_SAMPLEFILE_OK); b++)
+    {
+        for (uint32_t i = 0; i < BENCH_BLOCK_SAMPLES; i++, n++)
+        {
+            // Slow baseline plus a pulse every 320 samples (75 BPM)
+            uint32_t pulse = ((n % 320) < 40) ? (n % 320) * 100 : 0;
+            data[0][i] = 100000 + (n / 4000) % 1000 + pulse;
+            data[1][i] = 120000 + (n / 4000) % 1000 + pulse / 2;
+            data[2][i] = 20000 + pulse / 4;
+        }
+        error = MAX30101_SampleFile_Write(&writer, time_us, channel, BENCH_BLOCK_SAMPLES);
+        time_us += block_us;
+        if ((b + 1) % BENCH_GAP_BLOCKS == 0)
+        {
+            time_us += 10000000u;
+        }
+    }
+    if (writer.file != NULL)
+    {
+        int finish = MAX30101_SampleFile_Finish(&writer);
+        error = (error == MAX30101_SAMPLEFILE_OK) ? finish : error;
+    }
+    return error;
+}
+
+// Sum all the samples, in place
+static uint64_t Bench_ScanMapped(const MAX30101_SampleFile* file)
+{
+    uint64_t sum = 0;
+    MAX30101_SampleBlock block;
+    int error = MAX30101_SampleFile_First(file, &block);
+    while (error == MAX30101_SAMPLEFILE_OK)
+    {
+        for (uint8_t ch = 0; ch < file->channels; ch++)
+        {
+            const uint32_t* values = block.channel[ch];
+            for (uint32_t i = 0; i < block.num_samples; i++)
+            {
+                sum += values[i];
+            }
+        }
+        error = MAX30101_SampleFile_Next(file, &block);
+    }
+    return sum;
+}
+
+// Sum all the samples, reading each block in a buffer
+static uint64_t Bench_ScanBuffered(const char* path, uint64_t* bytes)
+{
+    uint64_t sum = 0;
+    *bytes = 0;
+    FILE* stream = fopen(path, "rb");
+    if (stream == NULL)
+    {
+        return 0;
+    }
+    uint8_t header[MAX30101_SAMPLEFILE_HEADER_SIZE];
+    if (fread(header, 1, sizeof(header), stream) != sizeof(header))
+    {
+        fclose(stream);
+        return 0;
+    }
+    uint8_t channels = header[6];
+    uint32_t block_samples = header[12] | (header[13] << 8) | (header[14] << 16) | ((uint32_t)header[15] << 24);
+    uint32_t* values = malloc((size_t)block_samples * channels * 4);
+    *bytes = sizeof(header);
+
+    uint8_t block[MAX30101_SAMPLEFILE_BLOCK_HEADER_SIZE];
+    while ((values != NULL) && (fread(block, 1, sizeof(block), stream) == sizeof(block)))
+    {
+        uint32_t num_samples;
+        memcpy(&num_samples, &block[4], 4);
+        if ((num_samples > block_samples) ||
+            (fread(values, 4, (size_t)num_samples * channels, stream) != (size_t)num_samples * channels))
+        {
+            break;
+        }
+        for (uint32_t i = 0; i < num_samples * channels; i++)
+        {
+            sum += values[i];
+        }
+        *bytes += sizeof(block) + (uint64_t)num_samples * channels * 4;
+    }
+    free(values);
+    fclose(stream);
+    return sum;
+}
+
+// Find the sample at a time reading block headers from the beginning
+static int Bench_SeekBuffered(FILE* stream, uint64_t time_us, uint32_t* value)
+{
+    uint8_t header[MAX30101_SAMPLEFILE_HEADER_SIZE];
+    fseek(stream, 0, SEEK_SET);
+    if (fread(header, 1, sizeof(header), stream) != sizeof(header))
+    {
+        return MAX30101_SAMPLEFILE_FORMAT_ERROR;
+    }
+    uint8_t channels = header[6];
+    uint32_t sample_rate;
+    memcpy(&sample_rate, &header[8], 4);
+
+    uint8_t block[MAX30101_SAMPLEFILE_BLOCK_HEADER_SIZE];
+    while (fread(block, 1, sizeof(block), stream) == sizeof(block))
+    {
+        uint32_t num_samples;
+        uint64_t block_us;
+        memcpy(&num_samples, &block[4], 4);
+        memcpy(&block_us, &block[8], 8);
+        uint64_t index = (time_us >= block_us) ? (time_us - block_us) * sample_rate / 1000000u : 0;
+        if (index < num_samples)
+        {
+            fseek(stream, (long)index * 4, SEEK_CUR);
+            return (fread(value, 4, 1, stream) == 1) ? MAX30101_SAMPLEFILE_OK : MAX30101_SAMPLEFILE_FORMAT_ERROR;
+        }
+        fseek(stream, (long)num_samples * channels * 4, SEEK_CUR);
+    }
+    return MAX30101_SAMPLEFILE_END;
+}
+
+/* [] END OF FILE */
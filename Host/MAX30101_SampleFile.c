@@ -0,0 +1,278 @@
+/**
+*   Source file for the host-side MAX30101 sample files.
+*
+*   Values are accessed in place in the mapped file, so the host must be
+*   little endian (x86, ARM).
+*/
+
+#include "MAX30101_SampleFile.h"
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+//==============================================
+//          FUNCTION PROTOTYPES
+//==============================================
+
+static int MAX30101_SampleFile_ReadBlock(const MAX30101_SampleFile* file, uint64_t offset,
+                                         MAX30101_SampleBlock* block);
+
+static uint64_t MAX30101_SampleFile_Get(const uint8_t* p, uint8_t bytes);
+
+static void MAX30101_SampleFile_Put(uint8_t* p, uint64_t value, uint8_t bytes);
+
+// Map file and build sparse index
+int MAX30101_SampleFile_Open(MAX30101_SampleFile* file, const char* path)
+{
+    memset(file, 0, sizeof(*file));
+
+    int fd = open(path, O_RDONLY);
+    if (fd < 0)
+    {
+        return MAX30101_SAMPLEFILE_IO_ERROR;
+    }
+    struct stat st;
+    if ((fstat(fd, &st) != 0) || (st.st_size < MAX30101_SAMPLEFILE_HEADER_SIZE))
+    {
+        close(fd);
+        return MAX30101_SAMPLEFILE_FORMAT_ERROR;
+    }
+    void* map = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED)
+    {
+        return MAX30101_SAMPLEFILE_IO_ERROR;
+    }
+    file->map = map;
+    file->size = st.st_size;
+
+    const uint8_t* header = file->map;
+    file->channels = header[6];
+    file->sample_rate_hz = (uint32_t)MAX30101_SampleFile_Get(&header[8], 4);
+    file->block_samples = (uint32_t)MAX30101_SampleFile_Get(&header[12], 4);
+    if ((memcmp(header, "MXSF", 4) != 0) ||
+        (MAX30101_SampleFile_Get(&header[4], 2) != MAX30101_SAMPLEFILE_VERSION) ||
+        (file->channels == 0) || (file->channels > MAX30101_SAMPLEFILE_MAX_CHANNELS) ||
+        (file->sample_rate_hz == 0) || (file->block_samples == 0))
+    {
+        MAX30101_SampleFile_Close(file);
+        return MAX30101_SAMPLEFILE_FORMAT_ERROR;
+    }
+
+    // Walk block headers once, keeping one block out of INDEX_STRIDE
+    uint64_t capacity = 1024;
+    file->index = malloc(capacity * sizeof(MAX30101_SampleIndexEntry));
+    MAX30101_SampleBlock block;
+    uint64_t offset = MAX30101_SAMPLEFILE_HEADER_SIZE;
+    while ((file->index != NULL) && (MAX30101_SampleFile_ReadBlock(file, offset, &block) == MAX30101_SAMPLEFILE_OK))
+    {
+        if (file->blocks % MAX30101_SAMPLEFILE_INDEX_STRIDE == 0)
+        {
+            if (file->index_entries == capacity)
+            {
+                capacity *= 2;
+                MAX30101_SampleIndexEntry* index = realloc(file->index, capacity * sizeof(MAX30101_SampleIndexEntry));
+                if (index == NULL)
+                {
+                    break;
+                }
+                file->index = index;
+            }
+            file->index[file->index_entries].time_us = block.time_us;
+            file->index[file->index_entries].offset = offset;
+            file->index_entries++;
+        }
+        file->blocks++;
+        file->samples += block.num_samples;
+        offset += MAX30101_SAMPLEFILE_BLOCK_HEADER_SIZE + (uint64_t)block.num_samples * file->channels * 4;
+    }
+    if ((file->index == NULL) || (offset != file->size))
+    {
+        // Out of memory, or truncated or corrupted block
+        MAX30101_SampleFile_Close(file);
+        return MAX30101_SAMPLEFILE_FORMAT_ERROR;
+    }
+    return MAX30101_SAMPLEFILE_OK;
+}
+
+// Unmap file
+void MAX30101_SampleFile_Close(MAX30101_SampleFile* file)
+{
+    if (file->map != NULL)
+    {
+        munmap((void*)file->map, file->size);
+    }
+    free(file->index);
+    memset(file, 0, sizeof(*file));
+}
+
+// Find block containing a given time
+int MAX30101_SampleFile_Seek(const MAX30101_SampleFile* file, uint64_t time_us,
+                             MAX30101_SampleBlock* block, uint32_t* sample)
+{
+    if (file->index_entries == 0)
+    {
+        return MAX30101_SAMPLEFILE_END;
+    }
+
+    // Last index entry not after time_us
+    uint64_t low = 0;
+    uint64_t high = file->index_entries;
+    while (high - low > 1)
+    {
+        uint64_t mid = low + (high - low) / 2;
+        if (file->index[mid].time_us <= time_us)
+        {
+            low = mid;
+        }
+        else
+        {
+            high = mid;
+        }
+    }
+
+    int error = MAX30101_SampleFile_ReadBlock(file, file->index[low].offset, block);
+    while (error == MAX30101_SAMPLEFILE_OK)
+    {
+        if (time_us < block->time_us)
+        {
+            // In a gap before this block
+            *sample = 0;
+            return MAX30101_SAMPLEFILE_OK;
+        }
+        uint64_t index = (time_us - block->time_us) * file->sample_rate_hz / 1000000u;
+        if (index < block->num_samples)
+        {
+            *sample = (uint32_t)index;
+            return MAX30101_SAMPLEFILE_OK;
+        }
+        error = MAX30101_SampleFile_Next(file, block);
+    }
+    return error;
+}
+
+// Get first block
+int MAX30101_SampleFile_First(const MAX30101_SampleFile* file, MAX30101_SampleBlock* block)
+{
+    return MAX30101_SampleFile_ReadBlock(file, MAX30101_SAMPLEFILE_HEADER_SIZE, block);
+}
+
+// Get next block
+int MAX30101_SampleFile_Next(const MAX30101_SampleFile* file, MAX30101_SampleBlock* block)
+{
+    uint64_t offset = block->offset + MAX30101_SAMPLEFILE_BLOCK_HEADER_SIZE +
+                      (uint64_t)block->num_samples * file->channels * 4;
+    return MAX30101_SampleFile_ReadBlock(file, offset, block);
+}
+
+// Create file and write header
+int MAX30101_SampleFile_Create(MAX30101_SampleWriter* writer, const char* path, uint8_t channels,
+                               uint32_t sample_rate_hz, uint32_t block_samples)
+{
+    writer->channels = channels;
+    writer->block_samples = block_samples;
+    writer->file = fopen(path, "wb");
+    if (writer->file == NULL)
+    {
+        return MAX30101_SAMPLEFILE_IO_ERROR;
+    }
+
+    uint8_t header[MAX30101_SAMPLEFILE_HEADER_SIZE] = {'M', 'X', 'S', 'F'};
+    MAX30101_SampleFile_Put(&header[4], MAX30101_SAMPLEFILE_VERSION, 2);
+    header[6] = channels;
+    MAX30101_SampleFile_Put(&header[8], sample_rate_hz, 4);
+    MAX30101_SampleFile_Put(&header[12], block_samples, 4);
+    if (fwrite(header, 1, sizeof(header), writer->file) != sizeof(header))
+    {
+        return MAX30101_SAMPLEFILE_IO_ERROR;
+    }
+    return MAX30101_SAMPLEFILE_OK;
+}
+
+// Append a block
+int MAX30101_SampleFile_Write(MAX30101_SampleWriter* writer, uint64_t time_us,
+                              const uint32_t* const* channel, uint32_t num_samples)
+{
+    if ((num_samples == 0) || (num_samples > writer->block_samples))
+    {
+        return MAX30101_SAMPLEFILE_IO_ERROR;
+    }
+
+    uint8_t header[MAX30101_SAMPLEFILE_BLOCK_HEADER_SIZE];
+    MAX30101_SampleFile_Put(&header[0], MAX30101_SAMPLEFILE_BLOCK_MAGIC, 4);
+    MAX30101_SampleFile_Put(&header[4], num_samples, 4);
+    MAX30101_SampleFile_Put(&header[8], time_us, 8);
+    if (fwrite(header, 1, sizeof(header), writer->file) != sizeof(header))
+    {
+        return MAX30101_SAMPLEFILE_IO_ERROR;
+    }
+    for (uint8_t ch = 0; ch < writer->channels; ch++)
+    {
+        if (fwrite(channel[ch], 4, num_samples, writer->file) != num_samples)
+        {
+            return MAX30101_SAMPLEFILE_IO_ERROR;
+        }
+    }
+    return MAX30101_SAMPLEFILE_OK;
+}
+
+// Close file being written
+int MAX30101_SampleFile_Finish(MAX30101_SampleWriter* writer)
+{
+    int error = (fclose(writer->file) == 0) ? MAX30101_SAMPLEFILE_OK : MAX30101_SAMPLEFILE_IO_ERROR;
+    writer->file = NULL;
+    return error;
+}
+
+// Decode block header at given offset
+static int MAX30101_SampleFile_ReadBlock(const MAX30101_SampleFile* file, uint64_t offset,
+                                         MAX30101_SampleBlock* block)
+{
+    if (offset + MAX30101_SAMPLEFILE_BLOCK_HEADER_SIZE > file->size)
+    {
+        return MAX30101_SAMPLEFILE_END;
+    }
+    const uint8_t* p = &file->map[offset];
+    uint32_t num_samples = (uint32_t)MAX30101_SampleFile_Get(&p[4], 4);
+    if ((MAX30101_SampleFile_Get(p, 4) != MAX30101_SAMPLEFILE_BLOCK_MAGIC) ||
+        (num_samples == 0) || (num_samples > file->block_samples) ||
+        (offset + MAX30101_SAMPLEFILE_BLOCK_HEADER_SIZE + (uint64_t)num_samples * file->channels * 4 > file->size))
+    {
+        return MAX30101_SAMPLEFILE_FORMAT_ERROR;
+    }
+
+    block->offset = offset;
+    block->num_samples = num_samples;
+    block->time_us = MAX30101_SampleFile_Get(&p[8], 8);
+    const uint32_t* data = (const uint32_t*)&p[MAX30101_SAMPLEFILE_BLOCK_HEADER_SIZE];
+    for (uint8_t ch = 0; ch < MAX30101_SAMPLEFILE_MAX_CHANNELS; ch++)
+    {
+        block->channel[ch] = (ch < file->channels) ? &data[ch * num_samples] : NULL;
+    }
+    return MAX30101_SAMPLEFILE_OK;
+}
+
+// Read a little endian value
+static uint64_t MAX30101_SampleFile_Get(const uint8_t* p, uint8_t bytes)
+{
+    uint64_t value = 0;
+    for (uint8_t i = 0; i < bytes; i++)
+    {
+        value |= (uint64_t)p[i] << (8 * i);
+    }
+    return value;
+}
+
+// Write a little endian value
+static void MAX30101_SampleFile_Put(uint8_t* p, uint64_t value, uint8_t bytes)
+{
+    for (uint8_t i = 0; i < bytes; i++)
+    {
+        p[i] = (uint8_t)(value >> (8 * i));
+    }
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,213 @@
+/**
+*   \file MAX30101_SampleFile.h
+*
+*   \brief Host-side reader and writer of MAX30101 sample files.
+*
+*   A sample file stores the channels of a recording (e.g., red, IR and
+*   green of #MAX30101_Data) as a sequence of blocks. Each block starts
+*   with the time stamp of its first sample and holds its samples one
+*   channel after the other, so that each channel of a block is a
+*   contiguous array of uint32_t. Blocks start a new time base, so gaps
+*   in the recording (e.g., duty cycling) are kept.
+*
+*   The reader memory-maps the file: channels are accessed in place,
+*   without copies. When the file is opened, a sparse index with the time
+*   of one block every #MAX30101_SAMPLEFILE_INDEX_STRIDE blocks is built,
+*   so that a seek is a binary search in the index followed by a short
+*   scan of at most #MAX30101_SAMPLEFILE_INDEX_STRIDE block headers.
+*
+*   File layout, multi-byte fields little endian:
+*   - header (#MAX30101_SAMPLEFILE_HEADER_SIZE bytes): magic "MXSF",
+*     version (2 bytes), number of channels, reserved byte, sample rate
+*     in Hz (4 bytes), maximum samples per block (4 bytes), reserved
+*     bytes up to the header size;
+*   - blocks: block magic (4 bytes), number of samples n (4 bytes),
+*     time of the first sample in us (8 bytes), then n values for each
+*     channel (4 bytes each).
+*/
+
+#ifndef __MAX30101_SAMPLEFILE_H__
+    #define __MAX30101_SAMPLEFILE_H__
+
+    #include <stdint.h>
+    #include <stdio.h>
+
+    /**
+    *   \brief Version of the sample file format.
+    */
+    #define MAX30101_SAMPLEFILE_VERSION 1
+
+    /**
+    *   \brief Size of the file header.
+    */
+    #define MAX30101_SAMPLEFILE_HEADER_SIZE 32
+
+    /**
+    *   \brief Size of a block header.
+    */
+    #define MAX30101_SAMPLEFILE_BLOCK_HEADER_SIZE 16
+
+    /**
+    *   \brief Magic number at the beginning of each block ("BLK0").
+    */
+    #define MAX30101_SAMPLEFILE_BLOCK_MAGIC 0x304B4C42u
+
+    /**
+    *   \brief Maximum number of channels.
+    */
+    #define MAX30101_SAMPLEFILE_MAX_CHANNELS 4
+
+    /**
+    *   \brief Number of blocks between two entries of the sparse index.
+    */
+    #define MAX30101_SAMPLEFILE_INDEX_STRIDE 64
+
+    /**
+    *   \brief No error.
+    */
+    #define MAX30101_SAMPLEFILE_OK 0
+
+    /**
+    *   \brief File could not be opened, mapped or written.
+    */
+    #define MAX30101_SAMPLEFILE_IO_ERROR 1
+
+    /**
+    *   \brief File is not a valid sample file.
+    */
+    #define MAX30101_SAMPLEFILE_FORMAT_ERROR 2
+
+    /**
+    *   \brief Requested time is outside the recording.
+    */
+    #define MAX30101_SAMPLEFILE_END 3
+
+    /**
+    *   \brief Entry of the sparse index.
+    */
+    typedef struct
+    {
+        uint64_t time_us;   ///< Time of the first sample of the block.
+        uint64_t offset;    ///< Offset of the block in the file.
+    } MAX30101_SampleIndexEntry;
+
+    /**
+    *   \brief A memory-mapped sample file.
+    */
+    typedef struct
+    {
+        const uint8_t* map;                 ///< Mapped file.
+        uint64_t size;                      ///< Size of the file.
+        uint8_t channels;                   ///< Number of channels.
+        uint32_t sample_rate_hz;            ///< Sample rate.
+        uint32_t block_samples;             ///< Maximum number of samples per block.
+        uint64_t blocks;                    ///< Number of blocks.
+        uint64_t samples;                   ///< Number of samples per channel.
+        MAX30101_SampleIndexEntry* index;   ///< Sparse index.
+        uint64_t index_entries;             ///< Number of entries in the sparse index.
+    } MAX30101_SampleFile;
+
+    /**
+    *   \brief A block of samples, pointing into the mapped file.
+    */
+    typedef struct
+    {
+        uint64_t time_us;                                       ///< Time of the first sample.
+        uint32_t num_samples;                                   ///< Number of samples.
+        const uint32_t* channel[MAX30101_SAMPLEFILE_MAX_CHANNELS]; ///< Samples of each channel.
+        uint64_t offset;                                        ///< Offset of the block in the file.
+    } MAX30101_SampleBlock;
+
+    /**
+    *   \brief Sample file being written.
+    */
+    typedef struct
+    {
+        FILE* file;                 ///< Output file.
+        uint8_t channels;           ///< Number of channels.
+        uint32_t block_samples;     ///< Maximum number of samples per block.
+    } MAX30101_SampleWriter;
+
+    /**
+    *   \brief Map a sample file and build its sparse index.
+    *
+    *   \param[out] file pointer to the sample file.
+    *   \param[in] path path of the file.
+    *   \retval #MAX30101_SAMPLEFILE_OK if no error occurred.
+    *   \retval #MAX30101_SAMPLEFILE_IO_ERROR if the file could not be mapped.
+    *   \retval #MAX30101_SAMPLEFILE_FORMAT_ERROR if the file is not a valid sample file.
+    */
+    int MAX30101_SampleFile_Open(MAX30101_SampleFile* file, const char* path);
+
+    /**
+    *   \brief Unmap a sample file.
+    */
+    void MAX30101_SampleFile_Close(MAX30101_SampleFile* file);
+
+    /**
+    *   \brief Find the block containing a given time.
+    *
+    *   \param[in] file pointer to the sample file.
+    *   \param[in] time_us time to look for, in us.
+    *   \param[out] block block containing time_us, or the first block after it if time_us falls in a gap.
+    *   \param[out] sample index of the sample at time_us within the block.
+    *   \retval #MAX30101_SAMPLEFILE_OK if a block was found.
+    *   \retval #MAX30101_SAMPLEFILE_END if time_us is after the end of the recording.
+    */
+    int MAX30101_SampleFile_Seek(const MAX30101_SampleFile* file, uint64_t time_us,
+                                 MAX30101_SampleBlock* block, uint32_t* sample);
+
+    /**
+    *   \brief Get the first block of the file.
+    *
+    *   \retval #MAX30101_SAMPLEFILE_OK if a block was found.
+    *   \retval #MAX30101_SAMPLEFILE_END if the file is empty.
+    */
+    int MAX30101_SampleFile_First(const MAX30101_SampleFile* file, MAX30101_SampleBlock* block);
+
+    /**
+    *   \brief Move to the block after the given one.
+    *
+    *   \param[in,out] block current block, updated to the next one.
+    *   \retval #MAX30101_SAMPLEFILE_OK if a block was found.
+    *   \retval #MAX30101_SAMPLEFILE_END at the end of the file.
+    */
+    int MAX30101_SampleFile_Next(const MAX30101_SampleFile* file, MAX30101_SampleBlock* block);
+
+    /**
+    *   \brief Create a sample file.
+    *
+    *   \param[out] writer pointer to the writer.
+    *   \param[in] path path of the file.
+    *   \param[in] channels number of channels (up to #MAX30101_SAMPLEFILE_MAX_CHANNELS).
+    *   \param[in] sample_rate_hz sample rate.
+    *   \param[in] block_samples maximum number of samples per block.
+    *   \retval #MAX30101_SAMPLEFILE_OK if no error occurred.
+    *   \retval #MAX30101_SAMPLEFILE_IO_ERROR if the file could not be created.
+    */
+    int MAX30101_SampleFile_Create(MAX30101_SampleWriter* writer, const char* path, uint8_t channels,
+                                   uint32_t sample_rate_hz, uint32_t block_samples);
+
+    /**
+    *   \brief Append a block of samples.
+    *
+    *   \param[in] writer pointer to the writer.
+    *   \param[in] time_us time of the first sample.
+    *   \param[in] channel samples of each channel.
+    *   \param[in] num_samples number of samples, up to the block size of the file.
+    *   \retval #MAX30101_SAMPLEFILE_OK if no error occurred.
+    *   \retval #MAX30101_SAMPLEFILE_IO_ERROR if the block could not be written.
+    */
+    int MAX30101_SampleFile_Write(MAX30101_SampleWriter* writer, uint64_t time_us,
+                                  const uint32_t* const* channel, uint32_t num_samples);
+
+    /**
+    *   \brief Close a sample file being written.
+    *
+    *   \retval #MAX30101_SAMPLEFILE_OK if no error occurred.
+    *   \retval #MAX30101_SAMPLEFILE_IO_ERROR if the file could not be written.
+    */
+    int MAX30101_SampleFile_Finish(MAX30101_SampleWriter* writer);
+
+#endif
+/* [] END OF FILE */
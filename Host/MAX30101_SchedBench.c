@@ -0,0 +1,485 @@
+/**
+*   Simulation of the FIFO drain latency with and without the scheduler.
+*
+*   The simulated MAX30101 (see MAX30101_Sim.h) acquires in the mode of
+*   MAX30101_FixedConfig.h (200 samples/s) with the A_FULL interrupt at
+*   32 samples and FIFO rollover, as the library test project: the FIFO
+*   must be drained within one sample period of the interrupt, or the
+*   oldest samples are overwritten.
+*
+*   Time is virtual, in us: samples are acquired at their time while the
+*   CPU "spends" the modelled cost of each piece of work:
+*   - drain: the I2C transfers of the library calls, at 400 kHz;
+*   - processing: a fixed cost per sample;
+*   - telemetry: one CSV line per sample on a blocking 115200 baud UART;
+*   - housekeeping: a 40 ms job about once per second (e.g., a log flush),
+*     triggered by a timer interrupt, in 2 ms steps;
+*   - report: a 30 lines status report at the same timer interrupt.
+*
+*   Telemetry lines are sent one at a time or, for the blocking load,
+*   all the pending lines in one call (e.g., a single printf of the
+*   report).
+*
+*   Both policies split the work the same way (processing of a burst,
+*   one telemetry line, one housekeeping step):
+*   - in a superloop, the interrupts set flags and each pass of the loop
+*     drains the FIFO if flagged, then runs one step of each pending job;
+*   - with the scheduler (MAX30101_Scheduler.h), the interrupt posts the
+*     drain and each step is an event of its priority.
+*
+*   For each load and policy it reports the drain latency (interrupt to
+*   start of the FIFO read), the drains started after the deadline and
+*   the samples overwritten in the FIFO. Fails if samples are not
+*   accounted for, or if the scheduler misses a deadline with work split
+*   in steps shorter than a sample period.
+*
+*   Usage: max30101_schedbench [seconds]
+*/
+
+#include "MAX30101.h"
+#include "MAX30101_Fixed.h"
+#include "MAX30101_Scheduler.h"
+#include "MAX30101_Sim.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+*   \brief I2C clock used to convert bus usage to time.
+*/
+#define BENCH_I2C_CLOCK_HZ 400000
+
+/**
+*   \brief Sample period of the fixed mode (400 Hz, 2 samples averaged), in us.
+*/
+#define BENCH_SAMPLE_PERIOD_US 5000
+
+/**
+*   \brief Time to drain the FIFO before a sample is overwritten, in us.
+*/
+#define BENCH_DEADLINE_US BENCH_SAMPLE_PERIOD_US
+
+/**
+*   \brief Processing cost per sample, in us.
+*/
+#define BENCH_PROCESS_US 20
+
+/**
+*   \brief Telemetry line ("123456,123456\r\n") on a 115200 baud UART (10 bits per char), in us.
+*/
+#define BENCH_LINE_US (15 * 10 * 1000000 / 115200)
+
+/**
+*   \brief Housekeeping job: period, total cost and cost of a step, in us.
+*
+*   The timer is not synchronised with the sensor oscillator, so the job
+*   starts at any time of the FIFO fill.
+*/
+#define BENCH_HOUSEKEEPING_PERIOD_US 997000
+#define BENCH_HOUSEKEEPING_US 40000
+#define BENCH_HOUSEKEEPING_STEP_US 2000
+
+/**
+*   \brief Work done besides the drain.
+*/
+#define BENCH_LOAD_PROCESS      0x01
+#define BENCH_LOAD_TELEMETRY    0x02
+#define BENCH_LOAD_HOUSEKEEPING 0x04
+#define BENCH_LOAD_REPORT       0x08
+#define BENCH_LOAD_BLOCKING     0x10
+
+/**
+*   \brief Lines of the status report.
+*/
+#define BENCH_REPORT_LINES 30
+
+/**
+*   \brief Results of a run.
+*/
+typedef struct
+{
+    uint32_t drains;        ///< FIFO reads.
+    uint32_t max_latency;   ///< Longest time between interrupt and FIFO read, in us.
+    uint64_t sum_latency;   ///< Sum of the latencies, in us.
+    uint32_t missed;        ///< Drains started after the deadline.
+    uint32_t lost;          ///< Samples overwritten in the FIFO.
+    uint32_t read;          ///< Samples read.
+} Bench_Result;
+
+static const struct
+{
+    const char* name;
+    uint8_t load;
+} bench_loads[] = {
+    {"drain", 0},
+    {"+processing", BENCH_LOAD_PROCESS},
+    {"+telemetry", BENCH_LOAD_PROCESS | BENCH_LOAD_TELEMETRY},
+    {"+housekeeping", BENCH_LOAD_PROCESS | BENCH_LOAD_TELEMETRY | BENCH_LOAD_HOUSEKEEPING},
+    {"+report", BENCH_LOAD_PROCESS | BENCH_LOAD_TELEMETRY | BENCH_LOAD_HOUSEKEEPING | BENCH_LOAD_REPORT},
+    {"blocking tx", BENCH_LOAD_PROCESS | BENCH_LOAD_TELEMETRY | BENCH_LOAD_HOUSEKEEPING | BENCH_LOAD_REPORT |
+                    BENCH_LOAD_BLOCKING},
+};
+
+// Virtual time
+static uint32_t bench_now;
+static uint32_t bench_next_sample;
+static uint32_t bench_next_housekeeping;
+
+// Run settings and state
+static uint8_t bench_scheduled;
+static uint8_t bench_load;
+static uint8_t bench_irq_pin;
+static uint32_t bench_irq_time;
+static volatile uint8_t bench_flag_fifo;
+static volatile uint8_t bench_flag_housekeeping;
+static volatile uint8_t bench_flag_report;
+static uint32_t bench_process;
+static uint32_t bench_lines;
+static uint32_t bench_steps;
+static Bench_Result bench_result;
+static MAX30101_Fixed_Data bench_data;
+
+static void Bench_Run(uint8_t scheduled, uint8_t load, uint32_t duration);
+
+static void Bench_Spend(uint32_t us);
+
+static void Bench_Idle(void);
+
+static uint32_t Bench_GetTime(void);
+
+static void Bench_FIFO_ISR(void);
+
+static void Bench_Timer_ISR(void);
+
+static uint32_t Bench_Drain(void);
+
+static uint32_t Bench_Telemetry(uint32_t lines);
+
+static void Task_Drain(uint32_t arg);
+
+static void Task_Process(uint32_t num_samples);
+
+static void Task_Telemetry(uint32_t lines);
+
+static void Task_Housekeeping(uint32_t steps);
+
+int main(int argc, char** argv)
+{
+    uint32_t seconds = (argc > 1) ? (uint32_t)strtoul(argv[1], NULL, 0) : 60;
+    if ((seconds == 0) || (seconds > 4000))
+    {
+        fprintf(stderr, "Usage: %s [seconds (1-4000)]\n", argv[0]);
+        return 1;
+    }
+
+    printf("%u s at %u samples/s, drain deadline %u us\n", seconds, 1000000 / BENCH_SAMPLE_PERIOD_US,
+           BENCH_DEADLINE_US);
+    printf("%-14s %-10s %7s %10s %10s %7s %7s\n", "Load", "Policy", "Drains", "Max lat.", "Mean lat.",
+           "Missed", "Lost");
+    int failed = 0;
+    for (uint8_t l = 0; l < sizeof(bench_loads) / sizeof(bench_loads[0]); l++)
+    {
+        for (uint8_t scheduled = 0; scheduled < 2; scheduled++)
+        {
+            Bench_Run(scheduled, bench_loads[l].load, seconds * 1000000u);
+            const Bench_Result* r = &bench_result;
+            printf("%-14s %-10s %7u %7u us %7u us %7u %7u\n", bench_loads[l].name,
+                   scheduled ? "scheduler" : "superloop", r->drains, r->max_latency,
+                   r->drains ? (uint32_t)(r->sum_latency / r->drains) : 0, r->missed, r->lost);
+
+            // Every acquired sample is either read, lost or still in the FIFO
+            uint32_t acquired = bench_now / BENCH_SAMPLE_PERIOD_US;
+            if (r->read + r->lost + MAX30101_Sim_GetFIFOCount() != acquired)
+            {
+                fprintf(stderr, "%s: %u samples acquired, %u read, %u lost\n", bench_loads[l].name,
+                        acquired, r->read, r->lost);
+                failed = 1;
+            }
+            if (scheduled)
+            {
+                MAX30101_SchedStats stats;
+                MAX30101_Sched_GetStats(MAX30101_SCHED_DRAIN, &stats);
+                if ((stats.max_latency != r->max_latency) || (stats.missed != r->missed))
+                {
+                    fprintf(stderr, "%s: scheduler statistics differ\n", bench_loads[l].name);
+                    failed = 1;
+                }
+                // Every step is shorter than a sample period, unless telemetry blocks
+                if (!(bench_loads[l].load & BENCH_LOAD_BLOCKING) && (r->missed > 0))
+                {
+                    fprintf(stderr, "%s: scheduler missed %u deadlines\n", bench_loads[l].name, r->missed);
+                    failed = 1;
+                }
+            }
+        }
+    }
+    return failed;
+}
+
+// Simulate a policy with a load
+static void Bench_Run(uint8_t scheduled, uint8_t load, uint32_t duration)
+{
+    MAX30101_Config config = {
+        .int_en_1 = MAX30101_CONF_INT_A_FULL,
+        .fifo_conf = MAX30101_FIXED_FIFO_CONF | MAX30101_CONF_FIFO_ROLLOVER | MAX30101_CONF_FIFO_A_FULL(32),
+        .mode_conf = MAX30101_FIXED_MODE_CONF,
+        .spo2_conf = MAX30101_FIXED_SPO2_CONF,
+        .led_pa = {0x1F, 0x1F, 0x1F, 0x1F},
+        .multi_led = {MAX30101_FIXED_MULTI_LED_1, MAX30101_FIXED_MULTI_LED_2},
+    };
+    MAX30101_Sim_PowerOn();
+    MAX30101_Boot(&config, NULL);
+    MAX30101_FlushFIFO();
+
+    memset(&bench_result, 0, sizeof(bench_result));
+    bench_now = 0;
+    bench_next_sample = BENCH_SAMPLE_PERIOD_US;
+    bench_next_housekeeping = BENCH_HOUSEKEEPING_PERIOD_US;
+    bench_scheduled = scheduled;
+    bench_load = load;
+    bench_irq_pin = MAX30101_Sim_IsInterrupt();
+    bench_flag_fifo = 0;
+    bench_flag_housekeeping = 0;
+    bench_flag_report = 0;
+    bench_process = 0;
+    bench_lines = 0;
+    bench_steps = 0;
+    MAX30101_Sched_Init(Bench_GetTime, Bench_Idle);
+
+    while (bench_now < duration)
+    {
+        if (scheduled)
+        {
+            if (MAX30101_Sched_RunOnce() == 0)
+            {
+                MAX30101_Sched_Idle();
+            }
+            continue;
+        }
+
+        // Superloop: drain if flagged, then one step of each pending job
+        if (bench_flag_fifo)
+        {
+            bench_flag_fifo = 0;
+            uint32_t num_samples = Bench_Drain();
+            if (load & BENCH_LOAD_PROCESS)
+            {
+                bench_process += num_samples;
+            }
+        }
+        if (bench_process > 0)
+        {
+            Bench_Spend(BENCH_PROCESS_US * bench_process);
+            if (load & BENCH_LOAD_TELEMETRY)
+            {
+                bench_lines += bench_process;
+            }
+            bench_process = 0;
+        }
+        if (bench_flag_report)
+        {
+            bench_flag_report = 0;
+            bench_lines += BENCH_REPORT_LINES;
+        }
+        if (bench_lines > 0)
+        {
+            bench_lines -= Bench_Telemetry(bench_lines);
+        }
+        if (bench_flag_housekeeping)
+        {
+            bench_flag_housekeeping = 0;
+            bench_steps += BENCH_HOUSEKEEPING_US / BENCH_HOUSEKEEPING_STEP_US;
+        }
+        if (bench_steps > 0)
+        {
+            Bench_Spend(BENCH_HOUSEKEEPING_STEP_US);
+            bench_steps--;
+        }
+        if (!bench_flag_fifo && !bench_flag_housekeeping && !bench_flag_report && (bench_lines == 0) &&
+            (bench_steps == 0))
+        {
+            Bench_Idle();
+        }
+    }
+    bench_result.lost = MAX30101_Sim_GetLostSamples();
+}
+
+// Advance the virtual time, acquiring samples and raising interrupts on the way
+static void Bench_Spend(uint32_t us)
+{
+    uint32_t end = bench_now + us;
+    for (;;)
+    {
+        uint32_t next = (bench_next_sample < bench_next_housekeeping) ? bench_next_sample : bench_next_housekeeping;
+        if (next > end)
+        {
+            break;
+        }
+        bench_now = next;
+        if (bench_now == bench_next_sample)
+        {
+            MAX30101_Sim_Generate(1);
+            bench_next_sample += BENCH_SAMPLE_PERIOD_US;
+        }
+        if (bench_now == bench_next_housekeeping)
+        {
+            bench_next_housekeeping += BENCH_HOUSEKEEPING_PERIOD_US;
+            if (bench_load & (BENCH_LOAD_HOUSEKEEPING | BENCH_LOAD_REPORT))
+            {
+                Bench_Timer_ISR();
+            }
+        }
+
+        // Falling edge of INT
+        uint8_t pin = MAX30101_Sim_IsInterrupt();
+        if (pin && !bench_irq_pin)
+        {
+            Bench_FIFO_ISR();
+        }
+        bench_irq_pin = pin;
+    }
+    bench_now = end;
+}
+
+// Sleep until the next sample or timer tick
+static void Bench_Idle(void)
+{
+    uint32_t next = (bench_next_sample < bench_next_housekeeping) ? bench_next_sample : bench_next_housekeeping;
+    Bench_Spend(next - bench_now);
+}
+
+// Virtual time
+static uint32_t Bench_GetTime(void)
+{
+    return bench_now;
+}
+
+// A_FULL interrupt
+static void Bench_FIFO_ISR(void)
+{
+    bench_irq_time = bench_now;
+    if (bench_scheduled)
+    {
+        MAX30101_Sched_Post(MAX30101_SCHED_DRAIN, Task_Drain, 0, BENCH_DEADLINE_US);
+    }
+    else
+    {
+        bench_flag_fifo = 1;
+    }
+}
+
+// Housekeeping and report timer interrupt
+static void Bench_Timer_ISR(void)
+{
+    uint8_t housekeeping = (bench_load & BENCH_LOAD_HOUSEKEEPING) != 0;
+    uint8_t report = (bench_load & BENCH_LOAD_REPORT) != 0;
+    if (bench_scheduled)
+    {
+        if (housekeeping)
+        {
+            MAX30101_Sched_Post(MAX30101_SCHED_HOUSEKEEPING, Task_Housekeeping,
+                                BENCH_HOUSEKEEPING_US / BENCH_HOUSEKEEPING_STEP_US, MAX30101_SCHED_NO_DEADLINE);
+        }
+        if (report)
+        {
+            MAX30101_Sched_Post(MAX30101_SCHED_TELEMETRY, Task_Telemetry, BENCH_REPORT_LINES,
+                                MAX30101_SCHED_NO_DEADLINE);
+        }
+    }
+    else
+    {
+        bench_flag_housekeeping = housekeeping;
+        bench_flag_report = report;
+    }
+}
+
+// Read the FIFO as the library test project, spend the bus time
+static uint32_t Bench_Drain(void)
+{
+    uint32_t latency = bench_now - bench_irq_time;
+    bench_result.drains++;
+    bench_result.sum_latency += latency;
+    if (latency > bench_result.max_latency)
+    {
+        bench_result.max_latency = latency;
+    }
+    if (latency > BENCH_DEADLINE_US)
+    {
+        bench_result.missed++;
+    }
+
+    MAX30101_SimStats before, after;
+    MAX30101_Sim_GetStats(&before);
+    uint8_t flag = 0;
+    int num_samples = 0;
+    MAX30101_IsFIFOAFull(&flag);
+    if (flag > 0)
+    {
+        uint8_t rp, ovf, wp;
+        MAX30101_ReadFIFOPointers(&wp, &ovf, &rp);
+        num_samples = wp - rp;
+        if (num_samples <= 0)
+            num_samples += 32; //Wrap condition
+        MAX30101_Fixed_ReadFIFO(num_samples, &bench_data);
+        bench_result.read += num_samples;
+    }
+    MAX30101_Sim_GetStats(&after);
+
+    after.starts -= before.starts;
+    after.stops -= before.stops;
+    after.bytes_written -= before.bytes_written;
+    after.bytes_read -= before.bytes_read;
+    Bench_Spend(MAX30101_Sim_BusTime(&after, BENCH_I2C_CLOCK_HZ));
+    return num_samples;
+}
+
+// Send telemetry lines, one or all of them if blocking, return the lines sent
+static uint32_t Bench_Telemetry(uint32_t lines)
+{
+    uint32_t sent = (bench_load & BENCH_LOAD_BLOCKING) ? lines : 1;
+    Bench_Spend(BENCH_LINE_US * sent);
+    return sent;
+}
+
+// Scheduled drain
+static void Task_Drain(uint32_t arg)
+{
+    (void)arg;
+    uint32_t num_samples = Bench_Drain();
+    if ((num_samples > 0) && (bench_load & BENCH_LOAD_PROCESS))
+    {
+        MAX30101_Sched_Post(MAX30101_SCHED_PROCESS, Task_Process, num_samples, MAX30101_SCHED_NO_DEADLINE);
+    }
+}
+
+// Scheduled processing of a burst
+static void Task_Process(uint32_t num_samples)
+{
+    Bench_Spend(BENCH_PROCESS_US * num_samples);
+    if (bench_load & BENCH_LOAD_TELEMETRY)
+    {
+        MAX30101_Sched_Post(MAX30101_SCHED_TELEMETRY, Task_Telemetry, num_samples, MAX30101_SCHED_NO_DEADLINE);
+    }
+}
+
+// Telemetry lines, then post the next ones
+static void Task_Telemetry(uint32_t lines)
+{
+    lines -= Bench_Telemetry(lines);
+    if (lines > 0)
+    {
+        MAX30101_Sched_Post(MAX30101_SCHED_TELEMETRY, Task_Telemetry, lines, MAX30101_SCHED_NO_DEADLINE);
+    }
+}
+
+// One housekeeping step, then post the next one
+static void Task_Housekeeping(uint32_t steps)
+{
+    Bench_Spend(BENCH_HOUSEKEEPING_STEP_US);
+    if (steps > 1)
+    {
+        MAX30101_Sched_Post(MAX30101_SCHED_HOUSEKEEPING, Task_Housekeeping, steps - 1, MAX30101_SCHED_NO_DEADLINE);
+    }
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,644 @@
+/**
+*   Source file for the simulated MAX30101.
+*/
+
+#include "MAX30101_Sim.h"
+#include "MAX30101_Defs.h"
+#include "MAX30101_Rate.h"
+#include "I2C_Master.h"
+#include <string.h>
+
+//==============================================
+//          MACROS
+//==============================================
+
+/**
+*   \brief Number of samples in the FIFO.
+*/
+#define SIM_FIFO_DEPTH 32
+
+/**
+*   \brief Maximum number of channels in a sample.
+*/
+#define SIM_MAX_CHANNELS 4
+
+/**
+*   \brief Bus state: no transfer, write transfer, read transfer.
+*/
+#define SIM_BUS_IDLE  0
+#define SIM_BUS_WRITE 1
+#define SIM_BUS_READ  2
+
+//==============================================
+//          VARIABLES
+//==============================================
+static uint8_t sim_regs[256];
+static uint8_t sim_fifo[SIM_FIFO_DEPTH][SIM_MAX_CHANNELS*3];
+static uint8_t sim_fifo_count;
+static uint8_t sim_fifo_byte;
+static uint8_t sim_present = 1;
+static uint8_t sim_bus = SIM_BUS_IDLE;
+static uint8_t sim_pointer_set;
+static uint8_t sim_pointer;
+static uint32_t sim_sample_counter;
+static uint32_t sim_lost_samples;
+static uint32_t sim_last[SIM_MAX_CHANNELS];
+static MAX30101_SimLight sim_light;
+static uint8_t sim_light_on;
+static uint32_t sim_last_light;
+static uint32_t sim_noise_state = 1;
+static uint8_t sim_prox;
+static MAX30101_SimLED sim_led;
+
+// Noise factor of each pulse width, sqrt(69 us / pulse width), Q10
+static const uint16_t sim_noise_pw[4] = {1024, 783, 580, 419};
+
+// Noise factor of each sample averaging, 1 / sqrt(samples), Q10
+static const uint16_t sim_noise_avg[8] = {1024, 724, 512, 362, 256, 181, 181, 181};
+static MAX30101_SimStats sim_stats;
+static uint64_t sim_run_time;
+static uint32_t sim_run_conversions;
+
+// Highest ADC sample rate the device reaches for 1 to 4 channels and each pulse width, in samples/s
+static const uint16_t sim_max_rate[SIM_MAX_CHANNELS][4] = {
+    {3200, 1600, 1600, 1000},
+    {1600, 1000, 800, 400},
+    {1000, 400, 400, 200},
+    {800, 400, 400, 200},
+};
+
+//==============================================
+//          FUNCTION PROTOTYPES
+//==============================================
+
+static uint8_t MAX30101_Sim_Channels(void);
+
+static uint8_t MAX30101_Sim_Room(void);
+
+static void MAX30101_Sim_Store(const uint32_t* values, uint8_t channels);
+
+static uint32_t MAX30101_Sim_Convert(uint8_t channel, uint8_t pa);
+
+static void MAX30101_Sim_Proximity(void);
+
+static void MAX30101_Sim_Pulse(uint8_t pa, uint32_t pulses);
+
+static int32_t MAX30101_Sim_Noise(void);
+
+static void MAX30101_Sim_Write(uint8_t reg, uint8_t value);
+
+static uint8_t MAX30101_Sim_Read(uint8_t reg);
+
+static uint8_t MAX30101_Sim_Address(uint8_t address, uint8_t mode);
+
+// Power on device
+void MAX30101_Sim_PowerOn(void)
+{
+    memset(sim_regs, 0, sizeof(sim_regs));
+    sim_regs[MAX30101_INT_ST_1] = 0x01; // PWR_RDY
+    sim_regs[MAX30101_REVISION_ID] = MAX30101_SIM_REVISION_ID;
+    sim_regs[MAX30101_PART_ID] = MAX30101_SIM_PART_ID;
+    sim_fifo_count = 0;
+    sim_fifo_byte = 0;
+    sim_bus = SIM_BUS_IDLE;
+    sim_lost_samples = 0;
+    sim_run_time = 0;
+    sim_run_conversions = 0;
+    sim_prox = 0;
+    memset(&sim_led, 0, sizeof(sim_led));
+}
+
+// Connect or disconnect device
+void MAX30101_Sim_SetPresent(uint8_t present)
+{
+    sim_present = present;
+}
+
+// Push samples in the FIFO
+void MAX30101_Sim_Generate(uint16_t num_samples)
+{
+    uint8_t channels = MAX30101_Sim_Channels();
+    // Unused LSBs are 0 with shorter pulse widths
+    uint32_t mask = 0x3FFFF & ~((1u << (3 - (sim_regs[MAX30101_SPO2_CONF] & 0x03))) - 1);
+    uint8_t avg = (sim_regs[MAX30101_FIFO_CONF] >> MAX30101_SAMPLE_AVG_SHIFT) & 0x07;
+    uint32_t averaged = 1u << ((avg > 5) ? 5 : avg);
+
+    for (uint16_t i = 0; (i < num_samples) && (channels > 0); i++)
+    {
+        if (sim_prox)
+        {
+            // Nothing stored until the proximity threshold is reached
+            MAX30101_Sim_Proximity();
+            sim_sample_counter++;
+            continue;
+        }
+        for (uint8_t ch = 0; ch < channels; ch++)
+        {
+            MAX30101_Sim_Pulse(sim_regs[MAX30101_LED1_PA + ch], averaged);
+        }
+        if (!MAX30101_Sim_Room())
+        {
+            // Sample lost
+            sim_sample_counter++;
+            continue;
+        }
+
+        // Triangle wave with a period of 100 samples, a different offset for each channel
+        uint32_t phase = sim_sample_counter % 100;
+        uint32_t wave = (phase < 50) ? phase : 100 - phase;
+        uint32_t values[SIM_MAX_CHANNELS];
+        for (uint8_t ch = 0; ch < channels; ch++)
+        {
+            uint32_t value = sim_light_on ? MAX30101_Sim_Convert(ch, sim_regs[MAX30101_LED1_PA + ch]) : (60000 + 40000 * ch + 100 * wave + sim_sample_counter % 7);
+            values[ch] = value & mask;
+        }
+        MAX30101_Sim_Store(values, channels);
+        sim_sample_counter++;
+    }
+}
+
+// Push recorded samples in the FIFO
+void MAX30101_Sim_Load(const uint8_t* raw, uint16_t num_samples)
+{
+    uint8_t channels = MAX30101_Sim_Channels();
+    for (uint16_t i = 0; (i < num_samples) && (channels > 0); i++, raw += 3 * channels)
+    {
+        if (!MAX30101_Sim_Room())
+        {
+            continue;
+        }
+        uint32_t values[SIM_MAX_CHANNELS];
+        for (uint8_t ch = 0; ch < channels; ch++)
+        {
+            values[ch] = (((uint32_t)raw[3*ch] << 16) | ((uint32_t)raw[3*ch + 1] << 8) | raw[3*ch + 2]) & 0x3FFFF;
+        }
+        MAX30101_Sim_Store(values, channels);
+    }
+}
+
+// Acquire the samples of an elapsed time
+void MAX30101_Sim_Run(uint32_t us)
+{
+    uint16_t adc_rate = MAX30101_Sim_GetADCRate();
+    if (adc_rate == 0)
+    {
+        return;
+    }
+    // Conversions in the elapsed time (us x samples/s), the rest carried to the next call
+    sim_run_time += (uint64_t)us * adc_rate;
+    uint32_t conversions = (uint32_t)(sim_run_time / 1000000u);
+    sim_run_time -= (uint64_t)conversions * 1000000u;
+    // A sample every averaged conversions
+    uint8_t avg = (sim_regs[MAX30101_FIFO_CONF] >> MAX30101_SAMPLE_AVG_SHIFT) & 0x07;
+    uint32_t averaged = 1u << ((avg > 5) ? 5 : avg);
+    sim_run_conversions += conversions;
+    uint32_t samples = sim_run_conversions / averaged;
+    sim_run_conversions -= samples * averaged;
+    while (samples > 0)
+    {
+        uint16_t chunk = (samples > 0xFFFF) ? 0xFFFF : (uint16_t)samples;
+        MAX30101_Sim_Generate(chunk);
+        samples -= chunk;
+    }
+}
+
+// ADC sample rate reached with the current configuration
+uint16_t MAX30101_Sim_GetADCRate(void)
+{
+    uint8_t channels = MAX30101_Sim_Channels();
+    if (channels == 0)
+    {
+        return 0;
+    }
+    uint8_t pw = sim_regs[MAX30101_SPO2_CONF] & 0x03;
+    uint16_t rate = MAX30101_Rate_SampleRate(sim_regs[MAX30101_SPO2_CONF] >> MAX30101_SAMPLE_RATE_SHIFT);
+    uint16_t max_rate = sim_max_rate[channels - 1][pw];
+    return (rate < max_rate) ? rate : max_rate;
+}
+
+// Set the light on the photodiode
+void MAX30101_Sim_SetLight(const MAX30101_SimLight* light)
+{
+    sim_light_on = (light != NULL);
+    if (light != NULL)
+    {
+        sim_light = *light;
+    }
+}
+
+// Light of the last sample
+uint32_t MAX30101_Sim_GetLastLight(void)
+{
+    return sim_last_light;
+}
+
+// Number of unread samples
+uint8_t MAX30101_Sim_GetFIFOCount(void)
+{
+    return sim_fifo_count;
+}
+
+// Samples overwritten or dropped because the FIFO was full
+uint32_t MAX30101_Sim_GetLostSamples(void)
+{
+    return sim_lost_samples;
+}
+
+// State of the INT pin
+uint8_t MAX30101_Sim_IsInterrupt(void)
+{
+    return ((sim_regs[MAX30101_INT_ST_1] & sim_regs[MAX30101_INT_EN_1]) != 0) ||
+           ((sim_regs[MAX30101_INT_ST_2] & sim_regs[MAX30101_INT_EN_2]) != 0);
+}
+
+// 1 in proximity mode
+uint8_t MAX30101_Sim_IsProximity(void)
+{
+    return sim_prox;
+}
+
+// LED usage
+void MAX30101_Sim_GetLED(MAX30101_SimLED* led)
+{
+    *led = sim_led;
+}
+
+// Last acquired value of a channel
+uint32_t MAX30101_Sim_GetLastSample(uint8_t channel)
+{
+    return (channel < SIM_MAX_CHANNELS) ? sim_last[channel] : 0;
+}
+
+// Get bus usage
+void MAX30101_Sim_GetStats(MAX30101_SimStats* stats)
+{
+    *stats = sim_stats;
+}
+
+// Reset bus usage
+void MAX30101_Sim_ResetStats(void)
+{
+    memset(&sim_stats, 0, sizeof(sim_stats));
+    memset(&sim_led, 0, sizeof(sim_led));
+}
+
+// Time on the bus
+uint32_t MAX30101_Sim_BusTime(const MAX30101_SimStats* stats, uint32_t clock_hz)
+{
+    uint64_t cycles = (uint64_t)stats->starts * 10 + stats->stops +
+                      9 * ((uint64_t)stats->bytes_written + stats->bytes_read);
+    return (uint32_t)(cycles * 1000000u / clock_hz);
+}
+
+//==============================================
+//          I2C_Master FUNCTIONS
+//==============================================
+
+// Start component
+void I2C_Master_Start(void)
+{
+    sim_bus = SIM_BUS_IDLE;
+}
+
+// Stop component
+void I2C_Master_Stop(void)
+{
+    sim_bus = SIM_BUS_IDLE;
+}
+
+// Start condition and address byte
+uint8 I2C_Master_MasterSendStart(uint8 slaveAddress, uint8 R_nW)
+{
+    return MAX30101_Sim_Address(slaveAddress, R_nW);
+}
+
+// Repeated start condition and address byte
+uint8 I2C_Master_MasterSendRestart(uint8 slaveAddress, uint8 R_nW)
+{
+    if (sim_bus == SIM_BUS_IDLE)
+    {
+        return I2C_Master_MSTR_NOT_READY;
+    }
+    return MAX30101_Sim_Address(slaveAddress, R_nW);
+}
+
+// Stop condition
+uint8 I2C_Master_MasterSendStop(void)
+{
+    sim_stats.stops++;
+    sim_bus = SIM_BUS_IDLE;
+    return I2C_Master_MSTR_NO_ERROR;
+}
+
+// Write a byte: register pointer first, then register values
+uint8 I2C_Master_MasterWriteByte(uint8 theByte)
+{
+    if (sim_bus != SIM_BUS_WRITE)
+    {
+        return I2C_Master_MSTR_NOT_READY;
+    }
+    sim_stats.bytes_written++;
+    if (!sim_pointer_set)
+    {
+        sim_pointer = theByte;
+        sim_pointer_set = 1;
+    }
+    else
+    {
+        MAX30101_Sim_Write(sim_pointer, theByte);
+        if (sim_pointer != MAX30101_FIFO_DATA)
+        {
+            sim_pointer++;
+        }
+    }
+    return I2C_Master_MSTR_NO_ERROR;
+}
+
+// Read a byte from the register pointer
+uint8 I2C_Master_MasterReadByte(uint8 acknNak)
+{
+    (void)acknNak;
+    if (sim_bus != SIM_BUS_READ)
+    {
+        return 0xFF;
+    }
+    sim_stats.bytes_read++;
+    uint8_t value = MAX30101_Sim_Read(sim_pointer);
+    if (sim_pointer != MAX30101_FIFO_DATA)
+    {
+        sim_pointer++;
+    }
+    return value;
+}
+
+//==============================================
+//          DEVICE MODEL
+//==============================================
+
+// Address byte of a start or repeated start
+static uint8_t MAX30101_Sim_Address(uint8_t address, uint8_t mode)
+{
+    sim_stats.starts++;
+    if (!sim_present || (address != MAX30101_I2C_ADDRESS))
+    {
+        sim_stats.naks++;
+        sim_bus = SIM_BUS_IDLE;
+        return I2C_Master_MSTR_ERR_LB_NAK;
+    }
+    sim_bus = (mode == I2C_Master_READ_XFER_MODE) ? SIM_BUS_READ : SIM_BUS_WRITE;
+    sim_pointer_set = 0;
+    return I2C_Master_MSTR_NO_ERROR;
+}
+
+// Make room for a sample in a full FIFO: 1 if a sample can be stored
+static uint8_t MAX30101_Sim_Room(void)
+{
+    if (sim_fifo_count < SIM_FIFO_DEPTH)
+    {
+        return 1;
+    }
+    uint8_t* ovf = &sim_regs[MAX30101_FIFO_OVF_CNT];
+    if (*ovf < 0x1F)
+    {
+        *ovf += 1;
+    }
+    sim_lost_samples++;
+    if ((sim_regs[MAX30101_FIFO_CONF] & MAX30101_CONF_FIFO_ROLLOVER) == 0)
+    {
+        return 0;
+    }
+    // Oldest sample overwritten
+    sim_regs[MAX30101_FIFO_RP] = (sim_regs[MAX30101_FIFO_RP] + 1) % SIM_FIFO_DEPTH;
+    sim_fifo_count--;
+    sim_fifo_byte = 0;
+    return 1;
+}
+
+// Store a sample at the write pointer
+static void MAX30101_Sim_Store(const uint32_t* values, uint8_t channels)
+{
+    uint8_t* wp = &sim_regs[MAX30101_FIFO_WP];
+    for (uint8_t ch = 0; ch < channels; ch++)
+    {
+        sim_last[ch] = values[ch];
+        sim_fifo[*wp][3*ch] = (uint8_t)(values[ch] >> 16);
+        sim_fifo[*wp][3*ch + 1] = (uint8_t)(values[ch] >> 8);
+        sim_fifo[*wp][3*ch + 2] = (uint8_t)values[ch];
+    }
+    *wp = (*wp + 1) % SIM_FIFO_DEPTH;
+    sim_fifo_count++;
+
+    // A_FULL when the number of unread samples reaches 32 - FIFO_A_FULL,
+    // not again until the FIFO is read below the threshold
+    sim_regs[MAX30101_INT_ST_1] |= MAX30101_CONF_INT_PPG_RDY;
+    if (sim_fifo_count == SIM_FIFO_DEPTH - (sim_regs[MAX30101_FIFO_CONF] & 0x0F))
+    {
+        sim_regs[MAX30101_INT_ST_1] |= MAX30101_CONF_INT_A_FULL;
+    }
+}
+
+// Number of channels in a FIFO sample
+static uint8_t MAX30101_Sim_Channels(void)
+{
+    uint8_t mode = sim_regs[MAX30101_MODE_CONF];
+    if (mode & 0x80)
+    {
+        // Shutdown
+        return 0;
+    }
+    switch (mode & 0x07)
+    {
+        case MAX30101_HR_MODE:
+            return 1;
+        case MAX30101_SPO2_MODE:
+            return 2;
+        case MAX30101_MULTI_MODE:
+        {
+            uint8_t channels = 0;
+            for (uint8_t slot = 0; slot < SIM_MAX_CHANNELS; slot++)
+            {
+                uint8_t led = (sim_regs[MAX30101_MULTI_LED_1 + slot / 2] >> (4 * (slot % 2))) & 0x07;
+                if ((led >= MAX30101_SLOT_RED) && (led <= MAX30101_SLOT_GREEN))
+                {
+                    channels++;
+                }
+            }
+            return channels;
+        }
+        default:
+            return 0;
+    }
+}
+
+// Convert the light of a channel, with the LED at amplitude pa, with the ADC range
+static uint32_t MAX30101_Sim_Convert(uint8_t channel, uint8_t pa)
+{
+    int64_t light = sim_light.led_na;
+    if (sim_light.na_per_ma > 0)
+    {
+        // 0.2 mA per LSB of the amplitude
+        light = (int64_t)sim_light.na_per_ma * pa / 5;
+    }
+    if (sim_light.period > 0)
+    {
+        // Triangle pulse around the mean
+        uint32_t phase = sim_sample_counter % sim_light.period;
+        uint32_t wave = (phase < sim_light.period / 2) ? phase : sim_light.period - phase;
+        light = light - sim_light.pulse_na / 2 + (int64_t)sim_light.pulse_na * 2 * wave / sim_light.period;
+    }
+    if (sim_light.ambient_na > MAX30101_SIM_ALC_LIMIT_NA)
+    {
+        light += sim_light.ambient_na - MAX30101_SIM_ALC_LIMIT_NA;
+        sim_regs[MAX30101_INT_ST_1] |= MAX30101_CONF_INT_ALC_OVF;
+    }
+    if (sim_light.noise_na > 0)
+    {
+        // Lower with longer pulses and with averaging
+        int64_t noise = (int64_t)sim_light.noise_na * MAX30101_Sim_Noise() *
+                        sim_noise_pw[sim_regs[MAX30101_SPO2_CONF] & 0x03] *
+                        sim_noise_avg[sim_regs[MAX30101_FIFO_CONF] >> MAX30101_SAMPLE_AVG_SHIFT];
+        light += noise / (1 << 30);
+    }
+    if (light < 0)
+    {
+        light = 0;
+    }
+    if (channel == 0)
+    {
+        sim_last_light = (uint32_t)light;
+    }
+
+    // 18 bits over 2048 nA to 16384 nA
+    uint32_t full_scale_na = 2048u << ((sim_regs[MAX30101_SPO2_CONF] >> MAX30101_ADC_RANGE_SHIFT) & 0x03);
+    uint64_t code = ((uint64_t)light << 18) / full_scale_na;
+    return (code > 0x3FFFF) ? 0x3FFFF : (uint32_t)code;
+}
+
+// Pilot conversion in proximity mode, normal mode when the IR level reaches the threshold
+static void MAX30101_Sim_Proximity(void)
+{
+    uint8_t pilot = sim_regs[MAX30101_PILOT_PA];
+    MAX30101_Sim_Pulse(pilot, 1);
+    // Without a light model something is always in front of the sensor
+    uint32_t code = sim_light_on ? MAX30101_Sim_Convert(1, pilot) : 0x3FFFF;
+    // Threshold on the 8 MSBs of the ADC count
+    if ((code >> 10) > sim_regs[MAX30101_PROX_INT_THRESH])
+    {
+        sim_regs[MAX30101_INT_ST_1] |= MAX30101_CONF_INT_PROX;
+        sim_prox = 0;
+    }
+}
+
+// Count LED pulses at amplitude pa
+static void MAX30101_Sim_Pulse(uint8_t pa, uint32_t pulses)
+{
+    if (pa > 0)
+    {
+        uint32_t pw = MAX30101_Rate_PulseWidth(sim_regs[MAX30101_SPO2_CONF] & 0x03);
+        sim_led.pulses += pulses;
+        sim_led.on_us += (uint64_t)pw * pulses;
+        // us x mA = nC, 0.2 mA per LSB
+        sim_led.charge_nc += (uint64_t)pw * pa * pulses / 5;
+    }
+}
+
+// Approximately normal noise of unit variance, Q10: sum of 4 uniform values
+static int32_t MAX30101_Sim_Noise(void)
+{
+    int32_t sum = 0;
+    for (uint8_t i = 0; i < 4; i++)
+    {
+        sim_noise_state = sim_noise_state * 1664525u + 1013904223u;
+        sum += (int32_t)(sim_noise_state >> 22) - 512;
+    }
+    return sum * 1773 / 1024;
+}
+
+// Register write
+static void MAX30101_Sim_Write(uint8_t reg, uint8_t value)
+{
+    switch (reg)
+    {
+        case MAX30101_INT_ST_1:
+        case MAX30101_INT_ST_2:
+        case MAX30101_FIFO_DATA:
+        case MAX30101_TEMP_INT:
+        case MAX30101_TEMP_FRACT:
+        case MAX30101_REVISION_ID:
+        case MAX30101_PART_ID:
+            // Read only
+            break;
+        case MAX30101_MODE_CONF:
+            if (value & 0x40)
+            {
+                // Soft reset, the RESET bit clears immediately
+                uint8_t present = sim_present;
+                MAX30101_Sim_PowerOn();
+                sim_regs[MAX30101_INT_ST_1] = 0x00;
+                sim_present = present;
+            }
+            else
+            {
+                sim_regs[reg] = value;
+                // Proximity mode until the threshold, if its interrupt is enabled
+                sim_prox = ((sim_regs[MAX30101_INT_EN_1] & MAX30101_CONF_INT_PROX) != 0) && ((value & 0x80) == 0);
+            }
+            break;
+        case MAX30101_FIFO_WP:
+        case MAX30101_FIFO_RP:
+            sim_regs[reg] = value & 0x1F;
+            sim_fifo_count = (sim_regs[MAX30101_FIFO_WP] - sim_regs[MAX30101_FIFO_RP]) & 0x1F;
+            sim_fifo_byte = 0;
+            break;
+        case MAX30101_FIFO_OVF_CNT:
+            sim_regs[reg] = value & 0x1F;
+            break;
+        case MAX30101_TEMP_CONF:
+            if (value & 0x01)
+            {
+                // Conversion completes immediately: 25.5 degrees
+                sim_regs[MAX30101_TEMP_INT] = 25;
+                sim_regs[MAX30101_TEMP_FRACT] = 8;
+                sim_regs[MAX30101_INT_ST_2] |= MAX30101_CONF_INT_DIE_TEMP_RDY;
+            }
+            break;
+        default:
+            sim_regs[reg] = value;
+            break;
+    }
+}
+
+// Register read
+static uint8_t MAX30101_Sim_Read(uint8_t reg)
+{
+    uint8_t value = sim_regs[reg];
+    switch (reg)
+    {
+        case MAX30101_INT_ST_1:
+        case MAX30101_INT_ST_2:
+            // Cleared on read
+            sim_regs[reg] = 0x00;
+            break;
+        case MAX30101_FIFO_DATA:
+            if (sim_fifo_count == 0)
+            {
+                // Empty FIFO, pointers do not move
+                return 0x00;
+            }
+            // Reading the FIFO clears PPG_RDY
+            sim_regs[MAX30101_INT_ST_1] &= ~MAX30101_CONF_INT_PPG_RDY;
+            value = sim_fifo[sim_regs[MAX30101_FIFO_RP]][sim_fifo_byte++];
+            if (sim_fifo_byte == 3 * MAX30101_Sim_Channels())
+            {
+                sim_regs[MAX30101_FIFO_RP] = (sim_regs[MAX30101_FIFO_RP] + 1) % SIM_FIFO_DEPTH;
+                sim_fifo_count--;
+                sim_fifo_byte = 0;
+            }
+            break;
+        default:
+            break;
+    }
+    return value;
+}
+
+/* [] END OF FILE */
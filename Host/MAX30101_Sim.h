@@ -0,0 +1,211 @@
+/**
+*   \file MAX30101_Sim.h
+*
+*   \brief Simulated MAX30101 behind the host I2C_Master stand-in.
+*
+*   The simulated device implements the I2C_Master functions used by
+*   I2C_Interface.c and MAX30101.c, so that the library runs unchanged
+*   on the host. It models:
+*   - the register map, with auto-increment of the register pointer
+*     except on #MAX30101_FIFO_DATA;
+*   - soft reset, die temperature conversion and interrupt status
+*     registers cleared on read;
+*   - the 32 samples FIFO, with write/read pointers, overflow counter,
+*     rollover and the A_FULL and PPG_RDY interrupts (PPG_RDY is also
+*     cleared by reading #MAX30101_FIFO_DATA);
+*   - proximity mode: with PROX_INT enabled, writing #MAX30101_MODE_CONF
+*     starts it. Each sample period the IR LED pulses at #MAX30101_PILOT_PA
+*     and nothing is stored, until the 8 MSBs of the IR count exceed
+*     #MAX30101_PROX_INT_THRESH: PROX_INT is set and samples are acquired.
+*
+*   Samples are generated on request with #MAX30101_Sim_Generate, or for
+*   an elapsed time with #MAX30101_Sim_Run, with the number of channels
+*   given by the mode and slot registers and the resolution given by the
+*   pulse width. By default each channel is a
+*   triangle wave; with #MAX30101_Sim_SetLight the samples convert the
+*   light on the photodiode with the ADC range of the SpO2 configuration,
+*   and ambient light beyond the cancellation limit raises ALC_OVF. Every I2C transfer is counted,
+*   so that read paths can be compared by bus usage as well as by CPU time,
+*   and so is every LED pulse (#MAX30101_Sim_GetLED).
+*/
+
+#ifndef __MAX30101_SIM_H__
+    #define __MAX30101_SIM_H__
+
+    #include "cytypes.h"
+
+    /**
+    *   \brief Part ID returned by the simulated device.
+    */
+    #define MAX30101_SIM_PART_ID 0x15
+
+    /**
+    *   \brief Revision ID returned by the simulated device.
+    */
+    #define MAX30101_SIM_REVISION_ID 0x03
+
+    /**
+    *   \brief Largest ambient light cancelled by the ALC, in nA (model parameter).
+    */
+    #ifndef MAX30101_SIM_ALC_LIMIT_NA
+        #define MAX30101_SIM_ALC_LIMIT_NA 20000
+    #endif
+
+    /**
+    *   \brief Light on the photodiode, see #MAX30101_Sim_SetLight.
+    */
+    typedef struct
+    {
+        uint32_t led_na;        ///< LED light reflected by the tissue, mean, in nA.
+        uint32_t pulse_na;      ///< Peak to peak amplitude of the pulse (triangle), in nA.
+        uint16_t period;        ///< Pulse period, in samples.
+        uint32_t ambient_na;    ///< Ambient light, in nA.
+        uint32_t na_per_ma;     ///< If not 0, LED light per mA of the LED of each channel, instead of led_na.
+        uint32_t noise_na;      ///< Noise, rms, in nA, at 69 us without averaging.
+    } MAX30101_SimLight;
+
+    /**
+    *   \brief I2C bus usage since the last #MAX30101_Sim_ResetStats.
+    */
+    typedef struct
+    {
+        uint32_t starts;            ///< Start and repeated start conditions (each followed by the address byte).
+        uint32_t stops;             ///< Stop conditions.
+        uint32_t bytes_written;     ///< Bytes written after the address byte.
+        uint32_t bytes_read;        ///< Bytes read.
+        uint32_t naks;              ///< Transfers not acknowledged by the device.
+    } MAX30101_SimStats;
+
+    /**
+    *   \brief LED usage since the last #MAX30101_Sim_ResetStats.
+    *
+    *   Each averaged conversion pulses the LED of each channel (channel c
+    *   uses #MAX30101_LED1_PA + c), once per sample period in proximity mode.
+    */
+    typedef struct
+    {
+        uint32_t pulses;        ///< LED pulses, at an amplitude other than 0.
+        uint64_t on_us;         ///< Time with an LED on (sum of the pulse widths), in us.
+        uint64_t charge_nc;     ///< Charge through the LEDs, in nC.
+    } MAX30101_SimLED;
+
+    /**
+    *   \brief Power on the device: registers to their reset values, FIFO empty.
+    */
+    void MAX30101_Sim_PowerOn(void);
+
+    /**
+    *   \brief Connect (1) or disconnect (0) the device from the bus.
+    */
+    void MAX30101_Sim_SetPresent(uint8_t present);
+
+    /**
+    *   \brief Acquire samples with the current configuration.
+    *
+    *   Nothing is acquired in shutdown or with no channel enabled.
+    *   \param[in] num_samples number of samples pushed in the FIFO.
+    */
+    void MAX30101_Sim_Generate(uint16_t num_samples);
+
+    /**
+    *   \brief Push recorded samples in the FIFO, e.g., the raw bytes of a trace.
+    *
+    *   Samples are stored as they would be acquired (FIFO pointers,
+    *   overflow and interrupts), with 3 bytes per channel of the current
+    *   configuration. Nothing is stored in shutdown or with no channel enabled.
+    *   \param[in] raw raw FIFO bytes, as read from #MAX30101_FIFO_DATA.
+    *   \param[in] num_samples number of samples in raw.
+    */
+    void MAX30101_Sim_Load(const uint8_t* raw, uint16_t num_samples);
+
+    /**
+    *   \brief Acquire the samples of an elapsed time.
+    *
+    *   The ADC converts at the sample rate of #MAX30101_SPO2_CONF, but not
+    *   faster than the device can with the pulse width and the number of
+    *   channels (model: the allowed settings of the datasheet for 1 and 2
+    *   channels, the same time per channel as 2 channels for 3 and 4). A
+    *   sample is pushed in the FIFO every averaged conversions. Fractions
+    *   of conversions and of samples are carried to the next call.
+    *   \param[in] us elapsed time, in us.
+    */
+    void MAX30101_Sim_Run(uint32_t us);
+
+    /**
+    *   \brief ADC sample rate reached with the current configuration, in samples/s (0 if not acquiring).
+    */
+    uint16_t MAX30101_Sim_GetADCRate(void);
+
+    /**
+    *   \brief Set the light on the photodiode.
+    *
+    *   The LED light is the same for every channel, or proportional to the
+    *   amplitude register of the LED of each channel (channel c uses
+    *   #MAX30101_LED1_PA + c) if na_per_ma is set. Ambient light up to
+    *   #MAX30101_SIM_ALC_LIMIT_NA is cancelled; beyond it, the rest adds to
+    *   the LED light and ALC_OVF is set. Noise decreases as the square root
+    *   of the pulse width and of the averaged samples. The light is
+    *   converted with the full scale of the ADC range (2048 nA to
+    *   16384 nA) and clipped at full scale.
+    *   \param[in] light light model, copied; NULL for the default triangle wave.
+    */
+    void MAX30101_Sim_SetLight(const MAX30101_SimLight* light);
+
+    /**
+    *   \brief Light converted for the first channel of the last acquired sample (LED, uncancelled ambient, noise), in nA.
+    */
+    uint32_t MAX30101_Sim_GetLastLight(void);
+
+    /**
+    *   \brief Number of unread samples in the FIFO.
+    */
+    uint8_t MAX30101_Sim_GetFIFOCount(void);
+
+    /**
+    *   \brief Samples overwritten (rollover) or dropped because the FIFO was full, since power on.
+    */
+    uint32_t MAX30101_Sim_GetLostSamples(void);
+
+    /**
+    *   \brief State of the INT pin: 1 (asserted, low) if an enabled interrupt is pending.
+    */
+    uint8_t MAX30101_Sim_IsInterrupt(void);
+
+    /**
+    *   \brief 1 in proximity mode, 0 otherwise.
+    */
+    uint8_t MAX30101_Sim_IsProximity(void);
+
+    /**
+    *   \brief Get LED usage.
+    */
+    void MAX30101_Sim_GetLED(MAX30101_SimLED* led);
+
+    /**
+    *   \brief Value of a channel of the last acquired sample, as stored in the FIFO.
+    */
+    uint32_t MAX30101_Sim_GetLastSample(uint8_t channel);
+
+    /**
+    *   \brief Get bus usage.
+    */
+    void MAX30101_Sim_GetStats(MAX30101_SimStats* stats);
+
+    /**
+    *   \brief Reset bus usage and LED usage counters.
+    */
+    void MAX30101_Sim_ResetStats(void);
+
+    /**
+    *   \brief Time on the bus for the given usage.
+    *
+    *   Each byte takes 9 clock cycles (8 bits and ACK/NAK), start and stop
+    *   conditions are counted as one cycle.
+    *   \param[in] stats bus usage.
+    *   \param[in] clock_hz I2C clock frequency (e.g., 400000).
+    *   \return time in us.
+    */
+    uint32_t MAX30101_Sim_BusTime(const MAX30101_SimStats* stats, uint32_t clock_hz);
+
+#endif
+/* [] END OF FILE */
@@ -0,0 +1,281 @@
+/**
+*   Register dump: one read per register versus a snapshot in bursts.
+*
+*   The previous MAX30101_LogRegisters read 22 registers one at a time
+*   (a write of the address and a read of one byte each), FIFO_DATA
+*   included, and formatted a line per register. MAX30101_Snapshot reads
+*   the same registers (and PILOT_PA and PROX_INT_THRESH) in a burst per
+*   range of contiguous registers, skipping FIFO_DATA and the interrupt
+*   status registers. Both run on the simulated MAX30101
+*   (see MAX30101_Sim.h); the benchmark reports, per dump, the I2C
+*   transfers, the bytes on the bus and the bus time at 400 kHz, and the
+*   CPU time of this host.
+*
+*   It also checks that the snapshot holds the values of the registers
+*   read one at a time and that, with samples waiting, the samples read
+*   from the FIFO after a dump are the ones acquired: a read of
+*   FIFO_DATA takes a byte of the FIFO, so that the samples that follow
+*   are misaligned, and that the pending interrupts are not cleared by
+*   the snapshot (the drain of the library example waits for A_FULL).
+*   Last, the snapshot is printed, decoded with
+*   MAX30101_SnapshotDecoder.h.
+*
+*   Usage: max30101_snapshotbench [rounds]
+*/
+
+#include "MAX30101.h"
+#include "MAX30101_Defs.h"
+#include "MAX30101_Fixed.h"
+#include "MAX30101_Profile.h"
+#include "MAX30101_Sim.h"
+#include "MAX30101_SnapshotDecoder.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+*   \brief I2C clock used to convert bus usage to time.
+*/
+#define SBENCH_I2C_CLOCK_HZ 400000
+
+/**
+*   \brief Samples in the FIFO before a dump.
+*/
+#define SBENCH_SAMPLES 4
+
+/**
+*   \brief Bytes of a sample.
+*/
+#define SBENCH_SAMPLE_BYTES (3 * MAX30101_FIXED_LEDS)
+
+/**
+*   \brief Proximity threshold written before the snapshot, to be found in it.
+*/
+#define SBENCH_PROX_THRESH 0x5A
+
+/**
+*   \brief A way to dump the registers.
+*/
+typedef struct
+{
+    const char* name;
+    uint8_t (*dump)(void);
+} SBench_Method;
+
+static uint32_t sbench_lines;
+static uint32_t sbench_failures;
+
+static void SBench_Boot(void);
+
+static void SBench_Print(const char* text);
+
+static uint8_t SBench_FIFOIntact(void);
+
+static uint8_t SBench_OldLog(void);
+
+static uint8_t SBench_Snapshot(void);
+
+static uint8_t SBench_Log(void);
+
+static void SBench_Check(uint8_t ok, const char* what);
+
+int main(int argc, char** argv)
+{
+    uint32_t rounds = (argc > 1) ? (uint32_t)strtoul(argv[1], NULL, 0) : 100000;
+    if (rounds == 0)
+    {
+        rounds = 1;
+    }
+    const SBench_Method methods[] = {
+        { "old log", SBench_OldLog },
+        { "snapshot", SBench_Snapshot },
+        { "log", SBench_Log },
+    };
+    MAX30101_Profile_Start();
+
+    printf("Register dump, I2C at %u kHz, %u rounds\n", SBENCH_I2C_CLOCK_HZ / 1000, rounds);
+    printf("%-10s %9s %9s %9s %9s %10s %6s\n", "Method", "Transfers", "Bytes", "Lines", "Bus us", "Host ns",
+           "FIFO");
+    double old_us = 0;
+    double snapshot_us = 0;
+    for (uint8_t m = 0; m < sizeof(methods) / sizeof(methods[0]); m++)
+    {
+        // One dump with samples waiting: bus usage and the FIFO after it
+        MAX30101_SimStats stats;
+        SBench_Boot();
+        MAX30101_Sim_ResetStats();
+        sbench_lines = 0;
+        SBench_Check(methods[m].dump() == MAX30101_OK, methods[m].name);
+        MAX30101_Sim_GetStats(&stats);
+        uint32_t lines = sbench_lines;
+        uint8_t fifo_ok = SBench_FIFOIntact();
+        double bus_us = MAX30101_Sim_BusTime(&stats, SBENCH_I2C_CLOCK_HZ);
+
+        // CPU time, the device being simulated
+        uint32_t start = MAX30101_Profile_Now();
+        for (uint32_t r = 0; r < rounds; r++)
+        {
+            methods[m].dump();
+        }
+        uint64_t host_ns = MAX30101_Profile_Now() - start;
+
+        printf("%-10s %9u %9u %9u %9.1f %10.1f %6s\n", methods[m].name, stats.starts,
+               stats.bytes_written + stats.bytes_read + stats.starts, lines, bus_us, (double)host_ns / rounds,
+               fifo_ok ? "intact" : "moved");
+        if (m == 0)
+        {
+            old_us = bus_us;
+        }
+        else
+        {
+            snapshot_us = bus_us;
+            SBench_Check(fifo_ok, "FIFO intact after the snapshot");
+        }
+    }
+    printf("Bus time: %.1fx shorter\n", old_us / snapshot_us);
+
+    // Snapshot against the registers read one at a time
+    MAX30101_RegSnapshot snapshot;
+    SBench_Boot();
+    MAX30101_SetProximityThreshold(SBENCH_PROX_THRESH);
+    MAX30101_StartTemperatureConversion();
+    MAX30101_Sim_Run(50000);
+    // A_FULL at 17 samples
+    MAX30101_Sim_Generate(17);
+    SBench_Check(MAX30101_Snapshot(&snapshot) == MAX30101_OK, "snapshot");
+    uint8_t pending = 0;
+    MAX30101_ReadRegister(MAX30101_INT_ST_1, &pending);
+    SBench_Check((pending & MAX30101_CONF_INT_A_FULL) != 0, "A_FULL pending after the snapshot");
+    uint8_t reg_addr = MAX30101_FIFO_CONF;
+    do
+    {
+        uint8_t value;
+        uint8_t single;
+        // The status registers are not in the snapshot
+        if (MAX30101_SnapshotValue(&snapshot, reg_addr, &value))
+        {
+            MAX30101_ReadRegister(reg_addr, &single);
+            SBench_Check(value == single, "snapshot value");
+        }
+    } while (++reg_addr != 0);
+    SBench_Check(snapshot.prox[0] == SBENCH_PROX_THRESH, "proximity threshold");
+    SBench_Check(snapshot.id[1] == 0x15, "part ID");
+
+    // Decoded, as received with MAX30101_CMD_SNAPSHOT
+    uint8_t bytes[MAX30101_SNAPSHOT_SIZE];
+    MAX30101_RegSnapshot received;
+    memcpy(bytes, &snapshot, sizeof(bytes));
+    MAX30101_SnapshotDecoder_Load(&received, bytes);
+    printf("\n");
+    MAX30101_SnapshotDecoder_Print(&received, stdout);
+
+    if (sbench_failures > 0)
+    {
+        printf("%u checks FAILED\n", sbench_failures);
+        return 1;
+    }
+    return 0;
+}
+
+// Power on and configure the simulated device, with samples waiting
+static void SBench_Boot(void)
+{
+    MAX30101_Config config = {
+        .int_en_1 = MAX30101_CONF_INT_A_FULL,
+        .int_en_2 = MAX30101_CONF_INT_DIE_TEMP_RDY,
+        .fifo_conf = MAX30101_FIXED_FIFO_CONF | MAX30101_CONF_FIFO_ROLLOVER | MAX30101_CONF_FIFO_A_FULL(17),
+        .mode_conf = MAX30101_FIXED_MODE_CONF,
+        .spo2_conf = MAX30101_FIXED_SPO2_CONF,
+        .led_pa = {0x1F, 0x24, 0x3F, 0x00},
+        .pilot_pa = 0x7F,
+        .multi_led = {MAX30101_FIXED_MULTI_LED_1, MAX30101_FIXED_MULTI_LED_2},
+    };
+    MAX30101_Sim_PowerOn();
+    MAX30101_Boot(&config, NULL);
+    MAX30101_Sim_Generate(SBENCH_SAMPLES);
+}
+
+// Read the samples waiting; 1 if the last one is the last acquired
+static uint8_t SBench_FIFOIntact(void)
+{
+    uint8_t sample[SBENCH_SAMPLE_BYTES];
+    for (uint8_t i = 0; i < SBENCH_SAMPLES; i++)
+    {
+        MAX30101_ReadRegisters(MAX30101_FIFO_DATA, SBENCH_SAMPLE_BYTES, sample);
+    }
+    for (uint8_t c = 0; c < MAX30101_FIXED_LEDS; c++)
+    {
+        uint32_t value = ((uint32_t)sample[3 * c] << 16) | (sample[3 * c + 1] << 8) | sample[3 * c + 2];
+        if ((value & 0x3FFFF) != MAX30101_Sim_GetLastSample(c))
+        {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+// Count the lines, as a UART would send them
+static void SBench_Print(const char* text)
+{
+    sbench_lines += (text[0] != '\0');
+}
+
+// Register dump as done before the snapshot: a read per register
+static uint8_t SBench_OldLog(void)
+{
+    const uint8_t reg_list[] = {MAX30101_INT_ST_1,
+                                MAX30101_INT_ST_2,
+                                MAX30101_INT_EN_1,
+                                MAX30101_INT_EN_2,
+                                MAX30101_FIFO_WP,
+                                MAX30101_FIFO_OVF_CNT,
+                                MAX30101_FIFO_RP,
+                                MAX30101_FIFO_DATA,
+                                MAX30101_FIFO_CONF,
+                                MAX30101_MODE_CONF,
+                                MAX30101_SPO2_CONF,
+                                MAX30101_LED1_PA,
+                                MAX30101_LED2_PA,
+                                MAX30101_LED3_PA,
+                                MAX30101_LED4_PA,
+                                MAX30101_MULTI_LED_1,
+                                MAX30101_MULTI_LED_2,
+                                MAX30101_TEMP_INT,
+                                MAX30101_TEMP_FRACT,
+                                MAX30101_TEMP_CONF,
+                                MAX30101_REVISION_ID,
+                                MAX30101_PART_ID};
+    uint8_t error = MAX30101_OK;
+    for (uint8_t i = 0; i < sizeof(reg_list); i++)
+    {
+        error = MAX30101_PrintRegister(SBench_Print, reg_list[i]);
+        if (error != MAX30101_OK)
+            break;
+    }
+    return error;
+}
+
+// Snapshot only, e.g., for the SNAPSHOT command
+static uint8_t SBench_Snapshot(void)
+{
+    MAX30101_RegSnapshot snapshot;
+    return MAX30101_Snapshot(&snapshot);
+}
+
+// Register dump with the snapshot
+static uint8_t SBench_Log(void)
+{
+    return MAX30101_LogRegisters(SBench_Print);
+}
+
+// Record a check
+static void SBench_Check(uint8_t ok, const char* what)
+{
+    if (!ok)
+    {
+        printf("Check failed: %s\n", what);
+        sbench_failures++;
+    }
+}
+
+/* [] END OF FILE */
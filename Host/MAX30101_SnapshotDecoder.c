@@ -0,0 +1,146 @@
+/**
+*   Source file for the host-side decoding of MAX30101 register snapshots.
+*/
+
+#include "MAX30101_SnapshotDecoder.h"
+#include "MAX30101_Defs.h"
+#include "MAX30101_Rate.h"
+#include <string.h>
+
+static const uint16_t snapshot_adc_range[4] = { 2048, 4096, 8192, 16384 };
+
+static const uint8_t snapshot_adc_bits[4] = { 15, 16, 17, 18 };
+
+static const char* const snapshot_slots[8] = { "none", "red", "IR", "green", "none", "red (pilot)",
+                                               "IR (pilot)", "green (pilot)" };
+
+static void MAX30101_SnapshotDecoder_PrintInterrupts(FILE* out, const char* name, uint8_t first, uint8_t second);
+
+static const char* MAX30101_SnapshotDecoder_Mode(uint8_t mode);
+
+// Read a snapshot from bytes
+void MAX30101_SnapshotDecoder_Load(MAX30101_RegSnapshot* snapshot, const uint8_t* bytes)
+{
+    memcpy(snapshot->status, &bytes[0], sizeof(snapshot->status));
+    memcpy(snapshot->config, &bytes[5], sizeof(snapshot->config));
+    memcpy(snapshot->temp, &bytes[16], sizeof(snapshot->temp));
+    memcpy(snapshot->prox, &bytes[19], sizeof(snapshot->prox));
+    memcpy(snapshot->id, &bytes[20], sizeof(snapshot->id));
+}
+
+// Samples in the FIFO
+uint8_t MAX30101_SnapshotDecoder_FIFOCount(const MAX30101_RegSnapshot* snapshot)
+{
+    uint8_t write_ptr = snapshot->status[MAX30101_FIFO_WP - MAX30101_INT_EN_1] & 0x1F;
+    uint8_t read_ptr = snapshot->status[MAX30101_FIFO_RP - MAX30101_INT_EN_1] & 0x1F;
+    if ((write_ptr == read_ptr) && (snapshot->status[MAX30101_FIFO_OVF_CNT - MAX30101_INT_EN_1] != 0))
+    {
+        // Pointers equal after an overflow: the FIFO is full
+        return 32;
+    }
+    return (write_ptr - read_ptr) & 0x1F;
+}
+
+// Print a snapshot, decoded
+void MAX30101_SnapshotDecoder_Print(const MAX30101_RegSnapshot* snapshot, FILE* out)
+{
+    const uint8_t* status = snapshot->status;
+    const uint8_t* config = snapshot->config;
+    uint8_t fifo_conf = config[MAX30101_FIFO_CONF - MAX30101_FIFO_CONF];
+    uint8_t mode_conf = config[MAX30101_MODE_CONF - MAX30101_FIFO_CONF];
+    uint8_t spo2_conf = config[MAX30101_SPO2_CONF - MAX30101_FIFO_CONF];
+
+    MAX30101_SnapshotDecoder_PrintInterrupts(out, "Enabled", status[MAX30101_INT_EN_1 - MAX30101_INT_EN_1],
+                                             status[MAX30101_INT_EN_2 - MAX30101_INT_EN_1]);
+    fprintf(out, "FIFO:        write %u, read %u, overflows %u, %u samples\n",
+            status[MAX30101_FIFO_WP - MAX30101_INT_EN_1] & 0x1F, status[MAX30101_FIFO_RP - MAX30101_INT_EN_1] & 0x1F,
+            status[MAX30101_FIFO_OVF_CNT - MAX30101_INT_EN_1] & 0x1F,
+            MAX30101_SnapshotDecoder_FIFOCount(snapshot));
+    // Averaging codes above 32 samples also mean 32
+    uint8_t average = (fifo_conf >> MAX30101_SAMPLE_AVG_SHIFT) & 0x07;
+    fprintf(out, "FIFO config: average %u, rollover %s, almost full at %u samples\n", 1u << ((average > 5) ? 5 : average),
+            (fifo_conf & MAX30101_CONF_FIFO_ROLLOVER) ? "on" : "off", 32u - (fifo_conf & 0x0F));
+    fprintf(out, "Mode:        %s%s%s\n", MAX30101_SnapshotDecoder_Mode(mode_conf & 0x07),
+            (mode_conf & 0x80) ? ", shutdown" : "", (mode_conf & 0x40) ? ", reset" : "");
+    fprintf(out, "ADC:         range %u nA, %u samples/s, pulse width %u us (%u bits)\n",
+            snapshot_adc_range[(spo2_conf >> MAX30101_ADC_RANGE_SHIFT) & 0x03],
+            MAX30101_Rate_SampleRate(spo2_conf >> MAX30101_SAMPLE_RATE_SHIFT),
+            MAX30101_Rate_PulseWidth(spo2_conf & 0x03), snapshot_adc_bits[spo2_conf & 0x03]);
+    fprintf(out, "LEDs:       ");
+    for (uint8_t led = 0; led < 4; led++)
+    {
+        uint8_t pa = config[MAX30101_LED1_PA + led - MAX30101_FIFO_CONF];
+        fprintf(out, " %u: %u.%u mA%s", led + 1, (pa * 2) / 10, (pa * 2) % 10, (led < 3) ? "," : "");
+    }
+    uint8_t pilot = config[MAX30101_PILOT_PA - MAX30101_FIFO_CONF];
+    fprintf(out, "\nPilot LED:   %u.%u mA\n", (pilot * 2) / 10, (pilot * 2) % 10);
+    // Threshold on the 8 MSBs of the ADC count
+    fprintf(out, "Proximity:   threshold 0x%02X (ADC count %u)\n", snapshot->prox[0],
+            (uint32_t)snapshot->prox[0] << 10);
+    uint8_t multi_1 = config[MAX30101_MULTI_LED_1 - MAX30101_FIFO_CONF];
+    uint8_t multi_2 = config[MAX30101_MULTI_LED_2 - MAX30101_FIFO_CONF];
+    fprintf(out, "Slots:       %s, %s, %s, %s\n", snapshot_slots[multi_1 & 0x07], snapshot_slots[(multi_1 >> 4) & 0x07],
+            snapshot_slots[multi_2 & 0x07], snapshot_slots[(multi_2 >> 4) & 0x07]);
+    // Integer part in two's complement, fraction in steps of 0.0625 C
+    int32_t temp = (int8_t)snapshot->temp[0] * 10000 + (snapshot->temp[1] & 0x0F) * 625;
+    uint32_t magnitude = (temp < 0) ? (uint32_t)-temp : (uint32_t)temp;
+    fprintf(out, "Temperature: %s%u.%04u C%s\n", (temp < 0) ? "-" : "", magnitude / 10000, magnitude % 10000,
+            (snapshot->temp[2] & 0x01) ? ", conversion running" : "");
+    fprintf(out, "Part ID:     0x%02X (%s), revision 0x%02X\n", snapshot->id[1],
+            (snapshot->id[1] == 0x15) ? "MAX30101" : "unknown", snapshot->id[0]);
+}
+
+// Interrupt flags of INT_EN_1 and INT_EN_2
+static void MAX30101_SnapshotDecoder_PrintInterrupts(FILE* out, const char* name, uint8_t first, uint8_t second)
+{
+    fprintf(out, "%-12s 0x%02X 0x%02X", name, first, second);
+    const char* separator = ": ";
+    if (first & MAX30101_CONF_INT_A_FULL)
+    {
+        fprintf(out, "%sA_FULL", separator);
+        separator = ", ";
+    }
+    if (first & MAX30101_CONF_INT_PPG_RDY)
+    {
+        fprintf(out, "%sPPG_RDY", separator);
+        separator = ", ";
+    }
+    if (first & MAX30101_CONF_INT_ALC_OVF)
+    {
+        fprintf(out, "%sALC_OVF", separator);
+        separator = ", ";
+    }
+    if (first & MAX30101_CONF_INT_PROX)
+    {
+        fprintf(out, "%sPROX", separator);
+        separator = ", ";
+    }
+    if (first & 0x01)
+    {
+        fprintf(out, "%sPWR_RDY", separator);
+        separator = ", ";
+    }
+    if (second & MAX30101_CONF_INT_DIE_TEMP_RDY)
+    {
+        fprintf(out, "%sDIE_TEMP_RDY", separator);
+    }
+    fprintf(out, "\n");
+}
+
+// Name of a mode
+static const char* MAX30101_SnapshotDecoder_Mode(uint8_t mode)
+{
+    switch (mode)
+    {
+        case MAX30101_HR_MODE:
+            return "heart rate (red)";
+        case MAX30101_SPO2_MODE:
+            return "SpO2 (red and IR)";
+        case MAX30101_MULTI_MODE:
+            return "multi-LED";
+        default:
+            return "not valid";
+    }
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,44 @@
+/**
+*   \file MAX30101_SnapshotDecoder.h
+*
+*   \brief Host-side decoding of MAX30101 register snapshots.
+*
+*   A snapshot read with #MAX30101_Snapshot (e.g., received with the
+*   #MAX30101_CMD_SNAPSHOT command) is printed field by field: pending
+*   and enabled interrupts, FIFO pointers and configuration, mode,
+*   ADC range, sample rate, pulse width, LED currents, slots,
+*   proximity threshold, die temperature and IDs.
+*/
+
+#ifndef __MAX30101_SNAPSHOTDECODER_H__
+    #define __MAX30101_SNAPSHOTDECODER_H__
+
+    #include "MAX30101.h"
+    #include <stdio.h>
+
+    /**
+    *   \brief Read a snapshot from bytes.
+    *
+    *   \param[out] snapshot snapshot.
+    *   \param[in] bytes #MAX30101_SNAPSHOT_SIZE bytes, registers in the order of #MAX30101_RegSnapshot.
+    */
+    void MAX30101_SnapshotDecoder_Load(MAX30101_RegSnapshot* snapshot, const uint8_t* bytes);
+
+    /**
+    *   \brief Samples waiting in the FIFO of a snapshot.
+    *
+    *   \param[in] snapshot snapshot.
+    *   \return number of samples, 32 if the FIFO is full.
+    */
+    uint8_t MAX30101_SnapshotDecoder_FIFOCount(const MAX30101_RegSnapshot* snapshot);
+
+    /**
+    *   \brief Print a snapshot, decoded.
+    *
+    *   \param[in] snapshot snapshot.
+    *   \param[in] out output stream.
+    */
+    void MAX30101_SnapshotDecoder_Print(const MAX30101_RegSnapshot* snapshot, FILE* out);
+
+#endif
+/* [] END OF FILE */
@@ -0,0 +1,193 @@
+/**
+*   Benchmark of the sliding window statistics.
+*
+*   For windows of 50 to 2000 samples, feeds synthetic PPG at 200 Hz
+*   (pulse, respiration, noise, and a baseline step halfway) to
+*   MAX30101_Stats.h and reads minimum, maximum, mean and variance after
+*   every sample. The same statistics are recomputed naively over the
+*   last samples (scan for minimum and maximum, two-pass variance in
+*   double) and must match: minimum and maximum exactly, mean and
+*   variance within one least significant bit.
+*
+*   Reports the host time per sample of both, and the worst number of
+*   deque steps taken by a single sample.
+*
+*   Usage: max30101_statsbench [num_samples]
+*/
+
+#include "MAX30101.h"
+#include "MAX30101_Stats.h"
+#include "MAX30101_HostTime.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+/**
+*   \brief Sample rate of the synthetic PPG, in Hz.
+*/
+#define SBENCH_RATE 200
+
+/**
+*   \brief Default number of samples per window size.
+*/
+#define SBENCH_SAMPLES 20000
+
+/**
+*   \brief Longest window benchmarked.
+*/
+#define SBENCH_MAX_WINDOW 2000
+
+#ifndef M_PI
+    #define M_PI 3.14159265358979323846
+#endif
+
+static const uint16_t sbench_windows[] = {50, 100, 200, 500, 1000, 2000};
+
+static MAX30101_STATS_STORAGE(sbench, SBENCH_MAX_WINDOW);
+
+static uint32_t* sbench_signal;
+
+static void SBench_Signal(uint32_t num_samples);
+
+static int SBench_Window(uint16_t window, uint32_t num_samples);
+
+int main(int argc, char** argv)
+{
+    uint32_t num_samples = (argc > 1) ? strtoul(argv[1], NULL, 0) : SBENCH_SAMPLES;
+    if (num_samples < SBENCH_MAX_WINDOW)
+    {
+        num_samples = SBENCH_MAX_WINDOW;
+    }
+    sbench_signal = malloc(num_samples * sizeof(uint32_t));
+    if (sbench_signal == NULL)
+    {
+        return 1;
+    }
+    SBench_Signal(num_samples);
+
+    printf("%u samples, statistics: %u bytes + 8 bytes per sample of the window\n", num_samples,
+           (unsigned)sizeof(MAX30101_Stats));
+    printf("%8s %14s %14s %8s %12s %s\n", "Window", "Naive ns/smp", "Stats ns/smp", "Speedup", "Worst steps",
+           "Result");
+    int failed = 0;
+    for (uint8_t w = 0; w < sizeof(sbench_windows) / sizeof(sbench_windows[0]); w++)
+    {
+        failed |= SBench_Window(sbench_windows[w], num_samples);
+    }
+    free(sbench_signal);
+    return failed;
+}
+
+// Synthetic PPG at 72 bpm
+static void SBench_Signal(uint32_t num_samples)
+{
+    srand(1);
+    for (uint32_t i = 0; i < num_samples; i++)
+    {
+        double t = (double)i / SBENCH_RATE;
+        double phase = 2.0 * M_PI * 1.2 * t;
+        double value = 120000.0 + 600.0 * (sin(phase) + 0.4 * sin(2 * phase + 0.5));
+        value += 2000.0 * sin(2.0 * M_PI * 0.25 * t);
+        value += (rand() % 401) - 200;
+        if (i >= num_samples / 2)
+        {
+            // Contact change
+            value += 30000.0;
+        }
+        sbench_signal[i] = (uint32_t)value & 0x3FFFF;
+    }
+}
+
+// Compare with the naive statistics for a window, return 1 on mismatch
+static int SBench_Window(uint16_t window, uint32_t num_samples)
+{
+    MAX30101_Stats stats;
+    if (MAX30101_Stats_Init(&stats, window, sbench_samples, sbench_queues) != MAX30101_OK)
+    {
+        fprintf(stderr, "Init failed\n");
+        return 1;
+    }
+
+    // Statistics module, all statistics read after every sample
+    volatile uint64_t sink = 0;
+    uint32_t worst_steps = 0;
+    uint64_t start = MAX30101_HostTime_Now();
+    for (uint32_t i = 0; i < num_samples; i++)
+    {
+        MAX30101_Stats_Add(&stats, sbench_signal[i]);
+        sink += MAX30101_Stats_Min(&stats) + MAX30101_Stats_Max(&stats) + MAX30101_Stats_Mean(&stats) +
+                MAX30101_Stats_Variance(&stats);
+    }
+    double stats_ns = (double)(MAX30101_HostTime_Now() - start) / num_samples;
+
+    // Naive recomputation over the window
+    start = MAX30101_HostTime_Now();
+    for (uint32_t i = 0; i < num_samples; i++)
+    {
+        uint32_t first = (i + 1 >= window) ? i + 1 - window : 0;
+        uint32_t min = sbench_signal[first], max = sbench_signal[first];
+        double sum = 0.0;
+        for (uint32_t j = first; j <= i; j++)
+        {
+            uint32_t x = sbench_signal[j];
+            min = (x < min) ? x : min;
+            max = (x > max) ? x : max;
+            sum += x;
+        }
+        double mean = sum / (i + 1 - first);
+        double spread = 0.0;
+        for (uint32_t j = first; j <= i; j++)
+        {
+            spread += (sbench_signal[j] - mean) * (sbench_signal[j] - mean);
+        }
+        sink += min + max + (uint64_t)mean + (uint64_t)(spread / (i + 1 - first));
+    }
+    double naive_ns = (double)(MAX30101_HostTime_Now() - start) / num_samples;
+
+    // Check every sample and count the deque steps
+    int failed = 0;
+    MAX30101_Stats_Reset(&stats);
+    double scale = (double)(1 << MAX30101_STATS_FRAC_BITS);
+    for (uint32_t i = 0; (i < num_samples) && !failed; i++)
+    {
+        uint32_t steps = stats.min_count + stats.max_count;
+        MAX30101_Stats_Add(&stats, sbench_signal[i]);
+        steps = steps + 2 - stats.min_count - stats.max_count;
+        worst_steps = (steps > worst_steps) ? steps : worst_steps;
+
+        uint32_t first = (i + 1 >= window) ? i + 1 - window : 0;
+        uint32_t n = i + 1 - first;
+        uint32_t min = sbench_signal[first], max = sbench_signal[first];
+        double sum = 0.0, spread = 0.0;
+        for (uint32_t j = first; j <= i; j++)
+        {
+            min = (sbench_signal[j] < min) ? sbench_signal[j] : min;
+            max = (sbench_signal[j] > max) ? sbench_signal[j] : max;
+            sum += sbench_signal[j];
+        }
+        double mean = sum / n;
+        for (uint32_t j = first; j <= i; j++)
+        {
+            spread += (sbench_signal[j] - mean) * (sbench_signal[j] - mean);
+        }
+        double variance = spread / n;
+
+        if ((MAX30101_Stats_Min(&stats) != min) || (MAX30101_Stats_Max(&stats) != max) ||
+            (fabs(MAX30101_Stats_Mean(&stats) / scale - mean) > 1.0 / scale) ||
+            (fabs(MAX30101_Stats_Variance(&stats) / scale - variance) > 1.0 / scale))
+        {
+            fprintf(stderr, "Window %u, sample %u: min %u max %u mean %.4f var %.4f, expected %u %u %.4f %.4f\n",
+                    window, i, MAX30101_Stats_Min(&stats), MAX30101_Stats_Max(&stats),
+                    MAX30101_Stats_Mean(&stats) / scale, MAX30101_Stats_Variance(&stats) / scale, min, max, mean,
+                    variance);
+            failed = 1;
+        }
+    }
+
+    printf("%8u %14.1f %14.1f %7.0fx %12u %s\n", window, naive_ns, stats_ns, naive_ns / stats_ns, worst_steps,
+           failed ? "FAILED" : "ok");
+    (void)sink;
+    return failed;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,261 @@
+/**
+*   Benchmark of the sample stream with several consumers.
+*
+*   A producer writes frames of 2 channels (SpO2 mode) in blocks of 32,
+*   as after each FIFO drain, and 1 to 8 consumers read every block:
+*   - broadcast: frames are written once in a MAX30101_Stream.h ring of
+*     64 frames, each consumer reads them in place through its cursor;
+*   - copy: the producer copies each frame in a ring of 64 frames per
+*     consumer, each with its own head and tail.
+*
+*   Each consumer sums the samples it reads, which must match the sum of
+*   the samples written. Reports the host time per frame of the producer
+*   and of the consumers, and the memory of the rings.
+*
+*   Last, a consumer that stops reading must lose exactly the frames
+*   written beyond the ring, and resume with the oldest frame kept.
+*
+*   Usage: max30101_streambench [num_frames]
+*/
+
+#include "MAX30101.h"
+#include "MAX30101_Stream.h"
+#include "MAX30101_HostTime.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+/**
+*   \brief Samples per frame and frames per block.
+*/
+#define TBENCH_CHANNELS 2
+#define TBENCH_BLOCK 32
+
+/**
+*   \brief Frames of each ring.
+*/
+#define TBENCH_FRAMES 64
+
+/**
+*   \brief Default number of frames written.
+*/
+#define TBENCH_NUM_FRAMES 2000000u
+
+/**
+*   \brief Maximum number of consumers benchmarked.
+*/
+#define TBENCH_MAX_CONSUMERS 8
+
+// Ring of a consumer in copy mode
+typedef struct
+{
+    uint32_t samples[TBENCH_FRAMES * TBENCH_CHANNELS];
+    uint32_t head;
+    uint32_t tail;
+} TBench_Ring;
+
+static MAX30101_Stream tbench_stream;
+static MAX30101_STREAM_STORAGE(tbench_ring, TBENCH_FRAMES, TBENCH_CHANNELS);
+static TBench_Ring tbench_copy[TBENCH_MAX_CONSUMERS];
+static uint32_t tbench_block[TBENCH_BLOCK * TBENCH_CHANNELS];
+
+static int TBench_Broadcast(uint8_t num_consumers, uint32_t num_frames, double* producer_ns, double* consumer_ns);
+
+static int TBench_Copy(uint8_t num_consumers, uint32_t num_frames, double* producer_ns, double* consumer_ns);
+
+static int TBench_Overrun(void);
+
+static void TBench_Fill(uint32_t block);
+
+int main(int argc, char** argv)
+{
+    uint32_t num_frames = (argc > 1) ? strtoul(argv[1], NULL, 0) : TBENCH_NUM_FRAMES;
+    num_frames -= num_frames % TBENCH_BLOCK;
+    if (num_frames == 0)
+    {
+        num_frames = TBENCH_NUM_FRAMES;
+    }
+
+    printf("%u frames of %u channels, blocks of %u, rings of %u frames\n", num_frames, TBENCH_CHANNELS,
+           TBENCH_BLOCK, TBENCH_FRAMES);
+    printf("%9s %12s %12s %12s %12s %10s %10s %s\n", "Consumers", "Bcast prod", "Copy prod", "Bcast cons",
+           "Copy cons", "Bcast B", "Copy B", "Result");
+    int failed = 0;
+    for (uint8_t n = 1; n <= TBENCH_MAX_CONSUMERS; n++)
+    {
+        double bcast_prod, bcast_cons, copy_prod, copy_cons;
+        int result = TBench_Broadcast(n, num_frames, &bcast_prod, &bcast_cons);
+        result |= TBench_Copy(n, num_frames, &copy_prod, &copy_cons);
+        unsigned bcast_bytes = (unsigned)(sizeof(MAX30101_Stream) + sizeof(tbench_ring));
+        unsigned copy_bytes = (unsigned)(n * sizeof(TBench_Ring));
+        printf("%9u %9.2f ns %9.2f ns %9.2f ns %9.2f ns %10u %10u %s\n", n, bcast_prod, copy_prod, bcast_cons,
+               copy_cons, bcast_bytes, copy_bytes, result ? "FAILED" : "ok");
+        failed |= result;
+    }
+    printf("Times per frame, consumers together; memory of the rings and cursors\n");
+
+    failed |= TBench_Overrun();
+    return failed;
+}
+
+// Write once, read in place by each consumer, return 1 if a sum differs
+static int TBench_Broadcast(uint8_t num_consumers, uint32_t num_frames, double* producer_ns, double* consumer_ns)
+{
+    uint8_t consumer[TBENCH_MAX_CONSUMERS];
+    uint64_t sum[TBENCH_MAX_CONSUMERS] = {0};
+    uint64_t expected = 0;
+    uint64_t produce = 0, consume = 0;
+
+    MAX30101_Stream_Init(&tbench_stream, tbench_ring, TBENCH_FRAMES, TBENCH_CHANNELS);
+    for (uint8_t i = 0; i < num_consumers; i++)
+    {
+        MAX30101_Stream_Register(&tbench_stream, &consumer[i]);
+    }
+    for (uint32_t b = 0; b < num_frames / TBENCH_BLOCK; b++)
+    {
+        TBench_Fill(b);
+        uint64_t start = MAX30101_HostTime_Now();
+        for (uint8_t f = 0; f < TBENCH_BLOCK; f++)
+        {
+            MAX30101_Stream_Write(&tbench_stream, &tbench_block[f * TBENCH_CHANNELS]);
+        }
+        uint64_t written = MAX30101_HostTime_Now();
+        for (uint8_t i = 0; i < num_consumers; i++)
+        {
+            const uint32_t* frame;
+            uint16_t count;
+            while ((count = MAX30101_Stream_Peek(&tbench_stream, consumer[i], &frame)) > 0)
+            {
+                for (uint16_t s = 0; s < count * TBENCH_CHANNELS; s++)
+                {
+                    sum[i] += frame[s];
+                }
+                MAX30101_Stream_Consume(&tbench_stream, consumer[i], count);
+            }
+        }
+        consume += MAX30101_HostTime_Now() - written;
+        produce += written - start;
+        for (uint16_t s = 0; s < TBENCH_BLOCK * TBENCH_CHANNELS; s++)
+        {
+            expected += tbench_block[s];
+        }
+    }
+
+    int failed = 0;
+    for (uint8_t i = 0; i < num_consumers; i++)
+    {
+        failed |= (sum[i] != expected) || (tbench_stream.cursor[consumer[i]].overruns != 0);
+    }
+    *producer_ns = (double)produce / num_frames;
+    *consumer_ns = (double)consume / num_frames;
+    return failed;
+}
+
+// Copy to a ring per consumer, return 1 if a sum differs
+static int TBench_Copy(uint8_t num_consumers, uint32_t num_frames, double* producer_ns, double* consumer_ns)
+{
+    uint64_t sum[TBENCH_MAX_CONSUMERS] = {0};
+    uint64_t expected = 0;
+    uint64_t produce = 0, consume = 0;
+
+    for (uint8_t i = 0; i < num_consumers; i++)
+    {
+        tbench_copy[i].head = 0;
+        tbench_copy[i].tail = 0;
+    }
+    for (uint32_t b = 0; b < num_frames / TBENCH_BLOCK; b++)
+    {
+        TBench_Fill(b);
+        uint64_t start = MAX30101_HostTime_Now();
+        for (uint8_t f = 0; f < TBENCH_BLOCK; f++)
+        {
+            const uint32_t* frame = &tbench_block[f * TBENCH_CHANNELS];
+            for (uint8_t i = 0; i < num_consumers; i++)
+            {
+                TBench_Ring* ring = &tbench_copy[i];
+                uint32_t* slot = &ring->samples[(ring->head % TBENCH_FRAMES) * TBENCH_CHANNELS];
+                for (uint8_t c = 0; c < TBENCH_CHANNELS; c++)
+                {
+                    slot[c] = frame[c];
+                }
+                ring->head++;
+            }
+        }
+        uint64_t written = MAX30101_HostTime_Now();
+        for (uint8_t i = 0; i < num_consumers; i++)
+        {
+            TBench_Ring* ring = &tbench_copy[i];
+            while (ring->tail != ring->head)
+            {
+                const uint32_t* frame = &ring->samples[(ring->tail % TBENCH_FRAMES) * TBENCH_CHANNELS];
+                for (uint8_t c = 0; c < TBENCH_CHANNELS; c++)
+                {
+                    sum[i] += frame[c];
+                }
+                ring->tail++;
+            }
+        }
+        consume += MAX30101_HostTime_Now() - written;
+        produce += written - start;
+        for (uint16_t s = 0; s < TBENCH_BLOCK * TBENCH_CHANNELS; s++)
+        {
+            expected += tbench_block[s];
+        }
+    }
+
+    int failed = 0;
+    for (uint8_t i = 0; i < num_consumers; i++)
+    {
+        failed |= sum[i] != expected;
+    }
+    *producer_ns = (double)produce / num_frames;
+    *consumer_ns = (double)consume / num_frames;
+    return failed;
+}
+
+// A consumer stops reading for a while, return 1 if its losses are wrong
+static int TBench_Overrun(void)
+{
+    uint8_t fast, slow;
+    const uint32_t* frame;
+    uint16_t count;
+    uint32_t lost_expected = 3 * TBENCH_BLOCK - TBENCH_FRAMES;
+
+    MAX30101_Stream_Init(&tbench_stream, tbench_ring, TBENCH_FRAMES, TBENCH_CHANNELS);
+    MAX30101_Stream_Register(&tbench_stream, &fast);
+    MAX30101_Stream_Register(&tbench_stream, &slow);
+    for (uint32_t b = 0; b < 3; b++)
+    {
+        TBench_Fill(b);
+        for (uint8_t f = 0; f < TBENCH_BLOCK; f++)
+        {
+            MAX30101_Stream_Write(&tbench_stream, &tbench_block[f * TBENCH_CHANNELS]);
+        }
+        while ((count = MAX30101_Stream_Peek(&tbench_stream, fast, &frame)) > 0)
+        {
+            MAX30101_Stream_Consume(&tbench_stream, fast, count);
+        }
+    }
+
+    // The slow consumer resumes with the first frame kept: block 1, frame lost_expected - 32
+    uint16_t lag = MAX30101_Stream_Lag(&tbench_stream, slow);
+    count = MAX30101_Stream_Peek(&tbench_stream, slow, &frame);
+    TBench_Fill(1);
+    int failed = (lag != TBENCH_FRAMES) || (tbench_stream.cursor[slow].overruns != lost_expected) ||
+                 (tbench_stream.cursor[slow].max_lag != TBENCH_FRAMES) || (count == 0) ||
+                 (frame[0] != tbench_block[(lost_expected - TBENCH_BLOCK) * TBENCH_CHANNELS]) ||
+                 (tbench_stream.cursor[fast].overruns != 0);
+    printf("Slow consumer: %u frames written, lag %u, lost %u (expected %u): %s\n", 3 * TBENCH_BLOCK, lag,
+           (unsigned)tbench_stream.cursor[slow].overruns, lost_expected, failed ? "FAILED" : "ok");
+    return failed;
+}
+
+// Samples of a block (18 bits)
+static void TBench_Fill(uint32_t block)
+{
+    for (uint16_t s = 0; s < TBENCH_BLOCK * TBENCH_CHANNELS; s++)
+    {
+        tbench_block[s] = ((block * TBENCH_BLOCK * TBENCH_CHANNELS + s) * 2654435761u) & 0x3FFFF;
+    }
+}
+
+/* [] END OF FILE */
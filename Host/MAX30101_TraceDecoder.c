@@ -0,0 +1,145 @@
+/**
+*   Source file for the host-side MAX30101 trace decoder.
+*/
+
+#include "MAX30101_TraceDecoder.h"
+#include "MAX30101_Profile.h"
+#include "MAX30101_Rate.h"
+#include <string.h>
+
+// Reset decoder
+void MAX30101_TraceDecoder_Init(MAX30101_TraceDecoder* decoder)
+{
+    memset(decoder, 0, sizeof(*decoder));
+    decoder->unit = MAX30101_PROFILE_UNIT_CYCLES;
+}
+
+// Update state with a record
+uint8_t MAX30101_TraceDecoder_Feed(MAX30101_TraceDecoder* decoder, const MAX30101_TraceRecord* record,
+                                   MAX30101_TraceBurst* burst)
+{
+    const uint8_t* p = record->payload;
+
+    // Unsigned difference is correct also when the time stamp wraps
+    if (decoder->records > 0)
+    {
+        decoder->ticks += record->time - decoder->last_time;
+    }
+    decoder->last_time = record->time;
+    decoder->records++;
+
+    if (record->type == MAX30101_TRACE_START)
+    {
+        if (record->length < 4)
+        {
+            decoder->invalid++;
+            return 0;
+        }
+        decoder->unit = p[1];
+        decoder->ticks_per_us = p[2] | (p[3] << 8);
+        return 0;
+    }
+    if (record->type == MAX30101_TRACE_CONFIG)
+    {
+        if ((record->length < 2) || (record->length < 2 + p[1]))
+        {
+            decoder->invalid++;
+            return 0;
+        }
+        for (uint8_t i = 0; i < p[1]; i++)
+        {
+            decoder->regs[(uint8_t)(p[0] + i)] = p[2 + i];
+        }
+        decoder->config_records++;
+        return 0;
+    }
+    if (record->type != MAX30101_TRACE_FIFO)
+    {
+        return 0;
+    }
+
+    decoder->fifo_records++;
+    if (record->length < MAX30101_TRACE_FIFO_INFO)
+    {
+        decoder->invalid++;
+        return 0;
+    }
+
+    uint8_t active_leds = p[4];
+    burst->time_us = (decoder->ticks_per_us > 0) ? decoder->ticks / decoder->ticks_per_us : decoder->ticks;
+    burst->num_samples = p[3];
+    burst->overflow = p[1];
+    burst->raw = &p[MAX30101_TRACE_FIFO_INFO];
+    burst->shift = 3 - (decoder->regs[MAX30101_SPO2_CONF] & 0x03);
+
+    // Channel of each slot from the recorded mode and slot registers
+    burst->slots[0] = MAX30101_SLOT_RED;
+    burst->slots[1] = MAX30101_SLOT_IR;
+    burst->active_slots = active_leds;
+    if ((decoder->regs[MAX30101_MODE_CONF] & 0x07) == MAX30101_MULTI_MODE)
+    {
+        MAX30101_DecodeSlots(&decoder->regs[MAX30101_MULTI_LED_1], burst->slots, &burst->active_slots);
+    }
+    if (burst->active_slots != active_leds)
+    {
+        // Configuration not in the trace, keep the recorded number of channels
+        burst->active_slots = active_leds;
+    }
+
+    if ((active_leds == 0) || (active_leds > MAX30101_MAX_SLOTS) ||
+        (burst->num_samples > MAX30101_TRACE_MAX_SAMPLES) ||
+        (record->length < MAX30101_TRACE_FIFO_INFO + burst->num_samples * active_leds * 3))
+    {
+        decoder->invalid++;
+        return 0;
+    }
+    // Overflows are counted only for records that are decoded
+    if (p[1] > 0)
+    {
+        decoder->overflows++;
+        decoder->lost_samples += p[1];
+    }
+    decoder->samples += burst->num_samples;
+    return 1;
+}
+
+// Unpack burst in one array per slot
+void MAX30101_TraceDecoder_Unpack(MAX30101_TraceDecoder* decoder, const MAX30101_TraceBurst* burst,
+                                  uint32_t out[][MAX30101_TRACE_MAX_SAMPLES])
+{
+    // Unpack as many samples as the circular buffer holds, then copy them out
+    const uint8_t* raw = burst->raw;
+    for (uint8_t done = 0; done < burst->num_samples; )
+    {
+        uint8_t chunk = burst->num_samples - done;
+        if (chunk > BUFFER_STORAGE_SIZE)
+        {
+            chunk = BUFFER_STORAGE_SIZE;
+        }
+        uint8_t head = decoder->data.head;
+        MAX30101_DemuxSlots(raw, chunk, burst->slots, burst->active_slots, burst->shift, &decoder->data);
+        raw += chunk * burst->active_slots * 3;
+        for (uint8_t sample = 0; sample < chunk; sample++)
+        {
+            head = (head + 1) % BUFFER_STORAGE_SIZE;
+            for (uint8_t slot = 0; slot < burst->active_slots; slot++)
+            {
+                out[slot][done + sample] = decoder->data.slot[slot][head];
+            }
+        }
+        done += chunk;
+    }
+}
+
+// Output sample rate
+uint32_t MAX30101_TraceDecoder_SampleRate(const MAX30101_TraceDecoder* decoder)
+{
+    uint8_t avg = (decoder->regs[MAX30101_FIFO_CONF] >> MAX30101_SAMPLE_AVG_SHIFT) & 0x07;
+    if (avg > 5)
+    {
+        avg = 5;
+    }
+    return MAX30101_Rate_SampleRate(decoder->regs[MAX30101_SPO2_CONF] >> MAX30101_SAMPLE_RATE_SHIFT) >> avg;
+}
+
+/* [] END OF FILE */
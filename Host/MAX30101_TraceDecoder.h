@@ -0,0 +1,96 @@
+/**
+*   \file MAX30101_TraceDecoder.h
+*
+*   \brief Host-side decoding of MAX30101 traces.
+*
+*   The decoder follows the configuration records of a trace (see
+*   MAX30101_Trace.h) to know, for each FIFO record, the channel of each
+*   slot, the shift given by the pulse width and the output sample rate.
+*   Unpacking is done with #MAX30101_DemuxSlots, the same code used on
+*   target. Each decoder is independent, so that several streams can be
+*   decoded in parallel.
+*/
+
+#ifndef __MAX30101_TRACEDECODER_H__
+    #define __MAX30101_TRACEDECODER_H__
+
+    #include "MAX30101.h"
+    #include "MAX30101_Trace.h"
+
+    /**
+    *   \brief Maximum number of samples in a FIFO record.
+    */
+    #define MAX30101_TRACE_MAX_SAMPLES 32
+
+    /**
+    *   \brief A FIFO burst ready to be unpacked.
+    */
+    typedef struct
+    {
+        uint64_t time_us;                       ///< Time of the read, in us from the beginning of the trace.
+        uint8_t num_samples;                    ///< Number of samples.
+        uint8_t active_slots;                   ///< Number of active slots.
+        uint8_t slots[MAX30101_MAX_SLOTS];      ///< Channel of each slot.
+        uint8_t shift;                          ///< Right shift given by the pulse width.
+        uint8_t overflow;                       ///< Overflow counter read before the burst.
+        const uint8_t* raw;                     ///< Raw FIFO bytes, pointing into the trace.
+    } MAX30101_TraceBurst;
+
+    /**
+    *   \brief State of a trace decoder.
+    */
+    typedef struct
+    {
+        uint8_t regs[256];          ///< Last value written to each register.
+        uint8_t unit;               ///< Time unit of the trace.
+        uint16_t ticks_per_us;      ///< Time stamp ticks in 1 us, 0 if unknown.
+        uint32_t last_time;         ///< Time stamp of the previous record.
+        uint64_t ticks;             ///< Time since the first record, in ticks.
+        uint32_t records;           ///< Number of records.
+        uint32_t fifo_records;      ///< Number of FIFO records.
+        uint32_t config_records;    ///< Number of configuration records.
+        uint32_t overflows;         ///< FIFO records with a non zero overflow counter.
+        uint32_t lost_samples;      ///< Sum of the overflow counters.
+        uint32_t invalid;           ///< Records too short or FIFO records that could not be decoded.
+        uint64_t samples;           ///< Number of decoded samples.
+        MAX30101_MultiData data;    ///< Circular buffer used by #MAX30101_DemuxSlots.
+    } MAX30101_TraceDecoder;
+
+    /**
+    *   \brief Reset a decoder.
+    */
+    void MAX30101_TraceDecoder_Init(MAX30101_TraceDecoder* decoder);
+
+    /**
+    *   \brief Feed a record to the decoder.
+    *
+    *   Configuration records update the register mirror, FIFO records are
+    *   described in burst. Records shorter than their content are
+    *   counted as invalid and ignored.
+    *   \param[in,out] decoder pointer to the decoder.
+    *   \param[in] record record read with #MAX30101_Trace_Next.
+    *   \param[out] burst FIFO burst, valid only if 1 is returned.
+    *   \return 1 if record is a FIFO record that can be unpacked, 0 otherwise.
+    */
+    uint8_t MAX30101_TraceDecoder_Feed(MAX30101_TraceDecoder* decoder, const MAX30101_TraceRecord* record,
+                                       MAX30101_TraceBurst* burst);
+
+    /**
+    *   \brief Unpack a FIFO burst in one array per slot.
+    *
+    *   \param[in,out] decoder pointer to the decoder.
+    *   \param[in] burst burst returned by #MAX30101_TraceDecoder_Feed.
+    *   \param[out] out one array of #MAX30101_TRACE_MAX_SAMPLES values per slot.
+    */
+    void MAX30101_TraceDecoder_Unpack(MAX30101_TraceDecoder* decoder, const MAX30101_TraceBurst* burst,
+                                      uint32_t out[][MAX30101_TRACE_MAX_SAMPLES]);
+
+    /**
+    *   \brief Output sample rate of the recorded configuration.
+    *
+    *   \return sample rate divided by the number of averaged samples, in Hz.
+    */
+    uint32_t MAX30101_TraceDecoder_SampleRate(const MAX30101_TraceDecoder* decoder);
+
+#endif
+/* [] END OF FILE */
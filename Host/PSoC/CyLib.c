@@ -0,0 +1,46 @@
+/**
+*   Host stand-in for the PSoC Creator CyLib functions.
+*/
+
+#include "CyLib.h"
+
+// Delays requested since the last reset, in us
+static uint32 delay_total_us = 0;
+
+// Delay in ms
+void CyDelay(uint32 milliseconds)
+{
+    delay_total_us += milliseconds * 1000u;
+}
+
+// Delay in us
+void CyDelayUs(uint16 microseconds)
+{
+    delay_total_us += microseconds;
+}
+
+// Total of the delays, in us
+uint32 CyDelay_GetTotalUs(void)
+{
+    return delay_total_us;
+}
+
+// Clear the total of the delays
+void CyDelay_ResetTotal(void)
+{
+    delay_total_us = 0;
+}
+
+// Enter critical section
+uint8 CyEnterCriticalSection(void)
+{
+    return 0;
+}
+
+// Exit critical section
+void CyExitCriticalSection(uint8 savedIntrStatus)
+{
+    (void)savedIntrStatus;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,33 @@
+/**
+*   \file CyLib.h
+*
+*   \brief Host stand-in for the PSoC Creator CyLib.h.
+*
+*   Delays return immediately: the simulated device (see
+*   MAX30101_Sim.h) is always ready. Their total is kept, so that host
+*   benchmarks can add the time a delay would take on target
+*   (CyDelay_GetTotalUs, host only). Critical sections do nothing.
+*/
+
+#ifndef __CYLIB_H__
+    #define __CYLIB_H__
+
+    #include "cytypes.h"
+
+    #define CyGlobalIntEnable   do { } while (0)
+    #define CyGlobalIntDisable  do { } while (0)
+
+    void CyDelay(uint32 milliseconds);
+
+    void CyDelayUs(uint16 microseconds);
+
+    uint32 CyDelay_GetTotalUs(void);
+
+    void CyDelay_ResetTotal(void);
+
+    uint8 CyEnterCriticalSection(void);
+
+    void CyExitCriticalSection(uint8 savedIntrStatus);
+
+#endif
+/* [] END OF FILE */
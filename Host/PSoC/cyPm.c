@@ -0,0 +1,31 @@
+/**
+*   Host stand-in for the PSoC Creator power management functions.
+*/
+
+#include "cyPm.h"
+
+// Save clocks before sleep
+void CyPmSaveClocks(void)
+{
+}
+
+// Restore clocks after sleep
+void CyPmRestoreClocks(void)
+{
+}
+
+// Sleep mode
+void CyPmSleep(uint8 wakeupTime, uint16 wakeupSource)
+{
+    (void)wakeupTime;
+    (void)wakeupSource;
+}
+
+// Alternate active mode
+void CyPmAltAct(uint16 wakeupTime, uint16 wakeupSource)
+{
+    (void)wakeupTime;
+    (void)wakeupSource;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,30 @@
+/**
+*   \file cyPm.h
+*
+*   \brief Host stand-in for the PSoC Creator cyPm.h.
+*
+*   Low power modes return at once, as if woken up by an interrupt.
+*/
+
+#ifndef __CYPM_H__
+    #define __CYPM_H__
+
+    #include "cytypes.h"
+
+    #define PM_SLEEP_TIME_NONE      0u
+    #define PM_SLEEP_SRC_PICU       0x0040u
+    #define PM_ALT_ACT_TIME_NONE    0u
+    #define PM_ALT_ACT_SRC_PICU     0x0040u
+
+    #define CY_PM_WFI               do { } while (0)
+
+    void CyPmSaveClocks(void);
+
+    void CyPmRestoreClocks(void);
+
+    void CyPmSleep(uint8 wakeupTime, uint16 wakeupSource);
+
+    void CyPmAltAct(uint16 wakeupTime, uint16 wakeupSource);
+
+#endif
+/* [] END OF FILE */
@@ -0,0 +1,37 @@
+/**
+*   \file cytypes.h
+*
+*   \brief Host stand-in for the PSoC Creator cytypes.h.
+*
+*   Only the types and macros used by the MAX30101 library are defined,
+*   so that the library can be built and benchmarked on the host.
+*/
+
+#ifndef __CYTYPES_H__
+    #define __CYTYPES_H__
+
+    #include <stdint.h>
+    #include <stddef.h>
+
+    typedef uint8_t  uint8;
+    typedef uint16_t uint16;
+    typedef uint32_t uint32;
+    typedef int8_t   int8;
+    typedef int16_t  int16;
+    typedef int32_t  int32;
+
+    typedef volatile uint8_t  reg8;
+    typedef volatile uint16_t reg16;
+    typedef volatile uint32_t reg32;
+
+    #define CY_ISR(function)        void function(void)
+    #define CY_ISR_PROTO(function)  void function(void)
+    #define CY_INLINE               inline
+
+    /**
+    *   \brief Bus clock frequency of the CY8CKIT-059 projects, in MHz.
+    */
+    #define BCLK__BUS_CLK__MHZ 24u
+
+#endif
+/* [] END OF FILE */
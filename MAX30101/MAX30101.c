@@ -0,0 +1,1371 @@
+/**
+*   Source file for the MAX30101 library.
+*/
+
+#include "I2C_Interface.h"
+#include "I2C_Master.h"
+#include "CyLib.h"
+#include "MAX30101.h"
+#include "MAX30101_Format.h"
+#include "MAX30101_Profile.h"
+#include "MAX30101_Rate.h"
+#include "string.h"
+
+//==============================================
+//          MACROS
+//==============================================
+
+/**
+*   \brief Mask for Power Ready interrupt.
+*/
+#define MAX30101_INT_PWR_RDY_MASK   0xFE
+
+/**
+*   \brief Mask for FIFO A FULL interrupt.
+*/
+#define MAX30101_INT_FIFO_A_FULL_MASK   0x7F
+
+/**
+*   \brief Enable FIFO A FULL interrupt.
+*/
+#define MAX30101_INT_FIFO_A_FULL_ENABLE 0x80
+
+/**
+*   \brief Disable FIFO A FULL interrupt.
+*/
+#define MAX30101_INT_FIFO_A_FULL_DISABLE 0x00
+
+/**
+*   \brief Mask for PPG ready interrupt.
+*/
+#define MAX30101_INT_PPG_RDY_MASK     0xBF
+
+/**
+*   \brief Enable PPG ready interrupt.
+*/
+#define MAX30101_INT_PPG_RDY_ENABLE 0x40
+
+/**
+*   \brief Disable PPG ready interrupt.
+*/
+#define MAX30101_INT_PPG_RDY_DISABLE 0x00
+
+/**
+*   \brief Mask for FIFO overflow interrupt.
+*/
+#define MAX30101_INT_ALC_OVF_MASK     0xDF
+
+/**
+*   \brief Enable OVERFLOW interrupt.
+*/
+#define MAX30101_INT_ALC_OVF_ENABLE 0x20
+
+/**
+*   \brief Disable OVERFLOW interrupt.
+*/
+#define MAX30101_INT_ALC_OVF_DISABLE 0x00
+
+/**
+*   \brief Mask for proximity interrupt.
+*/
+#define MAX30101_INT_PROX_INT_MASK     0xEF
+
+/**
+*   \brief Enable proximity interrupt.
+*/
+#define MAX30101_INT_PROX_INT_ENABLE 0x10
+
+/**
+*   \brief Disable proximity interrupt.
+*/
+#define MAX30101_INT_PROX_INT_DISABLE 0x00
+
+/**
+*   \brief Mask for temperature data ready interrupt.
+*/
+#define MAX30101_INT_TMP_RDY_MASK     0xFD
+
+/**
+*   \brief Enable temperature ready interrupt.
+*/
+#define MAX30101_INT_TMP_RDY_ENABLE 0x02
+
+/**
+*   \brief Disable temperature ready interrupt.
+*/
+#define MAX30101_INT_TMP_RDY_DISABLE 0x00
+
+/**
+*   \brief Mask for sample average settings.
+*/
+#define MAX30101_SMP_AVG_MASK    0x1F
+
+/**
+*   \brief Mask for fifo rollover.
+*/
+#define MAX30101_FIFO_ROLLOVER_MASK    0xEF
+
+/**
+*   \brief Mask for sample average settings.
+*/
+#define MAX30101_FIFO_ROLLOVER_ENABLE    0x10
+
+/**
+*   \brief Mask for sample average settings.
+*/
+#define MAX30101_FIFO_ROLLOVER_DISABLE    0x00
+
+/**
+*   \brief Mask for FIFO A Full samples.
+*/
+#define MAX30101_FIFO_A_FULL_MASK   0xF0
+
+/**
+*   \brief Mask for shutdown bit.
+*/
+#define MAX30101_SHUTDOWN_MASK 0x7F
+
+/**
+*   \brief Enable shutdown
+*/
+#define MAX30101_SHUTDOWN_ENABLE 0x80
+
+/**
+*   \brief Disable shutdown.
+*/
+#define MAX30101_SHUTDOWN_DISABLE 0x00
+
+/**
+*   \brief Reset bit mask.
+*/
+#define MAX30101_RESET_MASK 0xBF
+
+/**
+*   \brief Set reset bit.
+*/
+#define MAX30101_RESET_ENABLE 0x40
+
+/**
+*   \brief Mode mask.
+*/
+#define MAX30101_MODE_MASK 0xF8
+
+/**
+*   \brief SPO2 ADC Range mask.
+*/
+#define MAX30101_SPO2_ADC_RANGE_MASK 0x9F 
+
+/**
+*   \brief SPO2 Sample Rate mask.
+*/
+#define MAX30101_SPO2_SAMPLE_RATE_MASK 0xE3
+
+/**
+*   \brief SPO2 Sample Rate mask.
+*/
+#define MAX30101_SPO2_PULSEWIDTH_MASK 0xFC
+
+/**
+*   \brief Multi-LED SLOT1 mask.
+*/
+#define MAX30101_SLOT1_MASK  		0xF8
+
+/**
+*   \brief Multi-LED SLOT2 mask.
+*/
+#define MAX30101_SLOT2_MASK  		0x8F
+
+/**
+*   \brief Multi-LED SLOT3 mask.
+*/
+#define MAX30101_SLOT3_MASK  		0xF8
+
+/**
+*   \brief Multi-LED SLOT4 mask.
+*/
+#define MAX30101_SLOT4_MASK  		0x8F
+
+/**
+*   \brief Mask for a single slot setting in Multi-LED registers.
+*/
+#define MAX30101_SLOT_FIELD_MASK    0x07
+
+/**
+*   \brief Number of samples that can be stored in the FIFO.
+*/
+#define MAX30101_FIFO_DEPTH 32
+
+/**
+*   \brief Number of bytes per channel in the FIFO.
+*/
+#define MAX30101_BYTES_PER_CHANNEL 3
+
+/**
+*   \brief Right shift to be applied to FIFO data according to the LED_PW setting.
+*
+*   FIFO data is left-justified on 18 bits: with LED_PW set to 411 us (18 bit)
+*   no shift is required, with LED_PW set to 69 us (15 bit) data is shifted by 3.
+*/
+#define MAX30101_SHIFT(resolution) (3-(resolution))
+
+/**
+*   \brief Time between two polls of the MAX30101 status, in us.
+*/
+#define MAX30101_POLL_INTERVAL_US 50
+
+//==============================================
+//          VARIABLES
+//==============================================
+static void (*MAX30101_write_hook)(uint8_t reg_addr, uint8_t count, const uint8_t* data) = NULL;
+
+//==============================================
+//          FUNCTION PROTOTYPESS
+//==============================================
+
+static uint8_t MAX30101_BitMask(uint8_t reg_addr, uint8_t mask, uint8_t thing);
+
+static uint8_t MAX30101_WriteRegister(uint8_t reg_addr, uint8_t reg_data);
+
+static uint8_t MAX30101_CheckRate(uint8_t mode_conf, const uint8_t* multi_led, uint8_t spo2_conf);
+
+static uint8_t MAX30101_SetSpO2Timing(uint8_t mask, uint8_t thing);
+
+static void MAX30101_BootMark(MAX30101_BootTrace* trace, uint8_t phase, uint16_t polls);
+
+static void MAX30101_PrintRange(void (*print_fun)(const char*), uint8_t reg_addr, const uint8_t* values,
+                                uint8_t count);
+
+// Start the device
+uint8_t MAX30101_Start(void)
+{
+    I2C_Peripheral_Start();
+    uint8_t error = MAX30101_Reset();
+    if (error == MAX30101_OK)
+    {
+        error = MAX30101_WaitForReset(MAX30101_BOOT_TIMEOUT_US, NULL);
+    }
+    return error;
+}
+
+// Start and configure the device without fixed delays
+uint8_t MAX30101_Boot(const MAX30101_Config* config, MAX30101_BootTrace* trace)
+{
+    uint8_t error;
+    uint16_t polls;
+    uint16_t max_polls = MAX30101_BOOT_TIMEOUT_US / MAX30101_POLL_INTERVAL_US + 1;
+
+    if (trace != NULL)
+    {
+        trace->start = (trace->get_time != NULL) ? trace->get_time() : 0;
+        trace->failed_phase = MAX30101_BOOT_PHASES;
+        memset(trace->phase_end, 0, sizeof(trace->phase_end));
+        memset(trace->polls, 0, sizeof(trace->polls));
+    }
+
+    I2C_Peripheral_Start();
+    MAX30101_BootMark(trace, MAX30101_BOOT_I2C_START, 0);
+
+    // The device may still be powering up
+    error = MAX30101_DEV_NOT_FOUND;
+    for (polls = 1; polls <= max_polls; polls++)
+    {
+        error = MAX30101_IsDevicePresent();
+        if (error == MAX30101_OK)
+            break;
+        CyDelayUs(MAX30101_POLL_INTERVAL_US);
+    }
+    if (error != MAX30101_OK)
+    {
+        if (trace != NULL)
+            trace->failed_phase = MAX30101_BOOT_PRESENT;
+        return error;
+    }
+    MAX30101_BootMark(trace, MAX30101_BOOT_PRESENT, polls);
+
+    // Soft reset and wait for its completion
+    error = MAX30101_Reset();
+    if (error == MAX30101_OK)
+    {
+        error = MAX30101_WaitForReset(MAX30101_BOOT_TIMEOUT_US, &polls);
+    }
+    if (error != MAX30101_OK)
+    {
+        if (trace != NULL)
+            trace->failed_phase = MAX30101_BOOT_RESET;
+        return error;
+    }
+    MAX30101_BootMark(trace, MAX30101_BOOT_RESET, polls);
+
+    // Reading both status registers clears PWR_RDY and releases the interrupt pin
+    uint8_t status[2];
+    if (I2C_Peripheral_ReadRegisterMulti(MAX30101_I2C_ADDRESS, MAX30101_INT_ST_1, 2, status) != I2C_NO_ERROR)
+    {
+        if (trace != NULL)
+            trace->failed_phase = MAX30101_BOOT_STATUS;
+        return MAX30101_DEV_NOT_FOUND;
+    }
+    MAX30101_BootMark(trace, MAX30101_BOOT_STATUS, 1);
+
+    error = MAX30101_ApplyConfig(config);
+    if (error != MAX30101_OK)
+    {
+        if (trace != NULL)
+            trace->failed_phase = MAX30101_BOOT_CONFIG;
+        return error;
+    }
+    MAX30101_BootMark(trace, MAX30101_BOOT_CONFIG, 1);
+
+    return MAX30101_OK;
+}
+
+// Poll RESET bit until it is cleared
+uint8_t MAX30101_WaitForReset(uint16_t timeout_us, uint16_t* polls)
+{
+    uint16_t max_polls = timeout_us / MAX30101_POLL_INTERVAL_US + 1;
+    uint8_t error = MAX30101_DEV_NOT_FOUND;
+
+    for (uint16_t i = 1; i <= max_polls; i++)
+    {
+        uint8_t mode;
+        if (polls != NULL)
+            *polls = i;
+        // The device may not acknowledge while reset is in progress
+        error = MAX30101_ReadRegister(MAX30101_MODE_CONF, &mode);
+        if ((error == MAX30101_OK) && ((mode & MAX30101_RESET_ENABLE) == 0))
+        {
+            return MAX30101_OK;
+        }
+        CyDelayUs(MAX30101_POLL_INTERVAL_US);
+    }
+    return (error == MAX30101_OK) ? MAX30101_ERROR : error;
+}
+
+// Write a complete configuration with burst writes
+uint8_t MAX30101_ApplyConfig(const MAX30101_Config* config)
+{
+    // LED1_PA, LED2_PA, LED3_PA, LED4_PA, PILOT_PA, MULTI_LED_1, MULTI_LED_2
+    uint8_t leds[7] = {config->led_pa[0], config->led_pa[1], config->led_pa[2], config->led_pa[3],
+                       config->pilot_pa, config->multi_led[0], config->multi_led[1]};
+    uint8_t error = MAX30101_CheckRate(config->mode_conf, config->multi_led, config->spo2_conf);
+    if (error == MAX30101_OK)
+    {
+        error = MAX30101_WriteRegisters(MAX30101_LED1_PA, sizeof(leds), leds);
+    }
+    if (error == MAX30101_OK)
+    {
+        // INT_EN_1, INT_EN_2, FIFO_WP, OVF_COUNTER, FIFO_RP
+        uint8_t interrupts[5] = {config->int_en_1, config->int_en_2, 0x00, 0x00, 0x00};
+        error = MAX30101_WriteRegisters(MAX30101_INT_EN_1, sizeof(interrupts), interrupts);
+    }
+    if ((error == MAX30101_OK) && (config->int_en_1 & MAX30101_CONF_INT_PROX))
+    {
+        error = MAX30101_WriteRegister(MAX30101_PROX_INT_THRESH, config->prox_thresh);
+    }
+    if (error == MAX30101_OK)
+    {
+        // FIFO_CONF, MODE_CONF, SPO2_CONF: acquisition starts with mode
+        uint8_t conf[3] = {config->fifo_conf, config->mode_conf & MAX30101_RESET_MASK, config->spo2_conf};
+        error = MAX30101_WriteRegisters(MAX30101_FIFO_CONF, sizeof(conf), conf);
+    }
+    return error;
+}
+
+// Check if device is present on I2C bus
+uint8_t MAX30101_IsDevicePresent(void)
+{
+    if (I2C_Peripheral_IsDeviceConnected(MAX30101_I2C_ADDRESS) == I2C_NO_ERROR)
+    {
+        return MAX30101_OK;
+    }
+    
+    return MAX30101_DEV_NOT_FOUND;
+}
+
+//==============================================
+//          INTERRUPT RELATED FUNCTIONS
+//==============================================
+
+// Check interrupt status
+uint8_t MAX30101_IsFIFOAFull(uint8_t* flag)
+{
+    // Read register
+    uint8_t temp = 0;
+    uint8_t error = MAX30101_ReadRegister(MAX30101_INT_ST_1, &temp);
+    *flag = temp & (~MAX30101_INT_FIFO_A_FULL_MASK);
+    return error;
+    
+}
+
+uint8_t MAX30101_IsPPGReady(uint8_t* flag)
+{
+    // Read register
+    uint8_t temp = 0;
+    uint8_t error = MAX30101_ReadRegister(MAX30101_INT_ST_1, &temp);
+    *flag = temp & (~MAX30101_INT_PPG_RDY_MASK);
+    return error;
+}
+uint8_t MAX30101_IsALCOverflow(uint8_t* flag)
+{
+    // Read register
+    uint8_t temp = 0;
+    uint8_t error = MAX30101_ReadRegister(MAX30101_INT_ST_1, &temp);
+    *flag = temp & (~MAX30101_INT_ALC_OVF_MASK);
+    return error;
+}
+uint8_t MAX30101_IsPowerReady(uint8_t* flag)
+{
+    // Read register
+    uint8_t temp = 0;
+    uint8_t error = MAX30101_ReadRegister(MAX30101_INT_ST_1, &temp);
+    *flag = temp & (~MAX30101_INT_PWR_RDY_MASK);
+    return error;
+}
+uint8_t MAX30101_IsTempReady(uint8_t* flag)
+{
+    // Read register
+    uint8_t temp = 0;
+    uint8_t error = MAX30101_ReadRegister(MAX30101_INT_ST_2, &temp);
+    *flag = temp & (~MAX30101_INT_TMP_RDY_MASK);
+    return error;
+}
+uint8_t MAX30101_IsProximity(uint8_t* flag)
+{
+    // Read register
+    uint8_t temp = 0;
+    uint8_t error = MAX30101_ReadRegister(MAX30101_INT_ST_1, &temp);
+    *flag = temp & (~MAX30101_INT_PROX_INT_MASK);
+    return error;
+}
+    
+// Enable interrupts
+uint8_t MAX30101_EnableFIFOAFullInt(void)
+{
+    return MAX30101_BitMask(MAX30101_INT_EN_1, MAX30101_INT_FIFO_A_FULL_MASK, MAX30101_INT_FIFO_A_FULL_ENABLE);
+}
+uint8_t MAX30101_EnablePPGReadyInt(void)
+{
+    return MAX30101_BitMask(MAX30101_INT_EN_1, MAX30101_INT_PPG_RDY_MASK, MAX30101_INT_PPG_RDY_ENABLE);
+}
+uint8_t MAX30101_EnableALCOverflowInt(void)
+{
+    return MAX30101_BitMask(MAX30101_INT_EN_1, MAX30101_INT_ALC_OVF_MASK, MAX30101_INT_ALC_OVF_ENABLE);
+}
+
+uint8_t MAX30101_EnableTempReadyInt(void)
+{
+    return MAX30101_BitMask(MAX30101_INT_EN_2, MAX30101_INT_TMP_RDY_MASK, MAX30101_INT_TMP_RDY_ENABLE);
+}
+
+uint8_t MAX30101_EnableProximityInt(void)
+{
+    return MAX30101_BitMask(MAX30101_INT_EN_1, MAX30101_INT_PROX_INT_MASK, MAX30101_INT_PROX_INT_ENABLE);
+}
+
+// Disable interrupts
+uint8_t MAX30101_DisableFIFOAFullInt(void)
+{
+    return MAX30101_BitMask(MAX30101_INT_EN_1, MAX30101_INT_FIFO_A_FULL_MASK, MAX30101_INT_FIFO_A_FULL_DISABLE);
+}
+
+uint8_t MAX30101_DisablePPGReadyInt(void)
+{
+    return MAX30101_BitMask(MAX30101_INT_EN_1, MAX30101_INT_PPG_RDY_MASK, MAX30101_INT_PPG_RDY_DISABLE);
+}
+
+uint8_t MAX30101_DisableALCOverflowInt(void)
+{
+    return MAX30101_BitMask(MAX30101_INT_EN_1, MAX30101_INT_ALC_OVF_MASK, MAX30101_INT_ALC_OVF_DISABLE);
+}
+
+uint8_t MAX30101_DisableTempReadyInt(void)
+{
+    return MAX30101_BitMask(MAX30101_INT_EN_2, MAX30101_INT_TMP_RDY_MASK, MAX30101_INT_TMP_RDY_DISABLE);
+}
+
+uint8_t MAX30101_DisableProximityInt(void)
+{
+    return MAX30101_BitMask(MAX30101_INT_EN_1, MAX30101_INT_PROX_INT_MASK, MAX30101_INT_PROX_INT_DISABLE);
+}
+
+//==============================================
+//          FIFO FUNCTIONS
+//==============================================
+// Read Write pointer
+uint8_t MAX30101_ReadWritePointer(uint8_t* wr)
+{
+    return MAX30101_ReadRegister(MAX30101_FIFO_WP, wr);
+}
+
+// Read Overflow counter
+uint8_t MAX30101_ReadOverflowCounter(uint8_t* oc)
+{
+    return MAX30101_ReadRegister(MAX30101_FIFO_OVF_CNT, oc);
+}
+
+// Read Read Pointer
+uint8_t MAX30101_ReadReadPointer(uint8_t* rr)
+{
+    return MAX30101_ReadRegister(MAX30101_FIFO_RP, rr);
+}
+
+// Read Write pointer, Overflow counter and Read pointer
+uint8_t MAX30101_ReadFIFOPointers(uint8_t* wr, uint8_t* oc, uint8_t* rr)
+{
+    // FIFO_WP, OVF_COUNTER and FIFO_RP are contiguous
+    uint8_t pointers[3];
+    if (I2C_Peripheral_ReadRegisterMulti(MAX30101_I2C_ADDRESS, MAX30101_FIFO_WP,
+                                         sizeof(pointers), pointers) != I2C_NO_ERROR)
+    {
+        return MAX30101_DEV_NOT_FOUND;
+    }
+    *wr = pointers[0];
+    *oc = pointers[1];
+    *rr = pointers[2];
+    return MAX30101_OK;
+}
+
+// Clear FIFO
+uint8_t MAX30101_ClearFIFO(void)
+{
+    uint8_t error = MAX30101_WriteRegister(MAX30101_FIFO_WP, 0x00);
+    if ( error == MAX30101_OK)
+    {
+        error = MAX30101_WriteRegister(MAX30101_FIFO_RP, 0x00);
+        if ( error == MAX30101_OK)
+        {
+            // Read current mode and slots to determine number of active leds
+            uint8_t active_leds;
+            error = MAX30101_GetActiveLeds(&active_leds);
+            if (( error == MAX30101_OK) && (active_leds > 0))
+            {
+                uint8_t fifo_values[MAX30101_MAX_SLOTS*MAX30101_BYTES_PER_CHANNEL];
+                // Read 1 from FIFO to clear the overflow counter
+                error = MAX30101_ReadRawFIFOBytes(1, active_leds, fifo_values);
+            }
+        }
+    }
+    return error;
+}
+
+// Flush FIFO
+uint8_t MAX30101_FlushFIFO(void)
+{
+    // FIFO_WP, OVF_COUNTER and FIFO_RP are contiguous
+    uint8_t pointers[3] = {0x00, 0x00, 0x00};
+    return MAX30101_WriteRegisters(MAX30101_FIFO_WP, sizeof(pointers), pointers);
+}
+
+uint8_t MAX30101_ReadRawFIFOBytes(uint8_t num_samples, uint8_t active_leds, uint8_t* data)
+{
+    // We need to read a number of bytes equal to num_samples + 3 * active_leds
+    uint16_t bytes_left_ro_read = num_samples * 3 * active_leds;
+    if (I2C_Peripheral_ReadRegisterMulti(MAX30101_I2C_ADDRESS, MAX30101_FIFO_DATA, bytes_left_ro_read, data) == I2C_NO_ERROR)
+    {
+        return MAX30101_OK;
+    }
+    else
+    {
+        return MAX30101_DEV_NOT_FOUND;
+    }
+}
+
+// Read FIFO Data
+uint8_t MAX30101_ReadRawFIFO(uint8_t num_samples, uint8_t active_leds, uint32_t* data)
+{
+    // We need to read a number of bytes equal to num_samples + 3 * active_leds
+    uint16_t bytes_left_ro_read = num_samples * 3 * active_leds;
+    uint8_t error = MAX30101_OK;
+    //uint8_t error = I2C_Peripheral_WriteRegisterNoData(MAX30101_I2C_ADDRESS, MAX30101_FIFO_DATA);
+    //if ( error == I2C_NO_ERROR)
+    //{
+        uint8_t sample_counter = 0;
+        while(bytes_left_ro_read > 0)
+        {
+            uint16_t bytes_to_get =  active_leds * 3;
+            
+            bytes_left_ro_read -= bytes_to_get;
+            
+            uint8_t temp[sizeof(uint32_t)];
+            uint8_t temp_bytes[3];
+            uint32_t tempLong;
+            
+            error = I2C_Peripheral_ReadRegisterMulti(MAX30101_I2C_ADDRESS, MAX30101_FIFO_DATA, 3, temp_bytes);
+            
+            //Burst read three bytes - RED
+            temp[3] = 0;
+            temp[2] = temp_bytes[0];
+            temp[1] = temp_bytes[1];
+            temp[0] = temp_bytes[2];
+
+            //Convert array to long
+            memcpy(&tempLong, temp, sizeof(tempLong));
+    		
+            //Zero out all but 18 bits
+    		tempLong &= 0x3FFFF; 
+            data[sample_counter] = tempLong;
+            
+            if (active_leds > 1)
+            {
+                I2C_Peripheral_ReadRegisterMulti(MAX30101_I2C_ADDRESS, MAX30101_FIFO_DATA, 3, temp_bytes);
+               
+                //Burst read three bytes - IR
+                temp[3] = 0;
+                temp[2] = temp_bytes[0];
+                temp[1] = temp_bytes[1];
+                temp[0] = temp_bytes[2];
+            
+                //Convert array to long
+                memcpy(&tempLong, temp, sizeof(tempLong));
+        		
+                //Zero out all but 18 bits
+        		tempLong &= 0x3FFFF; 
+                sample_counter += 1;
+                data[sample_counter] = tempLong;
+            }
+            if (active_leds > 2)
+            {
+                I2C_Peripheral_ReadRegisterMulti(MAX30101_I2C_ADDRESS, MAX30101_FIFO_DATA,3, temp_bytes);
+                
+                //Burst read three bytes - GREEN
+                temp[3] = 0;
+                temp[2] = temp_bytes[0];
+                temp[1] = temp_bytes[1];
+                temp[0] = temp_bytes[2];
+
+                //Convert array to long
+                memcpy(&tempLong, temp, sizeof(tempLong));
+        		
+                //Zero out all but 18 bits
+        		tempLong &= 0x3FFFF; 
+                sample_counter += 1;
+                data[sample_counter] = tempLong;
+            }
+            if (active_leds > 3)
+            {
+                I2C_Peripheral_ReadRegisterMulti(MAX30101_I2C_ADDRESS, MAX30101_FIFO_DATA,3, temp_bytes);
+                
+                //Burst read three bytes - fourth slot (Multi-LED mode)
+                temp[3] = 0;
+                temp[2] = temp_bytes[0];
+                temp[1] = temp_bytes[1];
+                temp[0] = temp_bytes[2];
+
+                //Convert array to long
+                memcpy(&tempLong, temp, sizeof(tempLong));
+        		
+                //Zero out all but 18 bits
+        		tempLong &= 0x3FFFF; 
+                sample_counter += 1;
+                data[sample_counter] = tempLong;
+            }
+            sample_counter += 1;
+            
+        }
+    //}
+    return error;
+}
+
+// Read FIFO Data
+uint8_t MAX30101_ReadFIFO(uint8_t num_samples, uint8_t active_leds, MAX30101_Data* data)
+{
+    // Red, IR and green buffers only: a 4th slot would misalign every following sample
+    if ((active_leds == 0) || (active_leds > 3))
+    {
+        return MAX30101_ERROR;
+    }
+    
+    // We need to read a number of bytes equal to num_samples + 3 * active_leds
+    uint16_t bytes_left_ro_read = num_samples * 3 * active_leds;
+    uint8_t error = MAX30101_OK;
+    
+    // Read current resolution so that we know how much shift to apply
+    uint8_t resolution = 0;
+    I2C_Peripheral_ReadRegister(MAX30101_I2C_ADDRESS, MAX30101_SPO2_CONF, &resolution);
+    resolution &= (~MAX30101_SPO2_PULSEWIDTH_MASK);
+    
+    I2C_Master_MasterSendStart(MAX30101_I2C_ADDRESS, I2C_Master_WRITE_XFER_MODE);
+    I2C_Master_MasterWriteByte(MAX30101_FIFO_DATA);
+    I2C_Master_MasterSendRestart(MAX30101_I2C_ADDRESS, I2C_Master_READ_XFER_MODE);
+    
+    //I2C_Peripheral_WriteRegisterNoData(MAX30101_I2C_ADDRESS, MAX30101_FIFO_DATA);
+    //I2C_Peripheral_StartReadNoAddress(MAX30101_I2C_ADDRESS);
+    
+    while(bytes_left_ro_read > 0)
+    {
+        uint16_t bytes_to_get =  active_leds * 3;
+        
+        bytes_left_ro_read -= bytes_to_get;
+        
+        data->head++; //Advance the head of the storage struct
+        data->head %= BUFFER_STORAGE_SIZE; //Wrap condition
+        
+        uint8_t temp[sizeof(uint32_t)];
+        uint32_t tempLong;
+        
+        //error = I2C_Peripheral_ReadBytes(temp_bytes, 3);
+        
+        //Burst read three bytes - RED
+        temp[3] = 0;
+        temp[2] = I2C_Master_MasterReadByte(I2C_Master_ACK_DATA);
+        temp[1] = I2C_Master_MasterReadByte(I2C_Master_ACK_DATA);
+        temp[0] = I2C_Master_MasterReadByte(I2C_Master_ACK_DATA);
+
+        //Convert array to long
+        memcpy(&tempLong, temp, sizeof(tempLong));
+		
+        //Zero out all but 18 bits
+		tempLong &= 0x3FFFF; 
+        
+        // Shift according to resolution
+        tempLong = tempLong >> (MAX30101_SHIFT(resolution));
+        
+        data->red[data->head] = tempLong; //Store this reading into the sense array
+        
+        if (active_leds > 1)
+        {
+            //error = I2C_Peripheral_ReadBytes(temp_bytes, 3);
+           
+            //Burst read three bytes - IR
+            temp[3] = 0;
+            temp[2] = I2C_Master_MasterReadByte(I2C_Master_ACK_DATA);
+            temp[1] = I2C_Master_MasterReadByte(I2C_Master_ACK_DATA);
+            temp[0] = I2C_Master_MasterReadByte(I2C_Master_ACK_DATA);
+        
+            //Convert array to long
+            memcpy(&tempLong, temp, sizeof(tempLong));
+    		
+            //Zero out all but 18 bits
+    		tempLong &= 0x3FFFF;
+            tempLong = tempLong >> (MAX30101_SHIFT(resolution));
+            
+            data->IR[data->head] = tempLong; //Store this reading into the sense array
+        }
+        if (active_leds > 2)
+        {
+            //error = I2C_Peripheral_ReadBytes(temp_bytes, 3);
+            
+            //Burst read three bytes - GREEN
+            temp[3] = 0;
+            temp[2] = I2C_Master_MasterReadByte(I2C_Master_ACK_DATA);
+            temp[1] = I2C_Master_MasterReadByte(I2C_Master_ACK_DATA);
+            temp[0] = I2C_Master_MasterReadByte(I2C_Master_ACK_DATA);
+
+            //Convert array to long
+            memcpy(&tempLong, temp, sizeof(tempLong));
+    		
+            //Zero out all but 18 bits
+    		tempLong &= 0x3FFFF; 
+            
+            tempLong = tempLong >> (MAX30101_SHIFT(resolution));
+            
+            data->green[data->head] = tempLong; //Store this reading into the sense array
+        }
+    }
+    
+    I2C_Master_MasterSendStop();
+    return error;
+}
+
+// Read Multi-LED FIFO Data
+uint8_t MAX30101_ReadMultiLEDFIFO(uint8_t num_samples, MAX30101_MultiData* data)
+{
+    // Raw bytes of a full FIFO with all the slots enabled
+    static uint8_t raw_bytes[MAX30101_FIFO_DEPTH*MAX30101_MAX_SLOTS*MAX30101_BYTES_PER_CHANNEL];
+
+    if ((num_samples == 0) || (num_samples > MAX30101_FIFO_DEPTH))
+    {
+        return MAX30101_ERROR;
+    }
+
+    // Read which LED is active in each slot
+    uint8_t slots[MAX30101_MAX_SLOTS];
+    uint8_t active_slots;
+    uint8_t error = MAX30101_ReadSlotConfig(slots, &active_slots);
+    if (error != MAX30101_OK)
+    {
+        return error;
+    }
+    if (active_slots == 0)
+    {
+        return MAX30101_ERROR;
+    }
+
+    // Read current resolution so that we know how much shift to apply
+    uint8_t resolution;
+    error = MAX30101_ReadRegister(MAX30101_SPO2_CONF, &resolution);
+    if (error != MAX30101_OK)
+    {
+        return error;
+    }
+    resolution &= (~MAX30101_SPO2_PULSEWIDTH_MASK);
+
+    // Get all the samples in a single burst, then split them by slot
+    MAX30101_PROFILE_BEGIN(MAX30101_STAGE_BURST);
+    error = MAX30101_ReadRawFIFOBytes(num_samples, active_slots, raw_bytes);
+    MAX30101_PROFILE_END(MAX30101_STAGE_BURST);
+    if (error == MAX30101_OK)
+    {
+        MAX30101_PROFILE_BEGIN(MAX30101_STAGE_UNPACK);
+        MAX30101_DemuxSlots(raw_bytes, num_samples, slots, active_slots, MAX30101_SHIFT(resolution), data);
+        MAX30101_PROFILE_END(MAX30101_STAGE_UNPACK);
+    }
+    return error;
+}
+
+// Split raw FIFO bytes in one stream per slot
+void MAX30101_DemuxSlots(const uint8_t* raw, uint8_t num_samples,
+                         const uint8_t* slots, uint8_t active_slots,
+                         uint8_t shift, MAX30101_MultiData* data)
+{
+    data->active_slots = active_slots;
+
+    for (uint8_t sample = 0; sample < num_samples; sample++)
+    {
+        data->head++; //Advance the head of the storage struct
+        data->head %= BUFFER_STORAGE_SIZE; //Wrap condition
+
+        for (uint8_t slot = 0; slot < active_slots; slot++)
+        {
+            // Each channel is stored MSB first on three bytes
+            uint32_t value = ((uint32_t)raw[0] << 16) | ((uint32_t)raw[1] << 8) | raw[2];
+            raw += MAX30101_BYTES_PER_CHANNEL;
+
+            //Zero out all but 18 bits and shift according to resolution
+            data->slot[slot][data->head] = (value & 0x3FFFF) >> shift;
+            data->tag[slot][data->head] = slots[slot];
+        }
+    }
+}
+
+//==============================================
+//    MAX30101 FIFO CONFIGURATION FUNCTIONS
+//==============================================
+
+/// Set number of averaged samples
+uint8_t MAX30101_SetSampleAverage(uint8_t samples)
+{
+    return MAX30101_BitMask(MAX30101_FIFO_CONF, MAX30101_SMP_AVG_MASK, samples);
+}
+
+// Enable FIFO rollover
+uint8_t MAX30101_EnableFIFORollover(void)
+{
+    return MAX30101_BitMask(MAX30101_FIFO_CONF, MAX30101_FIFO_ROLLOVER_MASK, MAX30101_FIFO_ROLLOVER_ENABLE);
+}
+
+// Disable FIFO rollover
+uint8_t MAX30101_DisableFIFORollover(void)
+{
+    return MAX30101_BitMask(MAX30101_FIFO_CONF, MAX30101_FIFO_ROLLOVER_MASK, MAX30101_FIFO_ROLLOVER_DISABLE);
+}
+
+// Set number of samples for FIFO Almost Full
+uint8_t MAX30101_SetFIFOAlmostFull(uint8_t samples)
+{
+    return MAX30101_BitMask(MAX30101_FIFO_CONF, MAX30101_FIFO_A_FULL_MASK, 32-samples);
+}
+
+//==============================================
+//     MAX30101 MODE CONFIGURATION FUNCTIONS
+//==============================================
+
+// Shutdown the MAX30101
+uint8_t MAX30101_Shutdown(void)
+{
+    return MAX30101_BitMask(MAX30101_MODE_CONF, MAX30101_SHUTDOWN_MASK, MAX30101_SHUTDOWN_ENABLE);
+}
+
+// Wake Up the MAX30101
+uint8_t MAX30101_WakeUp(void)
+{
+    return MAX30101_BitMask(MAX30101_MODE_CONF, MAX30101_SHUTDOWN_MASK, MAX30101_SHUTDOWN_DISABLE);    
+}
+
+// Reset the MAX30101
+uint8_t MAX30101_Reset(void)
+{
+    // All registers are reset anyway, no need to preserve the others bits
+    return MAX30101_WriteRegister(MAX30101_MODE_CONF, MAX30101_RESET_ENABLE);
+}
+
+// Set current mode of operation
+uint8_t MAX30101_SetMode(uint8_t mode)
+{
+    return MAX30101_BitMask(MAX30101_MODE_CONF, MAX30101_MODE_MASK, mode);
+}
+
+//==============================================
+//     MAX30101 SPO2 CONFIGURATION FUNCTIONS
+//==============================================
+// Set SpO2 ADC Range
+uint8_t MAX30101_SetSpO2ADCRange(uint8_t range)
+{
+    return MAX30101_BitMask(MAX30101_SPO2_CONF, MAX30101_SPO2_ADC_RANGE_MASK, range);
+}
+
+// Set SpO2 Sample Rate
+uint8_t MAX30101_SetSpO2SampleRate(uint8_t sr)
+{
+    return MAX30101_SetSpO2Timing(MAX30101_SPO2_SAMPLE_RATE_MASK, sr);
+}
+
+// Set SpO2 Pulse Widht
+uint8_t MAX30101_SetSpO2PulseWidth(uint8_t pw)
+{
+    return MAX30101_SetSpO2Timing(MAX30101_SPO2_PULSEWIDTH_MASK, pw);
+}
+
+// Set pulse amplitude for a channel
+uint8_t MAX30101_SetLEDPulseAmplitude(uint8_t led_channel, uint8_t pa)
+{
+    if (led_channel > MAX30101_LED_4)
+    {
+        return MAX30101_ERROR;
+    }
+    // The whole register holds the amplitude: write it directly
+    return MAX30101_WriteRegister(MAX30101_LED1_PA + led_channel, pa);
+}
+
+//======================================================
+//     MAX30101 PROXIMITY CONFIGURATION FUNCTIONS
+//======================================================
+// Set pulse amplitude in proximity mode
+uint8_t MAX30101_SetPilotPulseAmplitude(uint8_t pa)
+{
+    return MAX30101_WriteRegister(MAX30101_PILOT_PA, pa);
+}
+
+// Set proximity interrupt threshold
+uint8_t MAX30101_SetProximityThreshold(uint8_t threshold)
+{
+    return MAX30101_WriteRegister(MAX30101_PROX_INT_THRESH, threshold);
+}
+
+//======================================================
+//    MAX30101 MULTI LED MODE CONFIGURATION FUNCTIONS
+//======================================================
+// Enable given slot
+uint8_t MAX30101_EnableSlot(uint8_t slot, uint8_t led)
+{
+    switch(slot)
+    {
+        case 1:
+            return MAX30101_BitMask(MAX30101_MULTI_LED_1, MAX30101_SLOT1_MASK, led);
+            break;
+        case 2:
+            return MAX30101_BitMask(MAX30101_MULTI_LED_1, MAX30101_SLOT2_MASK, led << 4);
+            break;
+        case 3:
+            return MAX30101_BitMask(MAX30101_MULTI_LED_2, MAX30101_SLOT3_MASK, led);
+            break;
+        case 4:
+            return MAX30101_BitMask(MAX30101_MULTI_LED_2, MAX30101_SLOT4_MASK, led << 4);
+            break;
+        default:
+            return MAX30101_ERROR;
+            break;
+    } 
+}
+
+// Disable all slots configurations
+uint8_t MAX30101_DisableSlots(void)
+{
+    uint8_t error = MAX30101_WriteRegister(MAX30101_MULTI_LED_1, 0x00);
+    if ( error == MAX30101_OK)
+    {    
+        error = MAX30101_WriteRegister(MAX30101_MULTI_LED_2, 0x00);
+    }
+    
+    return error;
+}
+
+// Read which LED is active in each slot
+uint8_t MAX30101_ReadSlotConfig(uint8_t* slots, uint8_t* active_slots)
+{
+    // MULTI_LED_1 and MULTI_LED_2 are contiguous: read both in one transaction
+    uint8_t multi_led[2];
+    if (I2C_Peripheral_ReadRegisterMulti(MAX30101_I2C_ADDRESS, MAX30101_MULTI_LED_1, 2, multi_led) != I2C_NO_ERROR)
+    {
+        return MAX30101_DEV_NOT_FOUND;
+    }
+    MAX30101_DecodeSlots(multi_led, slots, active_slots);
+    return MAX30101_OK;
+}
+
+// Get channel of each active slot from slot registers
+void MAX30101_DecodeSlots(const uint8_t* multi_led, uint8_t* slots, uint8_t* active_slots)
+{
+    uint8_t fields[MAX30101_MAX_SLOTS] = {multi_led[0] & MAX30101_SLOT_FIELD_MASK,
+                                          (multi_led[0] >> 4) & MAX30101_SLOT_FIELD_MASK,
+                                          multi_led[1] & MAX30101_SLOT_FIELD_MASK,
+                                          (multi_led[1] >> 4) & MAX30101_SLOT_FIELD_MASK};
+
+    // Only slots with an LED generate data in the FIFO
+    *active_slots = 0;
+    for (uint8_t i = 0; i < MAX30101_MAX_SLOTS; i++)
+    {
+        if ((fields[i] >= MAX30101_SLOT_RED) && (fields[i] <= MAX30101_SLOT_GREEN))
+        {
+            slots[*active_slots] = fields[i];
+            *active_slots += 1;
+        }
+    }
+}
+
+// Get number of channels per FIFO sample
+uint8_t MAX30101_GetActiveLeds(uint8_t* active_leds)
+{
+    uint8_t temp_value;
+    uint8_t error = MAX30101_ReadRegister(MAX30101_MODE_CONF, &temp_value);
+    if (error == MAX30101_OK)
+    {
+        uint8_t slots[MAX30101_MAX_SLOTS];
+        switch(temp_value & (~MAX30101_MODE_MASK))
+        {
+            case MAX30101_HR_MODE:
+                *active_leds = 1;
+                break;
+            case MAX30101_SPO2_MODE:
+                *active_leds = 2;
+                break;
+            case MAX30101_MULTI_MODE:
+                error = MAX30101_ReadSlotConfig(slots, active_leds);
+                break;
+            default:
+                error = MAX30101_ERROR;
+                break;
+        }
+    }
+    return error;
+}
+
+//======================================================
+//            MAX30101 DIE TEMPERATURE FUNCTIONS
+//======================================================
+uint8_t MAX30101_ReadTemperature(float* temperature)
+{
+    uint8_t integer, frac = 0;
+    uint8_t error = MAX30101_ReadRegister(MAX30101_TEMP_INT, &integer);
+    if ( error == MAX30101_OK)
+    {
+        error = MAX30101_ReadRegister(MAX30101_TEMP_FRACT, &frac);
+        if ( error == MAX30101_OK)
+        {
+            *temperature = ((float)(integer)) + frac * 0.0625;
+        }
+    }
+    
+    return error;
+}
+
+uint8_t MAX30101_ReadRawTemperature(int8_t* integer, uint8_t* frac)
+{
+    uint8_t temp;
+    uint8_t error = MAX30101_ReadRegister(MAX30101_TEMP_INT, &temp);
+    if ( error == MAX30101_OK)
+    {
+        *integer = (int8_t)temp;
+        error = MAX30101_ReadRegister(MAX30101_TEMP_FRACT, frac);
+    }
+    
+    return error;
+}
+
+uint8_t MAX30101_StartTemperatureConversion(void)
+{
+    return MAX30101_WriteRegister(MAX30101_TEMP_CONF, 0x01);
+}
+
+//======================================================
+//            MAX30101 PART/REVISION ID FUNCTIONS
+//======================================================
+// Read part ID number
+uint8_t MAX30101_ReadPartID(uint8_t* part_id)
+{
+    return MAX30101_ReadRegister(MAX30101_PART_ID, part_id);
+    
+}
+
+// Read revision ID number
+uint8_t MAX30101_ReadRevisionID(uint8_t* revision_id)
+{
+    return MAX30101_ReadRegister(MAX30101_REVISION_ID, revision_id);
+}
+
+//======================================================
+//            MAX30101 HELPER FUNCTIONS
+//======================================================
+// Simple helper function to read a register from the MAX30101
+uint8_t MAX30101_ReadRegister(uint8_t reg_addr, uint8_t* reg_value)
+{
+    uint8_t error = MAX30101_OK;
+    uint8_t reg_data;
+    if(I2C_Peripheral_ReadRegister(MAX30101_I2C_ADDRESS, reg_addr, &reg_data) == I2C_NO_ERROR)
+    {
+        *reg_value = reg_data;
+    }
+    else
+    {
+        error = MAX30101_DEV_NOT_FOUND;
+    }
+    return error;
+}
+
+// Read contiguous registers in a single transaction
+uint8_t MAX30101_ReadRegisters(uint8_t reg_addr, uint8_t count, uint8_t* data)
+{
+    uint8_t error = MAX30101_OK;
+    if(I2C_Peripheral_ReadRegisterMulti(MAX30101_I2C_ADDRESS, reg_addr, count, data) != I2C_NO_ERROR)
+    {
+        error = MAX30101_DEV_NOT_FOUND;
+    }
+    return error;
+}
+
+// Log all registers
+uint8_t MAX30101_LogRegisters(void (*print_fun)(const char*))
+{
+    MAX30101_RegSnapshot snapshot;
+    uint8_t error = MAX30101_Snapshot(&snapshot);
+    if (error == MAX30101_OK)
+    {
+        MAX30101_PrintSnapshot(print_fun, &snapshot);
+    }
+    return error;
+}
+
+// Read the registers, a burst per range of contiguous registers
+uint8_t MAX30101_Snapshot(MAX30101_RegSnapshot* snapshot)
+{
+    uint8_t error = MAX30101_ReadRegisters(MAX30101_INT_EN_1, sizeof(snapshot->status), snapshot->status);
+    if (error == MAX30101_OK)
+    {
+        error = MAX30101_ReadRegisters(MAX30101_FIFO_CONF, sizeof(snapshot->config), snapshot->config);
+    }
+    if (error == MAX30101_OK)
+    {
+        error = MAX30101_ReadRegisters(MAX30101_TEMP_INT, sizeof(snapshot->temp), snapshot->temp);
+    }
+    if (error == MAX30101_OK)
+    {
+        error = MAX30101_ReadRegisters(MAX30101_PROX_INT_THRESH, sizeof(snapshot->prox), snapshot->prox);
+    }
+    if (error == MAX30101_OK)
+    {
+        error = MAX30101_ReadRegisters(MAX30101_REVISION_ID, sizeof(snapshot->id), snapshot->id);
+    }
+    return error;
+}
+
+// Value of a register in a snapshot
+uint8_t MAX30101_SnapshotValue(const MAX30101_RegSnapshot* snapshot, uint8_t reg_addr, uint8_t* value)
+{
+    if ((reg_addr >= MAX30101_INT_EN_1) && (reg_addr <= MAX30101_FIFO_RP))
+    {
+        *value = snapshot->status[reg_addr - MAX30101_INT_EN_1];
+    }
+    else if ((reg_addr >= MAX30101_FIFO_CONF) && (reg_addr <= MAX30101_MULTI_LED_2))
+    {
+        *value = snapshot->config[reg_addr - MAX30101_FIFO_CONF];
+    }
+    else if ((reg_addr >= MAX30101_TEMP_INT) && (reg_addr <= MAX30101_TEMP_CONF))
+    {
+        *value = snapshot->temp[reg_addr - MAX30101_TEMP_INT];
+    }
+    else if (reg_addr == MAX30101_PROX_INT_THRESH)
+    {
+        *value = snapshot->prox[0];
+    }
+    else if (reg_addr >= MAX30101_REVISION_ID)
+    {
+        *value = snapshot->id[reg_addr - MAX30101_REVISION_ID];
+    }
+    else
+    {
+        return 0;
+    }
+    return 1;
+}
+
+// Print the registers of a snapshot
+void MAX30101_PrintSnapshot(void (*print_fun)(const char*), const MAX30101_RegSnapshot* snapshot)
+{
+    MAX30101_PrintRange(print_fun, MAX30101_INT_EN_1, snapshot->status, sizeof(snapshot->status));
+    MAX30101_PrintRange(print_fun, MAX30101_FIFO_CONF, snapshot->config, sizeof(snapshot->config));
+    MAX30101_PrintRange(print_fun, MAX30101_TEMP_INT, snapshot->temp, sizeof(snapshot->temp));
+    MAX30101_PrintRange(print_fun, MAX30101_PROX_INT_THRESH, snapshot->prox, sizeof(snapshot->prox));
+    MAX30101_PrintRange(print_fun, MAX30101_REVISION_ID, snapshot->id, sizeof(snapshot->id));
+}
+
+uint8_t MAX30101_PrintRegister(void (*print_fun)(const char*), uint8_t reg_addr)
+{
+    uint8_t value;
+    uint8_t error = MAX30101_ReadRegister(reg_addr, &value);
+    if (error == MAX30101_OK)
+    {
+        MAX30101_Line line;
+        MAX30101_Format_Clear(&line);
+        MAX30101_Format_String(&line, "[0x");
+        MAX30101_Format_Hex(&line, reg_addr, 2);
+        MAX30101_Format_String(&line, "] - 0x");
+        MAX30101_Format_Hex(&line, value, 2);
+        print_fun(MAX30101_Format_End(&line));
+    }
+    return error;
+}
+
+// Print boot phases
+void MAX30101_PrintBootTrace(void (*print_fun)(const char*), const MAX30101_BootTrace* trace)
+{
+    const char* phase_names[MAX30101_BOOT_PHASES] = {"I2C start", "Present", "Reset", "Status", "Config"};
+    MAX30101_Line line;
+    for (uint8_t i = 0; i < MAX30101_BOOT_PHASES; i++)
+    {
+        MAX30101_Format_Clear(&line);
+        MAX30101_Format_String(&line, "[BOOT] ");
+        MAX30101_Format_String(&line, phase_names[i]);
+        if (i == trace->failed_phase)
+        {
+            MAX30101_Format_String(&line, ": failed");
+            print_fun(MAX30101_Format_End(&line));
+            break;
+        }
+        MAX30101_Format_String(&line, ": ");
+        MAX30101_Format_Dec(&line, trace->phase_end[i] - trace->start);
+        MAX30101_Format_String(&line, " (polls: ");
+        MAX30101_Format_Dec(&line, trace->polls[i]);
+        MAX30101_Format_Char(&line, ')');
+        print_fun(MAX30101_Format_End(&line));
+    }
+}
+
+// Set function called after register writes
+void MAX30101_SetWriteHook(void (*hook)(uint8_t reg_addr, uint8_t count, const uint8_t* data))
+{
+    MAX30101_write_hook = hook;
+}
+
+// Simple helper function to write a register to the MAX30101
+static uint8_t MAX30101_WriteRegister(uint8_t reg_addr, uint8_t reg_data)
+{
+    uint8_t error = MAX30101_OK;
+    if(I2C_Peripheral_WriteRegister(MAX30101_I2C_ADDRESS, reg_addr, reg_data) != I2C_NO_ERROR)
+    {
+        error = MAX30101_DEV_NOT_FOUND;
+    }
+    else if (MAX30101_write_hook != NULL)
+    {
+        MAX30101_write_hook(reg_addr, 1, &reg_data);
+    }
+    return error;
+}
+
+// Write contiguous registers in a single transaction
+uint8_t MAX30101_WriteRegisters(uint8_t reg_addr, uint8_t count, const uint8_t* data)
+{
+    uint8_t error = MAX30101_OK;
+    if(I2C_Peripheral_WriteRegisterMulti(MAX30101_I2C_ADDRESS, reg_addr, count, data) != I2C_NO_ERROR)
+    {
+        error = MAX30101_DEV_NOT_FOUND;
+    }
+    else if (MAX30101_write_hook != NULL)
+    {
+        MAX30101_write_hook(reg_addr, count, data);
+    }
+    return error;
+}
+
+// Print contiguous registers, one per line
+static void MAX30101_PrintRange(void (*print_fun)(const char*), uint8_t reg_addr, const uint8_t* values,
+                                uint8_t count)
+{
+    MAX30101_Line line;
+    for (uint8_t i = 0; i < count; i++, reg_addr++)
+    {
+        // 0x0B is reserved
+        if (reg_addr != 0x0B)
+        {
+            MAX30101_Format_Clear(&line);
+            MAX30101_Format_String(&line, "[0x");
+            MAX30101_Format_Hex(&line, reg_addr, 2);
+            MAX30101_Format_String(&line, "] - 0x");
+            MAX30101_Format_Hex(&line, values[i], 2);
+            print_fun(MAX30101_Format_End(&line));
+        }
+    }
+}
+
+static void MAX30101_BootMark(MAX30101_BootTrace* trace, uint8_t phase, uint16_t polls)
+{
+    if (trace != NULL)
+    {
+        trace->phase_end[phase] = (trace->get_time != NULL) ? trace->get_time() : 0;
+        trace->polls[phase] = polls;
+    }
+}
+
+// Check that the ADC reaches the sample rate with the pulse width and the active slots
+static uint8_t MAX30101_CheckRate(uint8_t mode_conf, const uint8_t* multi_led, uint8_t spo2_conf)
+{
+    uint8_t slots = 0;
+    uint8_t channels[MAX30101_MAX_SLOTS];
+    switch (mode_conf & (~MAX30101_MODE_MASK))
+    {
+        case MAX30101_HR_MODE:
+            slots = 1;
+            break;
+        case MAX30101_SPO2_MODE:
+            slots = 2;
+            break;
+        case MAX30101_MULTI_MODE:
+            MAX30101_DecodeSlots(multi_led, channels, &slots);
+            break;
+        default:
+            break;
+    }
+    // Nothing is acquired without slots
+    if (slots == 0)
+    {
+        return MAX30101_OK;
+    }
+    return MAX30101_Rate_Check(slots, spo2_conf & (~MAX30101_SPO2_SAMPLE_RATE_MASK),
+                               spo2_conf & (~MAX30101_SPO2_PULSEWIDTH_MASK));
+}
+
+// Change sample rate or pulse width of SPO2_CONF if the result is allowed with the active slots
+static uint8_t MAX30101_SetSpO2Timing(uint8_t mask, uint8_t thing)
+{
+    // MODE_CONF, SPO2_CONF; MULTI_LED_1, MULTI_LED_2
+    uint8_t conf[2];
+    uint8_t multi_led[2];
+    uint8_t error = MAX30101_ReadRegisters(MAX30101_MODE_CONF, sizeof(conf), conf);
+    if (error == MAX30101_OK)
+    {
+        error = MAX30101_ReadRegisters(MAX30101_MULTI_LED_1, sizeof(multi_led), multi_led);
+    }
+    if (error == MAX30101_OK)
+    {
+        uint8_t spo2_conf = (conf[1] & mask) | thing;
+        error = MAX30101_CheckRate(conf[0], multi_led, spo2_conf);
+        if (error == MAX30101_OK)
+        {
+            error = MAX30101_WriteRegister(MAX30101_SPO2_CONF, spo2_conf);
+        }
+    }
+    return error;
+}
+
+// Simple helper function to perform bit mask operations
+static uint8_t MAX30101_BitMask(uint8_t reg_addr, uint8_t mask, uint8_t thing)
+{
+    uint8_t reg_data;
+    uint8_t error = MAX30101_ReadRegister(reg_addr, &reg_data);
+    if (error == MAX30101_OK)
+    {
+        reg_data = reg_data & mask;
+        error = MAX30101_WriteRegister(reg_addr, reg_data | thing);
+    }
+    return error;
+}
+
+/* [] END OF FILE */
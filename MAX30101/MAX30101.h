@@ -1,569 +1,993 @@
-/**
-*   \file MAX30101.h
-*   
-*   \brif Header file for MAX30101 Library.
-*/
-
-
-#ifndef __MAX30101_H__
-    #define __MAX30101_H__
-    
-    #include "cytypes.h"
-    #include "MAX30101_Defs.h"
-
-    /**
-    *   \brief Number of samples stored in the circular buffer.
-    *
-    *   This value sets the number of samples stored in the
-    *   circular buffer with MAX30101 data. If you have
-    *   enough RAM, you can increase it as long as you 
-    *   have memory available.
-    */
-    #define BUFFER_STORAGE_SIZE 8
-    
-    /**
-    *   \brief Circular buffer for MAX30101 data.
-    */
-    typedef struct 
-    {
-        uint32_t red[BUFFER_STORAGE_SIZE];      ///< Data from RED channel.
-        uint32_t IR[BUFFER_STORAGE_SIZE];       ///< Data from IR channel.
-        uint32_t green[BUFFER_STORAGE_SIZE];    ///< Data from GREEN channel.
-        uint8_t head;   ///< Current head of the circular buffer.
-        uint8_t tail;   ///< Current tail of the circular buffer.
-    } MAX30101_Data; //This is our circular buffer of readings from the sensor
-
-    
-    //==============================================
-    //           MAX30101 FUNCTIONS
-    //==============================================
-    /**
-    *   \brief Start the MAX30101.
-    *   \retval #MAX30101_OK
-    */
-    uint8_t MAX30101_Start(void);
-    
-    /**
-    *   \brief Check if MAX30101 is present on I2C bus.
-    *
-    *   \retval #MAX30101_OK if device is present.
-    *   \retval #MAX30101_DEV_NOT_FOUND if device is not present.
-    */
-    uint8_t MAX30101_IsDevicePresent(void);
-    
-    //==============================================
-    //          MAX30101 INTERRUPT FUNCTIONS
-    //==============================================
-    
-    /**
-    *   \brief Check if FIFO A Full interrupt was set.
-    *
-    *   \param flag pointer to variable where result of the check will be placed. 1 equal to true.
-    *   \retval #MAX30101_OK if device is present.
-    *   \retval #MAX30101_DEV_NOT_FOUND if device is not present.
-    */
-    uint8_t MAX30101_IsFIFOAFull(uint8_t* flag);
-    
-    /**
-    *   \brief Check if PPG Ready interrupt was set.
-    *
-    *   \param flag pointer to variable where result of the check will be placed. 1 equal to true.
-    *   \retval #MAX30101_OK if device is present.
-    *   \retval #MAX30101_DEV_NOT_FOUND if device is not present.
-    */
-    uint8_t MAX30101_IsPPGReady(uint8_t* flag);
-    
-    /**
-    *   \brief Check if ALC Overflow interrupt was set.
-    *
-    *   \param flag pointer to variable where result of the check will be placed. 1 equal to true.
-    *   \retval #MAX30101_OK if device is present.
-    *   \retval #MAX30101_DEV_NOT_FOUND if device is not present.
-    */
-    uint8_t MAX30101_IsALCOverflow(uint8_t* flag);
-    
-    /**
-    *   \brief Check if power ready interrupt was set.
-    *
-    *   \param flag pointer to variable where result of the check will be placed. 1 equal to true.
-    *   \retval #MAX30101_OK if device is present.
-    *   \retval #MAX30101_DEV_NOT_FOUND if device is not present.
-    */
-    uint8_t MAX30101_IsPowerReady(uint8_t* flag);
-    
-    /**
-    *   \brief Check if temperature ready interrupt was set.
-    *
-    *   \param flag pointer to variable where result of the check will be placed. 1 equal to true.
-    *   \retval #MAX30101_OK if device is present.
-    *   \retval #MAX30101_DEV_NOT_FOUND if device is not present.
-    */
-    uint8_t MAX30101_IsTempReady(uint8_t* flag);
-    
-    /**
-    *   \brief Enable FIFO A Full interrupt.
-    *
-    *   \retval #MAX30101_OK if device is present.
-    *   \retval #MAX30101_DEV_NOT_FOUND if device is not present.
-    */
-    uint8_t MAX30101_EnableFIFOAFullInt(void);
-    
-    /**
-    *   \brief Enable PPG Ready interrupt.
-    *
-    *   \retval #MAX30101_OK if device is present.
-    *   \retval #MAX30101_DEV_NOT_FOUND if device is not present.
-    */
-    uint8_t MAX30101_EnablePPGReadyInt(void);
-    
-    /**
-    *   \brief Enable ALC Overflow interrupt.
-    *
-    *   \retval #MAX30101_OK if device is present.
-    *   \retval #MAX30101_DEV_NOT_FOUND if device is not present.
-    */
-    uint8_t MAX30101_EnableALCOverflowInt(void);
-    
-    /**
-    *   \brief Enable Temperature ready interrupt.
-    *
-    *   \retval #MAX30101_OK if device is present.
-    *   \retval #MAX30101_DEV_NOT_FOUND if device is not present.
-    */
-    uint8_t MAX30101_EnableTempReadyInt(void);
-    
-    /**
-    *   \brief Disable FIFO A Full interrupt.
-    *
-    *   \retval #MAX30101_OK if device is present.
-    *   \retval #MAX30101_DEV_NOT_FOUND if device is not present.
-    */
-    uint8_t MAX30101_DisableFIFOAFullInt(void);
-    
-    /**
-    *   \brief Disable PPG ready interrupt.
-    *
-    *   \retval #MAX30101_OK if device is present.
-    *   \retval #MAX30101_DEV_NOT_FOUND if device is not present.
-    */
-    uint8_t MAX30101_DisablePPGReadyInt(void);
-    
-    /**
-    *   \brief Disable ALC Overflow interrupt.
-    *
-    *   \retval #MAX30101_OK if device is present.
-    *   \retval #MAX30101_DEV_NOT_FOUND if device is not present.
-    */
-    uint8_t MAX30101_DisableALCOverflowInt(void);
-    
-    /**
-    *   \brief Disable temperature ready interrupt.
-    *
-    *   \retval #MAX30101_OK if device is present.
-    *   \retval #MAX30101_DEV_NOT_FOUND if device is not present.  
-    */
-    uint8_t MAX30101_DisableTempReadyInt(void);
-    
-    //==============================================
-    //          MAX30101 FIFO FUNCTIONS
-    //==============================================
-    
-    /**
-    *   \brief Read FIFO Write pointer.
-    *
-    *   \param wr pointer to variable where the write pointer will be saved.
-    *   \retval #MAX30101_OK if device is present.
-    *   \retval #MAX30101_DEV_NOT_FOUND if device is not present.  
-    */
-    uint8_t MAX30101_ReadWritePointer(uint8_t* wr);
-    
-    /**
-    *   \brief Read FIFO Overflow counter.
-    *
-    *   \param oc pointer to variable where the overflow counter will be saved.
-    *   \retval #MAX30101_OK if device is present.
-    *   \retval #MAX30101_DEV_NOT_FOUND if device is not present.  
-    */
-    uint8_t MAX30101_ReadOverflowCounter(uint8_t* oc);
-    
-    /**
-    *   \brief Read FIFO read pointer.
-    *
-    *   \param oc pointer to variable where the read pointer will be saved.
-    *   \retval #MAX30101_OK if device is present.
-    *   \retval #MAX30101_DEV_NOT_FOUND if device is not present.  
-    */
-    uint8_t MAX30101_ReadReadPointer(uint8_t* rr);
-    
-    /**
-    *   \brief Clear FIFO.
-    *
-    *   \retval #MAX30101_OK if device is present.
-    *   \retval #MAX30101_DEV_NOT_FOUND if device is not present.  
-    */
-    uint8_t MAX30101_ClearFIFO(void);
-    
-    /**
-    *   \brief Read FIFO data as single bytes.
-    *
-    *   This function reads the data in the FIFO of the MAX30101
-    *   according to the specified settings. Based on the number
-    *   of samples to be read and the number of active leds this
-    *   function will perform a complete reading of the FIFO.
-    *   Data will be returned as raw uint8_t data.
-    *   \param[in] num_samples number of samples to be read
-    *   \param[in] active_leds number of active leds
-    *   \param[out] data pointer to variable storing raw data from FIFO
-    *
-    *   \retval #MAX30101_OK if device is present.
-    *   \retval #MAX30101_DEV_NOT_FOUND if device is not present.  
-    */
-    uint8_t MAX30101_ReadRawFIFOBytes(uint8_t num_samples, uint8_t active_leds, uint8_t* data);
-    
-    /**
-    *   \brief Read FIFO data.
-    *
-    *   This function reads the data in the FIFO of the MAX30101
-    *   according to the specified settings. Based on the number
-    *   of samples to be read and the number of active leds this
-    *   function will perform a complete reading of the FIFO.
-    *   Data will be returned as uint32_t.
-    *   \param[in] num_samples number of samples to be read
-    *   \param[in] active_leds number of active leds
-    *   \param[out] data pointer to variable storing raw data from FIFO
-    *
-    *   \retval #MAX30101_OK if device is present.
-    *   \retval #MAX30101_DEV_NOT_FOUND if device is not present.  
-    */
-    uint8_t MAX30101_ReadRawFIFO(uint8_t num_samples, uint8_t active_leds, uint32_t* data);
-    
-    /**
-    *   \brief Read FIFO data and place them in a circular buffer.
-    *
-    *   This function reads the data in the FIFO of the MAX30101
-    *   according to the specified settings. Based on the number
-    *   of samples to be read and the number of active leds this
-    *   function will perform a complete reading of the FIFO.
-    *   Data will be returned inside the circular buffer passed
-    *   in as parameter to the function.
-    *   \param[in] num_samples number of samples to be read
-    *   \param[in] active_leds number of active leds
-    *   \param[out] data pointer to circular buffer storing data from FIFO
-    *   \retval #MAX30101_OK if device is present.
-    *   \retval #MAX30101_DEV_NOT_FOUND if device is not present.  
-    */
-    uint8_t MAX30101_ReadFIFO(uint8_t num_samples, uint8_t active_leds, MAX30101_Data* data);
-    
-    //==============================================
-    //     MAX30101 FIFO CONFIGURATION FUNCTIONS
-    //==============================================
-    
-    /**
-    *   \brief Set the number of samples averaged per sample in FIFO.
-    *   
-    *   This function sets the number of samples to be averaged per FIFO sample.
-    *   Available choices go from 1 to 32.
-    *   \param samples number of samples to be averaged.
-    *   \retval #MAX30101_OK if no error occurred.
-    *   \retval #MAX30101_DEV_NOT_FOUND if device is not present on the I2C bus.
-    *   \retval #MAX30101_ERROR if error occurred during configuration.
-    */
-    uint8_t MAX30101_SetSampleAverage(uint8_t samples);
-    
-    /**
-    *   \brief Enable FIFO Rollover.
-    *   
-    *   This function enables FIFO Rollover. When enabled, 
-    *   the FIFO Address rolls over to zero and the FIFO continues to fill with new data. 
-    *   \retval #MAX30101_OK if no error occurred.
-    *   \retval #MAX30101_DEV_NOT_FOUND if device is not present on the I2C bus.
-    */
-    uint8_t MAX30101_EnableFIFORollover(void);
-    
-    /**
-    *   \brief Disable FIFO Rollover.
-    *
-    *   This function disables FIFO Rollover. When disabled, 
-    *   FIFO is not updated until #MAX30101_FIFO_DATA is read or the 
-    *   #MAX30101_FIFO_WP or #MAX30101_FIFO_RP positions are changed.
-    *   \retval #MAX30101_OK if no error occurred.
-    *   \retval #MAX30101_DEV_NOT_FOUND if device is not present on the I2C bus.
-    */
-    uint8_t MAX30101_DisableFIFORollover(void);
-    
-    /**
-    *   \brief Set number of samples for FIFO Almost Full.
-    *
-    *   This function sets the number of samples required to
-    *   trigger a FIFO Almost Full interrupt. 
-    *   \param[in] samples number of samples required to trigger a FIFO A FULL interrupt.
-    *   \retval #MAX30101_OK if no error occurred.
-    *   \retval #MAX30101_DEV_NOT_FOUND if device is not present on the I2C bus.
-    */
-    uint8_t MAX30101_SetFIFOAlmostFull(uint8_t samples);
-    
-    //==============================================
-    //     MAX30101 MODE CONFIGURATION FUNCTIONS
-    //==============================================
-    
-    /**
-    *   \brief Shutdown the MAX30101.
-    *
-    *   The MAX30101 can be put into a power-save mode. 
-    *   While in power-save mode, all registers retain their values, and write/read operations
-    *   function as normal. All interrupts are cleared to zero in this mode.
-    *   \retval #MAX30101_OK if no error occurred.
-    *   \retval #MAX30101_DEV_NOT_FOUND if device is not present on the I2C bus.
-    */
-    uint8_t MAX30101_Shutdown(void);
-    
-    /**
-    *   \brief Wake up the MAX30101.
-    *
-    *   \retval #MAX30101_OK if no error occurred.
-    *   \retval #MAX30101_DEV_NOT_FOUND if device is not present on the I2C bus.
-    */
-    uint8_t MAX30101_WakeUp(void);
-    
-    /**
-    *   \brief Reset the MAX30101.
-    *
-    *   This function resets the MAX30101 via software by setting
-    *   the reset bit in the register #MAX30101_MODE_CONF to 1.
-    *   All configuration, threshold, and data registers are reset 
-    *   to their power-on-state through a power-on reset
-    *   \retval #MAX30101_OK if no error occurred.
-    *   \retval #MAX30101_DEV_NOT_FOUND if device is not present on the I2C bus.
-    */
-    uint8_t MAX30101_Reset(void);
-    
-    /**
-    *   \brief Set the operation mode for the MAX30101.
-    *   
-    *   This function sets the current LED pulse amplitude mode for 
-    *   the MAX30101. Available choices are:
-    *       - #MAX30101_HR_MODE: RED Led ON
-    *       - #MAX30101_SPO2_MODE: RED and IR Led ON
-    *       - #MAX30101_MULTI_MODE: configurable Leds
-    *   \param mode mode to be set in the #MAX30101_MODE_CONF register
-    *   \retval #MAX30101_OK if no error occurred.
-    *   \retval #MAX30101_DEV_NOT_FOUND if device is not present on the I2C bus.
-    *   \retval #MAX30101_ERROR if error occurred during configuration.
-    */
-    uint8_t MAX30101_SetMode(uint8_t mode);
-    
-    //==============================================
-    //     MAX30101 SPO2 CONFIGURATION FUNCTIONS
-    //==============================================
-      
-    /**
-    *   \brief Set MAX30101 SpO2 ADC Range.
-    *
-    *   This function sets the value for the SpO2 ADC
-    *   range. Values that can be passed as input to this
-    *   function are:
-    *       - #MAX30101_ADC_RANGE_2048
-    *       - #MAX30101_ADC_RANGE_4096
-    *       - #MAX30101_ADC_RANGE_8192
-    *       - #MAX30101_ADC_RANGE_16384
-    *   \param range the value of SpO2 ADC range to be set.
-    *   \retval #MAX30101_OK if no error occurred.
-    *   \retval #MAX30101_DEV_NOT_FOUND if device is not present on the I2C bus.
-    *   \retval #MAX30101_ERROR if error occurred during configuration.
-    */
-    uint8_t MAX30101_SetSpO2SampleRate(uint8_t range);
-    
-    /**
-    *   \brief Set MAX30101 SpO2 Sample Rate.
-    *
-    *   This function sets the value for the SpO2 sample
-    *   rate. Values that can be passed as input to this
-    *   function are:
-    *       - #MAX30101_SAMPLE_RATE_50
-    *       - #MAX30101_SAMPLE_RATE_100
-    *       - #MAX30101_SAMPLE_RATE_200
-    *       - #MAX30101_SAMPLE_RATE_400
-    *       - #MAX30101_SAMPLE_RATE_800
-    *       - #MAX30101_SAMPLE_RATE_1000
-    *       - #MAX30101_SAMPLE_RATE_1600
-    *       - #MAX30101_SAMPLE_RATE_3200
-    *   \param sr the value of SpO2 sample rate to be set.
-    *   \retval #MAX30101_OK if no error occurred.
-    *   \retval #MAX30101_DEV_NOT_FOUND if device is not present on the I2C bus.
-    *   \retval #MAX30101_ERROR if error occurred during configuration.
-    */
-    uint8_t MAX30101_SetSpO2ADCRange(uint8_t sr);
-    
-    /**
-    *   \brief Set MAX30101 LED Pulse Width.
-    *
-    *   This function sets the value for the SpO2 sample
-    *   rate. Values that can be passed as input to this
-    *   function are:
-    *       - #MAX30101_PULSEWIDTH_69
-    *       - #MAX30101_PULSEWIDTH_118
-    *       - #MAX30101_PULSEWIDTH_215
-    *       - #MAX30101_PULSEWIDTH_411
-    *   \param pw the value of LED Pulse Width to be set.
-    *   \retval #MAX30101_OK if no error occurred.
-    *   \retval #MAX30101_DEV_NOT_FOUND if device is not present on the I2C bus.
-    *   \retval #MAX30101_ERROR if error occurred during configuration.
-    */
-    uint8_t MAX30101_SetSpO2PulseWidth(uint8_t pw);
-    
-    /**
-    *   \brief Set the pulse amplitude for a MAX30101 channel.
-    *   
-    *   This function sets the current LED pulse amplitude a given
-    *   channel of the MAX30101.
-    *   Pulse amplitude values range from 0x00 to 0xFF.
-    *   \param led_channel the channel for which to set the pulse amplitude.
-    *   \param pa the value of pulse amplitude to be set,.
-    *   \retval #MAX30101_OK if no error occurred.
-    *   \retval #MAX30101_DEV_NOT_FOUND if device is not present on the I2C bus.
-    *   \retval #MAX30101_ERROR if error occurred during configuration.
-    */
-    uint8_t MAX30101_SetLEDPulseAmplitude(uint8_t led_channel, uint8_t pa);
-    
-    //======================================================
-    //    MAX30101 MULTI LED MODE CONFIGURATION FUNCTIONS
-    //======================================================
-    /**
-    *   \brief Enable a slot in Multi-LED mode.
-    *   
-    *   In multi-LED mode, each sample is split into up to four time slots, 
-    *   SLOT1 through SLOT4. These control registers determine which LED is
-    *   active in each time slot, making for a very flexible configuration.
-    *   In MAX30101 Both LED3 and LED4 are wired to Green LED. 
-    *   Green LED sinks current out of #MAX30101_LED3_PA and #MAX30101_LED4_PA 
-    *   if enabled in multi-LED mode.
-    *   
-    *   \param slot the slot to be enabled (1 through 4)
-    *   \param led the led to be activated. It can be one of:
-    *       - #MAX30101_SLOT_RED
-    *       - #MAX30101_SLOT_IR
-    *       - #MAX30101_SLOT_GREEN
-    *       - #MAX30101_SLOT_NONE
-    *   \retval #MAX30101_OK if no error occurred.
-    *   \retval #MAX30101_DEV_NOT_FOUND if device is not present on the I2C bus.
-    *   \retval #MAX30101_ERROR if error occurred during configuration.
-    */
-    uint8_t MAX30101_EnableSlot(uint8_t slot, uint8_t led);
-    
-    /**
-    *   \brief Disable all slot configurations in Multi-LED mode.
-    *
-    *   Disable all the configurations that were set for Multi-LED mode.
-    *   \retval #MAX30101_OK if no error occurred.
-    *   \retval #MAX30101_DEV_NOT_FOUND if device is not present on the I2C bus.
-    *   \retval #MAX30101_ERROR if error occurred during configuration.
-    */
-    uint8_t MAX30101_DisableSlots(void);
-    
-    //======================================================
-    //            MAX30101 DIE TEMPERATURE FUNCTIONS
-    //======================================================
-    
-    /**
-    *   \brief Read Die Temperature from MAX30101 in float format.
-    *
-    *   This functions reads the die temperature data from the MAX30101
-    *   and returns its value in float format. The temperature value
-    *   can be used to calibrate the SpO2 readings.
-    *   \param[out] temperature float value of die temperature
-    *   \retval #MAX30101_OK if no error occurred.
-    *   \retval #MAX30101_DEV_NOT_FOUND if device is not present on the I2C bus.
-    *   \retval #MAX30101_ERROR if error occurred during configuration.   
-    */
-    uint8_t MAX30101_ReadTemperature(float* temperature);
-    
-    /**
-    *   \brief Read Die Temperature from MAX30101 in raw format.
-    *
-    *   This functions reads the die temperature data from the MAX30101
-    *   and returns its integer and fractional parts. The temperature value
-    *   can be used to calibrate the SpO2 readings.
-    *   \param[out] integer integer value of die temperature
-    *   \param[out] frac fractional value of die temperature
-    *   \retval #MAX30101_OK if no error occurred.
-    *   \retval #MAX30101_DEV_NOT_FOUND if device is not present on the I2C bus.
-    *   \retval #MAX30101_ERROR if error occurred during configuration.   
-    */
-    uint8_t MAX30101_ReadRawTemperature(int8_t* integer, uint8_t* frac);
-    
-    
-    /**
-    *   \brief Start temperature conversion on the MAX30101.
-    *
-    *   \retval #MAX30101_OK if no error occurred.
-    *   \retval #MAX30101_DEV_NOT_FOUND if device is not present on the I2C bus.
-    *   \retval #MAX30101_ERROR if error occurred during configuration.     
-    */
-    uint8_t MAX30101_StartTemperatureConversion(void);
-    
-    //======================================================
-    //            MAX30101 PART/REVISION ID FUNCTIONS
-    //======================================================
-    /**
-    *   \brief Read Part ID number from MAX30101.
-    *   
-    *   \param part_id pointer to variable where part ID value will be stored.
-    *   \retval #MAX30101_OK if no error occurred.
-    *   \retval #MAX30101_DEV_NOT_FOUND if device is not present on the I2C bus.
-    *   \retval #MAX30101_ERROR if error occurred during configuration.
-    */
-    uint8_t MAX30101_ReadPartID(uint8_t* part_id);
-    
-    /**
-    *   \brief Read Revision ID number from MAX30101.
-    *   
-    *   \param revision_id pointer to variable where revision ID value will be stored.
-    *   \retval #MAX30101_OK if no error occurred.
-    *   \retval #MAX30101_DEV_NOT_FOUND if device is not present on the I2C bus.
-    *   \retval #MAX30101_ERROR if error occurred during configuration.
-    */
-    uint8_t MAX30101_ReadRevisionID(uint8_t* revision_id);
-    
-    //======================================================
-    //            MAX30101 HELPER FUNCTIONS
-    //======================================================
-    /**
-    *   \brief Read a register from the MAX30101.
-    *   
-    *   \param[in] reg_addr address of the register to be read.
-    *   \param[out] reg_value pointer to variable where register data will be stored.
-    *   \retval #MAX30101_OK if no error occurred.
-    *   \retval #MAX30101_DEV_NOT_FOUND if device is not present on the I2C bus.
-    *   \retval #MAX30101_ERROR if error occurred during configuration.
-    */
-    uint8_t MAX30101_ReadRegister(uint8_t reg_addr, uint8_t* reg_value);
-    
-    /**
-    *   \brief Log the values of all MAX30101 registers.
-    *   
-    *   This function logs all the current values of the 
-    *   MAX30101 registers. Be aware that reading some of the
-    *   registers may clear interrupts.
-    *   \param[in] fun_ptr pointer to the function used for logging.
-    *   \param[in] reg_addr address of the register to be read.
-    *   \retval #MAX30101_OK if no error occurred.
-    *   \retval #MAX30101_DEV_NOT_FOUND if device is not present on the I2C bus.
-    *   \retval #MAX30101_ERROR if error occurred during configuration.
-    */
-    uint8_t MAX30101_LogRegisters(void (*fun_ptr)(const char*));
-    
-    /**
-    *   \brief Print the value of a MAX30101 register.
-    *   
-    *   This function prints the value of a MAX30101 register.
-    *   Be aware that reading some of the registers may cler interrupts.
-    *   registers fun_ptr pointer to the function used for logging.
-    *   \param[in] reg_addr address of the register to be read.
-    *   \retval #MAX30101_OK if no error occurred.
-    *   \retval #MAX30101_DEV_NOT_FOUND if device is not present on the I2C bus.
-    *   \retval #MAX30101_ERROR if error occurred during configuration.
-    */
-    uint8_t MAX30101_PrintRegister(void (*print_fun)(const char*), uint8_t reg_addr);
-
-#endif
-/* [] END OF FILE */
+/**
+*   \file MAX30101.h
+*   
+*   \brif Header file for MAX30101 Library.
+*/
+
+
+#ifndef __MAX30101_H__
+    #define __MAX30101_H__
+    
+    #include "cytypes.h"
+    #include "MAX30101_Defs.h"
+
+    /**
+    *   \brief Number of samples stored in the circular buffer.
+    *
+    *   This value sets the number of samples stored in the
+    *   circular buffer with MAX30101 data. If you have
+    *   enough RAM, you can increase it as long as you 
+    *   have memory available. With at least 32 samples
+    *   (the FIFO depth) the samples of a whole FIFO read are
+    *   kept until the next read, e.g., for processing.
+    *   It must be a power of 2: the ring helpers (e.g.,
+    *   MAX30101_Fixed.h, MAX30101_Stats_AddRing) wrap the
+    *   index with a mask.
+    */
+    #ifndef BUFFER_STORAGE_SIZE
+        #define BUFFER_STORAGE_SIZE 32
+    #endif
+    
+    #if ((BUFFER_STORAGE_SIZE & (BUFFER_STORAGE_SIZE - 1)) != 0)
+        #error "BUFFER_STORAGE_SIZE must be a power of 2"
+    #endif
+    
+    /**
+    *   \brief Circular buffer for MAX30101 data.
+    */
+    typedef struct 
+    {
+        uint32_t red[BUFFER_STORAGE_SIZE];      ///< Data from RED channel.
+        uint32_t IR[BUFFER_STORAGE_SIZE];       ///< Data from IR channel.
+        uint32_t green[BUFFER_STORAGE_SIZE];    ///< Data from GREEN channel.
+        uint8_t head;   ///< Current head of the circular buffer.
+        uint8_t tail;   ///< Current tail of the circular buffer.
+    } MAX30101_Data; //This is our circular buffer of readings from the sensor
+
+    /**
+    *   \brief Maximum number of time slots in Multi-LED mode.
+    */
+    #define MAX30101_MAX_SLOTS 4
+
+    /**
+    *   \brief Circular buffer for MAX30101 Multi-LED mode data.
+    *
+    *   Each active time slot is demultiplexed into its own stream.
+    *   The channel of each sample is taken from the slot configuration
+    *   in #MAX30101_MULTI_LED_1 and #MAX30101_MULTI_LED_2, so that
+    *   the same LED can be used in more than one slot (e.g., GREEN
+    *   in SLOT1 and SLOT3).
+    */
+    typedef struct
+    {
+        uint32_t slot[MAX30101_MAX_SLOTS][BUFFER_STORAGE_SIZE]; ///< Data from each time slot.
+        uint8_t tag[MAX30101_MAX_SLOTS][BUFFER_STORAGE_SIZE];   ///< Channel of each sample (#MAX30101_SLOT_RED, #MAX30101_SLOT_IR, #MAX30101_SLOT_GREEN).
+        uint8_t active_slots;   ///< Number of active slots during the last read.
+        uint8_t head;           ///< Current head of the circular buffer.
+        uint8_t tail;           ///< Current tail of the circular buffer.
+    } MAX30101_MultiData;
+
+    /**
+    *   \brief Complete configuration of the MAX30101.
+    *
+    *   Each field holds the value of the register with the same name and
+    *   can be composed with the macros in MAX30101_Defs.h, e.g.:
+    *   \code
+    *   config.fifo_conf = MAX30101_SAMPLE_AVG_2 | MAX30101_CONF_FIFO_ROLLOVER | MAX30101_CONF_FIFO_A_FULL(32);
+    *   config.spo2_conf = MAX30101_ADC_RANGE_4096 | MAX30101_SAMPLE_RATE_400 | MAX30101_PULSEWIDTH_69;
+    *   \endcode
+    *   The configuration is written with #MAX30101_ApplyConfig.
+    */
+    typedef struct
+    {
+        uint8_t int_en_1;       ///< Value of #MAX30101_INT_EN_1.
+        uint8_t int_en_2;       ///< Value of #MAX30101_INT_EN_2.
+        uint8_t fifo_conf;      ///< Value of #MAX30101_FIFO_CONF.
+        uint8_t mode_conf;      ///< Value of #MAX30101_MODE_CONF.
+        uint8_t spo2_conf;      ///< Value of #MAX30101_SPO2_CONF.
+        uint8_t led_pa[4];      ///< Values of #MAX30101_LED1_PA through #MAX30101_LED4_PA.
+        uint8_t pilot_pa;       ///< Value of #MAX30101_PILOT_PA.
+        uint8_t multi_led[2];   ///< Values of #MAX30101_MULTI_LED_1 and #MAX30101_MULTI_LED_2.
+        uint8_t prox_thresh;    ///< Value of #MAX30101_PROX_INT_THRESH, written only if the proximity interrupt is enabled.
+    } MAX30101_Config;
+
+    /**
+    *   \brief Size of a register snapshot, in bytes.
+    */
+    #define MAX30101_SNAPSHOT_SIZE 22
+
+    /**
+    *   \brief Values of the registers read by #MAX30101_Snapshot.
+    *
+    *   Each array holds a range of contiguous registers, in address
+    *   order; the structure can be sent as #MAX30101_SNAPSHOT_SIZE bytes.
+    */
+    typedef struct
+    {
+        uint8_t status[5];      ///< #MAX30101_INT_EN_1 to #MAX30101_FIFO_RP.
+        uint8_t config[11];     ///< #MAX30101_FIFO_CONF to #MAX30101_MULTI_LED_2.
+        uint8_t temp[3];        ///< #MAX30101_TEMP_INT to #MAX30101_TEMP_CONF.
+        uint8_t prox[1];        ///< #MAX30101_PROX_INT_THRESH.
+        uint8_t id[2];          ///< #MAX30101_REVISION_ID and #MAX30101_PART_ID.
+    } MAX30101_RegSnapshot;
+
+    /**
+    *   \brief Boot phase: I2C peripheral start.
+    */
+    #define MAX30101_BOOT_I2C_START 0
+
+    /**
+    *   \brief Boot phase: wait for the device to acknowledge on the I2C bus.
+    */
+    #define MAX30101_BOOT_PRESENT 1
+
+    /**
+    *   \brief Boot phase: soft reset and wait for the RESET bit to clear.
+    */
+    #define MAX30101_BOOT_RESET 2
+
+    /**
+    *   \brief Boot phase: clear pending interrupts (e.g., PWR_RDY).
+    */
+    #define MAX30101_BOOT_STATUS 3
+
+    /**
+    *   \brief Boot phase: write configuration and flush FIFO.
+    */
+    #define MAX30101_BOOT_CONFIG 4
+
+    /**
+    *   \brief Number of boot phases.
+    */
+    #define MAX30101_BOOT_PHASES 5
+
+    /**
+    *   \brief Timeout for each polling phase of the boot, in us.
+    */
+    #define MAX30101_BOOT_TIMEOUT_US 10000
+
+    /**
+    *   \brief Trace of the boot sequence.
+    *
+    *   Timestamps are taken with the get_time function provided by the
+    *   caller (e.g., a free running timer or the CPU cycle counter)
+    *   and are expressed in its units. If get_time is NULL only the
+    *   number of polls per phase is traced.
+    */
+    typedef struct
+    {
+        uint32_t (*get_time)(void);                 ///< Function returning current time, can be NULL.
+        uint32_t start;                             ///< Time at which the boot started.
+        uint32_t phase_end[MAX30101_BOOT_PHASES];   ///< Time at which each phase completed.
+        uint16_t polls[MAX30101_BOOT_PHASES];       ///< Number of I2C polls performed in each phase.
+        uint8_t failed_phase;                       ///< Phase that failed, #MAX30101_BOOT_PHASES if boot completed.
+    } MAX30101_BootTrace;
+
+    //==============================================
+    //           MAX30101 FUNCTIONS
+    //==============================================
+    /**
+    *   \brief Start the MAX30101.
+    *
+    *   This function starts the I2C peripheral, resets the MAX30101 and
+    *   waits, up to #MAX30101_BOOT_TIMEOUT_US, for the reset to complete.
+    *   \retval #MAX30101_OK if no error occurred.
+    *   \retval #MAX30101_DEV_NOT_FOUND if device is not present on the I2C bus.
+    *   \retval #MAX30101_ERROR if the reset did not complete in time.
+    */
+    uint8_t MAX30101_Start(void);
+
+    /**
+    *   \brief Start and configure the MAX30101 as fast as possible.
+    *
+    *   This function replaces fixed delays during start-up with bounded
+    *   polling: it starts the I2C peripheral, waits for the device to be
+    *   present on the bus, resets it and polls the RESET bit until the
+    *   reset is complete, clears pending interrupts (such as PWR_RDY) so that
+    *   the interrupt pin is released, and applies the configuration with
+    *   #MAX30101_ApplyConfig. It returns as soon as the device is ready.
+    *   \param[in] config configuration to be applied.
+    *   \param[in,out] trace trace of the boot phases, can be NULL.
+    *   \retval #MAX30101_OK if no error occurred.
+    *   \retval #MAX30101_DEV_NOT_FOUND if device is not present on the I2C bus.
+    *   \retval #MAX30101_ERROR if a phase did not complete in time.
+    */
+    uint8_t MAX30101_Boot(const MAX30101_Config* config, MAX30101_BootTrace* trace);
+
+    /**
+    *   \brief Wait for a soft reset to complete.
+    *
+    *   This function polls the RESET bit of #MAX30101_MODE_CONF until
+    *   it is cleared by the MAX30101.
+    *   \param[in] timeout_us maximum time to wait, in us.
+    *   \param[out] polls pointer to variable where the number of polls will be stored, can be NULL.
+    *   \retval #MAX30101_OK if the reset completed.
+    *   \retval #MAX30101_DEV_NOT_FOUND if device is not present on the I2C bus.
+    *   \retval #MAX30101_ERROR if the reset did not complete in time.
+    */
+    uint8_t MAX30101_WaitForReset(uint16_t timeout_us, uint16_t* polls);
+
+    /**
+    *   \brief Apply a complete configuration with the minimum number of transactions.
+    *
+    *   Registers are written with burst writes over contiguous ranges:
+    *   LED and slot configuration (0x0C-0x12), interrupt enables and FIFO
+    *   pointers (0x02-0x06, which also flushes the FIFO) and finally FIFO,
+    *   mode and SpO2 configuration (0x08-0x0A), so that acquisition starts
+    *   with the complete configuration already in place. #MAX30101_PROX_INT_THRESH
+    *   is written with an additional transaction only if the proximity
+    *   interrupt is enabled.
+    *
+    *   Nothing is written if the sample rate is not allowed with the pulse
+    *   width and the active slots (#MAX30101_Rate_Check).
+    *   \param[in] config configuration to be applied.
+    *   \retval #MAX30101_OK if no error occurred.
+    *   \retval #MAX30101_DEV_NOT_FOUND if device is not present on the I2C bus.
+    *   \retval #MAX30101_ERROR if the sample rate is not allowed.
+    */
+    uint8_t MAX30101_ApplyConfig(const MAX30101_Config* config);
+    
+    /**
+    *   \brief Check if MAX30101 is present on I2C bus.
+    *
+    *   \retval #MAX30101_OK if device is present.
+    *   \retval #MAX30101_DEV_NOT_FOUND if device is not present.
+    */
+    uint8_t MAX30101_IsDevicePresent(void);
+    
+    //==============================================
+    //          MAX30101 INTERRUPT FUNCTIONS
+    //==============================================
+    
+    /**
+    *   \brief Check if FIFO A Full interrupt was set.
+    *
+    *   \param flag pointer to variable where result of the check will be placed. 1 equal to true.
+    *   \retval #MAX30101_OK if device is present.
+    *   \retval #MAX30101_DEV_NOT_FOUND if device is not present.
+    */
+    uint8_t MAX30101_IsFIFOAFull(uint8_t* flag);
+    
+    /**
+    *   \brief Check if PPG Ready interrupt was set.
+    *
+    *   \param flag pointer to variable where result of the check will be placed. 1 equal to true.
+    *   \retval #MAX30101_OK if device is present.
+    *   \retval #MAX30101_DEV_NOT_FOUND if device is not present.
+    */
+    uint8_t MAX30101_IsPPGReady(uint8_t* flag);
+    
+    /**
+    *   \brief Check if ALC Overflow interrupt was set.
+    *
+    *   \param flag pointer to variable where result of the check will be placed. 1 equal to true.
+    *   \retval #MAX30101_OK if device is present.
+    *   \retval #MAX30101_DEV_NOT_FOUND if device is not present.
+    */
+    uint8_t MAX30101_IsALCOverflow(uint8_t* flag);
+    
+    /**
+    *   \brief Check if power ready interrupt was set.
+    *
+    *   \param flag pointer to variable where result of the check will be placed. 1 equal to true.
+    *   \retval #MAX30101_OK if device is present.
+    *   \retval #MAX30101_DEV_NOT_FOUND if device is not present.
+    */
+    uint8_t MAX30101_IsPowerReady(uint8_t* flag);
+    
+    /**
+    *   \brief Check if temperature ready interrupt was set.
+    *
+    *   \param flag pointer to variable where result of the check will be placed. 1 equal to true.
+    *   \retval #MAX30101_OK if device is present.
+    *   \retval #MAX30101_DEV_NOT_FOUND if device is not present.
+    */
+    uint8_t MAX30101_IsTempReady(uint8_t* flag);
+
+    /**
+    *   \brief Check if proximity interrupt was set.
+    *
+    *   \param flag pointer to variable where result of the check will be placed. 1 equal to true.
+    *   \retval #MAX30101_OK if device is present.
+    *   \retval #MAX30101_DEV_NOT_FOUND if device is not present.
+    */
+    uint8_t MAX30101_IsProximity(uint8_t* flag);
+    
+    /**
+    *   \brief Enable FIFO A Full interrupt.
+    *
+    *   \retval #MAX30101_OK if device is present.
+    *   \retval #MAX30101_DEV_NOT_FOUND if device is not present.
+    */
+    uint8_t MAX30101_EnableFIFOAFullInt(void);
+    
+    /**
+    *   \brief Enable PPG Ready interrupt.
+    *
+    *   \retval #MAX30101_OK if device is present.
+    *   \retval #MAX30101_DEV_NOT_FOUND if device is not present.
+    */
+    uint8_t MAX30101_EnablePPGReadyInt(void);
+    
+    /**
+    *   \brief Enable ALC Overflow interrupt.
+    *
+    *   \retval #MAX30101_OK if device is present.
+    *   \retval #MAX30101_DEV_NOT_FOUND if device is not present.
+    */
+    uint8_t MAX30101_EnableALCOverflowInt(void);
+    
+    /**
+    *   \brief Enable Temperature ready interrupt.
+    *
+    *   \retval #MAX30101_OK if device is present.
+    *   \retval #MAX30101_DEV_NOT_FOUND if device is not present.
+    */
+    uint8_t MAX30101_EnableTempReadyInt(void);
+
+    /**
+    *   \brief Enable proximity interrupt.
+    *
+    *   Enabling the proximity interrupt also enables the proximity function:
+    *   the MAX30101 stays in a low power proximity mode, pulsing only the IR LED
+    *   at #MAX30101_PILOT_PA, until the threshold set with #MAX30101_SetProximityThreshold
+    *   is reached.
+    *   \retval #MAX30101_OK if device is present.
+    *   \retval #MAX30101_DEV_NOT_FOUND if device is not present.
+    */
+    uint8_t MAX30101_EnableProximityInt(void);
+    
+    /**
+    *   \brief Disable FIFO A Full interrupt.
+    *
+    *   \retval #MAX30101_OK if device is present.
+    *   \retval #MAX30101_DEV_NOT_FOUND if device is not present.
+    */
+    uint8_t MAX30101_DisableFIFOAFullInt(void);
+    
+    /**
+    *   \brief Disable PPG ready interrupt.
+    *
+    *   \retval #MAX30101_OK if device is present.
+    *   \retval #MAX30101_DEV_NOT_FOUND if device is not present.
+    */
+    uint8_t MAX30101_DisablePPGReadyInt(void);
+    
+    /**
+    *   \brief Disable ALC Overflow interrupt.
+    *
+    *   \retval #MAX30101_OK if device is present.
+    *   \retval #MAX30101_DEV_NOT_FOUND if device is not present.
+    */
+    uint8_t MAX30101_DisableALCOverflowInt(void);
+    
+    /**
+    *   \brief Disable temperature ready interrupt.
+    *
+    *   \retval #MAX30101_OK if device is present.
+    *   \retval #MAX30101_DEV_NOT_FOUND if device is not present.  
+    */
+    uint8_t MAX30101_DisableTempReadyInt(void);
+
+    /**
+    *   \brief Disable proximity interrupt.
+    *
+    *   \retval #MAX30101_OK if device is present.
+    *   \retval #MAX30101_DEV_NOT_FOUND if device is not present.
+    */
+    uint8_t MAX30101_DisableProximityInt(void);
+    
+    //==============================================
+    //          MAX30101 FIFO FUNCTIONS
+    //==============================================
+    
+    /**
+    *   \brief Read FIFO Write pointer.
+    *
+    *   \param wr pointer to variable where the write pointer will be saved.
+    *   \retval #MAX30101_OK if device is present.
+    *   \retval #MAX30101_DEV_NOT_FOUND if device is not present.  
+    */
+    uint8_t MAX30101_ReadWritePointer(uint8_t* wr);
+    
+    /**
+    *   \brief Read FIFO Overflow counter.
+    *
+    *   \param oc pointer to variable where the overflow counter will be saved.
+    *   \retval #MAX30101_OK if device is present.
+    *   \retval #MAX30101_DEV_NOT_FOUND if device is not present.  
+    */
+    uint8_t MAX30101_ReadOverflowCounter(uint8_t* oc);
+    
+    /**
+    *   \brief Read FIFO read pointer.
+    *
+    *   \param oc pointer to variable where the read pointer will be saved.
+    *   \retval #MAX30101_OK if device is present.
+    *   \retval #MAX30101_DEV_NOT_FOUND if device is not present.  
+    */
+    uint8_t MAX30101_ReadReadPointer(uint8_t* rr);
+    
+    /**
+    *   \brief Read FIFO write pointer, overflow counter and read pointer in one transaction.
+    *
+    *   \param wr pointer to variable where the write pointer will be saved.
+    *   \param oc pointer to variable where the overflow counter will be saved.
+    *   \param rr pointer to variable where the read pointer will be saved.
+    *   \retval #MAX30101_OK if device is present.
+    *   \retval #MAX30101_DEV_NOT_FOUND if device is not present.  
+    */
+    uint8_t MAX30101_ReadFIFOPointers(uint8_t* wr, uint8_t* oc, uint8_t* rr);
+    
+    /**
+    *   \brief Clear FIFO.
+    *
+    *   \retval #MAX30101_OK if device is present.
+    *   \retval #MAX30101_DEV_NOT_FOUND if device is not present.  
+    */
+    uint8_t MAX30101_ClearFIFO(void);
+
+    /**
+    *   \brief Flush FIFO in a single transaction.
+    *
+    *   This function writes #MAX30101_FIFO_WP, #MAX30101_FIFO_OVF_CNT and
+    *   #MAX30101_FIFO_RP to zero with a single burst write, leaving the
+    *   FIFO empty and in a known state. Unlike #MAX30101_ClearFIFO it does
+    *   not need to know the current mode and it does not read any data.
+    *
+    *   \retval #MAX30101_OK if device is present.
+    *   \retval #MAX30101_DEV_NOT_FOUND if device is not present.
+    */
+    uint8_t MAX30101_FlushFIFO(void);
+    
+    /**
+    *   \brief Read FIFO data as single bytes.
+    *
+    *   This function reads the data in the FIFO of the MAX30101
+    *   according to the specified settings. Based on the number
+    *   of samples to be read and the number of active leds this
+    *   function will perform a complete reading of the FIFO.
+    *   Data will be returned as raw uint8_t data.
+    *   \param[in] num_samples number of samples to be read
+    *   \param[in] active_leds number of active leds
+    *   \param[out] data pointer to variable storing raw data from FIFO
+    *
+    *   \retval #MAX30101_OK if device is present.
+    *   \retval #MAX30101_DEV_NOT_FOUND if device is not present.  
+    */
+    uint8_t MAX30101_ReadRawFIFOBytes(uint8_t num_samples, uint8_t active_leds, uint8_t* data);
+    
+    /**
+    *   \brief Read FIFO data.
+    *
+    *   This function reads the data in the FIFO of the MAX30101
+    *   according to the specified settings. Based on the number
+    *   of samples to be read and the number of active leds this
+    *   function will perform a complete reading of the FIFO.
+    *   Data will be returned as uint32_t.
+    *   \param[in] num_samples number of samples to be read
+    *   \param[in] active_leds number of active leds (1 to 4)
+    *   \param[out] data pointer to variable storing raw data from FIFO
+    *
+    *   \retval #MAX30101_OK if device is present.
+    *   \retval #MAX30101_DEV_NOT_FOUND if device is not present.  
+    */
+    uint8_t MAX30101_ReadRawFIFO(uint8_t num_samples, uint8_t active_leds, uint32_t* data);
+    
+    /**
+    *   \brief Read FIFO data and place them in a circular buffer.
+    *
+    *   This function reads the data in the FIFO of the MAX30101
+    *   according to the specified settings. Based on the number
+    *   of samples to be read and the number of active leds this
+    *   function will perform a complete reading of the FIFO.
+    *   Data will be returned inside the circular buffer passed
+    *   in as parameter to the function.
+    *   Channels are assigned by position (RED, IR, GREEN): in Multi-LED
+    *   mode use #MAX30101_ReadMultiLEDFIFO instead. With 4 active slots
+    *   the FIFO is not read, since a sample has no buffer for its 4th slot.
+    *   \param[in] num_samples number of samples to be read
+    *   \param[in] active_leds number of active leds (1 to 3)
+    *   \param[out] data pointer to circular buffer storing data from FIFO
+    *   \retval #MAX30101_OK if device is present.
+    *   \retval #MAX30101_DEV_NOT_FOUND if device is not present.
+    *   \retval #MAX30101_ERROR if active_leds is 0 or above 3.
+    */
+    uint8_t MAX30101_ReadFIFO(uint8_t num_samples, uint8_t active_leds, MAX30101_Data* data);
+
+    /**
+    *   \brief Read Multi-LED mode FIFO data and demultiplex it per slot.
+    *
+    *   This function reads the current slot configuration and ADC resolution,
+    *   reads num_samples samples from the FIFO in a single burst and places
+    *   the data of each active slot in its own stream of the circular buffer,
+    *   tagged with the LED that was active in that slot.
+    *   From 1 to 4 active slots are supported, with any LED assignment.
+    *   \param[in] num_samples number of samples to be read (up to 32).
+    *   \param[out] data pointer to circular buffer storing data from FIFO.
+    *   \retval #MAX30101_OK if no error occurred.
+    *   \retval #MAX30101_DEV_NOT_FOUND if device is not present on the I2C bus.
+    *   \retval #MAX30101_ERROR if no slot is enabled or num_samples is out of range.
+    */
+    uint8_t MAX30101_ReadMultiLEDFIFO(uint8_t num_samples, MAX30101_MultiData* data);
+
+    /**
+    *   \brief Demultiplex raw FIFO bytes into per-slot streams.
+    *
+    *   This function performs the deinterleaving step of #MAX30101_ReadMultiLEDFIFO
+    *   on data already read from the FIFO (e.g., with #MAX30101_ReadRawFIFOBytes).
+    *   It does not access the I2C bus.
+    *   \param[in] raw raw FIFO bytes, 3 bytes per slot per sample.
+    *   \param[in] num_samples number of samples contained in raw.
+    *   \param[in] slots channel of each active slot, as returned by #MAX30101_ReadSlotConfig.
+    *   \param[in] active_slots number of active slots.
+    *   \param[in] shift right shift to be applied according to the ADC resolution.
+    *   \param[out] data pointer to circular buffer where data will be stored.
+    */
+    void MAX30101_DemuxSlots(const uint8_t* raw, uint8_t num_samples,
+                             const uint8_t* slots, uint8_t active_slots,
+                             uint8_t shift, MAX30101_MultiData* data);
+
+    //==============================================
+    //     MAX30101 FIFO CONFIGURATION FUNCTIONS
+    //==============================================
+    
+    /**
+    *   \brief Set the number of samples averaged per sample in FIFO.
+    *   
+    *   This function sets the number of samples to be averaged per FIFO sample.
+    *   Available choices go from 1 to 32.
+    *   \param samples number of samples to be averaged.
+    *   \retval #MAX30101_OK if no error occurred.
+    *   \retval #MAX30101_DEV_NOT_FOUND if device is not present on the I2C bus.
+    *   \retval #MAX30101_ERROR if error occurred during configuration.
+    */
+    uint8_t MAX30101_SetSampleAverage(uint8_t samples);
+    
+    /**
+    *   \brief Enable FIFO Rollover.
+    *   
+    *   This function enables FIFO Rollover. When enabled, 
+    *   the FIFO Address rolls over to zero and the FIFO continues to fill with new data. 
+    *   \retval #MAX30101_OK if no error occurred.
+    *   \retval #MAX30101_DEV_NOT_FOUND if device is not present on the I2C bus.
+    */
+    uint8_t MAX30101_EnableFIFORollover(void);
+    
+    /**
+    *   \brief Disable FIFO Rollover.
+    *
+    *   This function disables FIFO Rollover. When disabled, 
+    *   FIFO is not updated until #MAX30101_FIFO_DATA is read or the 
+    *   #MAX30101_FIFO_WP or #MAX30101_FIFO_RP positions are changed.
+    *   \retval #MAX30101_OK if no error occurred.
+    *   \retval #MAX30101_DEV_NOT_FOUND if device is not present on the I2C bus.
+    */
+    uint8_t MAX30101_DisableFIFORollover(void);
+    
+    /**
+    *   \brief Set number of samples for FIFO Almost Full.
+    *
+    *   This function sets the number of samples required to
+    *   trigger a FIFO Almost Full interrupt. 
+    *   \param[in] samples number of samples required to trigger a FIFO A FULL interrupt.
+    *   \retval #MAX30101_OK if no error occurred.
+    *   \retval #MAX30101_DEV_NOT_FOUND if device is not present on the I2C bus.
+    */
+    uint8_t MAX30101_SetFIFOAlmostFull(uint8_t samples);
+    
+    //==============================================
+    //     MAX30101 MODE CONFIGURATION FUNCTIONS
+    //==============================================
+    
+    /**
+    *   \brief Shutdown the MAX30101.
+    *
+    *   The MAX30101 can be put into a power-save mode. 
+    *   While in power-save mode, all registers retain their values, and write/read operations
+    *   function as normal. All interrupts are cleared to zero in this mode.
+    *   \retval #MAX30101_OK if no error occurred.
+    *   \retval #MAX30101_DEV_NOT_FOUND if device is not present on the I2C bus.
+    */
+    uint8_t MAX30101_Shutdown(void);
+    
+    /**
+    *   \brief Wake up the MAX30101.
+    *
+    *   \retval #MAX30101_OK if no error occurred.
+    *   \retval #MAX30101_DEV_NOT_FOUND if device is not present on the I2C bus.
+    */
+    uint8_t MAX30101_WakeUp(void);
+    
+    /**
+    *   \brief Reset the MAX30101.
+    *
+    *   This function resets the MAX30101 via software by setting
+    *   the reset bit in the register #MAX30101_MODE_CONF to 1.
+    *   All configuration, threshold, and data registers are reset 
+    *   to their power-on-state through a power-on reset
+    *   \retval #MAX30101_OK if no error occurred.
+    *   \retval #MAX30101_DEV_NOT_FOUND if device is not present on the I2C bus.
+    */
+    uint8_t MAX30101_Reset(void);
+    
+    /**
+    *   \brief Set the operation mode for the MAX30101.
+    *   
+    *   This function sets the current LED pulse amplitude mode for 
+    *   the MAX30101. Available choices are:
+    *       - #MAX30101_HR_MODE: RED Led ON
+    *       - #MAX30101_SPO2_MODE: RED and IR Led ON
+    *       - #MAX30101_MULTI_MODE: configurable Leds
+    *   \param mode mode to be set in the #MAX30101_MODE_CONF register
+    *   \retval #MAX30101_OK if no error occurred.
+    *   \retval #MAX30101_DEV_NOT_FOUND if device is not present on the I2C bus.
+    *   \retval #MAX30101_ERROR if error occurred during configuration.
+    */
+    uint8_t MAX30101_SetMode(uint8_t mode);
+    
+    //==============================================
+    //     MAX30101 SPO2 CONFIGURATION FUNCTIONS
+    //==============================================
+      
+    /**
+    *   \brief Set MAX30101 SpO2 ADC Range.
+    *
+    *   This function sets the value for the SpO2 ADC
+    *   range. Values that can be passed as input to this
+    *   function are:
+    *       - #MAX30101_ADC_RANGE_2048
+    *       - #MAX30101_ADC_RANGE_4096
+    *       - #MAX30101_ADC_RANGE_8192
+    *       - #MAX30101_ADC_RANGE_16384
+    *   \param range the value of SpO2 ADC range to be set.
+    *   \retval #MAX30101_OK if no error occurred.
+    *   \retval #MAX30101_DEV_NOT_FOUND if device is not present on the I2C bus.
+    *   \retval #MAX30101_ERROR if error occurred during configuration.
+    */
+    uint8_t MAX30101_SetSpO2ADCRange(uint8_t range);
+    
+    /**
+    *   \brief Set MAX30101 SpO2 Sample Rate.
+    *
+    *   This function sets the value for the SpO2 sample
+    *   rate. Values that can be passed as input to this
+    *   function are:
+    *       - #MAX30101_SAMPLE_RATE_50
+    *       - #MAX30101_SAMPLE_RATE_100
+    *       - #MAX30101_SAMPLE_RATE_200
+    *       - #MAX30101_SAMPLE_RATE_400
+    *       - #MAX30101_SAMPLE_RATE_800
+    *       - #MAX30101_SAMPLE_RATE_1000
+    *       - #MAX30101_SAMPLE_RATE_1600
+    *       - #MAX30101_SAMPLE_RATE_3200
+    *
+    *   The sample rate is checked with #MAX30101_Rate_Check against the
+    *   current pulse width and active slots, and not written if the ADC
+    *   cannot reach it: when both change, set them in an order where
+    *   each step is allowed, or use #MAX30101_ApplyConfig.
+    *   \param sr the value of SpO2 sample rate to be set.
+    *   \retval #MAX30101_OK if no error occurred.
+    *   \retval #MAX30101_DEV_NOT_FOUND if device is not present on the I2C bus.
+    *   \retval #MAX30101_ERROR if error occurred during configuration or the sample rate is not allowed.
+    */
+    uint8_t MAX30101_SetSpO2SampleRate(uint8_t sr);
+    
+    /**
+    *   \brief Set MAX30101 LED Pulse Width.
+    *
+    *   This function sets the value for the SpO2 sample
+    *   rate. Values that can be passed as input to this
+    *   function are:
+    *       - #MAX30101_PULSEWIDTH_69
+    *       - #MAX30101_PULSEWIDTH_118
+    *       - #MAX30101_PULSEWIDTH_215
+    *       - #MAX30101_PULSEWIDTH_411
+    *
+    *   As for #MAX30101_SetSpO2SampleRate, the pulse width is not written
+    *   if the current sample rate is not allowed with it.
+    *   \param pw the value of LED Pulse Width to be set.
+    *   \retval #MAX30101_OK if no error occurred.
+    *   \retval #MAX30101_DEV_NOT_FOUND if device is not present on the I2C bus.
+    *   \retval #MAX30101_ERROR if error occurred during configuration or the pulse width is not allowed.
+    */
+    uint8_t MAX30101_SetSpO2PulseWidth(uint8_t pw);
+    
+    /**
+    *   \brief Set the pulse amplitude for a MAX30101 channel.
+    *   
+    *   This function sets the current LED pulse amplitude a given
+    *   channel of the MAX30101.
+    *   Pulse amplitude values range from 0x00 to 0xFF.
+    *   \param led_channel the channel for which to set the pulse amplitude.
+    *   \param pa the value of pulse amplitude to be set,.
+    *   \retval #MAX30101_OK if no error occurred.
+    *   \retval #MAX30101_DEV_NOT_FOUND if device is not present on the I2C bus.
+    *   \retval #MAX30101_ERROR if error occurred during configuration.
+    */
+    uint8_t MAX30101_SetLEDPulseAmplitude(uint8_t led_channel, uint8_t pa);
+
+    //======================================================
+    //     MAX30101 PROXIMITY CONFIGURATION FUNCTIONS
+    //======================================================
+    /**
+    *   \brief Set the pulse amplitude used in proximity mode.
+    *
+    *   This function sets the IR LED pulse amplitude used while the MAX30101
+    *   is waiting for an object in proximity mode.
+    *   Pulse amplitude values range from 0x00 to 0xFF.
+    *   \param pa the value of pilot pulse amplitude to be set.
+    *   \retval #MAX30101_OK if no error occurred.
+    *   \retval #MAX30101_DEV_NOT_FOUND if device is not present on the I2C bus.
+    */
+    uint8_t MAX30101_SetPilotPulseAmplitude(uint8_t pa);
+
+    /**
+    *   \brief Set the proximity interrupt threshold.
+    *
+    *   This function sets the threshold, as the 8 MSBs of the IR ADC count,
+    *   that triggers the proximity interrupt and the beginning of the
+    *   configured SpO2/HR or Multi-LED mode.
+    *   \param threshold the value of the threshold to be set.
+    *   \retval #MAX30101_OK if no error occurred.
+    *   \retval #MAX30101_DEV_NOT_FOUND if device is not present on the I2C bus.
+    */
+    uint8_t MAX30101_SetProximityThreshold(uint8_t threshold);
+    
+    //======================================================
+    //    MAX30101 MULTI LED MODE CONFIGURATION FUNCTIONS
+    //======================================================
+    /**
+    *   \brief Enable a slot in Multi-LED mode.
+    *   
+    *   In multi-LED mode, each sample is split into up to four time slots, 
+    *   SLOT1 through SLOT4. These control registers determine which LED is
+    *   active in each time slot, making for a very flexible configuration.
+    *   In MAX30101 Both LED3 and LED4 are wired to Green LED. 
+    *   Green LED sinks current out of #MAX30101_LED3_PA and #MAX30101_LED4_PA 
+    *   if enabled in multi-LED mode.
+    *   
+    *   \param slot the slot to be enabled (1 through 4)
+    *   \param led the led to be activated. It can be one of:
+    *       - #MAX30101_SLOT_RED
+    *       - #MAX30101_SLOT_IR
+    *       - #MAX30101_SLOT_GREEN
+    *       - #MAX30101_SLOT_NONE
+    *   \retval #MAX30101_OK if no error occurred.
+    *   \retval #MAX30101_DEV_NOT_FOUND if device is not present on the I2C bus.
+    *   \retval #MAX30101_ERROR if error occurred during configuration.
+    */
+    uint8_t MAX30101_EnableSlot(uint8_t slot, uint8_t led);
+    
+    /**
+    *   \brief Disable all slot configurations in Multi-LED mode.
+    *
+    *   Disable all the configurations that were set for Multi-LED mode.
+    *   \retval #MAX30101_OK if no error occurred.
+    *   \retval #MAX30101_DEV_NOT_FOUND if device is not present on the I2C bus.
+    *   \retval #MAX30101_ERROR if error occurred during configuration.
+    */
+    uint8_t MAX30101_DisableSlots(void);
+
+    /**
+    *   \brief Read the slot configuration of Multi-LED mode.
+    *
+    *   This function reads #MAX30101_MULTI_LED_1 and #MAX30101_MULTI_LED_2
+    *   in a single transaction and returns the channel of each active slot,
+    *   in the order in which slots are stored in the FIFO. Disabled and
+    *   reserved slot settings are skipped.
+    *   \param[out] slots array of #MAX30101_MAX_SLOTS elements where the channel of each active slot will be stored.
+    *   \param[out] active_slots pointer to variable where the number of active slots will be stored.
+    *   \retval #MAX30101_OK if no error occurred.
+    *   \retval #MAX30101_DEV_NOT_FOUND if device is not present on the I2C bus.
+    */
+    uint8_t MAX30101_ReadSlotConfig(uint8_t* slots, uint8_t* active_slots);
+
+    /**
+    *   \brief Decode the slot configuration of Multi-LED mode.
+    *
+    *   This function performs the decoding step of #MAX30101_ReadSlotConfig
+    *   on register values already read (e.g., from a trace). It does not
+    *   access the I2C bus.
+    *   \param[in] multi_led values of #MAX30101_MULTI_LED_1 and #MAX30101_MULTI_LED_2.
+    *   \param[out] slots array of #MAX30101_MAX_SLOTS elements where the channel of each active slot will be stored.
+    *   \param[out] active_slots pointer to variable where the number of active slots will be stored.
+    */
+    void MAX30101_DecodeSlots(const uint8_t* multi_led, uint8_t* slots, uint8_t* active_slots);
+
+    /**
+    *   \brief Get the number of active channels in the FIFO.
+    *
+    *   This function reads the current mode and returns the number of
+    *   channels stored per FIFO sample: 1 in HR mode, 2 in SpO2 mode and
+    *   the number of active slots (1 through 4) in Multi-LED mode.
+    *   \param[out] active_leds pointer to variable where the number of active channels will be stored.
+    *   \retval #MAX30101_OK if no error occurred.
+    *   \retval #MAX30101_DEV_NOT_FOUND if device is not present on the I2C bus.
+    *   \retval #MAX30101_ERROR if the current mode is not valid.
+    */
+    uint8_t MAX30101_GetActiveLeds(uint8_t* active_leds);
+
+    //======================================================
+    //            MAX30101 DIE TEMPERATURE FUNCTIONS
+    //======================================================
+    
+    /**
+    *   \brief Read Die Temperature from MAX30101 in float format.
+    *
+    *   This functions reads the die temperature data from the MAX30101
+    *   and returns its value in float format. The temperature value
+    *   can be used to calibrate the SpO2 readings.
+    *   \param[out] temperature float value of die temperature
+    *   \retval #MAX30101_OK if no error occurred.
+    *   \retval #MAX30101_DEV_NOT_FOUND if device is not present on the I2C bus.
+    *   \retval #MAX30101_ERROR if error occurred during configuration.   
+    */
+    uint8_t MAX30101_ReadTemperature(float* temperature);
+    
+    /**
+    *   \brief Read Die Temperature from MAX30101 in raw format.
+    *
+    *   This functions reads the die temperature data from the MAX30101
+    *   and returns its integer and fractional parts. The temperature value
+    *   can be used to calibrate the SpO2 readings.
+    *   \param[out] integer integer value of die temperature
+    *   \param[out] frac fractional value of die temperature
+    *   \retval #MAX30101_OK if no error occurred.
+    *   \retval #MAX30101_DEV_NOT_FOUND if device is not present on the I2C bus.
+    *   \retval #MAX30101_ERROR if error occurred during configuration.   
+    */
+    uint8_t MAX30101_ReadRawTemperature(int8_t* integer, uint8_t* frac);
+    
+    
+    /**
+    *   \brief Start temperature conversion on the MAX30101.
+    *
+    *   \retval #MAX30101_OK if no error occurred.
+    *   \retval #MAX30101_DEV_NOT_FOUND if device is not present on the I2C bus.
+    *   \retval #MAX30101_ERROR if error occurred during configuration.     
+    */
+    uint8_t MAX30101_StartTemperatureConversion(void);
+    
+    //======================================================
+    //            MAX30101 PART/REVISION ID FUNCTIONS
+    //======================================================
+    /**
+    *   \brief Read Part ID number from MAX30101.
+    *   
+    *   \param part_id pointer to variable where part ID value will be stored.
+    *   \retval #MAX30101_OK if no error occurred.
+    *   \retval #MAX30101_DEV_NOT_FOUND if device is not present on the I2C bus.
+    *   \retval #MAX30101_ERROR if error occurred during configuration.
+    */
+    uint8_t MAX30101_ReadPartID(uint8_t* part_id);
+    
+    /**
+    *   \brief Read Revision ID number from MAX30101.
+    *   
+    *   \param revision_id pointer to variable where revision ID value will be stored.
+    *   \retval #MAX30101_OK if no error occurred.
+    *   \retval #MAX30101_DEV_NOT_FOUND if device is not present on the I2C bus.
+    *   \retval #MAX30101_ERROR if error occurred during configuration.
+    */
+    uint8_t MAX30101_ReadRevisionID(uint8_t* revision_id);
+    
+    //======================================================
+    //            MAX30101 HELPER FUNCTIONS
+    //======================================================
+    /**
+    *   \brief Read a register from the MAX30101.
+    *   
+    *   \param[in] reg_addr address of the register to be read.
+    *   \param[out] reg_value pointer to variable where register data will be stored.
+    *   \retval #MAX30101_OK if no error occurred.
+    *   \retval #MAX30101_DEV_NOT_FOUND if device is not present on the I2C bus.
+    *   \retval #MAX30101_ERROR if error occurred during configuration.
+    */
+    uint8_t MAX30101_ReadRegister(uint8_t reg_addr, uint8_t* reg_value);
+
+    /**
+    *   \brief Read contiguous registers in a single transaction.
+    *
+    *   \param[in] reg_addr address of the first register.
+    *   \param[in] count number of registers.
+    *   \param[out] data values of the registers.
+    *   \retval #MAX30101_OK if no error occurred.
+    *   \retval #MAX30101_DEV_NOT_FOUND if device is not present on the I2C bus.
+    */
+    uint8_t MAX30101_ReadRegisters(uint8_t reg_addr, uint8_t count, uint8_t* data);
+
+    /**
+    *   \brief Write contiguous registers in a single transaction.
+    *
+    *   The write hook (#MAX30101_SetWriteHook) is called after the write.
+    *   \param[in] reg_addr address of the first register.
+    *   \param[in] count number of registers.
+    *   \param[in] data values of the registers.
+    *   \retval #MAX30101_OK if no error occurred.
+    *   \retval #MAX30101_DEV_NOT_FOUND if device is not present on the I2C bus.
+    */
+    uint8_t MAX30101_WriteRegisters(uint8_t reg_addr, uint8_t count, const uint8_t* data);
+    
+    /**
+    *   \brief Read the values of the MAX30101 registers in five transactions.
+    *
+    *   Contiguous registers are read in bursts: 0x02 to 0x06, 0x08 to
+    *   0x12, 0x1F to 0x21, 0x30 and 0xFE to 0xFF. FIFO_DATA (0x07) is skipped,
+    *   so the FIFO is not changed; a burst cannot cross it, since the
+    *   register pointer does not move while FIFO_DATA is read. The
+    *   interrupt status registers (0x00 and 0x01) are not read either,
+    *   since reading them clears the pending interrupts.
+    *   \param[out] snapshot values of the registers.
+    *   \retval #MAX30101_OK if no error occurred.
+    *   \retval #MAX30101_DEV_NOT_FOUND if device is not present on the I2C bus.
+    */
+    uint8_t MAX30101_Snapshot(MAX30101_RegSnapshot* snapshot);
+
+    /**
+    *   \brief Value of a register in a snapshot.
+    *
+    *   \param[in] snapshot snapshot read with #MAX30101_Snapshot.
+    *   \param[in] reg_addr address of the register.
+    *   \param[out] value value of the register.
+    *   \return 1 if the register is in the snapshot, 0 otherwise.
+    */
+    uint8_t MAX30101_SnapshotValue(const MAX30101_RegSnapshot* snapshot, uint8_t reg_addr, uint8_t* value);
+
+    /**
+    *   \brief Print the registers of a snapshot, one per line.
+    *
+    *   \param[in] print_fun pointer to the function used for logging.
+    *   \param[in] snapshot snapshot read with #MAX30101_Snapshot.
+    */
+    void MAX30101_PrintSnapshot(void (*print_fun)(const char*), const MAX30101_RegSnapshot* snapshot);
+
+    /**
+    *   \brief Log the values of all MAX30101 registers.
+    *   
+    *   This function logs the current values of the MAX30101
+    *   registers, read with #MAX30101_Snapshot (FIFO_DATA is not
+    *   read, nor the interrupt status registers).
+    *   \param[in] fun_ptr pointer to the function used for logging.
+    *   \param[in] reg_addr address of the register to be read.
+    *   \retval #MAX30101_OK if no error occurred.
+    *   \retval #MAX30101_DEV_NOT_FOUND if device is not present on the I2C bus.
+    *   \retval #MAX30101_ERROR if error occurred during configuration.
+    */
+    uint8_t MAX30101_LogRegisters(void (*fun_ptr)(const char*));
+    
+    /**
+    *   \brief Print the value of a MAX30101 register.
+    *   
+    *   This function prints the value of a MAX30101 register.
+    *   Be aware that reading some of the registers may cler interrupts.
+    *   registers fun_ptr pointer to the function used for logging.
+    *   \param[in] reg_addr address of the register to be read.
+    *   \retval #MAX30101_OK if no error occurred.
+    *   \retval #MAX30101_DEV_NOT_FOUND if device is not present on the I2C bus.
+    *   \retval #MAX30101_ERROR if error occurred during configuration.
+    */
+    uint8_t MAX30101_PrintRegister(void (*print_fun)(const char*), uint8_t reg_addr);
+
+    /**
+    *   \brief Print the trace of the boot sequence.
+    *
+    *   This function prints, for each phase of #MAX30101_Boot, the time
+    *   elapsed since the beginning of the boot and the number of polls.
+    *   \param[in] print_fun pointer to the function used for logging.
+    *   \param[in] trace trace filled by #MAX30101_Boot.
+    */
+    void MAX30101_PrintBootTrace(void (*print_fun)(const char*), const MAX30101_BootTrace* trace);
+
+    /**
+    *   \brief Set a function to be called after each register write.
+    *
+    *   The function is called after each successful write with the
+    *   address of the first register, the number of contiguous registers
+    *   written and their values (e.g., to record configuration changes).
+    *   \param[in] hook pointer to the function, NULL to remove it.
+    */
+    void MAX30101_SetWriteHook(void (*hook)(uint8_t reg_addr, uint8_t count, const uint8_t* data));
+
+#endif
+/* [] END OF FILE */
@@ -0,0 +1,343 @@
+/**
+*   Source file for the search of the acquisition settings.
+*/
+
+#include "MAX30101_AutoConfig.h"
+#include "MAX30101.h"
+#include "MAX30101_Rate.h"
+#include "MAX30101_Stats.h"
+
+//==============================================
+//          MACROS
+//==============================================
+
+/**
+*   \brief Number of pulse widths and of sample rates.
+*/
+#define AUTOCFG_PULSE_WIDTHS 4
+#define AUTOCFG_SAMPLE_RATES 8
+
+/**
+*   \brief Largest sample averaging setting (32 samples).
+*/
+#define AUTOCFG_MAX_AVG 5
+
+/**
+*   \brief Highest ADC range setting (16384 nA).
+*/
+#define AUTOCFG_MAX_RANGE 3
+
+/**
+*   \brief Samples at or above 15/16 of full scale are clipped.
+*/
+#define AUTOCFG_CLIP_16THS 15
+
+/**
+*   \brief The selected range keeps the samples below 12/16 of full scale.
+*/
+#define AUTOCFG_HEADROOM_16THS 12
+
+/**
+*   \brief First byte and version of a packed result.
+*/
+#define AUTOCFG_CACHE_MAGIC 0xA5
+#define AUTOCFG_CACHE_VERSION 1
+
+//==============================================
+//          VARIABLES
+//==============================================
+
+// Raw bytes of a capture
+static uint8_t autocfg_raw[MAX30101_AUTOCFG_CAPTURE * MAX30101_MAX_SLOTS * 3];
+
+//==============================================
+//          FUNCTION PROTOTYPES
+//==============================================
+
+static uint8_t MAX30101_AutoConfig_Capture(const MAX30101_AutoConfigParams* params, uint8_t pulse_width,
+                                           MAX30101_AutoConfigResult* counters, uint16_t* snr, uint32_t* peak);
+
+// Search the best setting within the budget
+uint8_t MAX30101_AutoConfig_Search(const MAX30101_AutoConfigParams* params, MAX30101_AutoConfigResult* result)
+{
+    MAX30101_AutoConfigResult best = {0};
+    MAX30101_AutoConfigResult candidate = {0};
+    uint8_t found = 0;
+    uint8_t error = MAX30101_OK;
+
+    if ((params->active_leds == 0) || (params->active_leds > MAX30101_MAX_SLOTS) || (params->num_led_pa == 0))
+    {
+        return MAX30101_ERROR;
+    }
+    candidate.active_leds = params->active_leds;
+    result->captures = 0;
+    result->capture_us = 0;
+
+    for (uint8_t pw = 0; (pw < AUTOCFG_PULSE_WIDTHS) && (error == MAX30101_OK); pw++)
+    {
+        for (uint8_t avg = 0; (avg <= AUTOCFG_MAX_AVG) && (error == MAX30101_OK); avg++)
+        {
+            // The ADC runs at the output rate times the averaged samples
+            uint32_t adc_rate = (uint32_t)params->sample_rate << avg;
+            uint8_t rate = 0;
+            while ((rate < AUTOCFG_SAMPLE_RATES) && (MAX30101_Rate_SampleRate(rate) != adc_rate))
+            {
+                rate++;
+            }
+            if ((rate == AUTOCFG_SAMPLE_RATES) ||
+                (MAX30101_Rate_Check(params->active_leds, rate << MAX30101_SAMPLE_RATE_SHIFT, pw) != MAX30101_OK))
+            {
+                continue;
+            }
+
+            // Largest amplitude within the budget that does not clip at the highest range:
+            // lower amplitudes only lower the SNR
+            for (uint8_t k = params->num_led_pa; k > 0; k--)
+            {
+                candidate.spo2_conf = (AUTOCFG_MAX_RANGE << MAX30101_ADC_RANGE_SHIFT) |
+                                      (rate << MAX30101_SAMPLE_RATE_SHIFT) | pw;
+                candidate.sample_avg = avg << MAX30101_SAMPLE_AVG_SHIFT;
+                candidate.led_pa = params->led_pa[k - 1];
+                candidate.power_uw = MAX30101_AutoConfig_Power(candidate.spo2_conf, candidate.led_pa,
+                                                               params->active_leds);
+                if (candidate.power_uw > params->budget_uw)
+                {
+                    continue;
+                }
+
+                uint16_t snr;
+                uint32_t peak;
+                error = MAX30101_AutoConfig_Apply(&candidate);
+                if (error == MAX30101_OK)
+                {
+                    error = MAX30101_AutoConfig_Capture(params, pw, result, &snr, &peak);
+                }
+                if (error != MAX30101_OK)
+                {
+                    break;
+                }
+                uint32_t full_scale = 0x3FFFFu >> (3 - pw);
+                if (peak >= full_scale / 16 * AUTOCFG_CLIP_16THS)
+                {
+                    continue;
+                }
+
+                // Lowest range with headroom: each range below doubles the samples
+                uint8_t range = 0;
+                while ((range < AUTOCFG_MAX_RANGE) &&
+                       ((peak << (AUTOCFG_MAX_RANGE - range)) >= full_scale / 16 * AUTOCFG_HEADROOM_16THS))
+                {
+                    range++;
+                }
+                if (range < AUTOCFG_MAX_RANGE)
+                {
+                    candidate.spo2_conf = (range << MAX30101_ADC_RANGE_SHIFT) |
+                                          (rate << MAX30101_SAMPLE_RATE_SHIFT) | pw;
+                    error = MAX30101_SetSpO2ADCRange(range << MAX30101_ADC_RANGE_SHIFT);
+                    if (error == MAX30101_OK)
+                    {
+                        error = MAX30101_AutoConfig_Capture(params, pw, result, &snr, &peak);
+                    }
+                    if (error != MAX30101_OK)
+                    {
+                        break;
+                    }
+                }
+
+                candidate.snr = snr;
+                if (!found || (snr > best.snr) || ((snr == best.snr) && (candidate.power_uw < best.power_uw)))
+                {
+                    best = candidate;
+                    found = 1;
+                }
+                break;
+            }
+        }
+    }
+
+    if (error != MAX30101_OK)
+    {
+        return error;
+    }
+    if (!found)
+    {
+        return MAX30101_ERROR;
+    }
+    best.captures = result->captures;
+    best.capture_us = result->capture_us;
+    *result = best;
+    return MAX30101_AutoConfig_Apply(result);
+}
+
+// Estimated LED power
+uint32_t MAX30101_AutoConfig_Power(uint8_t spo2_conf, uint8_t led_pa, uint8_t active_leds)
+{
+    // mA x mV x duty cycle, with 0.2 mA per LSB
+    uint64_t power = (uint64_t)led_pa * MAX30101_AUTOCFG_VLED_MV * MAX30101_Rate_PulseWidth(spo2_conf & 0x03) *
+                     MAX30101_Rate_SampleRate(spo2_conf >> MAX30101_SAMPLE_RATE_SHIFT) * active_leds;
+    return (uint32_t)(power / 5000000u);
+}
+
+// Apply a setting
+uint8_t MAX30101_AutoConfig_Apply(const MAX30101_AutoConfigResult* result)
+{
+    // The driver refuses an intermediate setting the ADC cannot reach:
+    // if the new rate is refused with the old pulse width, the new pulse width
+    // is allowed with the old rate
+    uint8_t pw = result->spo2_conf & 0x03;
+    uint8_t rate = result->spo2_conf & (0x07 << MAX30101_SAMPLE_RATE_SHIFT);
+    uint8_t error = MAX30101_SetSpO2SampleRate(rate);
+    if (error == MAX30101_OK)
+    {
+        error = MAX30101_SetSpO2PulseWidth(pw);
+    }
+    else if (error == MAX30101_ERROR)
+    {
+        error = MAX30101_SetSpO2PulseWidth(pw);
+        if (error == MAX30101_OK)
+        {
+            error = MAX30101_SetSpO2SampleRate(rate);
+        }
+    }
+    if (error == MAX30101_OK)
+    {
+        error = MAX30101_SetSpO2ADCRange(result->spo2_conf & (0x03 << MAX30101_ADC_RANGE_SHIFT));
+    }
+    if (error == MAX30101_OK)
+    {
+        error = MAX30101_SetSampleAverage(result->sample_avg);
+    }
+    for (uint8_t led = 0; (led < result->active_leds) && (error == MAX30101_OK); led++)
+    {
+        error = MAX30101_SetLEDPulseAmplitude(led, result->led_pa);
+    }
+    return error;
+}
+
+// Pack a setting
+void MAX30101_AutoConfig_Pack(const MAX30101_AutoConfigResult* result, uint8_t* cache)
+{
+    cache[0] = AUTOCFG_CACHE_MAGIC;
+    cache[1] = AUTOCFG_CACHE_VERSION;
+    cache[2] = result->spo2_conf;
+    cache[3] = result->sample_avg;
+    cache[4] = result->led_pa;
+    cache[5] = result->active_leds;
+    cache[6] = (uint8_t)result->snr;
+    cache[7] = (uint8_t)(result->snr >> 8);
+    cache[8] = (uint8_t)result->power_uw;
+    cache[9] = (uint8_t)(result->power_uw >> 8);
+    cache[10] = (uint8_t)(result->power_uw >> 16);
+    uint8_t sum = 0;
+    for (uint8_t i = 0; i < MAX30101_AUTOCFG_CACHE_SIZE - 1; i++)
+    {
+        sum += cache[i];
+    }
+    cache[MAX30101_AUTOCFG_CACHE_SIZE - 1] = (uint8_t)(0x100 - sum);
+}
+
+// Unpack a setting
+uint8_t MAX30101_AutoConfig_Unpack(const uint8_t* cache, MAX30101_AutoConfigResult* result)
+{
+    uint8_t sum = 0;
+    for (uint8_t i = 0; i < MAX30101_AUTOCFG_CACHE_SIZE; i++)
+    {
+        sum += cache[i];
+    }
+    if ((sum != 0) || (cache[0] != AUTOCFG_CACHE_MAGIC) || (cache[1] != AUTOCFG_CACHE_VERSION) ||
+        (cache[5] == 0) || (cache[5] > MAX30101_MAX_SLOTS))
+    {
+        return MAX30101_ERROR;
+    }
+    result->spo2_conf = cache[2];
+    result->sample_avg = cache[3];
+    result->led_pa = cache[4];
+    result->active_leds = cache[5];
+    result->snr = cache[6] | ((uint16_t)cache[7] << 8);
+    result->power_uw = cache[8] | ((uint32_t)cache[9] << 8) | ((uint32_t)cache[10] << 16);
+    result->captures = 0;
+    result->capture_us = 0;
+    return MAX30101_OK;
+}
+
+// Capture samples: lowest SNR and largest sample of the channels
+static uint8_t MAX30101_AutoConfig_Capture(const MAX30101_AutoConfigParams* params, uint8_t pulse_width,
+                                           MAX30101_AutoConfigResult* counters, uint16_t* snr, uint32_t* peak)
+{
+    uint32_t period_us = 1000000u / params->sample_rate;
+    uint32_t wait_us = MAX30101_AUTOCFG_DISCARD * period_us;
+
+    // Discard the samples acquired while the settings changed
+    params->wait(wait_us);
+    uint8_t error = MAX30101_FlushFIFO();
+    if (error != MAX30101_OK)
+    {
+        return error;
+    }
+    params->wait(MAX30101_AUTOCFG_CAPTURE * period_us + period_us / 2);
+    wait_us += MAX30101_AUTOCFG_CAPTURE * period_us + period_us / 2;
+    counters->captures++;
+    counters->capture_us += wait_us;
+
+    uint8_t wp, ovf, rp;
+    error = MAX30101_ReadFIFOPointers(&wp, &ovf, &rp);
+    if (error != MAX30101_OK)
+    {
+        return error;
+    }
+    uint8_t count = (wp - rp) & 0x1F;
+    if (count > MAX30101_AUTOCFG_CAPTURE)
+    {
+        count = MAX30101_AUTOCFG_CAPTURE;
+    }
+    if (count < 4)
+    {
+        return MAX30101_ERROR;
+    }
+    error = MAX30101_ReadRawFIFOBytes(count, params->active_leds, autocfg_raw);
+    if (error != MAX30101_OK)
+    {
+        return error;
+    }
+
+    *snr = 0xFFFF;
+    *peak = 0;
+    for (uint8_t led = 0; led < params->active_leds; led++)
+    {
+        uint32_t sum = 0;
+        uint64_t sum_diff = 0;
+        uint32_t previous = 0;
+        for (uint8_t i = 0; i < count; i++)
+        {
+            const uint8_t* bytes = &autocfg_raw[3 * (i * params->active_leds + led)];
+            uint32_t sample = ((((uint32_t)bytes[0] << 16) | ((uint32_t)bytes[1] << 8) | bytes[2]) & 0x3FFFF) >>
+                              (3 - pulse_width);
+            sum += sample;
+            if (i > 0)
+            {
+                int32_t diff = (int32_t)sample - (int32_t)previous;
+                sum_diff += (uint64_t)((int64_t)diff * diff);
+            }
+            if (sample > *peak)
+            {
+                *peak = sample;
+            }
+            previous = sample;
+        }
+
+        // noise^2 = mean square difference / 2, Q8
+        uint32_t noise_q4 = MAX30101_Sqrt64((sum_diff << 8) / (2 * (count - 1)));
+        uint32_t channel_snr = 0xFFFF;
+        if (noise_q4 > 0)
+        {
+            channel_snr = (uint32_t)((((uint64_t)sum / count) << 4) / noise_q4);
+        }
+        if (channel_snr < *snr)
+        {
+            *snr = (channel_snr > 0xFFFF) ? 0xFFFF : (uint16_t)channel_snr;
+        }
+    }
+    return MAX30101_OK;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,146 @@
+/**
+*   \file MAX30101_AutoConfig.h
+*
+*   \brief Search of the acquisition settings with the best SNR under a power budget.
+*
+*   Pulse width, sample averaging, LED amplitude and ADC range trade
+*   noise against LED power:
+*   - longer pulses and more averaged samples lower the noise, but the
+*     LEDs are on longer (the ADC sample rate is the output rate times
+*     the averaged samples);
+*   - more LED current raises the signal, until it clips at the highest
+*     range;
+*   - the lowest range that does not clip gives the finest resolution.
+*
+*   #MAX30101_AutoConfig_Search tries, for each pulse width and sample
+*   averaging allowed at the output rate (see MAX30101_Rate.h), the
+*   largest candidate LED amplitude within the budget. A capture at the
+*   highest range gives the light level: if it clips, the next lower
+*   amplitude is tried; otherwise the lowest range with headroom is
+*   selected and a second capture measures the SNR there. The setting with the best SNR of all channels
+*   (lower power on ties) is applied and returned.
+*
+*   SNR is the mean of a channel over its noise, estimated from the
+*   differences of consecutive samples (which removes the slow pulse and
+*   baseline): noise = rms(x[n] - x[n-1]) / sqrt(2).
+*
+*   LED power is estimated as amplitude (0.2 mA per LSB) x
+*   #MAX30101_AUTOCFG_VLED_MV x duty cycle (pulse width x ADC sample rate),
+*   for each active LED.
+*
+*   The result can be packed in #MAX30101_AUTOCFG_CACHE_SIZE bytes (e.g.,
+*   in EEPROM) and applied at the next boot with
+*   #MAX30101_AutoConfig_Apply, without searching again.
+*/
+
+#ifndef __MAX30101_AUTOCONFIG_H__
+    #define __MAX30101_AUTOCONFIG_H__
+
+    #include "cytypes.h"
+
+    /**
+    *   \brief LED supply voltage, in mV, for the power estimate.
+    */
+    #ifndef MAX30101_AUTOCFG_VLED_MV
+        #define MAX30101_AUTOCFG_VLED_MV 5000
+    #endif
+
+    /**
+    *   \brief Samples captured to measure the SNR (up to 30: a full FIFO reads as empty).
+    */
+    #ifndef MAX30101_AUTOCFG_CAPTURE
+        #define MAX30101_AUTOCFG_CAPTURE 30
+    #endif
+
+    /**
+    *   \brief Samples discarded after a change of settings.
+    */
+    #ifndef MAX30101_AUTOCFG_DISCARD
+        #define MAX30101_AUTOCFG_DISCARD 2
+    #endif
+
+    /**
+    *   \brief Size of a packed result.
+    */
+    #define MAX30101_AUTOCFG_CACHE_SIZE 12
+
+    /**
+    *   \brief Search parameters.
+    */
+    typedef struct
+    {
+        uint16_t sample_rate;       ///< Output sample rate, in samples/s (50 to 3200).
+        uint32_t budget_uw;         ///< LED power budget, in uW.
+        uint8_t active_leds;        ///< Channels in the FIFO (LED1 to LEDn), in the mode set at boot.
+        const uint8_t* led_pa;      ///< Candidate LED amplitudes, ascending.
+        uint8_t num_led_pa;         ///< Number of candidate LED amplitudes.
+        void (*wait)(uint32_t us);  ///< Wait function (e.g., CyDelayUs in a loop).
+    } MAX30101_AutoConfigParams;
+
+    /**
+    *   \brief Selected setting.
+    */
+    typedef struct
+    {
+        uint8_t spo2_conf;      ///< ADC range, sample rate and pulse width (#MAX30101_SPO2_CONF).
+        uint8_t sample_avg;     ///< Sample averaging (#MAX30101_SAMPLE_AVG_1 to #MAX30101_SAMPLE_AVG_32).
+        uint8_t led_pa;         ///< Amplitude of the active LEDs.
+        uint8_t active_leds;    ///< Number of active LEDs.
+        uint16_t snr;           ///< Lowest SNR of the channels (mean over noise).
+        uint32_t power_uw;      ///< Estimated LED power, in uW.
+        uint16_t captures;      ///< Captures taken by the search.
+        uint32_t capture_us;    ///< Time waited for samples by the search, in us.
+    } MAX30101_AutoConfigResult;
+
+    /**
+    *   \brief Search the setting with the best SNR within the power budget, and apply it.
+    *
+    *   The device must be running in the mode of params->active_leds.
+    *   \param[in] params search parameters.
+    *   \param[out] result selected setting.
+    *   \retval #MAX30101_OK if a setting was found.
+    *   \retval #MAX30101_DEV_NOT_FOUND if device is not present on the I2C bus.
+    *   \retval #MAX30101_ERROR if no setting fits the budget or the sample rate.
+    */
+    uint8_t MAX30101_AutoConfig_Search(const MAX30101_AutoConfigParams* params, MAX30101_AutoConfigResult* result);
+
+    /**
+    *   \brief Estimated LED power of a setting.
+    *
+    *   \param[in] spo2_conf sample rate and pulse width (#MAX30101_SPO2_CONF).
+    *   \param[in] led_pa amplitude of the active LEDs.
+    *   \param[in] active_leds number of active LEDs.
+    *   \return power in uW.
+    */
+    uint32_t MAX30101_AutoConfig_Power(uint8_t spo2_conf, uint8_t led_pa, uint8_t active_leds);
+
+    /**
+    *   \brief Apply a setting.
+    *
+    *   \param[in] result setting, from a search or a cache.
+    *   \retval #MAX30101_OK if no error occurred.
+    *   \retval #MAX30101_DEV_NOT_FOUND if device is not present on the I2C bus.
+    *   \retval #MAX30101_ERROR if an error occurred.
+    */
+    uint8_t MAX30101_AutoConfig_Apply(const MAX30101_AutoConfigResult* result);
+
+    /**
+    *   \brief Pack a setting, with a version and a checksum.
+    *
+    *   \param[in] result setting.
+    *   \param[out] cache #MAX30101_AUTOCFG_CACHE_SIZE bytes.
+    */
+    void MAX30101_AutoConfig_Pack(const MAX30101_AutoConfigResult* result, uint8_t* cache);
+
+    /**
+    *   \brief Unpack a setting.
+    *
+    *   \param[in] cache #MAX30101_AUTOCFG_CACHE_SIZE bytes.
+    *   \param[out] result setting.
+    *   \retval #MAX30101_OK if the cache holds a valid setting.
+    *   \retval #MAX30101_ERROR otherwise (e.g., erased memory).
+    */
+    uint8_t MAX30101_AutoConfig_Unpack(const uint8_t* cache, MAX30101_AutoConfigResult* result);
+
+#endif
+/* [] END OF FILE */
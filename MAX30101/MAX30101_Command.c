@@ -0,0 +1,256 @@
+/**
+*   Source file for the binary command channel.
+*/
+
+#include "MAX30101_Command.h"
+#include "MAX30101.h"
+#include "CyLib.h"
+#include "string.h"
+
+//==============================================
+//          MACROS
+//==============================================
+
+/**
+*   \brief Position in the frame being received.
+*/
+#define CMD_STATE_SYNC      0
+#define CMD_STATE_COMMAND   1
+#define CMD_STATE_LENGTH    2
+#define CMD_STATE_PAYLOAD   3
+#define CMD_STATE_CRC       4
+
+/**
+*   \brief Channel counters at the start of the COUNTERS reply.
+*/
+#define CMD_COUNTERS_SIZE   12
+
+//==============================================
+//          FUNCTION PROTOTYPES
+//==============================================
+
+static uint8_t MAX30101_Cmd_CrcByte(uint8_t crc, uint8_t byte);
+
+static void MAX30101_Cmd_Put32(uint8_t* bytes, uint32_t value);
+
+// Initialize a channel
+void MAX30101_Cmd_Init(MAX30101_CmdChannel* channel)
+{
+    uint8 interrupts = CyEnterCriticalSection();
+    memset(channel, 0, sizeof(MAX30101_CmdChannel));
+    CyExitCriticalSection(interrupts);
+}
+
+// Parse a received byte
+uint8_t MAX30101_Cmd_Feed(MAX30101_CmdChannel* channel, uint8_t byte)
+{
+    uint8_t* frame = channel->frames[channel->fill];
+    switch (channel->state)
+    {
+        case CMD_STATE_SYNC:
+            if (byte == MAX30101_CMD_SYNC)
+            {
+                channel->crc = 0;
+                channel->state = CMD_STATE_COMMAND;
+            }
+            else
+            {
+                channel->text = byte;
+            }
+            return 0;
+        case CMD_STATE_COMMAND:
+            frame[0] = byte;
+            channel->crc = MAX30101_Cmd_CrcByte(channel->crc, byte);
+            channel->state = CMD_STATE_LENGTH;
+            return 0;
+        case CMD_STATE_LENGTH:
+            if (byte > MAX30101_CMD_MAX_PAYLOAD)
+            {
+                // Not a frame, or a corrupted one: look for the next sync byte
+                channel->crc_errors++;
+                channel->state = CMD_STATE_SYNC;
+                return 0;
+            }
+            frame[1] = byte;
+            channel->crc = MAX30101_Cmd_CrcByte(channel->crc, byte);
+            channel->count = 0;
+            channel->state = (byte > 0) ? CMD_STATE_PAYLOAD : CMD_STATE_CRC;
+            return 0;
+        case CMD_STATE_PAYLOAD:
+            frame[2 + channel->count] = byte;
+            channel->crc = MAX30101_Cmd_CrcByte(channel->crc, byte);
+            if (++channel->count == frame[1])
+            {
+                channel->state = CMD_STATE_CRC;
+            }
+            return 0;
+        default:
+            channel->state = CMD_STATE_SYNC;
+            if (byte != channel->crc)
+            {
+                channel->crc_errors++;
+                return 0;
+            }
+            if (channel->ready != 0)
+            {
+                // The other buffer is still waiting: receive in this one again
+                channel->dropped++;
+                return 0;
+            }
+            channel->ready = channel->fill + 1;
+            channel->fill ^= 1;
+            return 1;
+    }
+}
+
+// Execute the waiting command
+uint8_t MAX30101_Cmd_Execute(MAX30101_CmdChannel* channel, const MAX30101_CmdHandlers* handlers)
+{
+    if (channel->ready == 0)
+    {
+        return 0;
+    }
+    // Not written by the interrupt until ready is cleared
+    const uint8_t* frame = channel->frames[channel->ready - 1];
+    uint8_t command = frame[0];
+    uint8_t length = frame[1];
+    const uint8_t* payload = &frame[2];
+
+    uint8_t reply[MAX30101_CMD_MAX_FRAME];
+    uint8_t* out = &reply[4];
+    uint8_t out_length = 0;
+    uint8_t status = MAX30101_ERROR;
+    uint8_t written = 0;
+
+    switch (command)
+    {
+        case MAX30101_CMD_READ:
+            // A range with FIFO_DATA would take samples out of the FIFO
+            if ((length == 2) && (payload[1] > 0) && (payload[1] <= MAX30101_CMD_MAX_PAYLOAD) &&
+                ((uint8_t)(MAX30101_FIFO_DATA - payload[0]) >= payload[1]))
+            {
+                status = MAX30101_ReadRegisters(payload[0], payload[1], out);
+                out_length = (status == MAX30101_OK) ? payload[1] : 0;
+            }
+            break;
+        case MAX30101_CMD_WRITE:
+            if (length >= 2)
+            {
+                status = MAX30101_WriteRegisters(payload[0], length - 1, &payload[1]);
+                written = 1;
+            }
+            break;
+        case MAX30101_CMD_CONFIG:
+            if (length == MAX30101_CMD_CONFIG_SIZE)
+            {
+                MAX30101_Config config;
+                config.int_en_1 = payload[0];
+                config.int_en_2 = payload[1];
+                config.fifo_conf = payload[2];
+                config.mode_conf = payload[3];
+                config.spo2_conf = payload[4];
+                memcpy(config.led_pa, &payload[5], sizeof(config.led_pa));
+                config.pilot_pa = payload[9];
+                memcpy(config.multi_led, &payload[10], sizeof(config.multi_led));
+                config.prox_thresh = payload[12];
+                // Nothing is written if the sample rate is not allowed (MAX30101_Rate_Check)
+                status = MAX30101_ApplyConfig(&config);
+                written = 1;
+            }
+            break;
+        case MAX30101_CMD_STREAM:
+            if ((length == 1) && (payload[0] <= 1) && (handlers->set_streaming != NULL))
+            {
+                handlers->set_streaming(payload[0]);
+                status = MAX30101_OK;
+            }
+            break;
+        case MAX30101_CMD_COUNTERS:
+            if (length == 0)
+            {
+                MAX30101_Cmd_Put32(&out[0], channel->commands);
+                MAX30101_Cmd_Put32(&out[4], channel->crc_errors);
+                MAX30101_Cmd_Put32(&out[8], channel->dropped);
+                out_length = CMD_COUNTERS_SIZE;
+                if (handlers->get_counters != NULL)
+                {
+                    out_length += handlers->get_counters(&out[CMD_COUNTERS_SIZE],
+                                                         MAX30101_CMD_MAX_PAYLOAD - CMD_COUNTERS_SIZE);
+                }
+                status = MAX30101_OK;
+            }
+            break;
+        case MAX30101_CMD_SNAPSHOT:
+            if (length == 0)
+            {
+                MAX30101_RegSnapshot snapshot;
+                status = MAX30101_Snapshot(&snapshot);
+                if (status == MAX30101_OK)
+                {
+                    memcpy(out, &snapshot, MAX30101_SNAPSHOT_SIZE);
+                    out_length = MAX30101_SNAPSHOT_SIZE;
+                }
+            }
+            break;
+        default:
+            break;
+    }
+    if (written && (status == MAX30101_OK) && (handlers->configured != NULL))
+    {
+        handlers->configured();
+    }
+
+    // The payload is not used anymore: the interrupt can fill the buffer
+    channel->commands++;
+    channel->ready = 0;
+
+    reply[0] = MAX30101_CMD_REPLY_SYNC;
+    reply[1] = command;
+    reply[2] = status;
+    reply[3] = out_length;
+    reply[4 + out_length] = MAX30101_Cmd_Crc8(0, &reply[1], 3 + out_length);
+    handlers->send(reply, 5 + out_length);
+    return 1;
+}
+
+// Take the last text byte
+uint8_t MAX30101_Cmd_GetText(MAX30101_CmdChannel* channel)
+{
+    uint8 interrupts = CyEnterCriticalSection();
+    uint8_t byte = channel->text;
+    channel->text = 0;
+    CyExitCriticalSection(interrupts);
+    return byte;
+}
+
+// CRC-8 of bytes
+uint8_t MAX30101_Cmd_Crc8(uint8_t crc, const uint8_t* bytes, uint8_t length)
+{
+    for (uint8_t i = 0; i < length; i++)
+    {
+        crc = MAX30101_Cmd_CrcByte(crc, bytes[i]);
+    }
+    return crc;
+}
+
+// CRC-8 update with a byte, polynomial x^8 + x^2 + x + 1
+static uint8_t MAX30101_Cmd_CrcByte(uint8_t crc, uint8_t byte)
+{
+    crc ^= byte;
+    for (uint8_t bit = 0; bit < 8; bit++)
+    {
+        crc = (crc & 0x80) ? (uint8_t)((crc << 1) ^ 0x07) : (uint8_t)(crc << 1);
+    }
+    return crc;
+}
+
+// Write a 32-bit value, little endian
+static void MAX30101_Cmd_Put32(uint8_t* bytes, uint32_t value)
+{
+    bytes[0] = value & 0xFF;
+    bytes[1] = (value >> 8) & 0xFF;
+    bytes[2] = (value >> 16) & 0xFF;
+    bytes[3] = (value >> 24) & 0xFF;
+}
+
+/* [] END OF FILE */
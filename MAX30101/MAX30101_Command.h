@@ -0,0 +1,177 @@
+/**
+*   \file MAX30101_Command.h
+*
+*   \brief Binary command channel for remote reconfiguration.
+*
+*   Commands are received on the UART in frames:
+*   \code
+*   request: 0xA5 | command | length | payload (length bytes) | CRC
+*   reply:   0x5A | command | status | length | payload (length bytes) | CRC
+*   \endcode
+*   The CRC is a CRC-8 (polynomial 0x07, initial value 0) of the bytes
+*   after the sync byte. The status is #MAX30101_OK, #MAX30101_DEV_NOT_FOUND
+*   or #MAX30101_ERROR (unknown command, invalid payload).
+*
+*   | Command                      | Payload                        | Reply payload            |
+*   |------------------------------|--------------------------------|--------------------------|
+*   | #MAX30101_CMD_READ           | register, count (1 to 32)      | count register values    |
+*   | #MAX30101_CMD_WRITE          | register, values (1 to 31)     | none                     |
+*   | #MAX30101_CMD_CONFIG         | #MAX30101_CMD_CONFIG_SIZE bytes | none                    |
+*   | #MAX30101_CMD_STREAM         | 0 to stop, 1 to start          | none                     |
+*   | #MAX30101_CMD_COUNTERS       | none                           | counters, see below      |
+*   | #MAX30101_CMD_SNAPSHOT       | none                           | #MAX30101_RegSnapshot    |
+*
+*   READ refuses a range that includes #MAX30101_FIFO_DATA, which would
+*   take samples out of the FIFO. WRITE writes consecutive registers with
+*   a single burst write and CONFIG applies a whole configuration with
+*   #MAX30101_ApplyConfig, which refuses it, writing nothing, if the
+*   sample rate is not allowed (#MAX30101_Rate_Check); its
+*   payload is int_en_1, int_en_2, fifo_conf, mode_conf, spo2_conf,
+*   led_pa[0..3], pilot_pa, multi_led[0..1] and prox_thresh. COUNTERS
+*   replies with the commands executed, the frames with a wrong CRC and
+*   the commands dropped (little endian, 4 bytes each), followed by the
+*   counters of the application.
+*
+*   Bytes are parsed one at a time in an interrupt (e.g., UART receive
+*   or a periodic poll of the UART) with
+*   #MAX30101_Cmd_Feed, without allocation: a frame is received in one
+*   of two buffers while the other holds the command waiting to be
+*   executed. Commands are executed outside the interrupt, in a task,
+*   with #MAX30101_Cmd_Execute; a command received before the previous
+*   one is executed is dropped. Bytes outside frames are kept for text
+*   commands (#MAX30101_Cmd_GetText): frames start with a byte that is
+*   not ASCII.
+*/
+
+#ifndef __MAX30101_COMMAND_H__
+    #define __MAX30101_COMMAND_H__
+
+    #include "cytypes.h"
+
+    /**
+    *   \brief Sync bytes of requests and replies.
+    */
+    #define MAX30101_CMD_SYNC       0xA5
+    #define MAX30101_CMD_REPLY_SYNC 0x5A
+
+    /**
+    *   \brief Longest payload.
+    */
+    #define MAX30101_CMD_MAX_PAYLOAD 32
+
+    //==============================================
+    //           COMMANDS
+    //==============================================
+    /**
+    *   \brief Read consecutive registers.
+    */
+    #define MAX30101_CMD_READ       0x01
+
+    /**
+    *   \brief Write consecutive registers.
+    */
+    #define MAX30101_CMD_WRITE      0x02
+
+    /**
+    *   \brief Apply a complete configuration.
+    */
+    #define MAX30101_CMD_CONFIG     0x03
+
+    /**
+    *   \brief Start or stop streaming.
+    */
+    #define MAX30101_CMD_STREAM     0x04
+
+    /**
+    *   \brief Read the counters.
+    */
+    #define MAX30101_CMD_COUNTERS   0x05
+
+    /**
+    *   \brief Read all the registers but FIFO_DATA and the interrupt status (#MAX30101_Snapshot, #MAX30101_SNAPSHOT_SIZE bytes).
+    */
+    #define MAX30101_CMD_SNAPSHOT   0x06
+
+    /**
+    *   \brief Payload of #MAX30101_CMD_CONFIG.
+    */
+    #define MAX30101_CMD_CONFIG_SIZE 13
+
+    /**
+    *   \brief Longest frame: sync, command, status, length, payload and CRC.
+    */
+    #define MAX30101_CMD_MAX_FRAME (MAX30101_CMD_MAX_PAYLOAD + 5)
+
+    /**
+    *   \brief Functions of the application called by #MAX30101_Cmd_Execute.
+    */
+    typedef struct
+    {
+        void (*send)(const uint8_t* bytes, uint8_t length);         ///< Send a reply (e.g., UART_Debug_PutArray).
+        void (*set_streaming)(uint8_t on);                          ///< Start (1) or stop (0) streaming, can be NULL.
+        uint8_t (*get_counters)(uint8_t* payload, uint8_t size);    ///< Write counters, return their length, can be NULL.
+        void (*configured)(void);   ///< Called after registers are written, can be NULL.
+    } MAX30101_CmdHandlers;
+
+    /**
+    *   \brief State of the command channel.
+    */
+    typedef struct
+    {
+        uint8_t frames[2][MAX30101_CMD_MAX_PAYLOAD + 2];    ///< Command, length and payload of two frames.
+        volatile uint8_t ready;     ///< Frame waiting to be executed, plus 1; 0 if none.
+        uint8_t fill;               ///< Frame being received.
+        uint8_t state;              ///< Position in the frame being received.
+        uint8_t count;              ///< Payload bytes received.
+        uint8_t crc;                ///< CRC of the bytes received.
+        volatile uint8_t text;      ///< Last byte received outside a frame, 0 if none.
+        volatile uint32_t commands;     ///< Commands executed.
+        volatile uint32_t crc_errors;   ///< Frames with a wrong CRC or length.
+        volatile uint32_t dropped;      ///< Commands received while another was waiting.
+    } MAX30101_CmdChannel;
+
+    /**
+    *   \brief Initialize a channel: no frame, counters cleared.
+    *
+    *   \param[out] channel command channel.
+    */
+    void MAX30101_Cmd_Init(MAX30101_CmdChannel* channel);
+
+    /**
+    *   \brief Parse a received byte, e.g., in the interrupt polling the UART.
+    *
+    *   \param[in,out] channel command channel.
+    *   \param[in] byte received byte.
+    *   \return 1 if a command is now waiting for #MAX30101_Cmd_Execute, 0 otherwise.
+    */
+    uint8_t MAX30101_Cmd_Feed(MAX30101_CmdChannel* channel, uint8_t byte);
+
+    /**
+    *   \brief Execute the waiting command and send its reply.
+    *
+    *   \param[in,out] channel command channel.
+    *   \param[in] handlers functions of the application.
+    *   \return 1 if a command was executed, 0 if none was waiting.
+    */
+    uint8_t MAX30101_Cmd_Execute(MAX30101_CmdChannel* channel, const MAX30101_CmdHandlers* handlers);
+
+    /**
+    *   \brief Take the last byte received outside a frame (text command).
+    *
+    *   \param[in,out] channel command channel.
+    *   \return the byte, 0 if none.
+    */
+    uint8_t MAX30101_Cmd_GetText(MAX30101_CmdChannel* channel);
+
+    /**
+    *   \brief Update a CRC-8 (polynomial 0x07) with bytes.
+    *
+    *   \param[in] crc CRC of the previous bytes, 0 to start.
+    *   \param[in] bytes bytes.
+    *   \param[in] length number of bytes.
+    *   \return the CRC.
+    */
+    uint8_t MAX30101_Cmd_Crc8(uint8_t crc, const uint8_t* bytes, uint8_t length);
+
+#endif
+/* [] END OF FILE */
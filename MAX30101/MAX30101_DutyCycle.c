@@ -0,0 +1,122 @@
+/**
+*   Source file for the MAX30101 duty cycle scheduler.
+*/
+
+#include "MAX30101_DutyCycle.h"
+
+//==============================================
+//          FUNCTION PROTOTYPES
+//==============================================
+
+static uint8_t MAX30101_Duty_BeginBurst(MAX30101_Duty* duty);
+
+// Start the scheduler with a burst
+uint8_t MAX30101_Duty_Start(MAX30101_Duty* duty, const MAX30101_DutyConfig* config, uint32_t now_ms)
+{
+    if ((config->period_ms == 0) || (config->burst_ms == 0) ||
+        (config->burst_ms > config->period_ms) || (config->sample_rate_hz == 0))
+    {
+        return MAX30101_ERROR;
+    }
+
+    duty->config = *config;
+    duty->bursts = 0;
+    duty->discarded = 0;
+    duty->valid = 0;
+    duty->burst_start_ms = now_ms;
+    return MAX30101_Duty_BeginBurst(duty);
+}
+
+// Shutdown or wake up the sensor according to current time
+uint8_t MAX30101_Duty_Update(MAX30101_Duty* duty, uint32_t now_ms)
+{
+    // Unsigned difference is correct also when the ms counter wraps
+    uint32_t elapsed = now_ms - duty->burst_start_ms;
+
+    if ((duty->state != MAX30101_DUTY_OFF) && (elapsed >= duty->config.burst_ms))
+    {
+        duty->state = MAX30101_DUTY_OFF;
+        return MAX30101_Shutdown();
+    }
+
+    if ((duty->state == MAX30101_DUTY_OFF) && (elapsed >= duty->config.period_ms))
+    {
+        // Keep bursts on a fixed grid, unless we are late by more than a period
+        if (elapsed >= 2 * duty->config.period_ms)
+        {
+            duty->burst_start_ms = now_ms;
+        }
+        else
+        {
+            duty->burst_start_ms += duty->config.period_ms;
+        }
+        return MAX30101_Duty_BeginBurst(duty);
+    }
+
+    return MAX30101_OK;
+}
+
+// Drop settling samples at the beginning of a burst
+uint8_t MAX30101_Duty_Discard(MAX30101_Duty* duty, uint8_t num_samples)
+{
+    if (duty->state == MAX30101_DUTY_OFF)
+    {
+        duty->discarded += num_samples;
+        return num_samples;
+    }
+
+    uint8_t skip = num_samples;
+    if (duty->discard_left < num_samples)
+    {
+        skip = (uint8_t)duty->discard_left;
+    }
+    duty->discard_left -= skip;
+    if (duty->discard_left == 0)
+    {
+        duty->state = MAX30101_DUTY_ON;
+    }
+
+    duty->discarded += skip;
+    duty->valid += num_samples - skip;
+    return skip;
+}
+
+// Check if sensor is awake
+uint8_t MAX30101_Duty_IsAcquiring(const MAX30101_Duty* duty)
+{
+    return (duty->state != MAX30101_DUTY_OFF) ? 1 : 0;
+}
+
+// Power and latency model
+void MAX30101_Duty_Model(const MAX30101_DutyConfig* config, const MAX30101_PowerModel* power,
+                         MAX30101_DutyReport* report)
+{
+    float sample_period_ms = 1000.0f / config->sample_rate_hz;
+
+    report->duty_cycle = (float)config->burst_ms / config->period_ms;
+    report->settle_ms = config->settle_samples * sample_period_ms;
+    report->settle_overhead = report->settle_ms / config->burst_ms;
+    // The first valid sample is the one after the settling samples
+    report->first_valid_ms = power->wake_ms + (config->settle_samples + 1) * sample_period_ms;
+    report->always_on_ua = power->active_ua + power->led_ua;
+    report->average_ua = report->duty_cycle * report->always_on_ua +
+                         (1.0f - report->duty_cycle) * power->shutdown_ua;
+}
+
+// Wake up the sensor and start discarding settling samples
+static uint8_t MAX30101_Duty_BeginBurst(MAX30101_Duty* duty)
+{
+    duty->bursts++;
+    duty->discard_left = duty->config.settle_samples;
+    duty->state = (duty->discard_left > 0) ? MAX30101_DUTY_SETTLING : MAX30101_DUTY_ON;
+
+    uint8_t error = MAX30101_WakeUp();
+    if (error == MAX30101_OK)
+    {
+        // Samples left over from the previous burst are stale
+        error = MAX30101_FlushFIFO();
+    }
+    return error;
+}
+
+/* [] END OF FILE */
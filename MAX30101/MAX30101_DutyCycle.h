@@ -0,0 +1,164 @@
+/**
+*   \file MAX30101_DutyCycle.h
+*
+*   \brief Duty-cycled acquisition scheduler for the MAX30101.
+*
+*   For battery powered deployments the MAX30101 does not need to sample
+*   continuously. This module samples in bursts (e.g., 10 s every minute)
+*   and puts the sensor in shutdown between bursts with #MAX30101_Shutdown.
+*   At the beginning of each burst the sensor is woken up with
+*   #MAX30101_WakeUp, the FIFO is flushed in a single transaction and a
+*   configurable number of settling samples is discarded, so that the
+*   first valid sample is available as early as possible.
+*
+*   The scheduler does not own a time base: the current time in ms
+*   (e.g., from a SysTick or a timer) is passed to #MAX30101_Duty_Update.
+*
+*   Typical usage:
+*   \code
+*   MAX30101_Duty duty;
+*   MAX30101_Duty_Start(&duty, &duty_config, now_ms());
+*   for(;;)
+*   {
+*       MAX30101_Duty_Update(&duty, now_ms());
+*       if (fifo_interrupt && MAX30101_Duty_IsAcquiring(&duty))
+*       {
+*           // read num_samples from FIFO, then drop the first ones
+*           uint8_t skip = MAX30101_Duty_Discard(&duty, num_samples);
+*       }
+*   }
+*   \endcode
+*/
+
+#ifndef __MAX30101_DUTYCYCLE_H__
+    #define __MAX30101_DUTYCYCLE_H__
+
+    #include "cytypes.h"
+    #include "MAX30101.h"
+
+    /**
+    *   \brief Sensor is in shutdown between two bursts.
+    */
+    #define MAX30101_DUTY_OFF 0
+
+    /**
+    *   \brief Sensor is awake, settling samples are being discarded.
+    */
+    #define MAX30101_DUTY_SETTLING 1
+
+    /**
+    *   \brief Sensor is awake and producing valid samples.
+    */
+    #define MAX30101_DUTY_ON 2
+
+    /**
+    *   \brief Configuration of the duty cycle scheduler.
+    */
+    typedef struct
+    {
+        uint32_t period_ms;         ///< Time between the start of two bursts.
+        uint32_t burst_ms;          ///< Duration of each burst.
+        uint16_t settle_samples;    ///< Samples discarded at the beginning of each burst.
+        uint16_t sample_rate_hz;    ///< Output sample rate of the FIFO (sample rate / averaged samples).
+    } MAX30101_DutyConfig;
+
+    /**
+    *   \brief State of the duty cycle scheduler.
+    */
+    typedef struct
+    {
+        MAX30101_DutyConfig config; ///< Current configuration.
+        uint8_t state;              ///< Current state (#MAX30101_DUTY_OFF, #MAX30101_DUTY_SETTLING, #MAX30101_DUTY_ON).
+        uint32_t burst_start_ms;    ///< Start time of the current (or last) burst.
+        uint16_t discard_left;      ///< Settling samples still to be discarded.
+        uint32_t bursts;            ///< Number of bursts started.
+        uint32_t discarded;         ///< Total number of discarded samples.
+        uint32_t valid;             ///< Total number of valid samples.
+    } MAX30101_Duty;
+
+    /**
+    *   \brief Power figures used by the duty cycle model.
+    *
+    *   Currents are in uA. LED current is the average current drawn by the
+    *   LEDs while sampling, i.e., pulse amplitude x pulse width x sample rate
+    *   for each active LED.
+    */
+    typedef struct
+    {
+        float active_ua;        ///< Supply current while sampling, LEDs excluded (600 uA typical).
+        float shutdown_ua;      ///< Supply current in shutdown (0.7 uA typical).
+        float led_ua;           ///< Average LED current while sampling.
+        float wake_ms;          ///< Time from wake-up command to first sample in the FIFO.
+    } MAX30101_PowerModel;
+
+    /**
+    *   \brief Results of the duty cycle model.
+    */
+    typedef struct
+    {
+        float duty_cycle;           ///< Fraction of time the sensor is awake.
+        float settle_ms;            ///< Time spent discarding settling samples in each burst.
+        float settle_overhead;      ///< Fraction of awake time spent settling.
+        float first_valid_ms;       ///< Time from burst start to first valid sample.
+        float average_ua;           ///< Average supply current, LEDs included.
+        float always_on_ua;         ///< Average supply current when sampling continuously.
+    } MAX30101_DutyReport;
+
+    /**
+    *   \brief Start the duty cycle scheduler.
+    *
+    *   This function stores the configuration and starts the first burst.
+    *   \param[out] duty pointer to the scheduler.
+    *   \param[in] config pointer to the configuration to be used.
+    *   \param[in] now_ms current time in ms.
+    *   \retval #MAX30101_OK if no error occurred.
+    *   \retval #MAX30101_DEV_NOT_FOUND if device is not present on the I2C bus.
+    *   \retval #MAX30101_ERROR if the configuration is not valid.
+    */
+    uint8_t MAX30101_Duty_Start(MAX30101_Duty* duty, const MAX30101_DutyConfig* config, uint32_t now_ms);
+
+    /**
+    *   \brief Update the duty cycle scheduler.
+    *
+    *   This function shuts the sensor down at the end of a burst and wakes
+    *   it up at the beginning of the next one. It must be called periodically,
+    *   with a resolution adequate for the configured burst duration.
+    *   \param[in,out] duty pointer to the scheduler.
+    *   \param[in] now_ms current time in ms.
+    *   \retval #MAX30101_OK if no error occurred.
+    *   \retval #MAX30101_DEV_NOT_FOUND if device is not present on the I2C bus.
+    */
+    uint8_t MAX30101_Duty_Update(MAX30101_Duty* duty, uint32_t now_ms);
+
+    /**
+    *   \brief Get the number of samples to be discarded from a FIFO read.
+    *
+    *   This function must be called for each block of samples read from the FIFO.
+    *   It returns how many of the first samples of the block are still settling
+    *   and must be discarded.
+    *   \param[in,out] duty pointer to the scheduler.
+    *   \param[in] num_samples number of samples read from the FIFO.
+    *   \return number of samples to be discarded from the beginning of the block.
+    */
+    uint8_t MAX30101_Duty_Discard(MAX30101_Duty* duty, uint8_t num_samples);
+
+    /**
+    *   \brief Check if the sensor is awake.
+    *
+    *   \param[in] duty pointer to the scheduler.
+    *   \return 1 if the sensor is sampling, 0 if it is in shutdown.
+    */
+    uint8_t MAX30101_Duty_IsAcquiring(const MAX30101_Duty* duty);
+
+    /**
+    *   \brief Compute power and latency figures for a duty cycle configuration.
+    *
+    *   \param[in] config duty cycle configuration.
+    *   \param[in] power power figures of the sensor.
+    *   \param[out] report computed figures.
+    */
+    void MAX30101_Duty_Model(const MAX30101_DutyConfig* config, const MAX30101_PowerModel* power,
+                             MAX30101_DutyReport* report);
+
+#endif
+/* [] END OF FILE */
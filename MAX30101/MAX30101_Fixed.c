@@ -0,0 +1,50 @@
+/**
+*   Source file for the MAX30101 reader specialised for a fixed acquisition mode.
+*/
+
+#include "MAX30101_Fixed.h"
+
+// Reader for the settings in MAX30101_FixedConfig.h
+MAX30101_FIXED_DEFINE(MAX30101_Fixed, MAX30101_FIXED_LEDS, MAX30101_FIXED_SHIFT)
+
+// Compare device configuration with compiled settings
+uint8_t MAX30101_Fixed_Check(void)
+{
+    uint8_t mode_conf, spo2_conf, fifo_conf;
+    uint8_t error = MAX30101_ReadRegister(MAX30101_MODE_CONF, &mode_conf);
+    if (error == MAX30101_OK)
+    {
+        error = MAX30101_ReadRegister(MAX30101_SPO2_CONF, &spo2_conf);
+    }
+    if (error == MAX30101_OK)
+    {
+        error = MAX30101_ReadRegister(MAX30101_FIFO_CONF, &fifo_conf);
+    }
+    if (error != MAX30101_OK)
+    {
+        return error;
+    }
+
+    // Bit 7 of SPO2_CONF is reserved, the ADC range (bits 6:5) does not change
+    // the FIFO format and may be switched at run time (MAX30101_Range.h),
+    // averaging is in bits 7:5 of FIFO_CONF
+    if (((mode_conf & 0x07) != MAX30101_FIXED_MODE_CONF) ||
+        ((spo2_conf & 0x1F) != (MAX30101_FIXED_SPO2_CONF & 0x1F)) ||
+        ((fifo_conf & 0xE0) != MAX30101_FIXED_FIFO_CONF))
+    {
+        return MAX30101_ERROR;
+    }
+
+#if (MAX30101_FIXED_MODE == MAX30101_MULTI_MODE)
+    uint8_t slots[MAX30101_MAX_SLOTS];
+    uint8_t active_slots;
+    error = MAX30101_ReadSlotConfig(slots, &active_slots);
+    if ((error == MAX30101_OK) && (active_slots != MAX30101_FIXED_LEDS))
+    {
+        return MAX30101_ERROR;
+    }
+#endif
+    return error;
+}
+
+/* [] END OF FILE */
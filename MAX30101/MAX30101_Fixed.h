@@ -0,0 +1,231 @@
+/**
+*   \file MAX30101_Fixed.h
+*
+*   \brief FIFO read specialised for a fixed acquisition mode.
+*
+*   #MAX30101_ReadFIFO and #MAX30101_ReadMultiLEDFIFO support any
+*   configuration: they read the pulse width (and the slots) from the
+*   device before each burst and test the number of channels for each
+*   sample. When the firmware never changes mode, all of this is known
+*   at compile time.
+*
+*   #MAX30101_FIXED_DECLARE and #MAX30101_FIXED_DEFINE generate a reader
+*   for a given number of channels and shift: a circular buffer with only
+*   the active channels, an unpack function without branches on the
+*   number of channels or on the pulse width, and a read function with a
+*   single I2C burst. MAX30101_Fixed.c instantiates them as MAX30101_Fixed
+*   for the settings in MAX30101_FixedConfig.h, e.g.:
+*   \code
+*   MAX30101_Fixed_Data data = {0};
+*   MAX30101_Fixed_ReadFIFO(num_samples, &data);
+*   red = data.channel[MAX30101_FIXED_RED][data.head];
+*   \endcode
+*/
+
+#ifndef __MAX30101_FIXED_H__
+    #define __MAX30101_FIXED_H__
+
+    #include "MAX30101.h"
+    #include "MAX30101_FixedConfig.h"
+    #include "MAX30101_Rate.h"
+    #include "I2C_Interface.h"
+    #include "MAX30101_Profile.h"
+
+    /**
+    *   \brief Number of samples in the FIFO.
+    */
+    #define MAX30101_FIXED_FIFO_DEPTH 32
+
+    /**
+    *   \brief Number of bytes of each channel in the FIFO.
+    */
+    #define MAX30101_FIXED_BYTES_PER_CHANNEL 3
+
+    /**
+    *   \brief Declare the circular buffer and the functions of a reader.
+    *
+    *   \param name prefix of the generated type and functions.
+    *   \param leds number of channels in the FIFO (1 to #MAX30101_MAX_SLOTS).
+    */
+    #define MAX30101_FIXED_DECLARE(name, leds) \
+        typedef struct \
+        { \
+            uint32_t channel[(leds)][BUFFER_STORAGE_SIZE]; \
+            uint8_t head; \
+            uint8_t tail; \
+        } name##_Data; \
+        void name##_Unpack(const uint8_t* raw, uint8_t num_samples, name##_Data* data); \
+        uint8_t name##_ReadFIFO(uint8_t num_samples, name##_Data* data); \
+        uint8_t name##_ReadSample(name##_Data* data)
+
+    /**
+    *   \brief Define the functions of a reader declared with #MAX30101_FIXED_DECLARE.
+    *
+    *   name##_Unpack() stores raw FIFO bytes in the circular buffer;
+    *   name##_ReadFIFO() reads num_samples samples (1 to 32) in a single
+    *   burst and unpacks them, returning the same codes as
+    *   #MAX30101_ReadMultiLEDFIFO. name##_ReadSample() reads one sample
+    *   (e.g., on the PPG_RDY interrupt): the register pointer does not
+    *   move on #MAX30101_FIFO_DATA, so if no other transfer used the bus
+    *   since its last read (see #I2C_Peripheral_GetTransfers) the register
+    *   address is not sent again and the transfer is only the address byte
+    *   and the bytes of the sample.
+    *   \param name prefix used in #MAX30101_FIXED_DECLARE.
+    *   \param leds number of channels used in #MAX30101_FIXED_DECLARE.
+    *   \param shift right shift given by the pulse width (3 - pulse width setting).
+    */
+    #define MAX30101_FIXED_DEFINE(name, leds, shift) \
+        void name##_Unpack(const uint8_t* raw, uint8_t num_samples, name##_Data* data) \
+        { \
+            uint8_t head = data->head; \
+            for (uint8_t sample = 0; sample < num_samples; sample++) \
+            { \
+                head = (head + 1) & (BUFFER_STORAGE_SIZE - 1); \
+                MAX30101_FIXED_UNPACK(raw, data->channel, head, 0, (leds), (shift)); \
+                MAX30101_FIXED_UNPACK(raw, data->channel, head, 1, (leds), (shift)); \
+                MAX30101_FIXED_UNPACK(raw, data->channel, head, 2, (leds), (shift)); \
+                MAX30101_FIXED_UNPACK(raw, data->channel, head, 3, (leds), (shift)); \
+                raw += (leds) * MAX30101_FIXED_BYTES_PER_CHANNEL; \
+            } \
+            data->head = head; \
+        } \
+        uint8_t name##_ReadFIFO(uint8_t num_samples, name##_Data* data) \
+        { \
+            static uint8_t raw[MAX30101_FIXED_FIFO_DEPTH*(leds)*MAX30101_FIXED_BYTES_PER_CHANNEL]; \
+            if ((num_samples == 0) || (num_samples > MAX30101_FIXED_FIFO_DEPTH)) \
+            { \
+                return MAX30101_ERROR; \
+            } \
+            MAX30101_PROFILE_BEGIN(MAX30101_STAGE_BURST); \
+            uint8_t error = MAX30101_ReadRawFIFOBytes(num_samples, (leds), raw); \
+            MAX30101_PROFILE_END(MAX30101_STAGE_BURST); \
+            if (error == MAX30101_OK) \
+            { \
+                MAX30101_PROFILE_BEGIN(MAX30101_STAGE_UNPACK); \
+                name##_Unpack(raw, num_samples, data); \
+                MAX30101_PROFILE_END(MAX30101_STAGE_UNPACK); \
+            } \
+            return error; \
+        } \
+        uint8_t name##_ReadSample(name##_Data* data) \
+        { \
+            static uint8_t raw[(leds)*MAX30101_FIXED_BYTES_PER_CHANNEL]; \
+            static uint8_t parked = 0; \
+            static uint32_t parked_at; \
+            uint8_t error; \
+            MAX30101_PROFILE_BEGIN(MAX30101_STAGE_BURST); \
+            if (parked && (I2C_Peripheral_GetTransfers() == parked_at)) \
+            { \
+                error = (I2C_Peripheral_ReadRegisterMultiNoAddress(MAX30101_I2C_ADDRESS, sizeof(raw), raw) \
+                         == I2C_NO_ERROR) ? MAX30101_OK : MAX30101_DEV_NOT_FOUND; \
+            } \
+            else \
+            { \
+                error = MAX30101_ReadRawFIFOBytes(1, (leds), raw); \
+            } \
+            parked = (error == MAX30101_OK); \
+            parked_at = I2C_Peripheral_GetTransfers(); \
+            MAX30101_PROFILE_END(MAX30101_STAGE_BURST); \
+            if (error == MAX30101_OK) \
+            { \
+                name##_Unpack(raw, 1, data); \
+            } \
+            return error; \
+        }
+
+    /**
+    *   \brief Unpack one channel of a sample, if ch is below leds.
+    *
+    *   The condition is a constant, so that unused channels generate no code.
+    *   Channels are stored MSB first on three bytes, only the 18 LSBs are valid.
+    */
+    #define MAX30101_FIXED_UNPACK(raw, channel, head, ch, leds, shift) \
+        if ((ch) < (leds)) \
+        { \
+            channel[(ch) % (leds)][head] = ((((uint32_t)raw[3*(ch)] & 0x03) << 16) | \
+                                            ((uint32_t)raw[3*(ch) + 1] << 8) | \
+                                            raw[3*(ch) + 2]) >> (shift); \
+        }
+
+    /**
+    *   \brief Number of channels of the configured mode.
+    */
+    #if (MAX30101_FIXED_MODE == MAX30101_HR_MODE)
+        #define MAX30101_FIXED_LEDS 1
+        #define MAX30101_FIXED_MULTI_LED_1 MAX30101_CONF_SLOTS(MAX30101_SLOT_NONE, MAX30101_SLOT_NONE)
+        #define MAX30101_FIXED_MULTI_LED_2 MAX30101_CONF_SLOTS(MAX30101_SLOT_NONE, MAX30101_SLOT_NONE)
+    #elif (MAX30101_FIXED_MODE == MAX30101_SPO2_MODE)
+        #define MAX30101_FIXED_LEDS 2
+        #define MAX30101_FIXED_MULTI_LED_1 MAX30101_CONF_SLOTS(MAX30101_SLOT_NONE, MAX30101_SLOT_NONE)
+        #define MAX30101_FIXED_MULTI_LED_2 MAX30101_CONF_SLOTS(MAX30101_SLOT_NONE, MAX30101_SLOT_NONE)
+    #elif (MAX30101_FIXED_MODE == MAX30101_MULTI_MODE)
+        #if (MAX30101_FIXED_SLOT_1 == MAX30101_SLOT_NONE)
+            #error "Multi-LED mode needs at least one slot"
+        #elif (MAX30101_FIXED_SLOT_2 == MAX30101_SLOT_NONE)
+            #define MAX30101_FIXED_LEDS 1
+        #elif (MAX30101_FIXED_SLOT_3 == MAX30101_SLOT_NONE)
+            #define MAX30101_FIXED_LEDS 2
+        #elif (MAX30101_FIXED_SLOT_4 == MAX30101_SLOT_NONE)
+            #define MAX30101_FIXED_LEDS 3
+        #else
+            #define MAX30101_FIXED_LEDS 4
+        #endif
+        #define MAX30101_FIXED_MULTI_LED_1 MAX30101_CONF_SLOTS(MAX30101_FIXED_SLOT_1, MAX30101_FIXED_SLOT_2)
+        #define MAX30101_FIXED_MULTI_LED_2 MAX30101_CONF_SLOTS(MAX30101_FIXED_SLOT_3, MAX30101_FIXED_SLOT_4)
+    #else
+        #error "MAX30101_FIXED_MODE must be MAX30101_HR_MODE, MAX30101_SPO2_MODE or MAX30101_MULTI_MODE"
+    #endif
+
+    #if !MAX30101_RATE_IS_VALID(MAX30101_FIXED_LEDS, MAX30101_FIXED_SAMPLE_RATE, MAX30101_FIXED_PULSEWIDTH)
+        #error "MAX30101_FIXED_SAMPLE_RATE is not achievable with MAX30101_FIXED_PULSEWIDTH and these slots (see MAX30101_Rate.h)"
+    #endif
+
+    /**
+    *   \brief Right shift of the samples given by the pulse width.
+    */
+    #define MAX30101_FIXED_SHIFT (3 - (MAX30101_FIXED_PULSEWIDTH))
+
+    /**
+    *   \brief Index of the RED channel in HR and SpO2 modes.
+    */
+    #define MAX30101_FIXED_RED 0
+
+    /**
+    *   \brief Index of the IR channel in SpO2 mode.
+    */
+    #define MAX30101_FIXED_IR 1
+
+    /**
+    *   \brief Value of #MAX30101_MODE_CONF for the configured mode.
+    */
+    #define MAX30101_FIXED_MODE_CONF (MAX30101_FIXED_MODE)
+
+    /**
+    *   \brief Value of #MAX30101_SPO2_CONF for the configured settings.
+    */
+    #define MAX30101_FIXED_SPO2_CONF ((MAX30101_FIXED_ADC_RANGE) | (MAX30101_FIXED_SAMPLE_RATE) | (MAX30101_FIXED_PULSEWIDTH))
+
+    /**
+    *   \brief Averaging bits of #MAX30101_FIFO_CONF, to be combined with the FIFO settings.
+    */
+    #define MAX30101_FIXED_FIFO_CONF (MAX30101_FIXED_SAMPLE_AVG)
+
+    /**
+    *   \brief Reader for the settings in MAX30101_FixedConfig.h.
+    */
+    MAX30101_FIXED_DECLARE(MAX30101_Fixed, MAX30101_FIXED_LEDS);
+
+    /**
+    *   \brief Check that the device runs with the compiled settings.
+    *
+    *   Reads back mode, SpO2 and slot configuration, which must not change
+    *   while #MAX30101_Fixed_ReadFIFO is used. The ADC range is not checked:
+    *   it does not change the FIFO format.
+    *   \retval #MAX30101_OK if the configuration matches.
+    *   \retval #MAX30101_DEV_NOT_FOUND if device is not present on the I2C bus.
+    *   \retval #MAX30101_ERROR if the device has a different configuration.
+    */
+    uint8_t MAX30101_Fixed_Check(void);
+
+#endif
+/* [] END OF FILE */
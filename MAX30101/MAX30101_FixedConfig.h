@@ -0,0 +1,71 @@
+/**
+*   \file MAX30101_FixedConfig.h
+*
+*   \brief Compile-time acquisition settings of the MAX30101.
+*
+*   Edit this file (or define the macros on the compiler command line)
+*   to set the acquisition mode built by MAX30101_Fixed.h. The settings
+*   are not read back from the device: the firmware must write them with
+*   the values of MAX30101_Fixed.h (e.g., with #MAX30101_FIXED_MODE_CONF
+*   and #MAX30101_FIXED_SPO2_CONF in a #MAX30101_Config).
+*/
+
+#ifndef __MAX30101_FIXEDCONFIG_H__
+    #define __MAX30101_FIXEDCONFIG_H__
+
+    /**
+    *   \brief Acquisition mode (#MAX30101_HR_MODE, #MAX30101_SPO2_MODE or #MAX30101_MULTI_MODE).
+    */
+    #ifndef MAX30101_FIXED_MODE
+        #define MAX30101_FIXED_MODE MAX30101_SPO2_MODE
+    #endif
+
+    /**
+    *   \brief LED of each time slot in Multi-LED mode.
+    *
+    *   Slots are used up to the first #MAX30101_SLOT_NONE. Ignored in
+    *   HR mode (RED only) and SpO2 mode (RED and IR).
+    */
+    #ifndef MAX30101_FIXED_SLOT_1
+        #define MAX30101_FIXED_SLOT_1 MAX30101_SLOT_RED
+    #endif
+    #ifndef MAX30101_FIXED_SLOT_2
+        #define MAX30101_FIXED_SLOT_2 MAX30101_SLOT_IR
+    #endif
+    #ifndef MAX30101_FIXED_SLOT_3
+        #define MAX30101_FIXED_SLOT_3 MAX30101_SLOT_GREEN
+    #endif
+    #ifndef MAX30101_FIXED_SLOT_4
+        #define MAX30101_FIXED_SLOT_4 MAX30101_SLOT_NONE
+    #endif
+
+    /**
+    *   \brief LED pulse width (#MAX30101_PULSEWIDTH_69 to #MAX30101_PULSEWIDTH_411).
+    */
+    #ifndef MAX30101_FIXED_PULSEWIDTH
+        #define MAX30101_FIXED_PULSEWIDTH MAX30101_PULSEWIDTH_69
+    #endif
+
+    /**
+    *   \brief Sample rate (#MAX30101_SAMPLE_RATE_50 to #MAX30101_SAMPLE_RATE_3200).
+    */
+    #ifndef MAX30101_FIXED_SAMPLE_RATE
+        #define MAX30101_FIXED_SAMPLE_RATE MAX30101_SAMPLE_RATE_400
+    #endif
+
+    /**
+    *   \brief Number of averaged samples (#MAX30101_SAMPLE_AVG_1 to #MAX30101_SAMPLE_AVG_32).
+    */
+    #ifndef MAX30101_FIXED_SAMPLE_AVG
+        #define MAX30101_FIXED_SAMPLE_AVG MAX30101_SAMPLE_AVG_2
+    #endif
+
+    /**
+    *   \brief ADC full scale range (#MAX30101_ADC_RANGE_2048 to #MAX30101_ADC_RANGE_16384).
+    */
+    #ifndef MAX30101_FIXED_ADC_RANGE
+        #define MAX30101_FIXED_ADC_RANGE MAX30101_ADC_RANGE_4096
+    #endif
+
+#endif
+/* [] END OF FILE */
@@ -0,0 +1,204 @@
+/**
+*   Source file for text output without sprintf.
+*/
+
+#include "MAX30101_Format.h"
+
+#if (MAX30101_LINE_SIZE < 4) || (MAX30101_LINE_SIZE > 255)
+    #error "MAX30101_LINE_SIZE must be from 4 to 255"
+#endif
+
+//==============================================
+//          MACROS
+//==============================================
+
+/**
+*   \brief Characters available for text: line end and terminator are always kept.
+*/
+#define FORMAT_ROOM (MAX30101_LINE_SIZE - 3)
+
+//==============================================
+//          VARIABLES
+//==============================================
+
+// Decimal digits of 0 to 99, two characters each
+static const char format_pairs[200] =
+    "0001020304050607080910111213141516171819"
+    "2021222324252627282930313233343536373839"
+    "4041424344454647484950515253545556575859"
+    "6061626364656667686970717273747576777879"
+    "8081828384858687888990919293949596979899";
+
+static const uint32_t format_powers[MAX30101_FORMAT_DEC_DIGITS] = {
+    1u, 10u, 100u, 1000u, 10000u, 100000u, 1000000u, 10000000u, 100000000u, 1000000000u
+};
+
+static const char format_hex[16] = "0123456789ABCDEF";
+
+//==============================================
+//          FUNCTION PROTOTYPES
+//==============================================
+
+static void MAX30101_Format_Append(MAX30101_Line* line, const char* text, uint8_t length);
+
+// Unsigned decimal
+uint8_t MAX30101_Format_WriteDec(char* out, uint32_t value)
+{
+    // Count the digits, then write from the last one, two at a time
+    uint8_t length = 1;
+    while ((length < MAX30101_FORMAT_DEC_DIGITS) && (value >= format_powers[length]))
+    {
+        length++;
+    }
+    char* p = out + length;
+    while (value >= 100)
+    {
+        uint32_t pair = (value % 100) * 2;
+        value /= 100;
+        *--p = format_pairs[pair + 1];
+        *--p = format_pairs[pair];
+    }
+    if (value >= 10)
+    {
+        *--p = format_pairs[value * 2 + 1];
+        *--p = format_pairs[value * 2];
+    }
+    else
+    {
+        *--p = (char)('0' + value);
+    }
+    return length;
+}
+
+// Unsigned hexadecimal with leading zeros
+uint8_t MAX30101_Format_WriteHex(char* out, uint32_t value, uint8_t digits)
+{
+    for (uint8_t i = digits; i > 0; i--)
+    {
+        out[i - 1] = format_hex[value & 0x0F];
+        value >>= 4;
+    }
+    return digits;
+}
+
+// Empty a line
+void MAX30101_Format_Clear(MAX30101_Line* line)
+{
+    line->length = 0;
+    line->truncated = 0;
+}
+
+// Append a character
+void MAX30101_Format_Char(MAX30101_Line* line, char c)
+{
+    if (line->length < FORMAT_ROOM)
+    {
+        line->text[line->length++] = c;
+    }
+    else
+    {
+        line->truncated = 1;
+    }
+}
+
+// Append a string
+void MAX30101_Format_String(MAX30101_Line* line, const char* string)
+{
+    while (*string != '\0')
+    {
+        if (line->length == FORMAT_ROOM)
+        {
+            line->truncated = 1;
+            return;
+        }
+        line->text[line->length++] = *string++;
+    }
+}
+
+// Append a decimal number
+void MAX30101_Format_Dec(MAX30101_Line* line, uint32_t value)
+{
+    if (line->length + MAX30101_FORMAT_DEC_DIGITS <= FORMAT_ROOM)
+    {
+        line->length += MAX30101_Format_WriteDec(&line->text[line->length], value);
+    }
+    else
+    {
+        char digits[MAX30101_FORMAT_DEC_DIGITS];
+        MAX30101_Format_Append(line, digits, MAX30101_Format_WriteDec(digits, value));
+    }
+}
+
+// Append a hexadecimal number
+void MAX30101_Format_Hex(MAX30101_Line* line, uint32_t value, uint8_t digits)
+{
+    char hex[8];
+    if (digits > sizeof(hex))
+    {
+        digits = sizeof(hex);
+    }
+    MAX30101_Format_Append(line, hex, MAX30101_Format_WriteHex(hex, value, digits));
+}
+
+// Append a fixed point number
+void MAX30101_Format_Fixed(MAX30101_Line* line, uint32_t value, uint8_t decimals)
+{
+    if (decimals >= MAX30101_FORMAT_DEC_DIGITS)
+    {
+        decimals = MAX30101_FORMAT_DEC_DIGITS - 1;
+    }
+    uint32_t scale = format_powers[decimals];
+    MAX30101_Format_Dec(line, value / scale);
+    if (decimals > 0)
+    {
+        // Fraction with its leading zeros
+        char digits[MAX30101_FORMAT_DEC_DIGITS];
+        uint8_t length = MAX30101_Format_WriteDec(digits, value % scale);
+        MAX30101_Format_Char(line, '.');
+        for (uint8_t i = length; i < decimals; i++)
+        {
+            MAX30101_Format_Char(line, '0');
+        }
+        MAX30101_Format_Append(line, digits, length);
+    }
+}
+
+// Terminate a line
+const char* MAX30101_Format_End(MAX30101_Line* line)
+{
+    line->text[line->length++] = '\r';
+    line->text[line->length++] = '\n';
+    line->text[line->length] = '\0';
+    return line->text;
+}
+
+// CSV row of a time stamp and channels
+uint8_t MAX30101_Format_CsvRow(MAX30101_Line* line, uint32_t timestamp, const uint32_t* channels,
+                               uint8_t num_channels)
+{
+    MAX30101_Format_Clear(line);
+    MAX30101_Format_Dec(line, timestamp);
+    for (uint8_t c = 0; c < num_channels; c++)
+    {
+        MAX30101_Format_Char(line, ',');
+        MAX30101_Format_Dec(line, channels[c]);
+    }
+    MAX30101_Format_End(line);
+    return line->length;
+}
+
+// Append characters, as many as fit
+static void MAX30101_Format_Append(MAX30101_Line* line, const char* text, uint8_t length)
+{
+    if (line->length + length > FORMAT_ROOM)
+    {
+        length = FORMAT_ROOM - line->length;
+        line->truncated = 1;
+    }
+    for (uint8_t i = 0; i < length; i++)
+    {
+        line->text[line->length++] = text[i];
+    }
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,144 @@
+/**
+*   \file MAX30101_Format.h
+*
+*   \brief Text output without sprintf.
+*
+*   Numbers are written with dedicated unsigned decimal and hexadecimal
+*   routines in a reusable line buffer, which is then sent as a string
+*   (e.g., with UART_Debug_PutString). Decimal conversion writes two
+*   digits per division, from a table. This avoids the CPU time and the
+*   code size of the printf family for periodic output, e.g., CSV rows
+*   of samples:
+*   \code
+*   MAX30101_Format_CsvRow(&line, time_ms, frame, MAX30101_FIXED_LEDS);
+*   UART_Debug_PutString(line.text);
+*   \endcode
+*   or text lines:
+*   \code
+*   MAX30101_Format_Clear(&line);
+*   MAX30101_Format_String(&line, "HR: ");
+*   MAX30101_Format_Fixed(&line, bpm_x10, 1);
+*   UART_Debug_PutString(MAX30101_Format_End(&line));
+*   \endcode
+*   A line that does not fit is truncated and flagged; it is always
+*   terminated.
+*/
+
+#ifndef __MAX30101_FORMAT_H__
+    #define __MAX30101_FORMAT_H__
+
+    #include "cytypes.h"
+
+    /**
+    *   \brief Size of a line buffer, including line end and terminator (up to 255).
+    */
+    #ifndef MAX30101_LINE_SIZE
+        #define MAX30101_LINE_SIZE 64
+    #endif
+
+    /**
+    *   \brief Longest decimal number (32 bits).
+    */
+    #define MAX30101_FORMAT_DEC_DIGITS 10
+
+    /**
+    *   \brief A line buffer.
+    */
+    typedef struct
+    {
+        char text[MAX30101_LINE_SIZE];  ///< Text, terminated by #MAX30101_Format_End.
+        uint8_t length;                 ///< Characters written.
+        uint8_t truncated;              ///< 1 if some text did not fit.
+    } MAX30101_Line;
+
+    /**
+    *   \brief Write an unsigned number in decimal, without terminator.
+    *
+    *   \param[out] out room for #MAX30101_FORMAT_DEC_DIGITS characters.
+    *   \param[in] value number.
+    *   \return number of characters written.
+    */
+    uint8_t MAX30101_Format_WriteDec(char* out, uint32_t value);
+
+    /**
+    *   \brief Write an unsigned number in hexadecimal (upper case), without terminator.
+    *
+    *   \param[out] out room for digits characters.
+    *   \param[in] value number.
+    *   \param[in] digits number of digits (1 to 8), with leading zeros.
+    *   \return number of characters written.
+    */
+    uint8_t MAX30101_Format_WriteHex(char* out, uint32_t value, uint8_t digits);
+
+    /**
+    *   \brief Empty a line.
+    *
+    *   \param[out] line line buffer.
+    */
+    void MAX30101_Format_Clear(MAX30101_Line* line);
+
+    /**
+    *   \brief Append a character.
+    *
+    *   \param[in,out] line line buffer.
+    *   \param[in] c character.
+    */
+    void MAX30101_Format_Char(MAX30101_Line* line, char c);
+
+    /**
+    *   \brief Append a string.
+    *
+    *   \param[in,out] line line buffer.
+    *   \param[in] string string.
+    */
+    void MAX30101_Format_String(MAX30101_Line* line, const char* string);
+
+    /**
+    *   \brief Append an unsigned number in decimal.
+    *
+    *   \param[in,out] line line buffer.
+    *   \param[in] value number.
+    */
+    void MAX30101_Format_Dec(MAX30101_Line* line, uint32_t value);
+
+    /**
+    *   \brief Append an unsigned number in hexadecimal, as printf "%0<digits>X".
+    *
+    *   \param[in,out] line line buffer.
+    *   \param[in] value number.
+    *   \param[in] digits number of digits (1 to 8).
+    */
+    void MAX30101_Format_Hex(MAX30101_Line* line, uint32_t value, uint8_t digits);
+
+    /**
+    *   \brief Append a fixed point number, e.g., 725 with 1 decimal as 72.5.
+    *
+    *   \param[in,out] line line buffer.
+    *   \param[in] value number times 10^decimals.
+    *   \param[in] decimals number of decimals (0 to 9).
+    */
+    void MAX30101_Format_Fixed(MAX30101_Line* line, uint32_t value, uint8_t decimals);
+
+    /**
+    *   \brief Append the line end ("\r\n") and terminate the line.
+    *
+    *   Call once per line, then clear the line before the next one.
+    *   \param[in,out] line line buffer.
+    *   \return the text of the line.
+    */
+    const char* MAX30101_Format_End(MAX30101_Line* line);
+
+    /**
+    *   \brief Write a CSV row: time stamp and channels, e.g., "1250,81234,90321,4410\r\n".
+    *
+    *   \param[out] line line buffer, cleared and terminated.
+    *   \param[in] timestamp first field.
+    *   \param[in] channels values of the other fields.
+    *   \param[in] num_channels number of channels.
+    *   \return length of the row.
+    */
+    uint8_t MAX30101_Format_CsvRow(MAX30101_Line* line, uint32_t timestamp, const uint32_t* channels,
+                                   uint8_t num_channels);
+
+#endif
+/* [] END OF FILE */
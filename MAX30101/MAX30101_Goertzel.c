@@ -0,0 +1,230 @@
+/**
+*   Source file for the Goertzel filter bank.
+*/
+
+#include "MAX30101_Goertzel.h"
+#include "MAX30101.h"
+#include "MAX30101_Stats.h"
+#include "string.h"
+
+//==============================================
+//          MACROS
+//==============================================
+
+/**
+*   \brief Largest high-passed sample.
+*/
+#define GOERTZEL_CLAMP ((1 << 17) - 1)
+
+/**
+*   \brief Fractional bits of the coefficients.
+*/
+#define GOERTZEL_COEF_BITS 14
+
+/**
+*   \brief 2 pi, Q30.
+*/
+#define GOERTZEL_2PI_Q30 6746518852LL
+
+//==============================================
+//          VARIABLES
+//==============================================
+
+// Hann window of a block, Q15
+static const uint16_t goertzel_hann[MAX30101_GOERTZEL_BLOCK] = {
+        0,    20,    79,   177,   315,   491,   705,   958,  1247,  1573,  1935,  2331,  2761,  3224,  3719,  4244,
+     4799,  5381,  5990,  6624,  7281,  7961,  8660,  9379, 10114, 10864, 11628, 12403, 13187, 13980, 14778, 15580,
+    16383, 17187, 17989, 18787, 19580, 20364, 21139, 21903, 22653, 23388, 24107, 24806, 25486, 26143, 26777, 27386,
+    27968, 28523, 29048, 29543, 30006, 30436, 30832, 31194, 31520, 31809, 32062, 32276, 32452, 32590, 32688, 32747,
+    32767, 32747, 32688, 32590, 32452, 32276, 32062, 31809, 31520, 31194, 30832, 30436, 30006, 29543, 29048, 28523,
+    27968, 27386, 26777, 26143, 25486, 24806, 24107, 23388, 22653, 21903, 21139, 20364, 19580, 18787, 17989, 17187,
+    16384, 15580, 14778, 13980, 13187, 12403, 11628, 10864, 10114,  9379,  8660,  7961,  7281,  6624,  5990,  5381,
+     4799,  4244,  3719,  3224,  2761,  2331,  1935,  1573,  1247,   958,   705,   491,   315,   177,    79,    20,
+};
+
+//==============================================
+//          FUNCTION PROTOTYPES
+//==============================================
+
+static void MAX30101_Goertzel_SetBins(MAX30101_Goertzel* bank);
+
+static void MAX30101_Goertzel_Estimate(MAX30101_Goertzel* bank);
+
+// Initialize filter bank
+uint8_t MAX30101_Goertzel_Init(MAX30101_Goertzel* bank, uint16_t sample_rate, uint8_t decimation, uint8_t mode)
+{
+    if ((sample_rate == 0) || (decimation == 0))
+    {
+        return MAX30101_ERROR;
+    }
+    memset(bank, 0, sizeof(*bank));
+    bank->decimation = decimation;
+    bank->mode = mode;
+    bank->rate_mhz = (uint32_t)sample_rate * 1000u / decimation;
+    // The band must be below the Nyquist rate
+    if ((uint64_t)MAX30101_GOERTZEL_MAX_BPM * 1000u * 2 >= (uint64_t)bank->rate_mhz * 60)
+    {
+        return MAX30101_ERROR;
+    }
+
+    // cos(k d), d angle of 1 bpm, with the recurrence cos((k+1) d) = 2 cos(d) cos(k d) - cos((k-1) d), Q30
+    int64_t delta = GOERTZEL_2PI_Q30 * 1000 / (60 * (int64_t)bank->rate_mhz);
+    int64_t delta2 = (delta * delta) >> 30;
+    int64_t cos_delta = (1LL << 30) - delta2 / 2 + ((delta2 * delta2) >> 30) / 24;
+    int64_t previous = cos_delta;
+    int64_t current = 1LL << 30;
+    for (uint16_t k = 0; k <= MAX30101_GOERTZEL_MAX_BPM; k++)
+    {
+        if (k >= MAX30101_GOERTZEL_MIN_BPM)
+        {
+            // 2 cos, Q30 to Q14
+            bank->coef[k - MAX30101_GOERTZEL_MIN_BPM] = (int16_t)((2 * current + (1 << 15)) >> 16);
+        }
+        int64_t next = ((2 * cos_delta * current) >> 30) - previous;
+        previous = current;
+        current = next;
+    }
+
+    MAX30101_Goertzel_SetBins(bank);
+    return MAX30101_OK;
+}
+
+// Add a sample
+uint8_t MAX30101_Goertzel_Add(MAX30101_Goertzel* bank, uint32_t sample)
+{
+    bank->sum += sample;
+    if (++bank->count < bank->decimation)
+    {
+        return 0;
+    }
+    int32_t x = bank->sum / bank->decimation;
+    bank->sum = 0;
+    bank->count = 0;
+
+    // High-pass: subtract the baseline, started at the first sample
+    if (!bank->started)
+    {
+        bank->dc = x << 8;
+        bank->started = 1;
+    }
+    bank->dc += ((x << 8) - bank->dc) >> 4;
+    int32_t ac = x - (bank->dc >> 8);
+    if (ac > GOERTZEL_CLAMP)
+    {
+        ac = GOERTZEL_CLAMP;
+    }
+    else if (ac < -GOERTZEL_CLAMP)
+    {
+        ac = -GOERTZEL_CLAMP;
+    }
+    int32_t windowed = (int32_t)(((int64_t)ac * goertzel_hann[bank->n]) >> 15);
+
+    // s[n] = x[n] + 2 cos(w) s[n-1] - s[n-2]
+    for (uint8_t b = 0; b < bank->num_bins; b++)
+    {
+        int32_t coef = bank->coef[bank->bpm[b] - MAX30101_GOERTZEL_MIN_BPM];
+        int32_t s0 = windowed + (int32_t)(((int64_t)coef * bank->s1[b]) >> GOERTZEL_COEF_BITS) - bank->s2[b];
+        bank->s2[b] = bank->s1[b];
+        bank->s1[b] = s0;
+    }
+
+    if (++bank->n < MAX30101_GOERTZEL_BLOCK)
+    {
+        return 0;
+    }
+    bank->n = 0;
+    MAX30101_Goertzel_Estimate(bank);
+    MAX30101_Goertzel_SetBins(bank);
+    return 1;
+}
+
+// Add the last samples of a ring
+uint8_t MAX30101_Goertzel_AddRing(MAX30101_Goertzel* bank, const uint32_t* ring, uint8_t head, uint8_t num_samples)
+{
+    uint8_t updated = 0;
+    for (uint8_t i = num_samples; i > 0; i--)
+    {
+        updated |= MAX30101_Goertzel_Add(bank, ring[(head + 1 - i) & (BUFFER_STORAGE_SIZE - 1)]);
+    }
+    return updated;
+}
+
+// Choose the bins of the next block
+static void MAX30101_Goertzel_SetBins(MAX30101_Goertzel* bank)
+{
+    uint16_t first, last;
+    if ((bank->mode == MAX30101_GOERTZEL_TRACK) && bank->valid && (bank->fine_blocks < MAX30101_GOERTZEL_RESCAN))
+    {
+        // Fine bins around the estimate
+        uint16_t center = (bank->bpm_x10 + 5) / 10;
+        first = (center > MAX30101_GOERTZEL_MIN_BPM + MAX30101_GOERTZEL_FINE_SPAN) ?
+                center - MAX30101_GOERTZEL_FINE_SPAN : MAX30101_GOERTZEL_MIN_BPM;
+        last = first + 2 * MAX30101_GOERTZEL_FINE_SPAN;
+        if (last > MAX30101_GOERTZEL_MAX_BPM)
+        {
+            last = MAX30101_GOERTZEL_MAX_BPM;
+            first = last - 2 * MAX30101_GOERTZEL_FINE_SPAN;
+        }
+        bank->step = 1;
+        bank->fine_blocks++;
+    }
+    else
+    {
+        first = MAX30101_GOERTZEL_MIN_BPM;
+        last = MAX30101_GOERTZEL_MAX_BPM;
+        bank->step = MAX30101_GOERTZEL_COARSE_STEP;
+        bank->fine_blocks = 0;
+    }
+
+    bank->num_bins = 0;
+    for (uint16_t bpm = first; (bpm <= last) && (bank->num_bins < MAX30101_GOERTZEL_MAX_BINS); bpm += bank->step)
+    {
+        bank->bpm[bank->num_bins] = bpm;
+        bank->s1[bank->num_bins] = 0;
+        bank->s2[bank->num_bins] = 0;
+        bank->num_bins++;
+    }
+}
+
+// Peak of the block, parabolic interpolation of the magnitudes
+static void MAX30101_Goertzel_Estimate(MAX30101_Goertzel* bank)
+{
+    uint64_t power[MAX30101_GOERTZEL_MAX_BINS];
+    uint8_t peak = 0;
+    for (uint8_t b = 0; b < bank->num_bins; b++)
+    {
+        // |X|^2 = s1^2 + s2^2 - 2 cos(w) s1 s2
+        int64_t s1 = bank->s1[b];
+        int64_t s2 = bank->s2[b];
+        int64_t coef = bank->coef[bank->bpm[b] - MAX30101_GOERTZEL_MIN_BPM];
+        int64_t value = s1 * s1 + s2 * s2 - ((coef * s1) >> GOERTZEL_COEF_BITS) * s2;
+        power[b] = (value > 0) ? (uint64_t)value : 0;
+        if (power[b] > power[peak])
+        {
+            peak = b;
+        }
+    }
+
+    int32_t delta = 0;
+    if ((peak > 0) && (peak < bank->num_bins - 1))
+    {
+        int64_t a = MAX30101_Sqrt64(power[peak-1]);
+        int64_t b = MAX30101_Sqrt64(power[peak]);
+        int64_t c = MAX30101_Sqrt64(power[peak+1]);
+        int64_t denominator = a - 2 * b + c;
+        if (denominator < 0)
+        {
+            // 0.5 (a - c) / (a - 2b + c), in tenths of a bin
+            delta = (int32_t)(5 * (a - c) / denominator);
+        }
+    }
+    else if (bank->step == 1)
+    {
+        // Peak at the edge of the fine bins: search again
+        bank->fine_blocks = MAX30101_GOERTZEL_RESCAN;
+    }
+    bank->bpm_x10 = bank->bpm[peak] * 10 + delta * bank->step;
+    bank->valid = 1;
+}
+
+/* [] END OF FILE */
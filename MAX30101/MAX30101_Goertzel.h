@@ -0,0 +1,145 @@
+/**
+*   \file MAX30101_Goertzel.h
+*
+*   \brief Heart rate from a bank of Goertzel filters over the heart rate band.
+*
+*   Samples of a PPG channel (e.g., the IR ring of #MAX30101_Data) are
+*   decimated (block average), high-passed to remove the baseline and
+*   Hann windowed in blocks of #MAX30101_GOERTZEL_BLOCK samples. Each
+*   active bin is a Goertzel filter at an integer rate in bpm, updated
+*   sample by sample: the cost is one 32x32 multiply per bin and sample,
+*   and no window of samples is stored.
+*
+*   At the end of a block the power of each bin is computed, the peak is
+*   located with parabolic interpolation of the magnitudes and the bins
+*   of the next block are chosen:
+*   - coarse search: one bin every #MAX30101_GOERTZEL_COARSE_STEP bpm over
+*     the whole band (21 bins from 40 to 200 bpm);
+*   - fine search: one bin per bpm within #MAX30101_GOERTZEL_FINE_SPAN bpm
+*     of the last estimate (9 bins).
+*   In #MAX30101_GOERTZEL_TRACK mode a coarse block is followed by fine
+*   blocks, back to a coarse block when the fine peak is at the edge of
+*   the fine bins or every #MAX30101_GOERTZEL_RESCAN fine blocks. In
+*   #MAX30101_GOERTZEL_COARSE mode every block is coarse.
+*
+*   With a 200 Hz input decimated by 8: blocks of 5.12 s at 25 Hz.
+*
+*   Memory: sizeof(MAX30101_Goertzel) is 564 bytes (coefficient per bpm,
+*   filter states), plus a 256 bytes Hann table in flash.
+*
+*   Cost on Cortex-M3 (estimated by instruction count: SMULL, 2 cycles
+*   per load, 0 wait states): about 15 cycles per bin and about 25 per
+*   decimated sample, i.e. about 340 cycles per decimated sample for a
+*   coarse block and 160 for a fine block (7 us at 24 MHz).
+*/
+
+#ifndef __MAX30101_GOERTZEL_H__
+    #define __MAX30101_GOERTZEL_H__
+
+    #include "cytypes.h"
+
+    /**
+    *   \brief Heart rate band, in bpm.
+    */
+    #define MAX30101_GOERTZEL_MIN_BPM 40
+    #define MAX30101_GOERTZEL_MAX_BPM 200
+
+    /**
+    *   \brief Decimated samples per block (size of the Hann table).
+    */
+    #define MAX30101_GOERTZEL_BLOCK 128
+
+    /**
+    *   \brief Maximum number of active bins.
+    */
+    #define MAX30101_GOERTZEL_MAX_BINS 24
+
+    /**
+    *   \brief Spacing of the coarse bins, in bpm.
+    */
+    #ifndef MAX30101_GOERTZEL_COARSE_STEP
+        #define MAX30101_GOERTZEL_COARSE_STEP 8
+    #endif
+
+    /**
+    *   \brief Fine bins on each side of the last estimate, in bpm.
+    */
+    #ifndef MAX30101_GOERTZEL_FINE_SPAN
+        #define MAX30101_GOERTZEL_FINE_SPAN 4
+    #endif
+
+    /**
+    *   \brief Fine blocks between two coarse blocks.
+    */
+    #ifndef MAX30101_GOERTZEL_RESCAN
+        #define MAX30101_GOERTZEL_RESCAN 8
+    #endif
+
+    /**
+    *   \brief Every block is a coarse search.
+    */
+    #define MAX30101_GOERTZEL_COARSE 0
+
+    /**
+    *   \brief Coarse search, then fine search around the estimate.
+    */
+    #define MAX30101_GOERTZEL_TRACK 1
+
+    /**
+    *   \brief State of the filter bank.
+    */
+    typedef struct
+    {
+        int16_t coef[MAX30101_GOERTZEL_MAX_BPM - MAX30101_GOERTZEL_MIN_BPM + 1]; ///< 2 cos(w), Q14, for each bpm.
+        int32_t s1[MAX30101_GOERTZEL_MAX_BINS];   ///< Last output of each filter.
+        int32_t s2[MAX30101_GOERTZEL_MAX_BINS];   ///< Output before the last one.
+        uint8_t bpm[MAX30101_GOERTZEL_MAX_BINS];  ///< Rate of each active bin.
+        uint32_t rate_mhz;      ///< Decimated sample rate, in mHz.
+        uint32_t sum;           ///< Sum of the samples of the current decimation block.
+        int32_t dc;             ///< Baseline, Q8.
+        uint16_t n;             ///< Position in the block.
+        uint16_t bpm_x10;       ///< Last estimate, in tenths of bpm.
+        uint8_t decimation;     ///< Input samples per decimated sample.
+        uint8_t count;          ///< Samples in the current decimation block.
+        uint8_t num_bins;       ///< Number of active bins.
+        uint8_t step;           ///< Spacing of the active bins, in bpm.
+        uint8_t mode;           ///< #MAX30101_GOERTZEL_COARSE or #MAX30101_GOERTZEL_TRACK.
+        uint8_t fine_blocks;    ///< Fine blocks since the last coarse block.
+        uint8_t started;        ///< 1 after the first decimated sample.
+        uint8_t valid;          ///< 1 once an estimate is available.
+    } MAX30101_Goertzel;
+
+    /**
+    *   \brief Initialize the filter bank, starting with a coarse block.
+    *
+    *   \param[out] bank filter bank.
+    *   \param[in] sample_rate input sample rate, in Hz.
+    *   \param[in] decimation input samples per decimated sample.
+    *   \param[in] mode #MAX30101_GOERTZEL_COARSE or #MAX30101_GOERTZEL_TRACK.
+    *   \retval #MAX30101_OK if the band is below the decimated Nyquist rate.
+    *   \retval #MAX30101_ERROR otherwise.
+    */
+    uint8_t MAX30101_Goertzel_Init(MAX30101_Goertzel* bank, uint16_t sample_rate, uint8_t decimation, uint8_t mode);
+
+    /**
+    *   \brief Add a sample.
+    *
+    *   \param[in,out] bank filter bank.
+    *   \param[in] sample input sample (18 bits).
+    *   \return 1 at the end of a block, with a new estimate in bank->bpm_x10, 0 otherwise.
+    */
+    uint8_t MAX30101_Goertzel_Add(MAX30101_Goertzel* bank, uint32_t sample);
+
+    /**
+    *   \brief Add the last samples of a channel of #MAX30101_Data (e.g., data.IR).
+    *
+    *   \param[in,out] bank filter bank.
+    *   \param[in] ring samples of the channel, #BUFFER_STORAGE_SIZE long.
+    *   \param[in] head index of the last sample.
+    *   \param[in] num_samples number of samples, up to #BUFFER_STORAGE_SIZE.
+    *   \return 1 if at least a new estimate is available, 0 otherwise.
+    */
+    uint8_t MAX30101_Goertzel_AddRing(MAX30101_Goertzel* bank, const uint32_t* ring, uint8_t head, uint8_t num_samples);
+
+#endif
+/* [] END OF FILE */
@@ -0,0 +1,235 @@
+/**
+*   Source file for the pipeline of processing stages.
+*/
+
+#include "MAX30101_Pipeline.h"
+#include "CyLib.h"
+#include "string.h"
+
+#if ((MAX30101_PIPE_QUEUE_SIZE & (MAX30101_PIPE_QUEUE_SIZE - 1)) != 0) || (MAX30101_PIPE_QUEUE_SIZE > 128)
+    #error "MAX30101_PIPE_QUEUE_SIZE must be a power of 2, up to 128"
+#endif
+
+//==============================================
+//          MACROS
+//==============================================
+
+/**
+*   \brief Encoding and channels of a format.
+*/
+#define PIPE_ENCODING(format) ((format) & 0xF0)
+#define PIPE_CHANNELS(format) ((format) & 0x0F)
+
+//==============================================
+//          FUNCTION PROTOTYPES
+//==============================================
+
+static uint8_t MAX30101_Pipeline_Enqueue(MAX30101_Pipeline* pipe, uint8_t stage, MAX30101_Block* block);
+
+static uint8_t MAX30101_Pipeline_Step(MAX30101_Pipeline* pipe, uint8_t stage);
+
+static uint8_t MAX30101_Pipeline_IsComplete(const MAX30101_Pipeline* pipe);
+
+// Initialize an empty pipeline
+void MAX30101_Pipeline_Init(MAX30101_Pipeline* pipe, uint32_t (*get_time)(void))
+{
+    memset(pipe, 0, sizeof(MAX30101_Pipeline));
+    pipe->get_time = get_time;
+}
+
+// Add a stage at the end
+uint8_t MAX30101_Pipeline_Add(MAX30101_Pipeline* pipe, const MAX30101_PipeStage* stage)
+{
+    if ((pipe->num_stages == MAX30101_PIPE_MAX_STAGES) || (stage->process == NULL) ||
+        (stage->in_format == MAX30101_PIPE_NONE) || (PIPE_CHANNELS(stage->in_format) > MAX30101_MAX_SLOTS) ||
+        (stage->in_place && (PIPE_ENCODING(stage->in_format) != PIPE_ENCODING(stage->out_format))))
+    {
+        return MAX30101_ERROR;
+    }
+    if (pipe->num_stages > 0)
+    {
+        // Connected to the output of the last stage, which must not be a sink
+        uint8_t out_format = pipe->stages[pipe->num_stages - 1]->out_format;
+        if ((out_format == MAX30101_PIPE_NONE) || (out_format != stage->in_format))
+        {
+            return MAX30101_ERROR;
+        }
+    }
+    pipe->stages[pipe->num_stages++] = stage;
+    return MAX30101_OK;
+}
+
+// Give a block to the first stage
+uint8_t MAX30101_Pipeline_Push(MAX30101_Pipeline* pipe, MAX30101_Block* block)
+{
+    block->timestamp = (pipe->get_time != NULL) ? pipe->get_time() : 0;
+    if (!MAX30101_Pipeline_IsComplete(pipe) || (MAX30101_Pipeline_Enqueue(pipe, 0, block) != MAX30101_OK))
+    {
+        pipe->refused++;
+        MAX30101_Pool_Release(block);
+        return MAX30101_ERROR;
+    }
+    return MAX30101_OK;
+}
+
+// Run the stages on the waiting blocks
+uint16_t MAX30101_Pipeline_Run(MAX30101_Pipeline* pipe, uint16_t max_blocks)
+{
+    uint16_t processed = 0;
+    uint8_t progress = MAX30101_Pipeline_IsComplete(pipe);
+    while (progress && ((max_blocks == 0) || (processed < max_blocks)))
+    {
+        // Last stages first, to make room for the blocks before them
+        progress = 0;
+        for (uint8_t s = pipe->num_stages; (s > 0) && ((max_blocks == 0) || (processed < max_blocks)); s--)
+        {
+            if (MAX30101_Pipeline_Step(pipe, s - 1))
+            {
+                processed++;
+                progress = 1;
+            }
+        }
+    }
+    return processed;
+}
+
+// Blocks waiting in the queues
+uint16_t MAX30101_Pipeline_Pending(const MAX30101_Pipeline* pipe)
+{
+    uint16_t pending = 0;
+    for (uint8_t s = 0; s < pipe->num_stages; s++)
+    {
+        pending += pipe->queues[s].count;
+    }
+    return pending;
+}
+
+// Clear the statistics
+void MAX30101_Pipeline_ResetStats(MAX30101_Pipeline* pipe)
+{
+    memset(pipe->stats, 0, sizeof(pipe->stats));
+    pipe->refused = 0;
+    pipe->max_latency = 0;
+}
+
+// Unpack raw FIFO bytes
+uint8_t MAX30101_Pipe_Unpack(void* state, const MAX30101_Block* in, MAX30101_Block* out)
+{
+    const MAX30101_PipeUnpack* unpack = (const MAX30101_PipeUnpack*)state;
+    const uint8_t* raw = in->data;
+    uint16_t count = (uint16_t)in->num_samples * unpack->channels;
+    for (uint16_t i = 0; i < count; i++, raw += 3)
+    {
+        // MSB first on three bytes, 18 bits left aligned
+        out->samples[i] = ((((uint32_t)raw[0] << 16) | ((uint32_t)raw[1] << 8) | raw[2]) & 0x3FFFF) >> unpack->shift;
+    }
+    out->length = count * sizeof(uint32_t);
+    return MAX30101_OK;
+}
+
+// Add a block to the input queue of a stage
+static uint8_t MAX30101_Pipeline_Enqueue(MAX30101_Pipeline* pipe, uint8_t stage, MAX30101_Block* block)
+{
+    uint8_t error = MAX30101_OK;
+    uint8 interrupts = CyEnterCriticalSection();
+    MAX30101_PipeQueue* queue = &pipe->queues[stage];
+    if (queue->count == MAX30101_PIPE_QUEUE_SIZE)
+    {
+        error = MAX30101_ERROR;
+    }
+    else
+    {
+        queue->blocks[(queue->head + queue->count) & (MAX30101_PIPE_QUEUE_SIZE - 1)] = block;
+        if (++queue->count > pipe->stats[stage].max_queued)
+        {
+            pipe->stats[stage].max_queued = queue->count;
+        }
+    }
+    CyExitCriticalSection(interrupts);
+    return error;
+}
+
+// Process the first waiting block of a stage, return 1 if done
+static uint8_t MAX30101_Pipeline_Step(MAX30101_Pipeline* pipe, uint8_t stage)
+{
+    MAX30101_PipeQueue* queue = &pipe->queues[stage];
+    const MAX30101_PipeStage* desc = pipe->stages[stage];
+    MAX30101_PipeStats* stats = &pipe->stats[stage];
+    uint8_t sink = (desc->out_format == MAX30101_PIPE_NONE);
+
+    // Read by Push in interrupts only when not full: the first block is stable
+    if (queue->count == 0)
+    {
+        return 0;
+    }
+    MAX30101_Block* in = queue->blocks[queue->head];
+
+    // Backpressure: room in the next queue, and a block for the output
+    MAX30101_Block* out = NULL;
+    if (!sink)
+    {
+        // Only the sink is the last stage (see MAX30101_Pipeline_IsComplete)
+        if ((stage + 1 >= pipe->num_stages) || (pipe->queues[stage + 1].count == MAX30101_PIPE_QUEUE_SIZE))
+        {
+            stats->blocked++;
+            return 0;
+        }
+        out = desc->in_place ? in : MAX30101_Pool_Alloc();
+        if (out == NULL)
+        {
+            stats->blocked++;
+            return 0;
+        }
+        out->timestamp = in->timestamp;
+        out->num_samples = in->num_samples;
+    }
+
+    uint8 interrupts = CyEnterCriticalSection();
+    queue->head = (queue->head + 1) & (MAX30101_PIPE_QUEUE_SIZE - 1);
+    queue->count--;
+    CyExitCriticalSection(interrupts);
+
+    uint32_t start = (pipe->get_time != NULL) ? pipe->get_time() : 0;
+    uint8_t error = desc->process(desc->state, in, out);
+    uint32_t end = (pipe->get_time != NULL) ? pipe->get_time() : 0;
+
+    stats->blocks++;
+    stats->samples += in->num_samples;
+    stats->total_time += end - start;
+    if (end - start > stats->max_time)
+    {
+        stats->max_time = end - start;
+    }
+    if (sink && (end - in->timestamp > pipe->max_latency))
+    {
+        pipe->max_latency = end - in->timestamp;
+    }
+
+    if (!sink && !desc->in_place)
+    {
+        MAX30101_Pool_Release(in);
+    }
+    if (error != MAX30101_OK)
+    {
+        stats->dropped++;
+        MAX30101_Pool_Release(sink ? in : out);
+    }
+    else if (sink)
+    {
+        MAX30101_Pool_Release(in);
+    }
+    else
+    {
+        // Room was checked, and only this task adds to the queues after the first
+        MAX30101_Pipeline_Enqueue(pipe, stage + 1, out);
+    }
+    return 1;
+}
+
+// 1 if the last stage is a sink, so that every block leaves the pipeline
+static uint8_t MAX30101_Pipeline_IsComplete(const MAX30101_Pipeline* pipe)
+{
+    return (pipe->num_stages > 0) && (pipe->stages[pipe->num_stages - 1]->out_format == MAX30101_PIPE_NONE);
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,224 @@
+/**
+*   \file MAX30101_Pipeline.h
+*
+*   \brief Chain of processing stages on blocks of samples.
+*
+*   A pipeline is a chain of stages (e.g., unpack, filters, heart rate,
+*   compression, output) connected by bounded queues of blocks of
+*   MAX30101_Pool.h. Each stage declares the format of the blocks it
+*   takes and of the blocks it gives (encoding and number of channels):
+*   a stage is added only if its input matches the output of the
+*   previous one. The last stage is a sink, without output: until a sink
+*   is added, the pipeline refuses blocks and does not run.
+*
+*   Blocks are pushed in the first queue (e.g., by the task reading the
+*   FIFO) and #MAX30101_Pipeline_Run moves them through the stages, the
+*   last stages first. A stage writes its output in a new block from the
+*   pool, or in the input block if it works in place. A stage runs only
+*   if the next queue has room and, unless in place, a block is free:
+*   otherwise it is blocked and its input waits in its queue, up to the
+*   first queue, which refuses new blocks. The producer then keeps the
+*   samples in the sensor FIFO or counts them as lost.
+*
+*   For each stage the pipeline records blocks and samples processed,
+*   blocks dropped by the stage, blocked runs, the longest queue and the
+*   time spent in the stage, in the unit of the time function given to
+*   #MAX30101_Pipeline_Init. The time from the push of a block to the end
+*   of the sink is the end-to-end latency.
+*
+*   Push can be called from an interrupt, Run from a single task (e.g.,
+*   posted to the scheduler after each push).
+*/
+
+#ifndef __MAX30101_PIPELINE_H__
+    #define __MAX30101_PIPELINE_H__
+
+    #include "cytypes.h"
+    #include "MAX30101_Pool.h"
+
+    /**
+    *   \brief Maximum number of stages of a pipeline.
+    */
+    #ifndef MAX30101_PIPE_MAX_STAGES
+        #define MAX30101_PIPE_MAX_STAGES 8
+    #endif
+
+    /**
+    *   \brief Blocks waiting at the input of each stage (power of 2, up to 128).
+    */
+    #ifndef MAX30101_PIPE_QUEUE_SIZE
+        #define MAX30101_PIPE_QUEUE_SIZE 2
+    #endif
+
+    //==============================================
+    //           FORMATS
+    //==============================================
+    /**
+    *   \brief No blocks: output of a sink.
+    */
+    #define MAX30101_PIPE_NONE      0x00
+
+    /**
+    *   \brief Raw FIFO bytes, 3 bytes per channel (MAX30101_Block.data).
+    */
+    #define MAX30101_PIPE_RAW       0x10
+
+    /**
+    *   \brief 32-bit samples, one frame of channels after the other (MAX30101_Block.samples).
+    */
+    #define MAX30101_PIPE_SAMPLES   0x20
+
+    /**
+    *   \brief Bytes of any other content (e.g., compressed or text), length bytes in data.
+    */
+    #define MAX30101_PIPE_BYTES     0x30
+
+    /**
+    *   \brief Format of blocks: encoding and number of channels (1 to #MAX30101_MAX_SLOTS, 0 for bytes).
+    */
+    #define MAX30101_PIPE_FORMAT(encoding, channels) ((encoding) | (channels))
+
+    /**
+    *   \brief Process a block.
+    *
+    *   The output block has the time stamp and the number of samples of
+    *   the input; it is the input block for a stage in place, NULL for a
+    *   sink.
+    *   \param[in,out] state state of the stage.
+    *   \param[in] in input block.
+    *   \param[out] out output block.
+    *   \retval #MAX30101_OK if the output is valid.
+    *   \retval #MAX30101_ERROR to drop the block.
+    */
+    typedef uint8_t (*MAX30101_PipeFunction)(void* state, const MAX30101_Block* in, MAX30101_Block* out);
+
+    /**
+    *   \brief Description of a stage.
+    */
+    typedef struct
+    {
+        const char* name;               ///< Name, for reports.
+        MAX30101_PipeFunction process;  ///< Processing of a block.
+        void* state;                    ///< State given to process.
+        uint8_t in_format;              ///< Format of the input blocks (#MAX30101_PIPE_FORMAT).
+        uint8_t out_format;             ///< Format of the output blocks, #MAX30101_PIPE_NONE for a sink.
+        uint8_t in_place;               ///< 1 if the output is written in the input block.
+    } MAX30101_PipeStage;
+
+    /**
+    *   \brief Statistics of a stage.
+    */
+    typedef struct
+    {
+        uint32_t blocks;        ///< Blocks processed.
+        uint32_t samples;       ///< Samples of the blocks processed.
+        uint32_t dropped;       ///< Blocks dropped by the stage.
+        uint32_t blocked;       ///< Runs deferred: next queue full or no free block.
+        uint32_t total_time;    ///< Time spent in the stage.
+        uint32_t max_time;      ///< Longest block.
+        uint8_t max_queued;     ///< Longest input queue.
+    } MAX30101_PipeStats;
+
+    /**
+    *   \brief Input queue of a stage.
+    */
+    typedef struct
+    {
+        MAX30101_Block* blocks[MAX30101_PIPE_QUEUE_SIZE];
+        uint8_t head;   ///< Next block to process.
+        uint8_t count;  ///< Number of waiting blocks.
+    } MAX30101_PipeQueue;
+
+    /**
+    *   \brief A pipeline.
+    */
+    typedef struct
+    {
+        const MAX30101_PipeStage* stages[MAX30101_PIPE_MAX_STAGES]; ///< Stages, in order.
+        MAX30101_PipeQueue queues[MAX30101_PIPE_MAX_STAGES];        ///< Input queue of each stage.
+        MAX30101_PipeStats stats[MAX30101_PIPE_MAX_STAGES];         ///< Statistics of each stage.
+        uint32_t (*get_time)(void);     ///< Time function, NULL if none.
+        uint32_t refused;       ///< Blocks refused by #MAX30101_Pipeline_Push.
+        uint32_t max_latency;   ///< Longest time from push to the end of the sink.
+        uint8_t num_stages;     ///< Number of stages.
+    } MAX30101_Pipeline;
+
+    /**
+    *   \brief Initialize an empty pipeline.
+    *
+    *   \param[out] pipe pipeline.
+    *   \param[in] get_time time function (e.g., CPU cycle counter), NULL for no timing.
+    */
+    void MAX30101_Pipeline_Init(MAX30101_Pipeline* pipe, uint32_t (*get_time)(void));
+
+    /**
+    *   \brief Add a stage at the end of the pipeline.
+    *
+    *   \param[in,out] pipe pipeline.
+    *   \param[in] stage description of the stage, kept by the pipeline.
+    *   \retval #MAX30101_OK if the stage was added.
+    *   \retval #MAX30101_ERROR if its input does not match the output of the last stage,
+    *       the last stage is a sink, an in place stage changes the encoding, or
+    *       #MAX30101_PIPE_MAX_STAGES stages are already added.
+    */
+    uint8_t MAX30101_Pipeline_Add(MAX30101_Pipeline* pipe, const MAX30101_PipeStage* stage);
+
+    /**
+    *   \brief Give a block to the first stage.
+    *
+    *   The block is stamped with the current time and released by the
+    *   pipeline; on error it is released at once.
+    *   \param[in,out] pipe pipeline.
+    *   \param[in] block block of the pool in the input format of the first stage.
+    *   \retval #MAX30101_OK if the block was queued.
+    *   \retval #MAX30101_ERROR if the first queue is full or the last stage is not a sink
+    *       (counted in refused).
+    */
+    uint8_t MAX30101_Pipeline_Push(MAX30101_Pipeline* pipe, MAX30101_Block* block);
+
+    /**
+    *   \brief Run the stages on the waiting blocks.
+    *
+    *   \param[in,out] pipe pipeline.
+    *   \param[in] max_blocks most blocks processed (by all the stages together), 0 for no limit.
+    *   \return number of blocks processed; less than max_blocks if nothing more can run,
+    *       0 if the last stage is not a sink.
+    */
+    uint16_t MAX30101_Pipeline_Run(MAX30101_Pipeline* pipe, uint16_t max_blocks);
+
+    /**
+    *   \brief Number of blocks waiting in the queues.
+    *
+    *   \param[in] pipe pipeline.
+    *   \return blocks waiting.
+    */
+    uint16_t MAX30101_Pipeline_Pending(const MAX30101_Pipeline* pipe);
+
+    /**
+    *   \brief Clear the statistics of the stages.
+    *
+    *   \param[in,out] pipe pipeline.
+    */
+    void MAX30101_Pipeline_ResetStats(MAX30101_Pipeline* pipe);
+
+    /**
+    *   \brief State of #MAX30101_Pipe_Unpack.
+    */
+    typedef struct
+    {
+        uint8_t channels;       ///< Channels of a sample (1 to #MAX30101_MAX_SLOTS).
+        uint8_t shift;          ///< Right shift given by the pulse width (3 - pulse width setting, e.g., #MAX30101_FIXED_SHIFT).
+    } MAX30101_PipeUnpack;
+
+    /**
+    *   \brief Stage unpacking raw FIFO bytes to 32-bit samples (RAW to SAMPLES, same channels).
+    *
+    *   \param[in] state a #MAX30101_PipeUnpack.
+    *   \param[in] in raw bytes of num_samples samples.
+    *   \param[out] out samples, one frame of channels after the other.
+    *   \retval #MAX30101_OK always.
+    */
+    uint8_t MAX30101_Pipe_Unpack(void* state, const MAX30101_Block* in, MAX30101_Block* out);
+
+#endif
+/* [] END OF FILE */
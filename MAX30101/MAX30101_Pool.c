@@ -0,0 +1,147 @@
+/**
+*   Source file for the pool of sample blocks.
+*/
+
+#include "MAX30101_Pool.h"
+#include "CyLib.h"
+
+#if (MAX30101_POOL_BLOCKS == 0) || (MAX30101_POOL_BLOCKS > 255)
+    #error "MAX30101_POOL_BLOCKS must be from 1 to 255"
+#endif
+
+//==============================================
+//          MACROS
+//==============================================
+/**
+*   \brief Storage class of the pool: one pool per thread on the host.
+*/
+#if defined(__arm__)
+    #define MAX30101_POOL_STORAGE static
+#else
+    #define MAX30101_POOL_STORAGE static __thread
+#endif
+
+//==============================================
+//          VARIABLES
+//==============================================
+MAX30101_POOL_STORAGE MAX30101_Block pool_blocks[MAX30101_POOL_BLOCKS];
+MAX30101_POOL_STORAGE MAX30101_Block* pool_free = NULL;
+MAX30101_POOL_STORAGE MAX30101_PoolStats pool_stats;
+
+// Put all the blocks in the pool
+void MAX30101_Pool_Init(void)
+{
+    uint8 interrupts = CyEnterCriticalSection();
+    pool_free = NULL;
+    for (uint8_t i = MAX30101_POOL_BLOCKS; i > 0; i--)
+    {
+        pool_blocks[i - 1].refs = 0;
+        pool_blocks[i - 1].next = pool_free;
+        pool_free = &pool_blocks[i - 1];
+    }
+    pool_stats.allocs = 0;
+    pool_stats.failures = 0;
+    pool_stats.bad_releases = 0;
+    pool_stats.in_use = 0;
+    pool_stats.max_in_use = 0;
+    CyExitCriticalSection(interrupts);
+}
+
+// Take a block
+MAX30101_Block* MAX30101_Pool_Alloc(void)
+{
+    uint8 interrupts = CyEnterCriticalSection();
+    MAX30101_Block* block = pool_free;
+    if (block == NULL)
+    {
+        pool_stats.failures++;
+    }
+    else
+    {
+        pool_free = block->next;
+        block->refs = 1;
+        pool_stats.allocs++;
+        if (++pool_stats.in_use > pool_stats.max_in_use)
+        {
+            pool_stats.max_in_use = pool_stats.in_use;
+        }
+    }
+    CyExitCriticalSection(interrupts);
+
+    if (block != NULL)
+    {
+        block->next = NULL;
+        block->timestamp = 0;
+        block->length = 0;
+        block->num_samples = 0;
+    }
+    return block;
+}
+
+// Add a reference
+uint8_t MAX30101_Pool_Retain(MAX30101_Block* block)
+{
+    uint8_t error = MAX30101_ERROR;
+    uint8 interrupts = CyEnterCriticalSection();
+    if ((block->refs > 0) && (block->refs < 255))
+    {
+        block->refs++;
+        error = MAX30101_OK;
+    }
+    CyExitCriticalSection(interrupts);
+    return error;
+}
+
+// Release a reference
+uint8_t MAX30101_Pool_Release(MAX30101_Block* block)
+{
+    uint8_t error = MAX30101_OK;
+    uint8 interrupts = CyEnterCriticalSection();
+    if (block->refs == 0)
+    {
+        // Already free: putting it back would corrupt the list
+        pool_stats.bad_releases++;
+        error = MAX30101_ERROR;
+    }
+    else if (--block->refs == 0)
+    {
+        block->next = pool_free;
+        pool_free = block;
+        pool_stats.in_use--;
+    }
+    CyExitCriticalSection(interrupts);
+    return error;
+}
+
+// Index of a block
+uint32_t MAX30101_Pool_Index(const MAX30101_Block* block)
+{
+    return (uint32_t)(block - pool_blocks);
+}
+
+// Block of an index
+MAX30101_Block* MAX30101_Pool_Block(uint32_t index)
+{
+    return (index < MAX30101_POOL_BLOCKS) ? &pool_blocks[index] : NULL;
+}
+
+// Read the statistics
+void MAX30101_Pool_GetStats(MAX30101_PoolStats* stats)
+{
+    uint8 interrupts = CyEnterCriticalSection();
+    *stats = pool_stats;
+    CyExitCriticalSection(interrupts);
+}
+
+// Clear the counters
+void MAX30101_Pool_ResetStats(void)
+{
+    uint8 interrupts = CyEnterCriticalSection();
+    pool_stats.allocs = 0;
+    pool_stats.failures = 0;
+    pool_stats.bad_releases = 0;
+    pool_stats.max_in_use = pool_stats.in_use;
+    CyExitCriticalSection(interrupts);
+}
+
+/* [] END OF FILE */
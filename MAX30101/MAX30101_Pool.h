@@ -0,0 +1,140 @@
+/**
+*   \file MAX30101_Pool.h
+*
+*   \brief Pool of fixed-size sample blocks.
+*
+*   Buffers for raw FIFO data are taken from a static pool instead of
+*   the stack, so that they can be handed from the task reading the
+*   FIFO to later stages (e.g., posted to the scheduler with
+*   #MAX30101_Pool_Index) and their size is known at build time. Each
+*   block holds a whole FIFO (32 samples) of #MAX30101_MAX_SLOTS
+*   channels, as raw FIFO bytes or unpacked to 32 bits.
+*
+*   Free blocks are kept in a linked list: allocation and release take
+*   the first block and put it back in a short critical section, in
+*   constant time, and can be called from interrupts. A block is shared
+*   by several consumers with #MAX30101_Pool_Retain: it returns to the
+*   pool when the last reference is released.
+*
+*   The pool records allocations, failed allocations (pool exhausted)
+*   and the largest number of blocks in use, to size
+*   #MAX30101_POOL_BLOCKS.
+*
+*   On the host each thread has its own pool (e.g., the workers of the
+*   trace decoder), to be initialized by the thread.
+*/
+
+#ifndef __MAX30101_POOL_H__
+    #define __MAX30101_POOL_H__
+
+    #include "cytypes.h"
+    #include "MAX30101.h"
+
+    /**
+    *   \brief Number of blocks of the pool (up to 255).
+    */
+    #ifndef MAX30101_POOL_BLOCKS
+        #define MAX30101_POOL_BLOCKS 4
+    #endif
+
+    /**
+    *   \brief Samples of a block: a whole FIFO of #MAX30101_MAX_SLOTS channels.
+    */
+    #define MAX30101_POOL_BLOCK_SAMPLES (32 * MAX30101_MAX_SLOTS)
+
+    /**
+    *   \brief Bytes of a block, 32 bits per sample.
+    */
+    #define MAX30101_POOL_BLOCK_SIZE (MAX30101_POOL_BLOCK_SAMPLES * 4)
+
+    /**
+    *   \brief A block of samples.
+    */
+    typedef struct MAX30101_Block
+    {
+        union
+        {
+            uint8_t data[MAX30101_POOL_BLOCK_SIZE];         ///< Raw FIFO bytes, or bytes as set by the user.
+            uint32_t samples[MAX30101_POOL_BLOCK_SAMPLES];  ///< Unpacked samples, e.g., one frame of channels after the other.
+        };
+        struct MAX30101_Block* next;    ///< Next free block, used by the pool.
+        uint32_t timestamp;     ///< Time set by the user (e.g., of the FIFO read).
+        uint16_t length;        ///< Bytes used in data, set by the user.
+        uint8_t num_samples;    ///< Samples in data, set by the user.
+        uint8_t refs;           ///< References, 0 if free.
+    } MAX30101_Block;
+
+    /**
+    *   \brief Statistics of the pool.
+    */
+    typedef struct
+    {
+        uint32_t allocs;        ///< Blocks allocated.
+        uint32_t failures;      ///< Allocations failed because no block was free.
+        uint32_t bad_releases;  ///< Releases of a block not in use.
+        uint8_t in_use;         ///< Blocks in use now.
+        uint8_t max_in_use;     ///< Largest number of blocks in use.
+    } MAX30101_PoolStats;
+
+    /**
+    *   \brief Put all the blocks in the pool and clear the statistics.
+    *
+    *   Blocks still in use become invalid.
+    */
+    void MAX30101_Pool_Init(void);
+
+    /**
+    *   \brief Take a block with one reference.
+    *
+    *   \return the block (timestamp, length and num_samples set to 0), NULL if the pool is exhausted.
+    */
+    MAX30101_Block* MAX30101_Pool_Alloc(void);
+
+    /**
+    *   \brief Add a reference to a block in use, for another consumer.
+    *
+    *   \param[in,out] block block.
+    *   \retval #MAX30101_OK if the reference was added.
+    *   \retval #MAX30101_ERROR if the block is not in use or has 255 references.
+    */
+    uint8_t MAX30101_Pool_Retain(MAX30101_Block* block);
+
+    /**
+    *   \brief Release a reference, the block returns to the pool with the last one.
+    *
+    *   \param[in,out] block block.
+    *   \retval #MAX30101_OK if the reference was released.
+    *   \retval #MAX30101_ERROR if the block is not in use (counted in bad_releases).
+    */
+    uint8_t MAX30101_Pool_Release(MAX30101_Block* block);
+
+    /**
+    *   \brief Index of a block, e.g., to post it as the argument of a task.
+    *
+    *   \param[in] block block of the pool.
+    *   \return index from 0 to #MAX30101_POOL_BLOCKS - 1.
+    */
+    uint32_t MAX30101_Pool_Index(const MAX30101_Block* block);
+
+    /**
+    *   \brief Block of an index.
+    *
+    *   \param[in] index index returned by #MAX30101_Pool_Index.
+    *   \return the block, NULL if the index is not valid.
+    */
+    MAX30101_Block* MAX30101_Pool_Block(uint32_t index);
+
+    /**
+    *   \brief Read the statistics of the pool.
+    *
+    *   \param[out] stats statistics.
+    */
+    void MAX30101_Pool_GetStats(MAX30101_PoolStats* stats);
+
+    /**
+    *   \brief Clear the counters; the largest use restarts from the blocks in use.
+    */
+    void MAX30101_Pool_ResetStats(void);
+
+#endif
+/* [] END OF FILE */
@@ -0,0 +1,241 @@
+/**
+*   Source file for the MAX30101 acquisition path instrumentation.
+*/
+
+#include "MAX30101_Profile.h"
+#include "CyLib.h"
+
+#if !defined(__arm__)
+    #include <time.h>
+#endif
+
+//==============================================
+//          MACROS
+//==============================================
+/**
+*   \brief Number of runs used to measure the overhead.
+*/
+#define MAX30101_PROFILE_CALIB_RUNS 32
+
+/**
+*   \brief Size of the largest report packet.
+*/
+#define MAX30101_PROFILE_PACKET_SIZE (23 + 4 * MAX30101_PROFILE_BUCKETS)
+
+//==============================================
+//          VARIABLES
+//==============================================
+static MAX30101_StageStats profile_stats[MAX30101_PROFILE_STAGES];
+
+static uint32_t profile_null_time;
+
+static uint32_t profile_record_time;
+
+#if !defined(__arm__)
+    static uint32_t (*profile_clock)(void);
+#endif
+
+//==============================================
+//          FUNCTION PROTOTYPES
+//==============================================
+
+static void MAX30101_Profile_Update(MAX30101_StageStats* stats, uint32_t elapsed);
+
+static void MAX30101_Profile_Clear(MAX30101_StageStats* stats);
+
+static uint8_t MAX30101_Profile_Bucket(uint32_t value);
+
+static uint8_t* MAX30101_Profile_Put(uint8_t* buffer, uint64_t value, uint8_t bytes);
+
+// Enable time source and measure overhead
+void MAX30101_Profile_Start(void)
+{
+#if defined(__arm__)
+    MAX30101_DEMCR |= 0x01000000u;
+    MAX30101_DWT_CYCCNT = 0;
+    MAX30101_DWT_CTRL |= 0x00000001u;
+#endif
+
+    // Keep the shortest runs, longer ones were hit by interrupts
+    MAX30101_StageStats scratch;
+    profile_null_time = 0;
+    profile_record_time = UINT32_MAX;
+    MAX30101_Profile_Clear(&scratch);
+    for (uint8_t i = 0; i < MAX30101_PROFILE_CALIB_RUNS; i++)
+    {
+        uint32_t start = MAX30101_PROFILE_NOW();
+        uint32_t stop = MAX30101_PROFILE_NOW();
+        MAX30101_Profile_Update(&scratch, stop - start);
+        stop = MAX30101_PROFILE_NOW();
+        if (stop - start < profile_record_time)
+        {
+            profile_record_time = stop - start;
+        }
+    }
+    profile_null_time = scratch.min;
+    profile_record_time -= profile_null_time;
+
+    MAX30101_Profile_Reset();
+}
+
+// Clear all statistics
+void MAX30101_Profile_Reset(void)
+{
+    for (uint8_t stage = 0; stage < MAX30101_PROFILE_STAGES; stage++)
+    {
+        uint8_t int_status = CyEnterCriticalSection();
+        MAX30101_Profile_Clear(&profile_stats[stage]);
+        CyExitCriticalSection(int_status);
+    }
+}
+
+// Record a run
+void MAX30101_Profile_Record(uint8_t stage, uint32_t elapsed)
+{
+    if (stage < MAX30101_PROFILE_STAGES)
+    {
+        elapsed = (elapsed > profile_null_time) ? elapsed - profile_null_time : 0;
+        MAX30101_Profile_Update(&profile_stats[stage], elapsed);
+    }
+}
+
+// Copy statistics of a stage
+void MAX30101_Profile_GetStats(uint8_t stage, MAX30101_StageStats* stats)
+{
+    if (stage < MAX30101_PROFILE_STAGES)
+    {
+        uint8_t int_status = CyEnterCriticalSection();
+        *stats = profile_stats[stage];
+        CyExitCriticalSection(int_status);
+    }
+}
+
+// Send binary report
+void MAX30101_Profile_Report(void (*write_fun)(const uint8_t*, uint8_t))
+{
+    uint8_t packet[MAX30101_PROFILE_PACKET_SIZE];
+    uint8_t* p = packet;
+
+    *p++ = 'M';
+    *p++ = 'P';
+    *p++ = MAX30101_PROFILE_VERSION;
+    *p++ = MAX30101_PROFILE_UNIT;
+    *p++ = MAX30101_PROFILE_STAGES;
+    *p++ = MAX30101_PROFILE_BUCKETS;
+    p = MAX30101_Profile_Put(p, profile_null_time > UINT16_MAX ? UINT16_MAX : profile_null_time, 2);
+    p = MAX30101_Profile_Put(p, profile_record_time > UINT16_MAX ? UINT16_MAX : profile_record_time, 2);
+    write_fun(packet, (uint8_t)(p - packet));
+
+    for (uint8_t stage = 0; stage < MAX30101_PROFILE_STAGES; stage++)
+    {
+        MAX30101_StageStats stats;
+        MAX30101_Profile_GetStats(stage, &stats);
+        if (stats.count == 0)
+        {
+            continue;
+        }
+
+        // Send only the non empty part of the histogram
+        uint8_t first = 0;
+        uint8_t last = MAX30101_PROFILE_BUCKETS - 1;
+        while (stats.buckets[first] == 0)
+        {
+            first++;
+        }
+        while (stats.buckets[last] == 0)
+        {
+            last--;
+        }
+
+        p = packet;
+        *p++ = stage;
+        p = MAX30101_Profile_Put(p, stats.count, 4);
+        p = MAX30101_Profile_Put(p, stats.min, 4);
+        p = MAX30101_Profile_Put(p, stats.max, 4);
+        p = MAX30101_Profile_Put(p, stats.total, 8);
+        *p++ = first;
+        *p++ = last - first + 1;
+        for (uint8_t bucket = first; bucket <= last; bucket++)
+        {
+            p = MAX30101_Profile_Put(p, stats.buckets[bucket], 4);
+        }
+        write_fun(packet, (uint8_t)(p - packet));
+    }
+}
+
+// Get current time
+uint32_t MAX30101_Profile_Now(void)
+{
+#if defined(__arm__)
+    return MAX30101_DWT_CYCCNT;
+#else
+    if (profile_clock != NULL)
+    {
+        return profile_clock();
+    }
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint32_t)((uint64_t)now.tv_sec * 1000000000u + (uint64_t)now.tv_nsec);
+#endif
+}
+
+#if !defined(__arm__)
+// Replace the host time source
+void MAX30101_Profile_SetClock(uint32_t (*now)(void))
+{
+    profile_clock = now;
+}
+#endif
+
+// Add a run to the statistics
+static void MAX30101_Profile_Update(MAX30101_StageStats* stats, uint32_t elapsed)
+{
+    stats->count++;
+    stats->total += elapsed;
+    if (elapsed < stats->min)
+    {
+        stats->min = elapsed;
+    }
+    if (elapsed > stats->max)
+    {
+        stats->max = elapsed;
+    }
+    stats->buckets[MAX30101_Profile_Bucket(elapsed)]++;
+}
+
+// Clear statistics
+static void MAX30101_Profile_Clear(MAX30101_StageStats* stats)
+{
+    stats->count = 0;
+    stats->min = UINT32_MAX;
+    stats->max = 0;
+    stats->total = 0;
+    for (uint8_t bucket = 0; bucket < MAX30101_PROFILE_BUCKETS; bucket++)
+    {
+        stats->buckets[bucket] = 0;
+    }
+}
+
+// Log2 bucket of a duration
+static uint8_t MAX30101_Profile_Bucket(uint32_t value)
+{
+    if (value == 0)
+    {
+        return 0;
+    }
+    // Number of significant bits, single CLZ instruction on Cortex-M3
+    uint8_t bucket = 32 - __builtin_clz(value);
+    return (bucket < MAX30101_PROFILE_BUCKETS) ? bucket : MAX30101_PROFILE_BUCKETS - 1;
+}
+
+// Store a value in little endian
+static uint8_t* MAX30101_Profile_Put(uint8_t* buffer, uint64_t value, uint8_t bytes)
+{
+    for (uint8_t i = 0; i < bytes; i++)
+    {
+        *buffer++ = (uint8_t)(value >> (8 * i));
+    }
+    return buffer;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,253 @@
+/**
+*   \file MAX30101_Profile.h
+*
+*   \brief Per-stage timing instrumentation for the MAX30101 acquisition path.
+*
+*   Each stage of the acquisition path (interrupt, status read, pointer
+*   read, FIFO burst read, unpack, filter, output) is enclosed between
+*   #MAX30101_PROFILE_BEGIN and #MAX30101_PROFILE_END. For every stage
+*   the number of runs, the minimum, maximum and total time and a log2
+*   histogram of the durations are kept.
+*
+*   Times are in CPU cycles on target (Cortex-M3 DWT cycle counter) and
+*   in ns on the host (clock_gettime).
+*
+*   Typical usage:
+*   \code
+*   MAX30101_Profile_Start();
+*   ...
+*   MAX30101_PROFILE_BEGIN(MAX30101_STAGE_BURST);
+*   MAX30101_ReadRawFIFOBytes(num_samples, active_leds, raw);
+*   MAX30101_PROFILE_END(MAX30101_STAGE_BURST);
+*   ...
+*   MAX30101_Profile_Report(UART_Debug_PutArray);
+*   \endcode
+*
+*   Set #MAX30101_PROFILE to 0 to compile the instrumentation out: the
+*   macros then expand to nothing and the acquisition path is unchanged.
+*
+*   Overhead: the time between the two time stamps of an empty
+*   BEGIN/END pair (null time) and the time spent in
+*   #MAX30101_Profile_Record (record time) are measured by
+*   #MAX30101_Profile_Start and sent in the header of each report.
+*   The null time is subtracted from each measurement. The record
+*   time is not, so a stage enclosing other stages (e.g.,
+*   #MAX30101_STAGE_ISR) is inflated by one record time per nested
+*   stage.
+*
+*   Binary report, multi-byte fields little endian:
+*   - header: 'M', 'P', version, unit (#MAX30101_PROFILE_UNIT_CYCLES or
+*     #MAX30101_PROFILE_UNIT_NS), number of stages, number of buckets,
+*     null time (2 bytes), record time (2 bytes);
+*   - for each stage with at least one run: stage, count (4 bytes),
+*     min (4 bytes), max (4 bytes), total (8 bytes), first bucket,
+*     number of buckets n, n bucket counts (4 bytes each). Empty
+*     buckets at the two ends of the histogram are not sent.
+*
+*   Bucket 0 counts durations equal to 0, bucket b > 0 counts
+*   durations in [2^(b-1), 2^b).
+*/
+
+#ifndef __MAX30101_PROFILE_H__
+    #define __MAX30101_PROFILE_H__
+
+    #include "cytypes.h"
+
+    /**
+    *   \brief Enable (1) or disable (0) the instrumentation macros.
+    */
+    #ifndef MAX30101_PROFILE
+        #define MAX30101_PROFILE 1
+    #endif
+
+    //==============================================
+    //           STAGES
+    //==============================================
+    /**
+    *   \brief Interrupt service routine.
+    */
+    #define MAX30101_STAGE_ISR      0
+
+    /**
+    *   \brief Read of the interrupt status registers.
+    */
+    #define MAX30101_STAGE_STATUS   1
+
+    /**
+    *   \brief Read of the FIFO pointers.
+    */
+    #define MAX30101_STAGE_POINTERS 2
+
+    /**
+    *   \brief Burst read of FIFO_DATA.
+    */
+    #define MAX30101_STAGE_BURST    3
+
+    /**
+    *   \brief Conversion of raw FIFO bytes to samples.
+    */
+    #define MAX30101_STAGE_UNPACK   4
+
+    /**
+    *   \brief Signal processing of the samples.
+    */
+    #define MAX30101_STAGE_FILTER   5
+
+    /**
+    *   \brief Output of the results (e.g., UART).
+    */
+    #define MAX30101_STAGE_OUTPUT   6
+
+    /**
+    *   \brief Formatting of text output, before it is sent.
+    */
+    #define MAX30101_STAGE_FORMAT   7
+
+    /**
+    *   \brief Number of profiled stages.
+    */
+    #define MAX30101_PROFILE_STAGES 8
+
+    /**
+    *   \brief Number of buckets of the log2 histogram.
+    */
+    #define MAX30101_PROFILE_BUCKETS 32
+
+    /**
+    *   \brief Report times are in CPU cycles.
+    */
+    #define MAX30101_PROFILE_UNIT_CYCLES 0
+
+    /**
+    *   \brief Report times are in ns.
+    */
+    #define MAX30101_PROFILE_UNIT_NS 1
+
+    /**
+    *   \brief Version of the binary report.
+    */
+    #define MAX30101_PROFILE_VERSION 1
+
+    //==============================================
+    //           TIME SOURCE
+    //==============================================
+    #if defined(__arm__)
+        /**
+        *   \brief DWT control register.
+        */
+        #define MAX30101_DWT_CTRL    (*(reg32*)0xE0001000u)
+
+        /**
+        *   \brief DWT cycle counter register.
+        */
+        #define MAX30101_DWT_CYCCNT  (*(reg32*)0xE0001004u)
+
+        /**
+        *   \brief Debug Exception and Monitor Control register.
+        */
+        #define MAX30101_DEMCR       (*(reg32*)0xE000EDFCu)
+
+        /**
+        *   \brief Unit of the time source.
+        */
+        #define MAX30101_PROFILE_UNIT MAX30101_PROFILE_UNIT_CYCLES
+
+        /**
+        *   \brief Current time, a single load of the cycle counter.
+        */
+        #define MAX30101_PROFILE_NOW() ((uint32_t)MAX30101_DWT_CYCCNT)
+    #else
+        #define MAX30101_PROFILE_UNIT MAX30101_PROFILE_UNIT_NS
+
+        #define MAX30101_PROFILE_NOW() MAX30101_Profile_Now()
+    #endif
+
+    //==============================================
+    //           INSTRUMENTATION MACROS
+    //==============================================
+    #if MAX30101_PROFILE
+        /**
+        *   \brief Start timing a stage. Must be paired with #MAX30101_PROFILE_END in the same block.
+        */
+        #define MAX30101_PROFILE_BEGIN(stage) uint32_t profile_start_##stage = MAX30101_PROFILE_NOW()
+
+        /**
+        *   \brief Stop timing a stage and record its duration.
+        */
+        #define MAX30101_PROFILE_END(stage) \
+            MAX30101_Profile_Record((stage), MAX30101_PROFILE_NOW() - profile_start_##stage)
+    #else
+        #define MAX30101_PROFILE_BEGIN(stage)
+        #define MAX30101_PROFILE_END(stage)
+    #endif
+
+    /**
+    *   \brief Timing statistics of a stage.
+    */
+    typedef struct
+    {
+        uint32_t count;                             ///< Number of runs.
+        uint32_t min;                               ///< Shortest run.
+        uint32_t max;                               ///< Longest run.
+        uint64_t total;                             ///< Sum of all the runs, mean is total / count.
+        uint32_t buckets[MAX30101_PROFILE_BUCKETS]; ///< Log2 histogram of the runs.
+    } MAX30101_StageStats;
+
+    /**
+    *   \brief Start the time source and measure the instrumentation overhead.
+    *
+    *   This function enables the DWT cycle counter on target, clears all
+    *   the statistics and measures null and record times.
+    */
+    void MAX30101_Profile_Start(void);
+
+    /**
+    *   \brief Clear the statistics of all the stages.
+    */
+    void MAX30101_Profile_Reset(void);
+
+    /**
+    *   \brief Record a run of a stage.
+    *
+    *   Each stage must be recorded from a single context (either the
+    *   interrupt or the main loop).
+    *   \param[in] stage stage (e.g., #MAX30101_STAGE_BURST).
+    *   \param[in] elapsed duration of the run, null time included.
+    */
+    void MAX30101_Profile_Record(uint8_t stage, uint32_t elapsed);
+
+    /**
+    *   \brief Get a copy of the statistics of a stage.
+    *
+    *   \param[in] stage stage (e.g., #MAX30101_STAGE_BURST).
+    *   \param[out] stats pointer to the statistics.
+    */
+    void MAX30101_Profile_GetStats(uint8_t stage, MAX30101_StageStats* stats);
+
+    /**
+    *   \brief Send the binary report.
+    *
+    *   The report is sent as one packet for the header and one packet
+    *   for each stage, each shorter than 256 bytes.
+    *   \param[in] write_fun function used to send each packet (e.g., UART_Debug_PutArray).
+    */
+    void MAX30101_Profile_Report(void (*write_fun)(const uint8_t*, uint8_t));
+
+    /**
+    *   \brief Get current time.
+    *
+    *   \return current time in CPU cycles on target, in ns on host.
+    */
+    uint32_t MAX30101_Profile_Now(void);
+
+    #if !defined(__arm__)
+        /**
+        *   \brief Replace the host time source, e.g., with the clock of a simulation.
+        *
+        *   \param[in] now function returning the current time in ns; NULL for the monotonic clock.
+        */
+        void MAX30101_Profile_SetClock(uint32_t (*now)(void));
+    #endif
+
+#endif
+/* [] END OF FILE */
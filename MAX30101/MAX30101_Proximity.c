@@ -0,0 +1,132 @@
+/**
+*   Source file for the MAX30101 proximity state machine.
+*/
+
+#include "MAX30101_Proximity.h"
+
+//==============================================
+//          FUNCTION PROTOTYPES
+//==============================================
+
+static uint8_t MAX30101_Prox_EnterIdle(MAX30101_Prox* prox);
+
+static uint8_t MAX30101_Prox_EnterActive(MAX30101_Prox* prox);
+
+// Start the state machine in proximity mode
+uint8_t MAX30101_Prox_Start(MAX30101_Prox* prox, const MAX30101_ProxConfig* config)
+{
+    prox->config = *config;
+    prox->wake_ups = 0;
+    prox->fall_backs = 0;
+    prox->active_samples = 0;
+    return MAX30101_Prox_EnterIdle(prox);
+}
+
+// Wake up on proximity interrupt
+uint8_t MAX30101_Prox_HandleInterrupt(MAX30101_Prox* prox)
+{
+    if (prox->state != MAX30101_PROX_IDLE)
+    {
+        return MAX30101_OK;
+    }
+
+    uint8_t flag;
+    uint8_t error = MAX30101_IsProximity(&flag);
+    if ((error == MAX30101_OK) && (flag > 0))
+    {
+        error = MAX30101_Prox_EnterActive(prox);
+    }
+    return error;
+}
+
+// Look for sustained signal loss
+uint8_t MAX30101_Prox_ProcessSamples(MAX30101_Prox* prox, const uint32_t* values, uint8_t num_samples)
+{
+    if (prox->state != MAX30101_PROX_ACTIVE)
+    {
+        return MAX30101_OK;
+    }
+
+    prox->active_samples += num_samples;
+    for (uint8_t i = 0; i < num_samples; i++)
+    {
+        if (values[i] < prox->config.loss_level)
+        {
+            prox->below_count++;
+        }
+        else
+        {
+            prox->below_count = 0;
+        }
+    }
+
+    if (prox->below_count >= prox->config.loss_samples)
+    {
+        prox->fall_backs++;
+        return MAX30101_Prox_EnterIdle(prox);
+    }
+    return MAX30101_OK;
+}
+
+// Get current state
+uint8_t MAX30101_Prox_GetState(const MAX30101_Prox* prox)
+{
+    return prox->state;
+}
+
+// Go to low power proximity mode
+static uint8_t MAX30101_Prox_EnterIdle(MAX30101_Prox* prox)
+{
+    prox->state = MAX30101_PROX_IDLE;
+    prox->below_count = 0;
+
+    // No FIFO data is generated in proximity mode
+    uint8_t error = MAX30101_DisableFIFOAFullInt();
+    if (error == MAX30101_OK)
+    {
+        error = MAX30101_SetPilotPulseAmplitude(prox->config.pilot_pa);
+    }
+    if (error == MAX30101_OK)
+    {
+        error = MAX30101_SetProximityThreshold(prox->config.threshold);
+    }
+    if (error == MAX30101_OK)
+    {
+        error = MAX30101_EnableProximityInt();
+    }
+    if (error == MAX30101_OK)
+    {
+        // Proximity mode is entered again only when the mode register is written
+        uint8_t mode;
+        error = MAX30101_ReadRegister(MAX30101_MODE_CONF, &mode);
+        if (error == MAX30101_OK)
+        {
+            error = MAX30101_SetMode(mode & 0x07);
+        }
+    }
+    if (error == MAX30101_OK)
+    {
+        // Clear pending interrupts so that the interrupt pin is released
+        uint8_t flag;
+        error = MAX30101_IsProximity(&flag);
+    }
+    return error;
+}
+
+// Apply full configuration and start acquiring data
+static uint8_t MAX30101_Prox_EnterActive(MAX30101_Prox* prox)
+{
+    prox->state = MAX30101_PROX_ACTIVE;
+    prox->below_count = 0;
+    prox->wake_ups++;
+
+    // The device left proximity mode by itself, with the LED amplitudes of the configuration
+    uint8_t error = MAX30101_ClearFIFO();
+    if (error == MAX30101_OK)
+    {
+        error = MAX30101_EnableFIFOAFullInt();
+    }
+    return error;
+}
+
+/* [] END OF FILE */
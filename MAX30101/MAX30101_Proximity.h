@@ -0,0 +1,120 @@
+/**
+*   \file MAX30101_Proximity.h
+*
+*   \brief Proximity-triggered low power acquisition for the MAX30101.
+*
+*   This module keeps the MAX30101 in its low power proximity mode while
+*   no finger is present on the sensor, pulsing only the IR LED at the
+*   pilot amplitude. When the IR level reaches the threshold, the device
+*   switches to the LED amplitudes of the HR/SpO2 configuration by itself
+*   and raises the proximity interrupt; FIFO data is then acquired as
+*   usual. If the
+*   signal is lost for a given number of consecutive samples, the sensor
+*   goes back to proximity mode.
+*
+*   Typical usage from the main loop:
+*   \code
+*   MAX30101_Prox prox;
+*   MAX30101_Prox_Start(&prox, &prox_config);
+*   ...
+*   // MAX30101 interrupt pin was asserted
+*   if (MAX30101_Prox_GetState(&prox) == MAX30101_PROX_IDLE)
+*       MAX30101_Prox_HandleInterrupt(&prox);
+*   else
+*   {
+*       // read FIFO as usual, then
+*       MAX30101_Prox_ProcessSamples(&prox, ir_values, num_samples);
+*   }
+*   \endcode
+*/
+
+#ifndef __MAX30101_PROXIMITY_H__
+    #define __MAX30101_PROXIMITY_H__
+
+    #include "cytypes.h"
+    #include "MAX30101.h"
+
+    /**
+    *   \brief Sensor is in proximity mode, waiting for a finger.
+    */
+    #define MAX30101_PROX_IDLE 0
+
+    /**
+    *   \brief Sensor is acquiring data with the full configuration.
+    */
+    #define MAX30101_PROX_ACTIVE 1
+
+    /**
+    *   \brief Configuration of the proximity state machine.
+    */
+    typedef struct
+    {
+        uint8_t pilot_pa;       ///< IR pulse amplitude while in proximity mode.
+        uint8_t threshold;      ///< Proximity threshold (8 MSBs of the IR ADC count).
+        uint32_t loss_level;    ///< Level below which a sample is considered as signal loss.
+        uint16_t loss_samples;  ///< Number of consecutive samples below loss_level before going back to proximity mode.
+    } MAX30101_ProxConfig;
+
+    /**
+    *   \brief State of the proximity state machine.
+    */
+    typedef struct
+    {
+        MAX30101_ProxConfig config; ///< Current configuration.
+        uint8_t state;              ///< Current state (#MAX30101_PROX_IDLE or #MAX30101_PROX_ACTIVE).
+        uint16_t below_count;       ///< Consecutive samples below the loss level.
+        uint32_t wake_ups;          ///< Number of transitions to #MAX30101_PROX_ACTIVE.
+        uint32_t fall_backs;        ///< Number of transitions to #MAX30101_PROX_IDLE due to signal loss.
+        uint32_t active_samples;    ///< Number of samples processed while active.
+    } MAX30101_Prox;
+
+    /**
+    *   \brief Start the proximity state machine.
+    *
+    *   This function stores the configuration and puts the MAX30101 in
+    *   proximity mode. The operating mode (HR, SpO2, Multi-LED), the LED
+    *   amplitudes and the other acquisition settings must already be
+    *   configured.
+    *   \param[out] prox pointer to the state machine.
+    *   \param[in] config pointer to the configuration to be used.
+    *   \retval #MAX30101_OK if no error occurred.
+    *   \retval #MAX30101_DEV_NOT_FOUND if device is not present on the I2C bus.
+    */
+    uint8_t MAX30101_Prox_Start(MAX30101_Prox* prox, const MAX30101_ProxConfig* config);
+
+    /**
+    *   \brief Handle a MAX30101 interrupt while in proximity mode.
+    *
+    *   This function checks the proximity interrupt flag and, if set,
+    *   clears the FIFO and enables the FIFO almost full interrupt. It does nothing if the state machine
+    *   is already active.
+    *   \param[in,out] prox pointer to the state machine.
+    *   \retval #MAX30101_OK if no error occurred.
+    *   \retval #MAX30101_DEV_NOT_FOUND if device is not present on the I2C bus.
+    */
+    uint8_t MAX30101_Prox_HandleInterrupt(MAX30101_Prox* prox);
+
+    /**
+    *   \brief Process samples acquired while active.
+    *
+    *   This function checks the samples for signal loss (e.g., IR channel).
+    *   If more than loss_samples consecutive samples are below loss_level,
+    *   the MAX30101 is put back in proximity mode.
+    *   \param[in,out] prox pointer to the state machine.
+    *   \param[in] values samples to be checked.
+    *   \param[in] num_samples number of samples.
+    *   \retval #MAX30101_OK if no error occurred.
+    *   \retval #MAX30101_DEV_NOT_FOUND if device is not present on the I2C bus.
+    */
+    uint8_t MAX30101_Prox_ProcessSamples(MAX30101_Prox* prox, const uint32_t* values, uint8_t num_samples);
+
+    /**
+    *   \brief Get the current state of the proximity state machine.
+    *
+    *   \param[in] prox pointer to the state machine.
+    *   \return #MAX30101_PROX_IDLE or #MAX30101_PROX_ACTIVE.
+    */
+    uint8_t MAX30101_Prox_GetState(const MAX30101_Prox* prox);
+
+#endif
+/* [] END OF FILE */
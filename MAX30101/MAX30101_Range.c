@@ -0,0 +1,144 @@
+/**
+*   Source file for the ADC range monitor.
+*/
+
+#include "MAX30101_Range.h"
+#include "MAX30101.h"
+
+//==============================================
+//          MACROS
+//==============================================
+
+/**
+*   \brief Highest range index.
+*/
+#define RANGE_MAX_INDEX 3
+
+// Initialize range monitor
+uint8_t MAX30101_Range_Init(MAX30101_Range* monitor, uint8_t adc_range, uint8_t min_range, uint8_t max_range,
+                            uint8_t shift, uint16_t down_blocks)
+{
+    uint8_t range = adc_range >> MAX30101_ADC_RANGE_SHIFT;
+    min_range >>= MAX30101_ADC_RANGE_SHIFT;
+    max_range >>= MAX30101_ADC_RANGE_SHIFT;
+    if ((max_range > RANGE_MAX_INDEX) || (min_range > max_range) || (range < min_range) || (range > max_range) ||
+        (shift > 3))
+    {
+        return MAX30101_ERROR;
+    }
+    uint32_t full_scale = 0x3FFFFu >> shift;
+    monitor->high = full_scale / 16 * MAX30101_RANGE_HIGH;
+    monitor->low = full_scale / 16 * MAX30101_RANGE_LOW;
+    monitor->block_max = 0;
+    monitor->switches = 0;
+    monitor->alc_overflows = 0;
+    monitor->clipped = 0;
+    monitor->down_blocks = down_blocks;
+    monitor->dim_blocks = 0;
+    monitor->range = range;
+    monitor->previous = range;
+    monitor->pending = 0;
+    monitor->min_range = min_range;
+    monitor->max_range = max_range;
+    monitor->block_clipped = 0;
+    monitor->alc_overflow = 0;
+    return MAX30101_OK;
+}
+
+// Check and scale samples of a channel
+void MAX30101_Range_Scale(MAX30101_Range* monitor, uint32_t* ring, uint8_t head, uint8_t num_samples)
+{
+    for (uint8_t i = 0; i < num_samples; i++)
+    {
+        uint8_t index = (head + 1 - num_samples + i) & (BUFFER_STORAGE_SIZE - 1);
+        uint32_t sample = ring[index];
+        uint8_t range = monitor->range;
+        if (i < monitor->pending)
+        {
+            // Acquired before the last change
+            range = monitor->previous;
+        }
+        if (sample >= monitor->high)
+        {
+            monitor->clipped++;
+        }
+        if (range == monitor->range)
+        {
+            if (sample >= monitor->high)
+            {
+                monitor->block_clipped = 1;
+            }
+            if (sample > monitor->block_max)
+            {
+                monitor->block_max = sample;
+            }
+        }
+        ring[index] = sample << (range - monitor->min_range);
+    }
+}
+
+// Select the range after a drain
+uint8_t MAX30101_Range_Update(MAX30101_Range* monitor, uint8_t num_samples, uint8_t alc_overflow)
+{
+    monitor->pending = (monitor->pending > num_samples) ? monitor->pending - num_samples : 0;
+    if (alc_overflow)
+    {
+        monitor->alc_overflows++;
+    }
+
+    uint8_t range = monitor->range;
+    uint8_t alc_start = alc_overflow && !monitor->alc_overflow;
+    monitor->alc_overflow = alc_overflow;
+    if (monitor->block_clipped || alc_start)
+    {
+        monitor->dim_blocks = 0;
+        if (range < monitor->max_range)
+        {
+            range++;
+        }
+    }
+    else if (alc_overflow)
+    {
+        monitor->dim_blocks = 0;
+    }
+    else if (monitor->block_max < monitor->low)
+    {
+        if ((++monitor->dim_blocks >= monitor->down_blocks) && (range > monitor->min_range))
+        {
+            range--;
+        }
+    }
+    else
+    {
+        monitor->dim_blocks = 0;
+    }
+    monitor->block_max = 0;
+    monitor->block_clipped = 0;
+
+    if (range == monitor->range)
+    {
+        return MAX30101_OK;
+    }
+    uint8_t error = MAX30101_SetSpO2ADCRange(range << MAX30101_ADC_RANGE_SHIFT);
+    if (error != MAX30101_OK)
+    {
+        return error;
+    }
+    // Samples still in the FIFO were acquired with the previous range
+    uint8_t wp, ovf, rp;
+    error = MAX30101_ReadFIFOPointers(&wp, &ovf, &rp);
+    monitor->previous = monitor->range;
+    monitor->pending = (wp - rp) & 0x1F;
+    monitor->range = range;
+    monitor->dim_blocks = 0;
+    monitor->switches++;
+    return error;
+}
+
+// Current range
+uint8_t MAX30101_Range_Get(const MAX30101_Range* monitor)
+{
+    return monitor->range << MAX30101_ADC_RANGE_SHIFT;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,119 @@
+/**
+*   \file MAX30101_Range.h
+*
+*   \brief Automatic ADC range from saturation and ambient light overflow.
+*
+*   The ADC full scale (#MAX30101_ADC_RANGE_2048 to
+*   #MAX30101_ADC_RANGE_16384) trades headroom for resolution: too low
+*   and bright light clips the samples, too high and dim signals use a
+*   fraction of the codes. The monitor checks each block of samples read
+*   from the FIFO, with the ALC overflow flag read from the interrupt
+*   status register in the same drain:
+*   - a sample at or above #MAX30101_RANGE_HIGH of full scale (clipped or
+*     about to) selects the next higher range at once;
+*   - the start of an ALC overflow (ambient light no longer cancelled, the
+*     rest adds to the samples) selects the next higher range at once,
+*     before the samples clip; while it lasts, saturation alone decides;
+*   - blocks with every sample below #MAX30101_RANGE_LOW of full scale,
+*     and no ALC overflow, for down_blocks consecutive blocks select the
+*     next lower range. The samples double, staying below the high
+*     threshold, so the range does not oscillate.
+*
+*   Consumers see continuous units: #MAX30101_Range_Scale shifts each
+*   sample left by its range above the lowest range, so samples are in
+*   LSBs of the lowest range whatever the range they were acquired with.
+*   A scaled sample has up to 18 - shift + (max_range - min_range) bits.
+*
+*   The samples already in the FIFO when the range changes were acquired
+*   with the previous range: the monitor reads the FIFO pointers just
+*   after the change and scales that many samples of the next drain with
+*   the previous range (a sample converted during the change may be on
+*   either side).
+*/
+
+#ifndef __MAX30101_RANGE_H__
+    #define __MAX30101_RANGE_H__
+
+    #include "cytypes.h"
+
+    /**
+    *   \brief Near full scale threshold, in 1/16 of full scale.
+    */
+    #ifndef MAX30101_RANGE_HIGH
+        #define MAX30101_RANGE_HIGH 15
+    #endif
+
+    /**
+    *   \brief Dim threshold, in 1/16 of full scale (below half of #MAX30101_RANGE_HIGH).
+    */
+    #ifndef MAX30101_RANGE_LOW
+        #define MAX30101_RANGE_LOW 6
+    #endif
+
+    /**
+    *   \brief State of the range monitor.
+    */
+    typedef struct
+    {
+        uint32_t high;          ///< Samples at or above are near full scale.
+        uint32_t low;           ///< Blocks with every sample below are dim.
+        uint32_t block_max;     ///< Largest sample of the block acquired with the current range.
+        uint32_t switches;      ///< Range changes.
+        uint32_t alc_overflows; ///< Blocks with an ALC overflow.
+        uint32_t clipped;       ///< Samples near full scale.
+        uint16_t down_blocks;   ///< Dim blocks before a lower range.
+        uint16_t dim_blocks;    ///< Consecutive dim blocks.
+        uint8_t range;          ///< Current range, 0 (2048 nA) to 3 (16384 nA).
+        uint8_t previous;       ///< Range of the pending samples.
+        uint8_t pending;        ///< Samples of the next drain acquired with the previous range.
+        uint8_t min_range;      ///< Lowest range, unit of the scaled samples.
+        uint8_t max_range;      ///< Highest range.
+        uint8_t block_clipped;  ///< 1 if a sample of the block acquired with the current range is near full scale.
+        uint8_t alc_overflow;   ///< 1 if the last block had an ALC overflow.
+    } MAX30101_Range;
+
+    /**
+    *   \brief Initialize the range monitor.
+    *
+    *   \param[out] monitor range monitor.
+    *   \param[in] adc_range range the device runs with (#MAX30101_ADC_RANGE_2048 to #MAX30101_ADC_RANGE_16384).
+    *   \param[in] min_range lowest range to select.
+    *   \param[in] max_range highest range to select.
+    *   \param[in] shift right shift of the samples given by the pulse width (3 - pulse width setting).
+    *   \param[in] down_blocks consecutive dim blocks before a lower range.
+    *   \retval #MAX30101_OK if the ranges are consistent.
+    *   \retval #MAX30101_ERROR otherwise.
+    */
+    uint8_t MAX30101_Range_Init(MAX30101_Range* monitor, uint8_t adc_range, uint8_t min_range, uint8_t max_range,
+                                uint8_t shift, uint16_t down_blocks);
+
+    /**
+    *   \brief Check and scale the last samples of a channel of a circular buffer (e.g., data.channel[c]).
+    *
+    *   Call for each channel of a drain, then #MAX30101_Range_Update once.
+    *   \param[in,out] monitor range monitor.
+    *   \param[in,out] ring samples of the channel, #BUFFER_STORAGE_SIZE long, scaled in place.
+    *   \param[in] head index of the last sample.
+    *   \param[in] num_samples number of samples read by the drain.
+    */
+    void MAX30101_Range_Scale(MAX30101_Range* monitor, uint32_t* ring, uint8_t head, uint8_t num_samples);
+
+    /**
+    *   \brief Select the range after a drain, and write it to the device if it changes.
+    *
+    *   \param[in,out] monitor range monitor.
+    *   \param[in] num_samples number of samples read by the drain.
+    *   \param[in] alc_overflow 1 if ALC_OVF was set in the interrupt status.
+    *   \retval #MAX30101_OK if no error occurred.
+    *   \retval #MAX30101_DEV_NOT_FOUND if device is not present on the I2C bus.
+    *   \retval #MAX30101_ERROR if an error occurred.
+    */
+    uint8_t MAX30101_Range_Update(MAX30101_Range* monitor, uint8_t num_samples, uint8_t alc_overflow);
+
+    /**
+    *   \brief Current range, as #MAX30101_ADC_RANGE_2048 to #MAX30101_ADC_RANGE_16384.
+    */
+    uint8_t MAX30101_Range_Get(const MAX30101_Range* monitor);
+
+#endif
+/* [] END OF FILE */
@@ -0,0 +1,163 @@
+/**
+*   Source file for the achievable rate settings.
+*/
+
+#include "MAX30101_Rate.h"
+#include "MAX30101.h"
+
+//==============================================
+//          MACROS
+//==============================================
+
+/**
+*   \brief Number of pulse widths and of sample rates.
+*/
+#define RATE_PULSE_WIDTHS 4
+#define RATE_SAMPLE_RATES 8
+
+/**
+*   \brief Largest sample averaging setting (32 samples).
+*/
+#define RATE_MAX_AVG 5
+
+/**
+*   \brief Clock cycles of a register read: start, address, register, restart, address, stop.
+*/
+#define RATE_READ_CYCLES (2 * 10 + 9 + 1)
+
+/**
+*   \brief Clock cycles of a byte (8 bits and ACK/NAK).
+*/
+#define RATE_BYTE_CYCLES 9
+
+/**
+*   \brief Bytes of a slot in the FIFO.
+*/
+#define RATE_BYTES_PER_SLOT 3
+
+//==============================================
+//          VARIABLES
+//==============================================
+
+// Sample rates of the rate settings, in samples/s
+static const uint16_t rate_rates[RATE_SAMPLE_RATES] = {50, 100, 200, 400, 800, 1000, 1600, 3200};
+
+// Pulse widths of the pulse width settings, in us
+static const uint16_t rate_pulse_us[RATE_PULSE_WIDTHS] = {69, 118, 215, 411};
+
+// Sample rate of a setting
+uint16_t MAX30101_Rate_SampleRate(uint8_t setting)
+{
+    return rate_rates[setting & (RATE_SAMPLE_RATES - 1)];
+}
+
+// Pulse width of a setting
+uint16_t MAX30101_Rate_PulseWidth(uint8_t setting)
+{
+    return rate_pulse_us[setting & (RATE_PULSE_WIDTHS - 1)];
+}
+
+// Check a combination of slots, sample rate and pulse width
+uint8_t MAX30101_Rate_Check(uint8_t slots, uint8_t sample_rate, uint8_t pulse_width)
+{
+    if ((slots == 0) || (slots > MAX30101_MAX_SLOTS) || (pulse_width >= RATE_PULSE_WIDTHS) ||
+        !MAX30101_RATE_IS_VALID(slots, sample_rate, pulse_width))
+    {
+        return MAX30101_ERROR;
+    }
+    return MAX30101_OK;
+}
+
+// Predict the rates of a setting
+uint8_t MAX30101_Rate_Predict(uint8_t slots, uint8_t spo2_conf, uint8_t sample_avg, uint8_t a_full,
+                              uint32_t clock_hz, MAX30101_RatePlan* plan)
+{
+    uint8_t rate = (spo2_conf >> MAX30101_SAMPLE_RATE_SHIFT) & 0x07;
+    uint8_t avg = (sample_avg >> MAX30101_SAMPLE_AVG_SHIFT) & 0x07;
+    if ((MAX30101_Rate_Check(slots, spo2_conf & (0x07 << MAX30101_SAMPLE_RATE_SHIFT), spo2_conf & 0x03)
+         != MAX30101_OK) ||
+        (avg > RATE_MAX_AVG) || (a_full == 0) || (a_full > 32) || (clock_hz == 0))
+    {
+        return MAX30101_ERROR;
+    }
+
+    plan->spo2_conf = spo2_conf & ((0x07 << MAX30101_SAMPLE_RATE_SHIFT) | 0x03);
+    plan->sample_avg = avg << MAX30101_SAMPLE_AVG_SHIFT;
+    plan->slots = slots;
+    plan->a_full = a_full;
+    plan->adc_rate = rate_rates[rate];
+    plan->rate_mhz = ((uint32_t)rate_rates[rate] * 1000u) >> avg;
+    plan->bytes_per_s = (plan->rate_mhz * slots * RATE_BYTES_PER_SLOT + 999) / 1000;
+
+    // Status, pointers (3 bytes) and FIFO data at each drain, rate / a_full drains per second
+    uint64_t drain_cycles = 3 * RATE_READ_CYCLES +
+                            RATE_BYTE_CYCLES * (1 + 3 + (uint32_t)a_full * slots * RATE_BYTES_PER_SLOT);
+    uint64_t cycles_mhz = drain_cycles * plan->rate_mhz / a_full;
+    uint64_t bus_us = (cycles_mhz * 1000u + clock_hz - 1) / clock_hz;
+    plan->bus_us_per_s = (bus_us > 0xFFFFFFFFu) ? 0xFFFFFFFFu : (uint32_t)bus_us;
+    return (plan->bus_us_per_s < 1000000u) ? MAX30101_OK : MAX30101_ERROR;
+}
+
+// Select the setting of an output rate
+uint8_t MAX30101_Rate_Solve(uint16_t sample_rate, uint8_t slots, uint8_t a_full, uint32_t clock_hz,
+                            MAX30101_RatePlan* plan)
+{
+    uint32_t target_mhz = (uint32_t)sample_rate * 1000u;
+    MAX30101_RatePlan candidate;
+    uint8_t found = 0;
+
+    for (uint8_t rate = 0; rate < RATE_SAMPLE_RATES; rate++)
+    {
+        for (uint8_t pw = 0; pw < RATE_PULSE_WIDTHS; pw++)
+        {
+            for (uint8_t avg = 0; avg <= RATE_MAX_AVG; avg++)
+            {
+                if ((MAX30101_Rate_Predict(slots, (rate << MAX30101_SAMPLE_RATE_SHIFT) | pw,
+                                           avg << MAX30101_SAMPLE_AVG_SHIFT, a_full, clock_hz, &candidate)
+                     != MAX30101_OK) ||
+                    (candidate.rate_mhz < target_mhz))
+                {
+                    continue;
+                }
+                // Closest rate, then longest pulse, then fewest averaged samples
+                if (!found || (candidate.rate_mhz < plan->rate_mhz) ||
+                    ((candidate.rate_mhz == plan->rate_mhz) &&
+                     ((pw > (plan->spo2_conf & 0x03)) ||
+                      ((pw == (plan->spo2_conf & 0x03)) && (candidate.adc_rate < plan->adc_rate)))))
+                {
+                    *plan = candidate;
+                    found = 1;
+                }
+            }
+        }
+    }
+    return found ? MAX30101_OK : MAX30101_ERROR;
+}
+
+// Write the sample rate, pulse width and averaging of a setting
+uint8_t MAX30101_Rate_Apply(const MAX30101_RatePlan* plan)
+{
+    if ((MAX30101_Rate_Check(plan->slots, plan->spo2_conf & (0x07 << MAX30101_SAMPLE_RATE_SHIFT),
+                             plan->spo2_conf & 0x03) != MAX30101_OK) ||
+        (((plan->sample_avg >> MAX30101_SAMPLE_AVG_SHIFT) & 0x07) > RATE_MAX_AVG))
+    {
+        return MAX30101_ERROR;
+    }
+    // Lower the sample rate before lengthening the pulse, so that no intermediate setting is invalid
+    uint8_t error = MAX30101_SetSpO2SampleRate(MAX30101_SAMPLE_RATE_50);
+    if (error == MAX30101_OK)
+    {
+        error = MAX30101_SetSpO2PulseWidth(plan->spo2_conf & 0x03);
+    }
+    if (error == MAX30101_OK)
+    {
+        error = MAX30101_SetSpO2SampleRate(plan->spo2_conf & (0x07 << MAX30101_SAMPLE_RATE_SHIFT));
+    }
+    if (error == MAX30101_OK)
+    {
+        error = MAX30101_SetSampleAverage(plan->sample_avg);
+    }
+    return error;
+}
+
+/* [] END OF FILE */
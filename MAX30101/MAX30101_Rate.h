@@ -0,0 +1,148 @@
+/**
+*   \file MAX30101_Rate.h
+*
+*   \brief Achievable combinations of sample rate, averaging and pulse width.
+*
+*   The ADC converts each active slot with the LED on for the pulse
+*   width, so long pulses and many slots limit the sample rate. The
+*   datasheet gives the allowed combinations for one slot (HR mode) and
+*   two slots (SpO2 mode); with a setting that is not allowed the device
+*   does not reach the requested rate (see MAX30101_RateTesting). For
+*   three and four slots (Multi-LED mode) the limits are extrapolated
+*   with the time per slot of SpO2 mode: sample rate x slots at most
+*   twice the highest SpO2 rate of the pulse width.
+*
+*   Highest sample rate, in samples/s:
+*   | Slots | 69 us | 118 us | 215 us | 411 us |
+*   |-------|-------|--------|--------|--------|
+*   | 1     | 3200  | 1600   | 1600   | 1000   |
+*   | 2     | 1600  | 1000   | 800    | 400    |
+*   | 3     | 1000  | 400    | 400    | 200    |
+*   | 4     | 800   | 400    | 400    | 200    |
+*
+*   The output rate is the sample rate over the averaged samples.
+*   #MAX30101_Rate_Solve selects, for a target output rate, the setting
+*   with the closest output rate at or above the target, then the
+*   longest pulse width (full resolution), then the fewest averaged
+*   samples (lowest ADC rate, lowest LED power). It predicts the output
+*   rate and the I2C bus time needed to drain the FIFO. Invalid settings
+*   are refused by #MAX30101_Rate_Check and #MAX30101_Rate_Apply, and at
+*   compile time for MAX30101_FixedConfig.h with #MAX30101_RATE_IS_VALID.
+*/
+
+#ifndef __MAX30101_RATE_H__
+    #define __MAX30101_RATE_H__
+
+    #include "cytypes.h"
+    #include "MAX30101_Defs.h"
+
+    /**
+    *   \brief Highest sample rate setting (0 for 50 to 7 for 3200) of each pulse width, one nibble each, for 1 to 4 slots.
+    */
+    #define MAX30101_RATE_LIMITS_1 0x5667
+    #define MAX30101_RATE_LIMITS_2 0x3456
+    #define MAX30101_RATE_LIMITS_3 0x2335
+    #define MAX30101_RATE_LIMITS_4 0x2334
+
+    /**
+    *   \brief Highest sample rate setting for a number of slots (1 to 4) and a pulse width setting.
+    */
+    #define MAX30101_RATE_MAX_SETTING(slots, pw) \
+        (((((slots) <= 1) ? MAX30101_RATE_LIMITS_1 : ((slots) == 2) ? MAX30101_RATE_LIMITS_2 : \
+           ((slots) == 3) ? MAX30101_RATE_LIMITS_3 : MAX30101_RATE_LIMITS_4) >> (4 * (pw))) & 0x0F)
+
+    /**
+    *   \brief 1 if the sample rate (#MAX30101_SAMPLE_RATE_50 to #MAX30101_SAMPLE_RATE_3200) is allowed, usable in #if.
+    */
+    #define MAX30101_RATE_IS_VALID(slots, sample_rate, pw) \
+        ((((sample_rate) >> MAX30101_SAMPLE_RATE_SHIFT) & 0x07) <= MAX30101_RATE_MAX_SETTING(slots, pw))
+
+    /**
+    *   \brief Acquisition setting and its predicted rates.
+    */
+    typedef struct
+    {
+        uint8_t spo2_conf;      ///< Sample rate and pulse width (#MAX30101_SPO2_CONF without the ADC range).
+        uint8_t sample_avg;     ///< Sample averaging (#MAX30101_SAMPLE_AVG_1 to #MAX30101_SAMPLE_AVG_32).
+        uint8_t slots;          ///< Active slots (1 to 4).
+        uint8_t a_full;         ///< Unread samples at each FIFO drain (1 to 32).
+        uint16_t adc_rate;      ///< ADC sample rate, in samples/s.
+        uint32_t rate_mhz;      ///< Output rate, in mHz.
+        uint32_t bytes_per_s;   ///< FIFO bytes per second.
+        uint32_t bus_us_per_s;  ///< I2C bus time per second to drain the FIFO, in us.
+    } MAX30101_RatePlan;
+
+    /**
+    *   \brief Sample rate of a setting.
+    *
+    *   \param[in] setting sample rate field of #MAX30101_SPO2_CONF (0 for 50 to 7 for 3200 samples/s).
+    *   \return sample rate, in samples/s.
+    */
+    uint16_t MAX30101_Rate_SampleRate(uint8_t setting);
+
+    /**
+    *   \brief Pulse width of a setting.
+    *
+    *   \param[in] setting pulse width field of #MAX30101_SPO2_CONF (0 for 69 to 3 for 411 us).
+    *   \return pulse width, in us.
+    */
+    uint16_t MAX30101_Rate_PulseWidth(uint8_t setting);
+
+    /**
+    *   \brief Check a combination of slots, sample rate and pulse width.
+    *
+    *   \param[in] slots active slots (1 for HR mode, 2 for SpO2 mode, 1 to 4 in Multi-LED mode).
+    *   \param[in] sample_rate #MAX30101_SAMPLE_RATE_50 to #MAX30101_SAMPLE_RATE_3200.
+    *   \param[in] pulse_width #MAX30101_PULSEWIDTH_69 to #MAX30101_PULSEWIDTH_411.
+    *   \retval #MAX30101_OK if the datasheet allows it.
+    *   \retval #MAX30101_ERROR otherwise.
+    */
+    uint8_t MAX30101_Rate_Check(uint8_t slots, uint8_t sample_rate, uint8_t pulse_width);
+
+    /**
+    *   \brief Predict the rates of a setting.
+    *
+    *   The bus time counts, for each drain of a_full samples, the reads of
+    *   #MAX30101_INT_ST_1 and of the FIFO pointers and a single burst of
+    *   FIFO data (as the example firmware), with 9 clock cycles per byte
+    *   and one per start and stop condition.
+    *   \param[in] slots active slots (1 to 4).
+    *   \param[in] spo2_conf sample rate and pulse width (#MAX30101_SPO2_CONF, the ADC range is ignored).
+    *   \param[in] sample_avg #MAX30101_SAMPLE_AVG_1 to #MAX30101_SAMPLE_AVG_32.
+    *   \param[in] a_full unread samples at each drain (1 to 32).
+    *   \param[in] clock_hz I2C clock frequency (e.g., 400000).
+    *   \param[out] plan setting and predicted rates.
+    *   \retval #MAX30101_OK if the setting is valid and the bus can drain the FIFO.
+    *   \retval #MAX30101_ERROR otherwise.
+    */
+    uint8_t MAX30101_Rate_Predict(uint8_t slots, uint8_t spo2_conf, uint8_t sample_avg, uint8_t a_full,
+                                  uint32_t clock_hz, MAX30101_RatePlan* plan);
+
+    /**
+    *   \brief Select the setting of an output rate.
+    *
+    *   \param[in] sample_rate target output rate, in samples/s.
+    *   \param[in] slots active slots (1 to 4).
+    *   \param[in] a_full unread samples at each drain (1 to 32).
+    *   \param[in] clock_hz I2C clock frequency (e.g., 400000).
+    *   \param[out] plan selected setting and predicted rates.
+    *   \retval #MAX30101_OK if a setting reaches the target.
+    *   \retval #MAX30101_ERROR otherwise (target too high for the slots or the bus).
+    */
+    uint8_t MAX30101_Rate_Solve(uint16_t sample_rate, uint8_t slots, uint8_t a_full, uint32_t clock_hz,
+                                MAX30101_RatePlan* plan);
+
+    /**
+    *   \brief Write sample rate, pulse width and averaging of a setting.
+    *
+    *   The mode and the slots must already be set for plan->slots; the ADC
+    *   range and the other FIFO settings are not changed.
+    *   \param[in] plan setting.
+    *   \retval #MAX30101_OK if no error occurred.
+    *   \retval #MAX30101_DEV_NOT_FOUND if device is not present on the I2C bus.
+    *   \retval #MAX30101_ERROR if the setting is not valid, nothing is written.
+    */
+    uint8_t MAX30101_Rate_Apply(const MAX30101_RatePlan* plan);
+
+#endif
+/* [] END OF FILE */
@@ -0,0 +1,192 @@
+/**
+*   Source file for the run-to-completion scheduler.
+*/
+
+#include "MAX30101_Scheduler.h"
+#include "MAX30101.h"
+#include "CyLib.h"
+#include "string.h"
+
+#if ((MAX30101_SCHED_QUEUE_SIZE & (MAX30101_SCHED_QUEUE_SIZE - 1)) != 0) || (MAX30101_SCHED_QUEUE_SIZE > 128)
+    #error "MAX30101_SCHED_QUEUE_SIZE must be a power of 2, up to 128"
+#endif
+
+//==============================================
+//          TYPES
+//==============================================
+
+/**
+*   \brief A pending event.
+*/
+typedef struct
+{
+    MAX30101_Task task;     ///< Task to run.
+    uint32_t arg;           ///< Argument of the task.
+    uint32_t posted;        ///< Time of the post.
+    uint32_t deadline;      ///< Maximum latency, 0 if none.
+} MAX30101_SchedEvent;
+
+/**
+*   \brief Queue of a priority.
+*/
+typedef struct
+{
+    MAX30101_SchedEvent events[MAX30101_SCHED_QUEUE_SIZE];
+    uint8_t head;   ///< Next event to run.
+    uint8_t count;  ///< Number of pending events.
+} MAX30101_SchedQueue;
+
+//==============================================
+//          VARIABLES
+//==============================================
+static MAX30101_SchedQueue sched_queues[MAX30101_SCHED_PRIORITIES];
+static MAX30101_SchedStats sched_stats[MAX30101_SCHED_PRIORITIES];
+static volatile uint16_t sched_pending = 0;
+static uint32_t (*sched_get_time)(void) = NULL;
+static void (*sched_idle)(void) = NULL;
+
+// Clear queues and statistics
+void MAX30101_Sched_Init(uint32_t (*get_time)(void), void (*idle)(void))
+{
+    uint8 interrupts = CyEnterCriticalSection();
+    memset(sched_queues, 0, sizeof(sched_queues));
+    memset(sched_stats, 0, sizeof(sched_stats));
+    sched_pending = 0;
+    sched_get_time = get_time;
+    sched_idle = idle;
+    CyExitCriticalSection(interrupts);
+}
+
+// Queue an event
+uint8_t MAX30101_Sched_Post(uint8_t priority, MAX30101_Task task, uint32_t arg, uint32_t deadline)
+{
+    if ((priority >= MAX30101_SCHED_PRIORITIES) || (task == NULL))
+    {
+        return MAX30101_ERROR;
+    }
+    uint32_t now = (sched_get_time != NULL) ? sched_get_time() : 0;
+
+    uint8_t error = MAX30101_OK;
+    uint8 interrupts = CyEnterCriticalSection();
+    MAX30101_SchedQueue* queue = &sched_queues[priority];
+    if (queue->count == MAX30101_SCHED_QUEUE_SIZE)
+    {
+        sched_stats[priority].dropped++;
+        error = MAX30101_ERROR;
+    }
+    else
+    {
+        MAX30101_SchedEvent* event = &queue->events[(queue->head + queue->count) & (MAX30101_SCHED_QUEUE_SIZE - 1)];
+        event->task = task;
+        event->arg = arg;
+        event->posted = now;
+        event->deadline = deadline;
+        queue->count++;
+        sched_pending++;
+    }
+    CyExitCriticalSection(interrupts);
+    return error;
+}
+
+// Run oldest event of the highest priority
+uint8_t MAX30101_Sched_RunOnce(void)
+{
+    if (sched_pending == 0)
+    {
+        return 0;
+    }
+
+    MAX30101_SchedEvent event;
+    uint8_t priority;
+    uint8 interrupts = CyEnterCriticalSection();
+    for (priority = 0; priority < MAX30101_SCHED_PRIORITIES; priority++)
+    {
+        MAX30101_SchedQueue* queue = &sched_queues[priority];
+        if (queue->count > 0)
+        {
+            event = queue->events[queue->head];
+            queue->head = (queue->head + 1) & (MAX30101_SCHED_QUEUE_SIZE - 1);
+            queue->count--;
+            sched_pending--;
+            break;
+        }
+    }
+    CyExitCriticalSection(interrupts);
+    if (priority == MAX30101_SCHED_PRIORITIES)
+    {
+        return 0;
+    }
+
+    uint32_t start = (sched_get_time != NULL) ? sched_get_time() : 0;
+    event.task(event.arg);
+    uint32_t end = (sched_get_time != NULL) ? sched_get_time() : 0;
+
+    // Unsigned differences are correct also when the time wraps
+    MAX30101_SchedStats* stats = &sched_stats[priority];
+    uint32_t latency = start - event.posted;
+    stats->runs++;
+    if (latency > stats->max_latency)
+    {
+        stats->max_latency = latency;
+    }
+    if (end - start > stats->max_run)
+    {
+        stats->max_run = end - start;
+    }
+    if ((event.deadline != MAX30101_SCHED_NO_DEADLINE) && (latency > event.deadline))
+    {
+        stats->missed++;
+    }
+    return 1;
+}
+
+// Go idle if nothing is pending
+void MAX30101_Sched_Idle(void)
+{
+    // An interrupt between the check and the idle function would be missed
+    // until the next one: check with interrupts disabled. WFI still wakes
+    // up on the pending interrupt, which runs after the critical section.
+    uint8 interrupts = CyEnterCriticalSection();
+    if ((sched_pending == 0) && (sched_idle != NULL))
+    {
+        sched_idle();
+    }
+    CyExitCriticalSection(interrupts);
+}
+
+// Run forever
+void MAX30101_Sched_Run(void)
+{
+    for (;;)
+    {
+        if (MAX30101_Sched_RunOnce() == 0)
+        {
+            MAX30101_Sched_Idle();
+        }
+    }
+}
+
+// Number of pending events
+uint16_t MAX30101_Sched_Pending(void)
+{
+    return sched_pending;
+}
+
+// Get statistics of a priority
+void MAX30101_Sched_GetStats(uint8_t priority, MAX30101_SchedStats* stats)
+{
+    if (priority < MAX30101_SCHED_PRIORITIES)
+    {
+        *stats = sched_stats[priority];
+    }
+}
+
+// Clear statistics
+void MAX30101_Sched_ResetStats(void)
+{
+    uint8 interrupts = CyEnterCriticalSection();
+    memset(sched_stats, 0, sizeof(sched_stats));
+    CyExitCriticalSection(interrupts);
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,140 @@
+/**
+*   \file MAX30101_Scheduler.h
+*
+*   \brief Run-to-completion scheduler with prioritised event queues.
+*
+*   Work is split in short tasks, posted as events from interrupts or
+*   from other tasks. Each priority has its own queue; the scheduler
+*   always runs the oldest event of the highest non empty priority, so
+*   that a FIFO drain waits at most for the task being run, not for all
+*   the work of the main loop (e.g., a long UART print).
+*
+*   Tasks are never preempted by other tasks: keep them short and post a
+*   new event to continue long work. When no event is pending the idle
+*   function (e.g., WFI) is called with interrupts disabled, so that an
+*   event posted by an interrupt just before going idle is not missed.
+*
+*   For each priority the scheduler records the number of runs, the
+*   longest wait between post and start (latency), the longest run and
+*   the events started after their deadline. Times are in the unit of
+*   the time function given to #MAX30101_Sched_Init.
+*/
+
+#ifndef __MAX30101_SCHEDULER_H__
+    #define __MAX30101_SCHEDULER_H__
+
+    #include "cytypes.h"
+
+    //==============================================
+    //           PRIORITIES
+    //==============================================
+    /**
+    *   \brief Read of the sensor FIFO, highest priority.
+    */
+    #define MAX30101_SCHED_DRAIN        0
+
+    /**
+    *   \brief Signal processing.
+    */
+    #define MAX30101_SCHED_PROCESS      1
+
+    /**
+    *   \brief Output of the results.
+    */
+    #define MAX30101_SCHED_TELEMETRY    2
+
+    /**
+    *   \brief Background work, lowest priority.
+    */
+    #define MAX30101_SCHED_HOUSEKEEPING 3
+
+    /**
+    *   \brief Number of priorities.
+    */
+    #define MAX30101_SCHED_PRIORITIES   4
+
+    /**
+    *   \brief Number of pending events per priority (power of 2).
+    */
+    #ifndef MAX30101_SCHED_QUEUE_SIZE
+        #define MAX30101_SCHED_QUEUE_SIZE 8
+    #endif
+
+    /**
+    *   \brief No deadline for an event.
+    */
+    #define MAX30101_SCHED_NO_DEADLINE 0
+
+    /**
+    *   \brief A task, called with the argument of its event.
+    */
+    typedef void (*MAX30101_Task)(uint32_t arg);
+
+    /**
+    *   \brief Statistics of a priority.
+    */
+    typedef struct
+    {
+        uint32_t runs;          ///< Number of events run.
+        uint32_t max_latency;   ///< Longest time between post and start.
+        uint32_t max_run;       ///< Longest run.
+        uint32_t missed;        ///< Events started after their deadline.
+        uint32_t dropped;       ///< Events not posted because the queue was full.
+    } MAX30101_SchedStats;
+
+    /**
+    *   \brief Clear queues and statistics.
+    *
+    *   \param[in] get_time time function (e.g., #MAX30101_Profile_Now, DWT cycle counter).
+    *   \param[in] idle function called when no event is pending, with interrupts
+    *              disabled; it must return when an interrupt is pending (e.g., WFI).
+    *              NULL to return immediately.
+    */
+    void MAX30101_Sched_Init(uint32_t (*get_time)(void), void (*idle)(void));
+
+    /**
+    *   \brief Post an event. Can be called from interrupts.
+    *
+    *   \param[in] priority priority of the event (#MAX30101_SCHED_DRAIN to #MAX30101_SCHED_HOUSEKEEPING).
+    *   \param[in] task task to run.
+    *   \param[in] arg argument of the task.
+    *   \param[in] deadline maximum time between post and start, #MAX30101_SCHED_NO_DEADLINE if none.
+    *   \retval #MAX30101_OK if the event was queued.
+    *   \retval #MAX30101_ERROR if the queue is full or priority is not valid.
+    */
+    uint8_t MAX30101_Sched_Post(uint8_t priority, MAX30101_Task task, uint32_t arg, uint32_t deadline);
+
+    /**
+    *   \brief Run the next event, if any.
+    *
+    *   \return 1 if an event was run, 0 if no event was pending.
+    */
+    uint8_t MAX30101_Sched_RunOnce(void);
+
+    /**
+    *   \brief Call the idle function if no event is pending.
+    */
+    void MAX30101_Sched_Idle(void);
+
+    /**
+    *   \brief Run events forever, going idle when none is pending.
+    */
+    void MAX30101_Sched_Run(void);
+
+    /**
+    *   \brief Number of pending events of all the priorities.
+    */
+    uint16_t MAX30101_Sched_Pending(void);
+
+    /**
+    *   \brief Get the statistics of a priority.
+    */
+    void MAX30101_Sched_GetStats(uint8_t priority, MAX30101_SchedStats* stats);
+
+    /**
+    *   \brief Clear the statistics of all the priorities.
+    */
+    void MAX30101_Sched_ResetStats(void);
+
+#endif
+/* [] END OF FILE */
@@ -0,0 +1,112 @@
+/**
+*   Source file for the low power idle.
+*/
+
+#include "MAX30101_Sleep.h"
+#include "CyLib.h"
+#include "cyPm.h"
+#include "string.h"
+
+//==============================================
+//          VARIABLES
+//==============================================
+static MAX30101_SleepConfig sleep_config = { .mode = MAX30101_SLEEP_NONE };
+static MAX30101_SleepStats sleep_stats = { .min_free = 32 };
+
+// Set configuration
+void MAX30101_Sleep_Init(const MAX30101_SleepConfig* config)
+{
+    sleep_config = *config;
+    MAX30101_Sleep_ResetStats();
+}
+
+// Go idle until the next interrupt
+void MAX30101_Sleep_Idle(void)
+{
+    switch (sleep_config.mode)
+    {
+        case MAX30101_SLEEP_WFI:
+            sleep_stats.sleeps++;
+            CY_PM_WFI;
+            break;
+        case MAX30101_SLEEP_ALT_ACTIVE:
+            sleep_stats.sleeps++;
+            CyPmAltAct(PM_ALT_ACT_TIME_NONE, PM_ALT_ACT_SRC_PICU);
+            break;
+        case MAX30101_SLEEP_SLEEP:
+        {
+            sleep_stats.sleeps++;
+            if (sleep_config.prepare != NULL)
+            {
+                sleep_config.prepare();
+            }
+            CyPmSaveClocks();
+            CyPmSleep(PM_SLEEP_TIME_NONE, PM_SLEEP_SRC_PICU);
+            // The time function runs again from here
+            uint32_t wake = (sleep_config.get_time != NULL) ? sleep_config.get_time() : 0;
+            CyPmRestoreClocks();
+            if (sleep_config.restore != NULL)
+            {
+                sleep_config.restore();
+            }
+            uint32_t restore = (sleep_config.get_time != NULL) ? sleep_config.get_time() - wake : 0;
+            if (restore > sleep_stats.max_restore)
+            {
+                sleep_stats.max_restore = restore;
+            }
+            break;
+        }
+        default:
+            break;
+    }
+}
+
+// Record FIFO state at a drain
+void MAX30101_Sleep_RecordDrain(uint8_t unread, uint8_t overflow, uint32_t latency)
+{
+    uint8_t free_slots = (unread < 32) ? 32 - unread : 0;
+    sleep_stats.drains++;
+    if (free_slots < sleep_stats.min_free)
+    {
+        sleep_stats.min_free = free_slots;
+    }
+    sleep_stats.overflows += overflow;
+    if (latency > sleep_stats.max_latency)
+    {
+        sleep_stats.max_latency = latency;
+    }
+    if ((sleep_config.budget != 0) && (latency > sleep_config.budget))
+    {
+        sleep_stats.late++;
+    }
+}
+
+// Get statistics
+void MAX30101_Sleep_GetStats(MAX30101_SleepStats* stats)
+{
+    uint8 interrupts = CyEnterCriticalSection();
+    *stats = sleep_stats;
+    CyExitCriticalSection(interrupts);
+}
+
+// Clear statistics
+void MAX30101_Sleep_ResetStats(void)
+{
+    uint8 interrupts = CyEnterCriticalSection();
+    memset(&sleep_stats, 0, sizeof(sleep_stats));
+    sleep_stats.min_free = 32;
+    CyExitCriticalSection(interrupts);
+}
+
+// Time from the almost full interrupt to the first lost sample
+uint32_t MAX30101_Sleep_Budget(uint16_t sample_rate, uint8_t a_full)
+{
+    if ((sample_rate == 0) || (a_full > 32))
+    {
+        return 0;
+    }
+    // The sample after the last free slot is lost
+    return (uint32_t)(32 - a_full + 1) * 1000000u / sample_rate;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,126 @@
+/**
+*   \file MAX30101_Sleep.h
+*
+*   \brief Low power idle between FIFO interrupts.
+*
+*   #MAX30101_Sleep_Idle is the idle function of the scheduler (see
+*   MAX30101_Scheduler.h): it is called with interrupts disabled when no
+*   event is pending and returns after the next interrupt. Depending on
+*   the mode it returns at once, gates the CPU clock (WFI), or enters
+*   the PSoC alternate active or sleep mode, woken up by the port
+*   interrupt (PICU) of the MAX30101_INT pin.
+*
+*   Waking up from sleep takes time: the hardware wake-up (see the PSoC
+*   datasheet), then the clocks and the components stopped before
+*   sleeping are restored. The restore time is measured with the time
+*   function; the cycle counter does not run while the CPU sleeps, so
+*   the hardware wake-up is not included.
+*
+*   To confirm that the wake-up never costs samples, the drain task
+*   reports the unread samples, the overflow counter it finds and the
+*   time since the interrupt with #MAX30101_Sleep_RecordDrain: the fewest
+*   free FIFO slots is the margin left at the almost full threshold, any
+*   overflow is counted, and so is any drain started later than the
+*   budget of the configuration (#MAX30101_Sleep_Budget gives the time
+*   available to start the drain). The time since the interrupt is taken
+*   in the interrupt handler, so the hardware wake-up is not included.
+*/
+
+#ifndef __MAX30101_SLEEP_H__
+    #define __MAX30101_SLEEP_H__
+
+    #include "cytypes.h"
+
+    //==============================================
+    //           IDLE MODES
+    //==============================================
+    /**
+    *   \brief Return at once: the scheduler busy polls.
+    */
+    #define MAX30101_SLEEP_NONE         0
+
+    /**
+    *   \brief Gate the CPU clock until the next interrupt (WFI).
+    */
+    #define MAX30101_SLEEP_WFI          1
+
+    /**
+    *   \brief Alternate active mode: CPU off, peripherals clocked, wake-up on the INT pin.
+    */
+    #define MAX30101_SLEEP_ALT_ACTIVE   2
+
+    /**
+    *   \brief Sleep mode: clocks off, wake-up on the INT pin.
+    */
+    #define MAX30101_SLEEP_SLEEP        3
+
+    /**
+    *   \brief Idle configuration.
+    */
+    typedef struct
+    {
+        uint8_t mode;               ///< Idle mode (#MAX30101_SLEEP_NONE to #MAX30101_SLEEP_SLEEP).
+        void (*prepare)(void);      ///< Put components to sleep before #MAX30101_SLEEP_SLEEP (e.g., UART_Debug_Sleep), NULL if none.
+        void (*restore)(void);      ///< Wake components up after #MAX30101_SLEEP_SLEEP (e.g., UART_Debug_Wakeup), NULL if none.
+        uint32_t (*get_time)(void); ///< Time function, NULL not to measure the restore time.
+        uint32_t budget;            ///< Longest time from the interrupt to the drain, in units of get_time (see #MAX30101_Sleep_Budget), 0 not to check.
+    } MAX30101_SleepConfig;
+
+    /**
+    *   \brief Idle statistics.
+    */
+    typedef struct
+    {
+        uint32_t sleeps;        ///< Times the device went idle.
+        uint32_t max_restore;   ///< Longest restore of clocks and components after sleep.
+        uint32_t drains;        ///< Drains recorded.
+        uint8_t min_free;       ///< Fewest free FIFO slots at a drain.
+        uint32_t overflows;     ///< Samples lost (sum of the overflow counters).
+        uint32_t max_latency;   ///< Longest time from the interrupt to a drain.
+        uint32_t late;          ///< Drains started after the budget.
+    } MAX30101_SleepStats;
+
+    /**
+    *   \brief Set the idle configuration and clear the statistics.
+    *
+    *   \param[in] config idle configuration, copied.
+    */
+    void MAX30101_Sleep_Init(const MAX30101_SleepConfig* config);
+
+    /**
+    *   \brief Go idle until the next interrupt. Call with interrupts disabled.
+    */
+    void MAX30101_Sleep_Idle(void);
+
+    /**
+    *   \brief Record the state of the FIFO found by a drain.
+    *
+    *   \param[in] unread unread samples (0 to 32).
+    *   \param[in] overflow overflow counter.
+    *   \param[in] latency time from the interrupt to the drain, in units of the time function.
+    */
+    void MAX30101_Sleep_RecordDrain(uint8_t unread, uint8_t overflow, uint32_t latency);
+
+    /**
+    *   \brief Get the idle statistics.
+    */
+    void MAX30101_Sleep_GetStats(MAX30101_SleepStats* stats);
+
+    /**
+    *   \brief Clear the idle statistics.
+    */
+    void MAX30101_Sleep_ResetStats(void);
+
+    /**
+    *   \brief Time between the almost full interrupt and the first sample lost.
+    *
+    *   The first sample must be read before this time; afterwards each sample
+    *   must be read within a sample period.
+    *   \param[in] sample_rate output sample rate, in samples/s.
+    *   \param[in] a_full unread samples at the almost full interrupt (17 to 32).
+    *   \return time in us.
+    */
+    uint32_t MAX30101_Sleep_Budget(uint16_t sample_rate, uint8_t a_full);
+
+#endif
+/* [] END OF FILE */
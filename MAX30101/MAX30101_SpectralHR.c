@@ -0,0 +1,279 @@
+/**
+*   Source file for the spectral heart rate estimator.
+*/
+
+#include "MAX30101_SpectralHR.h"
+#include "MAX30101.h"
+#include "MAX30101_Stats.h"
+#include "string.h"
+
+//==============================================
+//          MACROS
+//==============================================
+
+/**
+*   \brief Largest high-passed sample, so that a product with the cosine table fits in 32 bits.
+*/
+#define SPECTRAL_CLAMP ((1 << 17) - 1)
+
+/**
+*   \brief Fractional bits of the cosine table.
+*/
+#define SPECTRAL_COS_BITS 14
+
+//==============================================
+//          VARIABLES
+//==============================================
+
+// cos(2 pi i / 256), Q14
+static const int16_t spectral_cos[MAX30101_SPECTRAL_N] = {
+     16384,  16379,  16364,  16340,  16305,  16261,  16207,  16143,  16069,  15986,  15893,  15791,  15679,  15557,  15426,  15286,
+     15137,  14978,  14811,  14635,  14449,  14256,  14053,  13842,  13623,  13395,  13160,  12916,  12665,  12406,  12140,  11866,
+     11585,  11297,  11003,  10702,  10394,  10080,   9760,   9434,   9102,   8765,   8423,   8076,   7723,   7366,   7005,   6639,
+      6270,   5897,   5520,   5139,   4756,   4370,   3981,   3590,   3196,   2801,   2404,   2006,   1606,   1205,    804,    402,
+         0,   -402,   -804,  -1205,  -1606,  -2006,  -2404,  -2801,  -3196,  -3590,  -3981,  -4370,  -4756,  -5139,  -5520,  -5897,
+     -6270,  -6639,  -7005,  -7366,  -7723,  -8076,  -8423,  -8765,  -9102,  -9434,  -9760, -10080, -10394, -10702, -11003, -11297,
+    -11585, -11866, -12140, -12406, -12665, -12916, -13160, -13395, -13623, -13842, -14053, -14256, -14449, -14635, -14811, -14978,
+    -15137, -15286, -15426, -15557, -15679, -15791, -15893, -15986, -16069, -16143, -16207, -16261, -16305, -16340, -16364, -16379,
+    -16384, -16379, -16364, -16340, -16305, -16261, -16207, -16143, -16069, -15986, -15893, -15791, -15679, -15557, -15426, -15286,
+    -15137, -14978, -14811, -14635, -14449, -14256, -14053, -13842, -13623, -13395, -13160, -12916, -12665, -12406, -12140, -11866,
+    -11585, -11297, -11003, -10702, -10394, -10080,  -9760,  -9434,  -9102,  -8765,  -8423,  -8076,  -7723,  -7366,  -7005,  -6639,
+     -6270,  -5897,  -5520,  -5139,  -4756,  -4370,  -3981,  -3590,  -3196,  -2801,  -2404,  -2006,  -1606,  -1205,   -804,   -402,
+         0,    402,    804,   1205,   1606,   2006,   2404,   2801,   3196,   3590,   3981,   4370,   4756,   5139,   5520,   5897,
+      6270,   6639,   7005,   7366,   7723,   8076,   8423,   8765,   9102,   9434,   9760,  10080,  10394,  10702,  11003,  11297,
+     11585,  11866,  12140,  12406,  12665,  12916,  13160,  13395,  13623,  13842,  14053,  14256,  14449,  14635,  14811,  14978,
+     15137,  15286,  15426,  15557,  15679,  15791,  15893,  15986,  16069,  16143,  16207,  16261,  16305,  16340,  16364,  16379,
+};
+
+//==============================================
+//          FUNCTION PROTOTYPES
+//==============================================
+
+static uint8_t MAX30101_SpectralHR_Estimate(MAX30101_SpectralHR* hr);
+
+static uint8_t MAX30101_SpectralHR_FindPeak(const uint64_t* power, uint8_t first, uint8_t last);
+
+static uint16_t MAX30101_SpectralHR_Interpolate(const MAX30101_SpectralHR* hr, const uint64_t* power, uint8_t bin);
+
+static uint8_t MAX30101_SpectralHR_Bin(const MAX30101_SpectralHR* hr, int32_t bpm_x10);
+
+// Initialize estimator
+uint8_t MAX30101_SpectralHR_Init(MAX30101_SpectralHR* hr, uint16_t sample_rate, uint8_t decimation)
+{
+    if ((sample_rate == 0) || (decimation == 0))
+    {
+        return MAX30101_ERROR;
+    }
+    memset(hr, 0, sizeof(*hr));
+    hr->decimation = decimation;
+    hr->rate_mhz = (uint32_t)sample_rate * 1000u / decimation;
+
+    // Bins of the band: k = bpm / 60 * N / rate
+    uint32_t scale = 60u * hr->rate_mhz;
+    uint32_t first = ((uint32_t)MAX30101_SPECTRAL_MIN_BPM * MAX30101_SPECTRAL_N * 1000u + scale - 1) / scale;
+    uint32_t last = (uint32_t)MAX30101_SPECTRAL_MAX_BPM * MAX30101_SPECTRAL_N * 1000u / scale;
+    if ((first == 0) || (last < first) || (last + 1 >= MAX30101_SPECTRAL_N / 2) ||
+        (last - first + 3 > MAX30101_SPECTRAL_MAX_BINS))
+    {
+        return MAX30101_ERROR;
+    }
+    hr->first_bin = first - 1;
+    hr->num_bins = last - first + 3;
+    return MAX30101_OK;
+}
+
+// Add a sample
+uint8_t MAX30101_SpectralHR_Add(MAX30101_SpectralHR* hr, uint32_t sample)
+{
+    hr->sum += sample;
+    if (++hr->count < hr->decimation)
+    {
+        return 0;
+    }
+    int32_t x = hr->sum / hr->decimation;
+    hr->sum = 0;
+    hr->count = 0;
+
+    // High-pass: subtract the baseline, started at the first sample
+    if (hr->filled == 0)
+    {
+        hr->dc = x << 8;
+    }
+    hr->dc += ((x << 8) - hr->dc) >> 4;
+    int32_t ac = x - (hr->dc >> 8);
+    if (ac > SPECTRAL_CLAMP)
+    {
+        ac = SPECTRAL_CLAMP;
+    }
+    else if (ac < -SPECTRAL_CLAMP)
+    {
+        ac = -SPECTRAL_CLAMP;
+    }
+
+    // Add the terms of the new sample, remove those of the sample it replaces.
+    // Both are rounded the same way, so the accumulators are exact.
+    uint16_t pos = hr->pos;
+    int32_t old = hr->window[pos];
+    hr->window[pos] = ac;
+    uint16_t index = (hr->first_bin * pos) & (MAX30101_SPECTRAL_N - 1);
+    for (uint8_t b = 0; b < hr->num_bins; b++)
+    {
+        int32_t c = spectral_cos[index];
+        int32_t s = spectral_cos[(index - MAX30101_SPECTRAL_N / 4) & (MAX30101_SPECTRAL_N - 1)];
+        // x * exp(-j theta) = x cos(theta) - j x sin(theta)
+        hr->re[b] += ((ac * c) >> SPECTRAL_COS_BITS) - ((old * c) >> SPECTRAL_COS_BITS);
+        hr->im[b] -= ((ac * s) >> SPECTRAL_COS_BITS) - ((old * s) >> SPECTRAL_COS_BITS);
+        index = (index + pos) & (MAX30101_SPECTRAL_N - 1);
+    }
+    hr->pos = (pos + 1) & (MAX30101_SPECTRAL_N - 1);
+    if (hr->filled < MAX30101_SPECTRAL_N)
+    {
+        hr->filled++;
+    }
+
+    if ((++hr->since_update < MAX30101_SPECTRAL_UPDATE) || (hr->filled < MAX30101_SPECTRAL_N))
+    {
+        return 0;
+    }
+    hr->since_update = 0;
+    return MAX30101_SpectralHR_Estimate(hr);
+}
+
+// Add a block of samples
+uint8_t MAX30101_SpectralHR_Push(MAX30101_SpectralHR* hr, const uint32_t* samples, uint16_t num_samples)
+{
+    uint8_t updated = 0;
+    for (uint16_t i = 0; i < num_samples; i++)
+    {
+        updated |= MAX30101_SpectralHR_Add(hr, samples[i]);
+    }
+    return updated;
+}
+
+// Locate and track the peak of the spectrum
+static uint8_t MAX30101_SpectralHR_Estimate(MAX30101_SpectralHR* hr)
+{
+    uint64_t power[MAX30101_SPECTRAL_MAX_BINS];
+    uint64_t total = 0;
+
+    // Bin k of the window starting at pos is exp(j k theta) A[k], theta = 2 pi pos / N:
+    // Hann is 0.5 A[k] - 0.25 (exp(-j theta) A[k-1] + exp(j theta) A[k+1]), scaled by 4
+    int64_t c = spectral_cos[hr->pos];
+    int64_t s = spectral_cos[(hr->pos - MAX30101_SPECTRAL_N / 4) & (MAX30101_SPECTRAL_N - 1)];
+    for (uint8_t b = 1; b < hr->num_bins - 1; b++)
+    {
+        int64_t nre = (hr->re[b-1] * c + hr->im[b-1] * s + hr->re[b+1] * c - hr->im[b+1] * s) >> SPECTRAL_COS_BITS;
+        int64_t nim = (hr->im[b-1] * c - hr->re[b-1] * s + hr->im[b+1] * c + hr->re[b+1] * s) >> SPECTRAL_COS_BITS;
+        int64_t hre = 2 * (int64_t)hr->re[b] - nre;
+        int64_t him = 2 * (int64_t)hr->im[b] - nim;
+        power[b] = (uint64_t)(hre * hre) + (uint64_t)(him * him);
+        total += power[b];
+    }
+
+    uint8_t last = hr->num_bins - 2;
+    uint8_t peak = MAX30101_SpectralHR_FindPeak(power, 1, last);
+    uint16_t candidate = MAX30101_SpectralHR_Interpolate(hr, power, peak);
+
+    // Share of the power around the peak
+    uint64_t around = power[peak] + ((peak > 1) ? power[peak-1] : 0) + ((peak < last) ? power[peak+1] : 0);
+    hr->quality = (total >= 100) ? (uint8_t)(around / (total / 100)) : 0;
+    if (hr->quality > 100)
+    {
+        hr->quality = 100;
+    }
+
+    int32_t difference = (int32_t)candidate - hr->bpm_x10;
+    if (!hr->valid)
+    {
+        hr->bpm_x10 = candidate;
+        hr->valid = 1;
+        hr->jumps = 0;
+    }
+    else if ((difference <= MAX30101_SPECTRAL_MAX_JUMP) && (difference >= -MAX30101_SPECTRAL_MAX_JUMP))
+    {
+        hr->bpm_x10 = (hr->bpm_x10 + candidate + 1) / 2;
+        hr->jumps = 0;
+    }
+    else
+    {
+        // A peak near the tracked rate, at least half the magnitude of the highest one
+        uint8_t near = MAX30101_SpectralHR_FindPeak(power,
+                                                    MAX30101_SpectralHR_Bin(hr, hr->bpm_x10 - MAX30101_SPECTRAL_MAX_JUMP),
+                                                    MAX30101_SpectralHR_Bin(hr, hr->bpm_x10 + MAX30101_SPECTRAL_MAX_JUMP));
+        uint8_t is_peak = ((near == 1) || (power[near] >= power[near-1])) &&
+                          ((near == last) || (power[near] >= power[near+1]));
+        if (is_peak && (power[near] >= power[peak] / 4))
+        {
+            hr->bpm_x10 = (hr->bpm_x10 + MAX30101_SpectralHR_Interpolate(hr, power, near) + 1) / 2;
+            hr->jumps = 0;
+        }
+        else if (++hr->jumps >= MAX30101_SPECTRAL_JUMPS)
+        {
+            hr->bpm_x10 = candidate;
+            hr->jumps = 0;
+        }
+    }
+    return 1;
+}
+
+// Highest bin in [first, last]
+static uint8_t MAX30101_SpectralHR_FindPeak(const uint64_t* power, uint8_t first, uint8_t last)
+{
+    uint8_t peak = first;
+    for (uint8_t b = first + 1; b <= last; b++)
+    {
+        if (power[b] > power[peak])
+        {
+            peak = b;
+        }
+    }
+    return peak;
+}
+
+// Rate of a peak, parabolic interpolation of the magnitudes
+static uint16_t MAX30101_SpectralHR_Interpolate(const MAX30101_SpectralHR* hr, const uint64_t* power, uint8_t bin)
+{
+    int32_t delta = 0;
+    if ((bin > 1) && (bin < hr->num_bins - 2))
+    {
+        int64_t a = MAX30101_Sqrt64(power[bin-1]);
+        int64_t b = MAX30101_Sqrt64(power[bin]);
+        int64_t c = MAX30101_Sqrt64(power[bin+1]);
+        int64_t denominator = a - 2 * b + c;
+        if (denominator < 0)
+        {
+            // 0.5 (a - c) / (a - 2b + c), Q8
+            delta = (int32_t)(128 * (a - c) / denominator);
+            if (delta > 128)
+            {
+                delta = 128;
+            }
+            else if (delta < -128)
+            {
+                delta = -128;
+            }
+        }
+    }
+    // bpm x 10 = k * rate * 60 * 10 / N
+    uint64_t k_q8 = (uint64_t)((hr->first_bin + bin) * 256 + delta);
+    return (uint16_t)((k_q8 * hr->rate_mhz * 600u / 1000u + MAX30101_SPECTRAL_N * 128) / (MAX30101_SPECTRAL_N * 256));
+}
+
+// Band bin nearest to a rate
+static uint8_t MAX30101_SpectralHR_Bin(const MAX30101_SpectralHR* hr, int32_t bpm_x10)
+{
+    int32_t k = (int32_t)(((int64_t)bpm_x10 * MAX30101_SPECTRAL_N * 1000 + 300 * (int64_t)hr->rate_mhz) /
+                          (600 * (int64_t)hr->rate_mhz));
+    int32_t bin = k - hr->first_bin;
+    if (bin < 1)
+    {
+        return 1;
+    }
+    if (bin > hr->num_bins - 2)
+    {
+        return hr->num_bins - 2;
+    }
+    return (uint8_t)bin;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,139 @@
+/**
+*   \file MAX30101_SpectralHR.h
+*
+*   \brief Heart rate estimate from the spectrum of a PPG channel.
+*
+*   Samples are decimated (block average), the baseline is removed with
+*   a first order high-pass (about 0.25 Hz at 25 Hz) and the result
+*   feeds a sliding DFT of #MAX30101_SPECTRAL_N samples, computed only
+*   for the bins of the heart rate band (#MAX30101_SPECTRAL_MIN_BPM to
+*   #MAX30101_SPECTRAL_MAX_BPM) and one more bin on each side.
+*
+*   The DFT is modulated: bin k accumulates x[m] * exp(-j 2 pi k m / N)
+*   with m the position of the sample in the window, so each new sample
+*   adds its terms and removes the terms of the sample it replaces. The
+*   terms are rounded the same way when added and when removed, so the
+*   integer accumulators are exact: no damping factor and no drift.
+*
+*   Every #MAX30101_SPECTRAL_UPDATE decimated samples, once the window
+*   is full, the spectrum is Hann windowed (combination of adjacent
+*   bins), the peak is located with parabolic interpolation of the
+*   magnitudes and the estimate is tracked: a peak farther than
+*   #MAX30101_SPECTRAL_MAX_JUMP from the tracked rate (e.g., motion) is
+*   accepted only if no comparable peak is found near the tracked rate
+*   for #MAX30101_SPECTRAL_JUMPS updates.
+*
+*   With a 200 Hz input decimated by 8: 25 Hz, window of 10.24 s, bins
+*   of 5.86 bpm, 35 bins (35 to 234 bpm) and 2 guard bins, an estimate
+*   every 1.28 s.
+*
+*   Memory: sizeof(MAX30101_SpectralHR) is 1436 bytes (window of 256
+*   int32_t, 2 x 48 int32_t accumulators), plus a 512 bytes cosine table
+*   in flash and 384 bytes of stack for an estimate.
+*
+*   Cost on Cortex-M3 (estimated by instruction count: single cycle MUL,
+*   2 cycles per load, 0 wait states): about 30 cycles per bin for each
+*   decimated sample, i.e. about 1100 cycles (46 us at 24 MHz) with 37
+*   bins, 0.2% of the CPU at 25 Hz. An estimate (Hann with 64-bit
+*   products, three square roots, four 64-bit divisions) takes about
+*   5000 cycles (0.2 ms) every 1.28 s.
+*/
+
+#ifndef __MAX30101_SPECTRAL_HR_H__
+    #define __MAX30101_SPECTRAL_HR_H__
+
+    #include "cytypes.h"
+
+    /**
+    *   \brief Window length in decimated samples (size of the cosine table).
+    */
+    #define MAX30101_SPECTRAL_N 256
+
+    /**
+    *   \brief Maximum number of bins, including the two guard bins.
+    */
+    #define MAX30101_SPECTRAL_MAX_BINS 48
+
+    /**
+    *   \brief Heart rate band, in bpm.
+    */
+    #define MAX30101_SPECTRAL_MIN_BPM 30
+    #define MAX30101_SPECTRAL_MAX_BPM 240
+
+    /**
+    *   \brief Decimated samples between two estimates.
+    */
+    #ifndef MAX30101_SPECTRAL_UPDATE
+        #define MAX30101_SPECTRAL_UPDATE 32
+    #endif
+
+    /**
+    *   \brief Largest change of the tracked rate between two estimates, in tenths of bpm.
+    */
+    #ifndef MAX30101_SPECTRAL_MAX_JUMP
+        #define MAX30101_SPECTRAL_MAX_JUMP 150
+    #endif
+
+    /**
+    *   \brief Consecutive estimates far from the tracked rate before it jumps.
+    */
+    #ifndef MAX30101_SPECTRAL_JUMPS
+        #define MAX30101_SPECTRAL_JUMPS 3
+    #endif
+
+    /**
+    *   \brief State of the estimator.
+    */
+    typedef struct
+    {
+        int32_t window[MAX30101_SPECTRAL_N];    ///< Last decimated, high-passed samples.
+        int32_t re[MAX30101_SPECTRAL_MAX_BINS]; ///< Real part of the bins.
+        int32_t im[MAX30101_SPECTRAL_MAX_BINS]; ///< Imaginary part of the bins.
+        uint32_t rate_mhz;      ///< Decimated sample rate, in mHz.
+        uint32_t sum;           ///< Sum of the samples of the current decimation block.
+        int32_t dc;             ///< Baseline, Q8.
+        uint16_t pos;           ///< Position of the next sample in the window.
+        uint16_t filled;        ///< Samples in the window (up to #MAX30101_SPECTRAL_N).
+        uint16_t since_update;  ///< Decimated samples since the last estimate.
+        uint16_t bpm_x10;       ///< Tracked heart rate, in tenths of bpm.
+        uint8_t decimation;     ///< Input samples per decimated sample.
+        uint8_t count;          ///< Samples in the current decimation block.
+        uint8_t first_bin;      ///< Bin of re[0] and im[0] (guard bin).
+        uint8_t num_bins;       ///< Number of bins, including the guard bins.
+        uint8_t valid;          ///< 1 once a rate is tracked.
+        uint8_t jumps;          ///< Consecutive estimates far from the tracked rate.
+        uint8_t quality;        ///< Power of the peak and its neighbours, in % of the band power.
+    } MAX30101_SpectralHR;
+
+    /**
+    *   \brief Initialize the estimator.
+    *
+    *   \param[out] hr estimator.
+    *   \param[in] sample_rate input sample rate, in Hz.
+    *   \param[in] decimation input samples per decimated sample.
+    *   \retval #MAX30101_OK if the band fits in #MAX30101_SPECTRAL_MAX_BINS bins.
+    *   \retval #MAX30101_ERROR otherwise.
+    */
+    uint8_t MAX30101_SpectralHR_Init(MAX30101_SpectralHR* hr, uint16_t sample_rate, uint8_t decimation);
+
+    /**
+    *   \brief Add a sample.
+    *
+    *   \param[in,out] hr estimator.
+    *   \param[in] sample input sample (18 bits).
+    *   \return 1 if a new estimate is available in hr->bpm_x10, 0 otherwise.
+    */
+    uint8_t MAX30101_SpectralHR_Add(MAX30101_SpectralHR* hr, uint32_t sample);
+
+    /**
+    *   \brief Add a block of samples.
+    *
+    *   \param[in,out] hr estimator.
+    *   \param[in] samples input samples.
+    *   \param[in] num_samples number of samples.
+    *   \return 1 if at least a new estimate is available, 0 otherwise.
+    */
+    uint8_t MAX30101_SpectralHR_Push(MAX30101_SpectralHR* hr, const uint32_t* samples, uint16_t num_samples);
+
+#endif
+/* [] END OF FILE */
@@ -0,0 +1,208 @@
+/**
+*   Source file for the sliding window statistics.
+*/
+
+#include "MAX30101_Stats.h"
+#include "MAX30101.h"
+
+//==============================================
+//          FUNCTION PROTOTYPES
+//==============================================
+
+static uint64_t MAX30101_Stats_Spread(const MAX30101_Stats* stats, uint8_t bits);
+
+// Initialize statistics
+uint8_t MAX30101_Stats_Init(MAX30101_Stats* stats, uint16_t window, uint32_t* samples, uint16_t* queues)
+{
+    if ((window == 0) || (window > MAX30101_STATS_MAX_WINDOW) || (samples == NULL) || (queues == NULL))
+    {
+        return MAX30101_ERROR;
+    }
+    stats->samples = samples;
+    stats->min_queue = queues;
+    stats->max_queue = queues + window;
+    stats->window = window;
+    MAX30101_Stats_Reset(stats);
+    return MAX30101_OK;
+}
+
+// Empty the window
+void MAX30101_Stats_Reset(MAX30101_Stats* stats)
+{
+    stats->sum_squares = 0;
+    stats->sum = 0;
+    stats->count = 0;
+    stats->pos = 0;
+    stats->min_head = 0;
+    stats->min_count = 0;
+    stats->max_head = 0;
+    stats->max_count = 0;
+}
+
+// Add a sample
+void MAX30101_Stats_Add(MAX30101_Stats* stats, uint32_t sample)
+{
+    uint16_t window = stats->window;
+    uint16_t pos = stats->pos;
+
+    if (stats->count == window)
+    {
+        // The oldest sample leaves the window, and the deques if at their front
+        uint32_t old = stats->samples[pos];
+        stats->sum -= old;
+        stats->sum_squares -= (uint64_t)old * old;
+        if ((stats->min_count > 0) && (stats->min_queue[stats->min_head] == pos))
+        {
+            stats->min_head = (stats->min_head + 1 == window) ? 0 : stats->min_head + 1;
+            stats->min_count--;
+        }
+        if ((stats->max_count > 0) && (stats->max_queue[stats->max_head] == pos))
+        {
+            stats->max_head = (stats->max_head + 1 == window) ? 0 : stats->max_head + 1;
+            stats->max_count--;
+        }
+    }
+    else
+    {
+        stats->count++;
+    }
+
+    stats->samples[pos] = sample;
+    stats->sum += sample;
+    stats->sum_squares += (uint64_t)sample * sample;
+
+    // Remove from the back the samples that can no longer be the minimum
+    uint16_t back;
+    while (stats->min_count > 0)
+    {
+        back = stats->min_head + stats->min_count - 1;
+        if (back >= window)
+        {
+            back -= window;
+        }
+        if (stats->samples[stats->min_queue[back]] < sample)
+        {
+            break;
+        }
+        stats->min_count--;
+    }
+    back = stats->min_head + stats->min_count;
+    stats->min_queue[(back >= window) ? back - window : back] = pos;
+    stats->min_count++;
+
+    // Remove from the back the samples that can no longer be the maximum
+    while (stats->max_count > 0)
+    {
+        back = stats->max_head + stats->max_count - 1;
+        if (back >= window)
+        {
+            back -= window;
+        }
+        if (stats->samples[stats->max_queue[back]] > sample)
+        {
+            break;
+        }
+        stats->max_count--;
+    }
+    back = stats->max_head + stats->max_count;
+    stats->max_queue[(back >= window) ? back - window : back] = pos;
+    stats->max_count++;
+
+    stats->pos = (pos + 1 == window) ? 0 : pos + 1;
+}
+
+// Add the last samples of a ring
+void MAX30101_Stats_AddRing(MAX30101_Stats* stats, const uint32_t* ring, uint8_t head, uint8_t num_samples)
+{
+    for (uint8_t i = num_samples; i > 0; i--)
+    {
+        MAX30101_Stats_Add(stats, ring[(head + 1 - i) & (BUFFER_STORAGE_SIZE - 1)]);
+    }
+}
+
+// Smallest sample
+uint32_t MAX30101_Stats_Min(const MAX30101_Stats* stats)
+{
+    return (stats->min_count > 0) ? stats->samples[stats->min_queue[stats->min_head]] : 0;
+}
+
+// Largest sample
+uint32_t MAX30101_Stats_Max(const MAX30101_Stats* stats)
+{
+    return (stats->max_count > 0) ? stats->samples[stats->max_queue[stats->max_head]] : 0;
+}
+
+// Mean
+uint32_t MAX30101_Stats_Mean(const MAX30101_Stats* stats)
+{
+    if (stats->count == 0)
+    {
+        return 0;
+    }
+    return (uint32_t)((((uint64_t)stats->sum << MAX30101_STATS_FRAC_BITS) + stats->count / 2) / stats->count);
+}
+
+// Variance
+uint64_t MAX30101_Stats_Variance(const MAX30101_Stats* stats)
+{
+    if (stats->count == 0)
+    {
+        return 0;
+    }
+    return MAX30101_Stats_Spread(stats, MAX30101_STATS_FRAC_BITS) / stats->count;
+}
+
+// Standard deviation
+uint32_t MAX30101_Stats_StdDev(const MAX30101_Stats* stats)
+{
+    if (stats->count == 0)
+    {
+        return 0;
+    }
+    // sqrt of the variance with twice the fractional bits
+    return MAX30101_Sqrt64(MAX30101_Stats_Spread(stats, 2 * MAX30101_STATS_FRAC_BITS) / stats->count);
+}
+
+// Sum of the squared deviations from the mean, sum of squares - sum^2 / count, with bits fractional bits
+static uint64_t MAX30101_Stats_Spread(const MAX30101_Stats* stats, uint8_t bits)
+{
+    // sum < 2^32, its square fits in 64 bits
+    uint64_t square = (uint64_t)stats->sum * stats->sum;
+    uint64_t correction = square / stats->count;
+    uint32_t remainder = (uint32_t)(square - correction * stats->count);
+    if (stats->sum_squares <= correction)
+    {
+        return 0;
+    }
+    // Fractional part of sum^2 / count, rounded
+    uint64_t fraction = (((uint64_t)remainder << bits) + stats->count / 2) / stats->count;
+    uint64_t spread = (stats->sum_squares - correction) << bits;
+    return (spread > fraction) ? spread - fraction : 0;
+}
+
+// Integer square root
+uint32_t MAX30101_Sqrt64(uint64_t value)
+{
+    uint64_t root = 0;
+    uint64_t bit = (uint64_t)1 << 62;
+    while (bit > value)
+    {
+        bit >>= 2;
+    }
+    while (bit != 0)
+    {
+        if (value >= root + bit)
+        {
+            value -= root + bit;
+            root = (root >> 1) + bit;
+        }
+        else
+        {
+            root >>= 1;
+        }
+        bit >>= 2;
+    }
+    return (uint32_t)root;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,148 @@
+/**
+*   \file MAX30101_Stats.h
+*
+*   \brief Minimum, maximum, mean and variance over a sliding window.
+*
+*   Each channel of the sample stream (e.g., data.channel[c] of
+*   #MAX30101_Fixed_Data) gets its own #MAX30101_Stats over its last
+*   samples, updated in constant time per sample whatever the window:
+*   - minimum and maximum: monotonic deques of positions in the window.
+*     A new sample removes from the back the samples it dominates (they
+*     can never be the extreme again), so the front is the extreme; the
+*     front leaves when its sample leaves the window. Each sample enters
+*     and leaves each deque once: amortised O(1), at most window steps
+*     for a single sample (e.g., a new minimum after a ramp down).
+*   - mean and variance: running sum and sum of squares, updated with
+*     the new sample and the sample it replaces. The sums are integers,
+*     so they are exact and never drift.
+*
+*   The window is given by the caller, with its storage (see
+*   #MAX30101_STATS_STORAGE): 8 bytes per sample.
+*
+*   Mean, variance and standard deviation are returned in fixed point,
+*   with #MAX30101_STATS_FRAC_BITS fractional bits. The variance needs a
+*   64-bit division (a few hundred cycles on Cortex-M3): read it when
+*   needed, not for every sample.
+*/
+
+#ifndef __MAX30101_STATS_H__
+    #define __MAX30101_STATS_H__
+
+    #include "cytypes.h"
+
+    /**
+    *   \brief Longest window: the sum of the samples (18 bits) fits in 32 bits.
+    */
+    #define MAX30101_STATS_MAX_WINDOW 16383
+
+    /**
+    *   \brief Fractional bits of mean, variance and standard deviation.
+    */
+    #ifndef MAX30101_STATS_FRAC_BITS
+        #define MAX30101_STATS_FRAC_BITS 4
+    #endif
+
+    /**
+    *   \brief Declare the storage of a window of a given number of samples.
+    *
+    *   \param name prefix of the arrays, passed to #MAX30101_Stats_Init as
+    *       name##_samples and name##_queues.
+    *   \param window number of samples (1 to #MAX30101_STATS_MAX_WINDOW).
+    */
+    #define MAX30101_STATS_STORAGE(name, window) \
+        uint32_t name##_samples[(window)]; \
+        uint16_t name##_queues[2 * (window)]
+
+    /**
+    *   \brief State of the statistics of a channel.
+    */
+    typedef struct
+    {
+        uint32_t* samples;      ///< Samples of the window, circular.
+        uint16_t* min_queue;    ///< Positions of the minimum deque, circular.
+        uint16_t* max_queue;    ///< Positions of the maximum deque, circular.
+        uint64_t sum_squares;   ///< Sum of the squares of the samples of the window.
+        uint32_t sum;           ///< Sum of the samples of the window.
+        uint16_t window;        ///< Number of samples of the window.
+        uint16_t count;         ///< Samples in the window (up to window).
+        uint16_t pos;           ///< Position of the next sample.
+        uint16_t min_head;      ///< Front of the minimum deque.
+        uint16_t min_count;     ///< Positions in the minimum deque.
+        uint16_t max_head;      ///< Front of the maximum deque.
+        uint16_t max_count;     ///< Positions in the maximum deque.
+    } MAX30101_Stats;
+
+    /**
+    *   \brief Initialize the statistics of a channel with an empty window.
+    *
+    *   \param[out] stats statistics.
+    *   \param[in] window number of samples (1 to #MAX30101_STATS_MAX_WINDOW).
+    *   \param[in] samples storage of window samples.
+    *   \param[in] queues storage of 2 x window positions.
+    *   \retval #MAX30101_OK if the window is valid.
+    *   \retval #MAX30101_ERROR otherwise.
+    */
+    uint8_t MAX30101_Stats_Init(MAX30101_Stats* stats, uint16_t window, uint32_t* samples, uint16_t* queues);
+
+    /**
+    *   \brief Empty the window.
+    *
+    *   \param[in,out] stats statistics.
+    */
+    void MAX30101_Stats_Reset(MAX30101_Stats* stats);
+
+    /**
+    *   \brief Add a sample, removing the oldest one when the window is full.
+    *
+    *   \param[in,out] stats statistics.
+    *   \param[in] sample sample (18 bits).
+    */
+    void MAX30101_Stats_Add(MAX30101_Stats* stats, uint32_t sample);
+
+    /**
+    *   \brief Add the last samples of a channel of a circular buffer (e.g., data.channel[c]).
+    *
+    *   \param[in,out] stats statistics.
+    *   \param[in] ring samples of the channel, #BUFFER_STORAGE_SIZE long.
+    *   \param[in] head index of the last sample.
+    *   \param[in] num_samples number of samples, up to #BUFFER_STORAGE_SIZE.
+    */
+    void MAX30101_Stats_AddRing(MAX30101_Stats* stats, const uint32_t* ring, uint8_t head, uint8_t num_samples);
+
+    /**
+    *   \brief Smallest sample of the window, 0 if empty.
+    */
+    uint32_t MAX30101_Stats_Min(const MAX30101_Stats* stats);
+
+    /**
+    *   \brief Largest sample of the window, 0 if empty.
+    */
+    uint32_t MAX30101_Stats_Max(const MAX30101_Stats* stats);
+
+    /**
+    *   \brief Mean of the window, with #MAX30101_STATS_FRAC_BITS fractional bits, 0 if empty.
+    */
+    uint32_t MAX30101_Stats_Mean(const MAX30101_Stats* stats);
+
+    /**
+    *   \brief Variance of the window, with #MAX30101_STATS_FRAC_BITS fractional bits, 0 if empty.
+    */
+    uint64_t MAX30101_Stats_Variance(const MAX30101_Stats* stats);
+
+    /**
+    *   \brief Standard deviation of the window, with #MAX30101_STATS_FRAC_BITS fractional bits, 0 if empty.
+    */
+    uint32_t MAX30101_Stats_StdDev(const MAX30101_Stats* stats);
+
+    /**
+    *   \brief Integer square root of a 64-bit value.
+    *
+    *   Bit by bit, without floating point or division (e.g., standard
+    *   deviation, magnitude of a spectral bin, noise level).
+    *   \param[in] value value.
+    *   \return largest integer whose square is not above value.
+    */
+    uint32_t MAX30101_Sqrt64(uint64_t value);
+
+#endif
+/* [] END OF FILE */
@@ -0,0 +1,144 @@
+/**
+*   Source file for the sample stream with several consumers.
+*/
+
+#include "MAX30101_Stream.h"
+#include "MAX30101.h"
+
+// Initialize an empty stream
+uint8_t MAX30101_Stream_Init(MAX30101_Stream* stream, uint32_t* samples, uint16_t frames, uint8_t channels)
+{
+    if ((samples == NULL) || (frames == 0) || (frames > MAX30101_STREAM_MAX_FRAMES) ||
+        ((frames & (frames - 1)) != 0) || (channels == 0) || (channels > MAX30101_MAX_SLOTS))
+    {
+        return MAX30101_ERROR;
+    }
+    stream->samples = samples;
+    stream->written = 0;
+    stream->frames = frames;
+    stream->channels = channels;
+    for (uint8_t i = 0; i < MAX30101_STREAM_MAX_CONSUMERS; i++)
+    {
+        stream->cursor[i].active = 0;
+    }
+    return MAX30101_OK;
+}
+
+// Register a consumer
+uint8_t MAX30101_Stream_Register(MAX30101_Stream* stream, uint8_t* consumer)
+{
+    for (uint8_t i = 0; i < MAX30101_STREAM_MAX_CONSUMERS; i++)
+    {
+        MAX30101_StreamCursor* cursor = &stream->cursor[i];
+        if (!cursor->active)
+        {
+            cursor->position = stream->written;
+            cursor->overruns = 0;
+            cursor->max_lag = 0;
+            cursor->active = 1;
+            *consumer = i;
+            return MAX30101_OK;
+        }
+    }
+    return MAX30101_ERROR;
+}
+
+// Remove a consumer
+void MAX30101_Stream_Unregister(MAX30101_Stream* stream, uint8_t consumer)
+{
+    if (consumer < MAX30101_STREAM_MAX_CONSUMERS)
+    {
+        stream->cursor[consumer].active = 0;
+    }
+}
+
+// Write a frame
+void MAX30101_Stream_Write(MAX30101_Stream* stream, const uint32_t* frame)
+{
+    uint8_t channels = stream->channels;
+    uint32_t* slot = &stream->samples[(stream->written & (stream->frames - 1)) * channels];
+    for (uint8_t c = 0; c < channels; c++)
+    {
+        slot[c] = frame[c];
+    }
+    // Published once the samples are in place
+    stream->written++;
+}
+
+// Write the last samples of a circular buffer
+void MAX30101_Stream_WriteRing(MAX30101_Stream* stream, const uint32_t* channels, uint8_t head,
+                               uint8_t num_samples)
+{
+    uint8_t num_channels = stream->channels;
+    uint32_t written = stream->written;
+    for (uint8_t i = num_samples; i > 0; i--)
+    {
+        uint8_t index = (head + 1 - i) & (BUFFER_STORAGE_SIZE - 1);
+        uint32_t* slot = &stream->samples[(written & (stream->frames - 1)) * num_channels];
+        for (uint8_t c = 0; c < num_channels; c++)
+        {
+            slot[c] = channels[c * BUFFER_STORAGE_SIZE + index];
+        }
+        written++;
+    }
+    stream->written = written;
+}
+
+// Unread contiguous frames of a consumer
+uint16_t MAX30101_Stream_Peek(MAX30101_Stream* stream, uint8_t consumer, const uint32_t** frames)
+{
+    if ((consumer >= MAX30101_STREAM_MAX_CONSUMERS) || !stream->cursor[consumer].active)
+    {
+        return 0;
+    }
+    MAX30101_StreamCursor* cursor = &stream->cursor[consumer];
+    uint32_t lag = stream->written - cursor->position;
+    if (lag > stream->frames)
+    {
+        // Skip to the oldest frame still in the ring
+        cursor->overruns += lag - stream->frames;
+        cursor->position += lag - stream->frames;
+        lag = stream->frames;
+    }
+    if (lag > cursor->max_lag)
+    {
+        cursor->max_lag = (uint16_t)lag;
+    }
+    uint16_t index = cursor->position & (stream->frames - 1);
+    uint16_t contiguous = stream->frames - index;
+    *frames = &stream->samples[(uint32_t)index * stream->channels];
+    return (lag < contiguous) ? (uint16_t)lag : contiguous;
+}
+
+// Release frames read
+uint8_t MAX30101_Stream_Consume(MAX30101_Stream* stream, uint8_t consumer, uint16_t num_frames)
+{
+    if ((consumer >= MAX30101_STREAM_MAX_CONSUMERS) || !stream->cursor[consumer].active)
+    {
+        return MAX30101_ERROR;
+    }
+    MAX30101_StreamCursor* cursor = &stream->cursor[consumer];
+    // Frames after position + frames overwrite the frames read
+    uint32_t ahead = stream->written - cursor->position;
+    cursor->position += num_frames;
+    if (ahead > stream->frames)
+    {
+        uint32_t lost = ahead - stream->frames;
+        cursor->overruns += (lost < num_frames) ? lost : num_frames;
+        return MAX30101_ERROR;
+    }
+    return MAX30101_OK;
+}
+
+// Unread frames of a consumer
+uint16_t MAX30101_Stream_Lag(const MAX30101_Stream* stream, uint8_t consumer)
+{
+    if ((consumer >= MAX30101_STREAM_MAX_CONSUMERS) || !stream->cursor[consumer].active)
+    {
+        return 0;
+    }
+    uint32_t lag = stream->written - stream->cursor[consumer].position;
+    return (lag > stream->frames) ? stream->frames : (uint16_t)lag;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,162 @@
+/**
+*   \file MAX30101_Stream.h
+*
+*   \brief Sample stream with one producer and several consumers.
+*
+*   The producer writes each frame (one sample of every channel) once in
+*   a ring; each registered consumer (e.g., filters, logger, UART
+*   output) reads it in place through its own cursor, so samples are
+*   never copied per consumer. The producer does not wait for the
+*   consumers: a write costs the same whatever the number of consumers,
+*   and the oldest frame is overwritten when the ring is full.
+*
+*   Cursors and the write position are free-running frame counters. A
+*   consumer more than a ring behind has lost the oldest frames: it is
+*   moved to the oldest frame still in the ring and the frames skipped
+*   are counted as overruns. Its largest lag (unread frames) is also
+*   kept, to size the ring.
+*
+*   A consumer reads with #MAX30101_Stream_Peek, which gives the frames
+*   contiguous in the ring, and releases them with
+*   #MAX30101_Stream_Consume. The producer may run in between (e.g., in
+*   a higher priority task or an interrupt): #MAX30101_Stream_Consume
+*   then reports whether the frames were overwritten while read.
+*
+*   Memory: sizeof(MAX30101_Stream) plus 4 bytes per channel per frame,
+*   for all consumers (see #MAX30101_STREAM_STORAGE).
+*/
+
+#ifndef __MAX30101_STREAM_H__
+    #define __MAX30101_STREAM_H__
+
+    #include "cytypes.h"
+
+    /**
+    *   \brief Maximum number of consumers of a stream.
+    */
+    #ifndef MAX30101_STREAM_MAX_CONSUMERS
+        #define MAX30101_STREAM_MAX_CONSUMERS 8
+    #endif
+
+    /**
+    *   \brief Largest ring, in frames.
+    */
+    #define MAX30101_STREAM_MAX_FRAMES 32768
+
+    /**
+    *   \brief Declare the storage of a ring.
+    *
+    *   \param name name of the array, passed to #MAX30101_Stream_Init.
+    *   \param frames number of frames (power of two, up to #MAX30101_STREAM_MAX_FRAMES).
+    *   \param channels samples per frame (1 to #MAX30101_MAX_SLOTS).
+    */
+    #define MAX30101_STREAM_STORAGE(name, frames, channels) \
+        uint32_t name[(frames) * (channels)]
+
+    /**
+    *   \brief Read position of a consumer.
+    */
+    typedef struct
+    {
+        uint32_t position;      ///< Frames written before the next frame to read.
+        uint32_t overruns;      ///< Frames lost, overwritten before being read.
+        uint16_t max_lag;       ///< Largest number of unread frames seen.
+        uint8_t active;         ///< 1 if registered.
+    } MAX30101_StreamCursor;
+
+    /**
+    *   \brief Ring and consumers of a stream.
+    */
+    typedef struct
+    {
+        uint32_t* samples;      ///< Frames of the ring, channels samples each.
+        volatile uint32_t written;  ///< Frames written since the start.
+        uint16_t frames;        ///< Frames in the ring.
+        uint8_t channels;       ///< Samples per frame.
+        MAX30101_StreamCursor cursor[MAX30101_STREAM_MAX_CONSUMERS]; ///< Consumers.
+    } MAX30101_Stream;
+
+    /**
+    *   \brief Initialize an empty stream without consumers.
+    *
+    *   \param[out] stream stream.
+    *   \param[in] samples storage of frames * channels samples.
+    *   \param[in] frames frames in the ring (power of two, up to #MAX30101_STREAM_MAX_FRAMES).
+    *   \param[in] channels samples per frame (1 to #MAX30101_MAX_SLOTS).
+    *   \retval #MAX30101_OK if the parameters are valid.
+    *   \retval #MAX30101_ERROR otherwise.
+    */
+    uint8_t MAX30101_Stream_Init(MAX30101_Stream* stream, uint32_t* samples, uint16_t frames, uint8_t channels);
+
+    /**
+    *   \brief Register a consumer, which reads the frames written from now on.
+    *
+    *   \param[in,out] stream stream.
+    *   \param[out] consumer identifier of the consumer.
+    *   \retval #MAX30101_OK if registered.
+    *   \retval #MAX30101_ERROR if #MAX30101_STREAM_MAX_CONSUMERS are registered.
+    */
+    uint8_t MAX30101_Stream_Register(MAX30101_Stream* stream, uint8_t* consumer);
+
+    /**
+    *   \brief Remove a consumer.
+    *
+    *   \param[in,out] stream stream.
+    *   \param[in] consumer identifier of the consumer.
+    */
+    void MAX30101_Stream_Unregister(MAX30101_Stream* stream, uint8_t consumer);
+
+    /**
+    *   \brief Write a frame, overwriting the oldest one if the ring is full.
+    *
+    *   \param[in,out] stream stream.
+    *   \param[in] frame one sample per channel.
+    */
+    void MAX30101_Stream_Write(MAX30101_Stream* stream, const uint32_t* frame);
+
+    /**
+    *   \brief Write the last samples of the channels of a circular buffer (e.g., data.channel of #MAX30101_Fixed_Data).
+    *
+    *   \param[in,out] stream stream.
+    *   \param[in] channels first channel of the buffer, #BUFFER_STORAGE_SIZE samples per channel.
+    *   \param[in] head index of the last sample.
+    *   \param[in] num_samples number of samples, up to #BUFFER_STORAGE_SIZE.
+    */
+    void MAX30101_Stream_WriteRing(MAX30101_Stream* stream, const uint32_t* channels, uint8_t head,
+                                   uint8_t num_samples);
+
+    /**
+    *   \brief Unread frames of a consumer that are contiguous in the ring.
+    *
+    *   Frames overwritten before being read are skipped and counted as
+    *   overruns. Call again after #MAX30101_Stream_Consume for the frames
+    *   after the end of the ring.
+    *   \param[in,out] stream stream.
+    *   \param[in] consumer identifier of the consumer.
+    *   \param[out] frames first unread frame (channels samples each).
+    *   \return number of frames at frames, 0 if none.
+    */
+    uint16_t MAX30101_Stream_Peek(MAX30101_Stream* stream, uint8_t consumer, const uint32_t** frames);
+
+    /**
+    *   \brief Release frames read after #MAX30101_Stream_Peek.
+    *
+    *   \param[in,out] stream stream.
+    *   \param[in] consumer identifier of the consumer.
+    *   \param[in] num_frames number of frames read, up to the value returned by #MAX30101_Stream_Peek.
+    *   \retval #MAX30101_OK if the frames were not overwritten while read.
+    *   \retval #MAX30101_ERROR otherwise (counted as overruns).
+    */
+    uint8_t MAX30101_Stream_Consume(MAX30101_Stream* stream, uint8_t consumer, uint16_t num_frames);
+
+    /**
+    *   \brief Number of frames written and not yet read by a consumer, at most the ring.
+    *
+    *   \param[in] stream stream.
+    *   \param[in] consumer identifier of the consumer.
+    *   \return unread frames.
+    */
+    uint16_t MAX30101_Stream_Lag(const MAX30101_Stream* stream, uint8_t consumer);
+
+#endif
+/* [] END OF FILE */
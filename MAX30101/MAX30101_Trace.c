@@ -0,0 +1,201 @@
+/**
+*   Source file for the MAX30101 trace recorder.
+*/
+
+#include "MAX30101_Trace.h"
+#include "MAX30101_Profile.h"
+#include "I2C_Interface.h"
+#include "string.h"
+
+//==============================================
+//          VARIABLES
+//==============================================
+static void (*trace_write_fun)(const uint8_t*, uint8_t) = NULL;
+
+//==============================================
+//          FUNCTION PROTOTYPES
+//==============================================
+
+static void MAX30101_Trace_Send(uint8_t type, const uint8_t* info, uint16_t info_length,
+                                const uint8_t* data, uint16_t data_length);
+
+static uint8_t MAX30101_Trace_Write(const uint8_t* data, uint16_t length, uint8_t sum);
+
+// Start recording
+void MAX30101_Trace_Start(void (*write_fun)(const uint8_t*, uint8_t), uint16_t ticks_per_us)
+{
+    trace_write_fun = write_fun;
+
+    uint8_t info[4] = {MAX30101_TRACE_VERSION, MAX30101_PROFILE_UNIT,
+                       (uint8_t)ticks_per_us, (uint8_t)(ticks_per_us >> 8)};
+    MAX30101_Trace_Send(MAX30101_TRACE_START, info, sizeof(info), NULL, 0);
+
+    MAX30101_SetWriteHook(MAX30101_Trace_RecordConfig);
+}
+
+// Stop recording
+void MAX30101_Trace_Stop(void)
+{
+    MAX30101_SetWriteHook(NULL);
+    trace_write_fun = NULL;
+}
+
+// Read FIFO pointers and data, and record them
+uint8_t MAX30101_Trace_ReadFIFO(uint8_t active_leds, uint8_t a_full, uint8_t* raw, uint8_t* num_samples)
+{
+    // FIFO_WP, OVF_COUNTER and FIFO_RP are contiguous
+    uint8_t pointers[3];
+    *num_samples = 0;
+    if (I2C_Peripheral_ReadRegisterMulti(MAX30101_I2C_ADDRESS, MAX30101_FIFO_WP,
+                                         sizeof(pointers), pointers) != I2C_NO_ERROR)
+    {
+        return MAX30101_DEV_NOT_FOUND;
+    }
+
+    // Equal pointers: full after an A_FULL interrupt or an overflow, empty otherwise
+    uint8_t samples = (pointers[0] - pointers[2]) & 0x1F;
+    if ((samples == 0) && (a_full || (pointers[1] > 0)))
+    {
+        samples = 32;
+    }
+
+    uint8_t error = MAX30101_OK;
+    if (samples > 0)
+    {
+        error = MAX30101_ReadRawFIFOBytes(samples, active_leds, raw);
+    }
+    if (error == MAX30101_OK)
+    {
+        *num_samples = samples;
+        MAX30101_Trace_RecordFIFO(pointers, samples, active_leds, raw);
+    }
+    return error;
+}
+
+// Record FIFO burst
+void MAX30101_Trace_RecordFIFO(const uint8_t* pointers, uint8_t num_samples, uint8_t active_leds, const uint8_t* raw)
+{
+    uint8_t info[MAX30101_TRACE_FIFO_INFO] = {pointers[0], pointers[1], pointers[2], num_samples, active_leds};
+    MAX30101_Trace_Send(MAX30101_TRACE_FIFO, info, sizeof(info), raw, num_samples * active_leds * 3);
+}
+
+// Record register write
+void MAX30101_Trace_RecordConfig(uint8_t reg_addr, uint8_t count, const uint8_t* data)
+{
+    uint8_t info[2] = {reg_addr, count};
+    MAX30101_Trace_Send(MAX30101_TRACE_CONFIG, info, sizeof(info), data, count);
+}
+
+// Encode record in a buffer
+uint16_t MAX30101_Trace_Encode(uint8_t* buffer, uint8_t type, uint32_t time, const uint8_t* info,
+                               uint16_t info_length, const uint8_t* data, uint16_t data_length)
+{
+    uint16_t length = info_length + data_length;
+    uint8_t header[MAX30101_TRACE_HEADER_SIZE] = {
+        MAX30101_TRACE_SYNC, type, (uint8_t)length, (uint8_t)(length >> 8),
+        (uint8_t)time, (uint8_t)(time >> 8), (uint8_t)(time >> 16), (uint8_t)(time >> 24)
+    };
+
+    uint16_t pos = 0;
+    memcpy(&buffer[pos], header, sizeof(header));
+    pos += sizeof(header);
+    memcpy(&buffer[pos], info, info_length);
+    pos += info_length;
+    if (data_length > 0)
+    {
+        memcpy(&buffer[pos], data, data_length);
+        pos += data_length;
+    }
+
+    uint8_t sum = 0;
+    for (uint16_t i = 0; i < pos; i++)
+    {
+        sum += buffer[i];
+    }
+    buffer[pos++] = sum;
+    return pos;
+}
+
+// Get next valid record
+uint8_t MAX30101_Trace_Next(const uint8_t* buffer, uint32_t size, uint32_t* offset, MAX30101_TraceRecord* record)
+{
+    uint32_t pos = *offset;
+    while (pos + MAX30101_TRACE_HEADER_SIZE < size)
+    {
+        const uint8_t* p = &buffer[pos];
+        uint16_t length = p[2] | (p[3] << 8);
+        if ((p[0] != MAX30101_TRACE_SYNC) || (p[1] > MAX30101_TRACE_CONFIG) ||
+            (length > MAX30101_TRACE_MAX_PAYLOAD))
+        {
+            pos++;
+            continue;
+        }
+        if (pos + MAX30101_TRACE_HEADER_SIZE + length >= size)
+        {
+            // Truncated record or false sync near the end of the trace
+            pos++;
+            continue;
+        }
+
+        uint8_t sum = 0;
+        for (uint16_t i = 0; i < MAX30101_TRACE_HEADER_SIZE + length; i++)
+        {
+            sum += p[i];
+        }
+        if (sum != p[MAX30101_TRACE_HEADER_SIZE + length])
+        {
+            pos++;
+            continue;
+        }
+
+        record->type = p[1];
+        record->length = length;
+        record->time = p[4] | ((uint32_t)p[5] << 8) | ((uint32_t)p[6] << 16) | ((uint32_t)p[7] << 24);
+        record->payload = &p[MAX30101_TRACE_HEADER_SIZE];
+        *offset = pos + MAX30101_TRACE_HEADER_SIZE + length + 1;
+        return 1;
+    }
+    *offset = size;
+    return 0;
+}
+
+// Send a record made of a fixed part and a variable part
+static void MAX30101_Trace_Send(uint8_t type, const uint8_t* info, uint16_t info_length,
+                                const uint8_t* data, uint16_t data_length)
+{
+    if (trace_write_fun == NULL)
+    {
+        return;
+    }
+
+    uint16_t length = info_length + data_length;
+    uint32_t time = MAX30101_PROFILE_NOW();
+    uint8_t header[MAX30101_TRACE_HEADER_SIZE] = {
+        MAX30101_TRACE_SYNC, type, (uint8_t)length, (uint8_t)(length >> 8),
+        (uint8_t)time, (uint8_t)(time >> 8), (uint8_t)(time >> 16), (uint8_t)(time >> 24)
+    };
+
+    uint8_t sum = MAX30101_Trace_Write(header, sizeof(header), 0);
+    sum = MAX30101_Trace_Write(info, info_length, sum);
+    sum = MAX30101_Trace_Write(data, data_length, sum);
+    trace_write_fun(&sum, 1);
+}
+
+// Send data in chunks shorter than 256 bytes and update checksum
+static uint8_t MAX30101_Trace_Write(const uint8_t* data, uint16_t length, uint8_t sum)
+{
+    for (uint16_t i = 0; i < length; i++)
+    {
+        sum += data[i];
+    }
+    while (length > 0)
+    {
+        uint8_t chunk = (length > 255) ? 255 : (uint8_t)length;
+        trace_write_fun(data, chunk);
+        data += chunk;
+        length -= chunk;
+    }
+    return sum;
+}
+
+/* [] END OF FILE */
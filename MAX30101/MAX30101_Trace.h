@@ -0,0 +1,175 @@
+/**
+*   \file MAX30101_Trace.h
+*
+*   \brief Recording of raw MAX30101 FIFO traces for offline replay.
+*
+*   A trace is a stream of records with the raw FIFO_DATA bytes, as read
+*   by #MAX30101_ReadRawFIFOBytes, the FIFO pointers read before each
+*   burst and every register write done by the driver (configuration
+*   changes). Each record is time stamped with #MAX30101_PROFILE_NOW, so
+*   that a trace can be fed again through the unpack and processing code
+*   on the host, both at maximum speed and with the original timing.
+*
+*   Record layout, multi-byte fields little endian:
+*   - sync byte (#MAX30101_TRACE_SYNC);
+*   - type (#MAX30101_TRACE_START, #MAX30101_TRACE_FIFO, #MAX30101_TRACE_CONFIG);
+*   - payload length (2 bytes);
+*   - time stamp (4 bytes);
+*   - payload;
+*   - checksum: sum of all the previous bytes of the record, modulo 256.
+*
+*   Payloads:
+*   - #MAX30101_TRACE_START: version, time unit (#MAX30101_PROFILE_UNIT_CYCLES
+*     or #MAX30101_PROFILE_UNIT_NS), ticks per us (2 bytes);
+*   - #MAX30101_TRACE_FIFO: FIFO_WP, OVF_COUNTER, FIFO_RP, number of
+*     samples, active LEDs, raw FIFO bytes;
+*   - #MAX30101_TRACE_CONFIG: first register, number of registers, values.
+*
+*   Sync byte and checksum allow the reader to skip text or corrupted
+*   bytes mixed in the UART stream.
+*/
+
+#ifndef __MAX30101_TRACE_H__
+    #define __MAX30101_TRACE_H__
+
+    #include "cytypes.h"
+    #include "MAX30101.h"
+
+    /**
+    *   \brief First byte of each record.
+    */
+    #define MAX30101_TRACE_SYNC 0xA5
+
+    /**
+    *   \brief Version of the trace format.
+    */
+    #define MAX30101_TRACE_VERSION 1
+
+    /**
+    *   \brief Beginning of a trace.
+    */
+    #define MAX30101_TRACE_START 0
+
+    /**
+    *   \brief Raw FIFO burst with the FIFO pointers read before it.
+    */
+    #define MAX30101_TRACE_FIFO 1
+
+    /**
+    *   \brief Write of one or more contiguous registers.
+    */
+    #define MAX30101_TRACE_CONFIG 2
+
+    /**
+    *   \brief Bytes before the payload of a record.
+    */
+    #define MAX30101_TRACE_HEADER_SIZE 8
+
+    /**
+    *   \brief Bytes before the raw data in a #MAX30101_TRACE_FIFO payload.
+    */
+    #define MAX30101_TRACE_FIFO_INFO 5
+
+    /**
+    *   \brief Largest payload, a full FIFO with four active LEDs.
+    */
+    #define MAX30101_TRACE_MAX_PAYLOAD (MAX30101_TRACE_FIFO_INFO + 32 * MAX30101_MAX_SLOTS * 3)
+
+    /**
+    *   \brief A record read from a trace.
+    */
+    typedef struct
+    {
+        uint8_t type;           ///< Type of the record (e.g., #MAX30101_TRACE_FIFO).
+        uint16_t length;        ///< Length of the payload.
+        uint32_t time;          ///< Time stamp.
+        const uint8_t* payload; ///< Payload, points into the trace buffer.
+    } MAX30101_TraceRecord;
+
+    /**
+    *   \brief Start recording.
+    *
+    *   This function sends a #MAX30101_TRACE_START record and records every
+    *   following register write done by the driver.
+    *   \param[in] write_fun function used to send the trace (e.g., UART_Debug_PutArray).
+    *   \param[in] ticks_per_us number of time stamp ticks in 1 us (e.g., CPU clock in MHz).
+    */
+    void MAX30101_Trace_Start(void (*write_fun)(const uint8_t*, uint8_t), uint16_t ticks_per_us);
+
+    /**
+    *   \brief Stop recording.
+    */
+    void MAX30101_Trace_Stop(void);
+
+    /**
+    *   \brief Read the FIFO and record it.
+    *
+    *   This function reads the FIFO pointers in a single transaction,
+    *   reads all the available samples with #MAX30101_ReadRawFIFOBytes
+    *   and records both. Equal pointers mean an empty FIFO or a full
+    *   one: the FIFO is taken as full (32 samples) after an A_FULL
+    *   interrupt or if the overflow counter is not 0.
+    *   \param[in] active_leds number of active LEDs.
+    *   \param[in] a_full 1 if the A_FULL interrupt is pending (read from #MAX30101_INT_ST_1 before this call).
+    *   \param[out] raw pointer to array where raw FIFO bytes will be stored
+    *               (32 x active_leds x 3 bytes).
+    *   \param[out] num_samples pointer to variable where the number of read samples will be stored.
+    *   \retval #MAX30101_OK if no error occurred.
+    *   \retval #MAX30101_DEV_NOT_FOUND if device is not present on the I2C bus.
+    */
+    uint8_t MAX30101_Trace_ReadFIFO(uint8_t active_leds, uint8_t a_full, uint8_t* raw, uint8_t* num_samples);
+
+    /**
+    *   \brief Record a FIFO burst.
+    *
+    *   \param[in] pointers FIFO_WP, OVF_COUNTER and FIFO_RP read before the burst.
+    *   \param[in] num_samples number of samples in the burst.
+    *   \param[in] active_leds number of active LEDs.
+    *   \param[in] raw raw FIFO bytes.
+    */
+    void MAX30101_Trace_RecordFIFO(const uint8_t* pointers, uint8_t num_samples, uint8_t active_leds, const uint8_t* raw);
+
+    /**
+    *   \brief Record a register write.
+    *
+    *   This function is installed with #MAX30101_SetWriteHook by
+    *   #MAX30101_Trace_Start.
+    *   \param[in] reg_addr address of the first register.
+    *   \param[in] count number of registers.
+    *   \param[in] data values written.
+    */
+    void MAX30101_Trace_RecordConfig(uint8_t reg_addr, uint8_t count, const uint8_t* data);
+
+    /**
+    *   \brief Encode a record in a buffer.
+    *
+    *   This function builds a record with a given time stamp (e.g., to
+    *   generate synthetic traces). The payload is made of info followed by data.
+    *   \param[out] buffer buffer of at least #MAX30101_TRACE_HEADER_SIZE + payload + 1 bytes.
+    *   \param[in] type type of the record.
+    *   \param[in] time time stamp.
+    *   \param[in] info first part of the payload.
+    *   \param[in] info_length length of the first part.
+    *   \param[in] data second part of the payload, can be NULL if data_length is 0.
+    *   \param[in] data_length length of the second part.
+    *   \return length of the record.
+    */
+    uint16_t MAX30101_Trace_Encode(uint8_t* buffer, uint8_t type, uint32_t time, const uint8_t* info,
+                                   uint16_t info_length, const uint8_t* data, uint16_t data_length);
+
+    /**
+    *   \brief Get the next record from a trace.
+    *
+    *   This function looks for the next valid record starting at offset,
+    *   skipping bytes that do not belong to a valid record. No data is copied:
+    *   the payload of the record points into the buffer.
+    *   \param[in] buffer trace.
+    *   \param[in] size size of the trace.
+    *   \param[in,out] offset position in the trace, updated to the end of the record.
+    *   \param[out] record record found.
+    *   \return 1 if a record was found, 0 at the end of the trace.
+    */
+    uint8_t MAX30101_Trace_Next(const uint8_t* buffer, uint32_t size, uint32_t* offset, MAX30101_TraceRecord* record);
+
+#endif
+/* [] END OF FILE */
@@ -1,156 +1,855 @@
-/**
-*   Main file for testing MAX30101 Library.
-*/
-
-#include "project.h"
-#include "MAX30101.h"
-#include "stdio.h"
-#include "I2C_Interface.h"
-
-#define UART_DEBUG
-
-#ifdef UART_DEBUG
-    
-    #define DEBUG_TEST 1
-    
-#else
-    
-    #define DEBUG_TEST 0
-    
-#endif
-
-#define debug_print(msg) do { if (DEBUG_TEST) UART_Debug_PutString(msg);} while (0)
-
-CY_ISR_PROTO(MAX30101_ISR);
-
-uint8_t flag_temp = 0;
-
-int main(void)
-{
-    // Variables
-    MAX30101_Data data;
-    data.head = 0;
-    data.tail = 0;
-    char msg[50];
-    void (*print_ptr)(const char*) = &(UART_Debug_PutString);
-    uint8_t active_leds = 1;
-    uint8_t rp, wp, flag = 0;
-    
-    // Initialization
-    MAX30101_Start();
-    UART_Debug_Start();
-
-    CyDelay(100);
-    
-    debug_print("**************************\r\n");
-    debug_print("         MAX30101         \r\n");
-    debug_print("**************************\r\n");
-    
-    if (MAX30101_IsDevicePresent() == MAX30101_OK)
-    {
-        // Check if device is present
-        debug_print("Device found on I2C bus\r\n");
-        Connection_LED_Write(1);
-        
-        // Read revision and part id
-        uint8_t rev_id, part_id = 0;
-        MAX30101_ReadPartID(&part_id);
-        MAX30101_ReadRevisionID(&rev_id);
-        sprintf(msg,"Revision ID: 0x%02X\r\n", rev_id);
-        debug_print(msg);
-        sprintf(msg,"Part ID: 0x%02X\r\n", part_id);
-        debug_print(msg);
-        
-        debug_print("Registers before configuration\r\n");
-        MAX30101_LogRegisters(print_ptr);
-        
-        // Soft reset sensor
-        MAX30101_Reset();
-        CyDelay(100);
-        
-        // Wake up sensor
-        MAX30101_WakeUp();
-        
-        MAX30101_DisableALCOverflowInt();
-        MAX30101_DisableTempReadyInt();
-        MAX30101_DisablePPGReadyInt();
-        MAX30101_EnableFIFOAFullInt();
-     
-        // set 28 samples to trigger interrupt
-        MAX30101_SetFIFOAlmostFull(32);
-
-        // enable fifo rollover
-        MAX30101_EnableFIFORollover();
-        
-        // 8 samples averaged
-        MAX30101_SetSampleAverage(MAX30101_SAMPLE_AVG_2);
-        
-        // Set LED Power level
-        MAX30101_SetLEDPulseAmplitude(MAX30101_LED_1, 0x1F);
-        
-        MAX30101_SetLEDPulseAmplitude(MAX30101_LED_2, 0x1F);
-        
-        MAX30101_SetLEDPulseAmplitude(MAX30101_LED_3, 0x1F);
-        
-        MAX30101_SetLEDPulseAmplitude(MAX30101_LED_4, 0x1F);
-        
-        // Set ADC Range
-        MAX30101_SetSpO2ADCRange(MAX30101_ADC_RANGE_4096);
-        
-        // Pulse width
-        MAX30101_SetSpO2PulseWidth(MAX30101_PULSEWIDTH_69);
-        
-        // Set Sample Rate
-        MAX30101_SetSpO2SampleRate(MAX30101_SAMPLE_RATE_400);
-        
-        // Set mode
-        MAX30101_SetMode(MAX30101_SPO2_MODE);
-        
-        // Enable Slots
-        MAX30101_DisableSlots();
-        
-        debug_print("Registers after configuration\r\n");
-        MAX30101_LogRegisters(print_ptr);
-    }
-    
-    debug_print("\r\n\r\n");
-    
-    isr_MAX30101_StartEx(MAX30101_ISR);
-    // Clear FIFO
-    MAX30101_ClearFIFO();
-    
-    CyGlobalIntEnable; /* Enable global interrupts. */
-    
-    for(;;)
-    {
-        if (flag_temp == 1)
-        {
-            MAX30101_IsFIFOAFull(&flag);
-            if (flag > 0)
-            {   
-                MAX30101_ReadReadPointer(&rp);
-                MAX30101_ReadWritePointer(&wp);
-                //Calculate the number of readings we need to get from sensor
-                int num_samples = wp - rp;
-                if (num_samples <= 0) 
-                    num_samples += 32; //Wrap condition
-                // Print out number of samples
-                sprintf(msg, "%d\r\n", num_samples);
-                debug_print(msg);
-                // Read FIFO
-                MAX30101_ReadFIFO(num_samples, active_leds, &data);
-            }
-            
-            flag_temp = 0;
-        }        
-    }
-}
-
-CY_ISR(MAX30101_ISR)
-{
-    Connection_LED_Write(!Connection_LED_Read());
-    MAX30101_INT_ClearInterrupt();
-    flag_temp = 1;
-}
-
-/* [] END OF FILE */
+/**
+*   Main file for testing MAX30101 Library.
+*/
+
+#include "project.h"
+#include "MAX30101.h"
+#include "MAX30101_Command.h"
+#include "MAX30101_Fixed.h"
+#include "MAX30101_Format.h"
+#include "MAX30101_Pipeline.h"
+#include "MAX30101_Pool.h"
+#include "MAX30101_Profile.h"
+#include "MAX30101_Range.h"
+#include "MAX30101_Scheduler.h"
+#include "MAX30101_Sleep.h"
+#include "MAX30101_SpectralHR.h"
+#include "MAX30101_Stats.h"
+#include "MAX30101_Stream.h"
+#include "MAX30101_Trace.h"
+#include "string.h"
+#include "I2C_Interface.h"
+
+#define UART_DEBUG
+
+// Uncomment to stream a binary trace of the raw FIFO data instead of text
+//#define UART_TRACE
+
+#ifdef UART_TRACE
+    
+    // Text output would be mixed with the binary trace
+    #undef UART_DEBUG
+    
+#endif
+
+#ifdef UART_DEBUG
+    
+    #define DEBUG_TEST 1
+    
+#else
+    
+    #define DEBUG_TEST 0
+    
+#endif
+
+#define debug_print(msg) do { if (DEBUG_TEST) UART_Debug_PutString(msg);} while (0)
+
+// Acquisition: batches of 32 samples on the A_FULL interrupt (throughput),
+// or each sample on the PPG_RDY interrupt with the shortest read and no
+// batching (latency, e.g., closed-loop biofeedback)
+#define ACQ_THROUGHPUT 0
+#define ACQ_LATENCY    1
+#define ACQ_MODE ACQ_THROUGHPUT
+
+#if (ACQ_MODE == ACQ_LATENCY) && defined(UART_TRACE)
+    #error "The binary trace records batches: use ACQ_THROUGHPUT with UART_TRACE"
+#endif
+
+// In latency mode a read clears PPG_RDY even if a late read left more than
+// one sample: status and FIFO pointers are read to catch up when the read
+// starts more than a sample period after the interrupt, and every
+// LATENCY_RESYNC samples. The ADC range is not switched in this mode.
+// Tasks are not preempted: a sample is read within a sample period only if
+// every task runs for less than about 4.5 ms. The CSV telemetry sends one
+// row per run; the profile report ('p') and the statistics ('s') block on
+// the UART for longer and delay the samples acquired meanwhile
+#define LATENCY_RESYNC 32
+
+// Output sample rate of MAX30101_FixedConfig.h (400 Hz, 2 samples averaged)
+#define SAMPLE_RATE_HZ 200
+
+// The FIFO must be read within one sample period of the A_FULL interrupt,
+// which is raised when the FIFO is full (or of the PPG_RDY interrupt, for
+// the next sample not to wait)
+#define DRAIN_DEADLINE (BCLK__BUS_CLK__MHZ * 1000000u / SAMPLE_RATE_HZ)
+
+// A character at 115200 baud, in us
+#define UART_CHAR_US 87
+
+// Longest wait for the UART before sleep: the 4-byte TX FIFO, the shift
+// register and a margin
+#define SLEEP_TX_TIMEOUT (BCLK__BUS_CLK__MHZ * UART_CHAR_US * 6)
+
+// Heart rate from IR in SpO2 mode (RED in HR mode), decimated to 25 Hz
+#define HR_CHANNEL (MAX30101_FIXED_LEDS - 1)
+#define HR_DECIMATION 8
+
+// ADC range follows the light: one step down after a second of dim drains
+// (6 drains of 32 samples), samples in LSBs of the 2048 nA range
+#define RANGE_DOWN_BLOCKS 6
+
+// Statistics of each channel over the last second
+#define STATS_WINDOW SAMPLE_RATE_HZ
+
+// Scaled samples for the telemetry (and the processing in latency mode),
+// each at its own pace: two FIFO drains, so that a task can run a drain late
+// without losing samples
+#define STREAM_FRAMES 64
+
+// Telemetry in throughput mode: number of new samples after each drain, or
+// a CSV row per sample (time in ms, then each channel: red, IR, green)
+#define TELEMETRY_COUNT 0
+#define TELEMETRY_CSV   1
+#define TELEMETRY TELEMETRY_COUNT
+
+// Idle mode between interrupts. The UART is polled from the SysTick
+// interrupt, which wakes the CPU from WFI only: alternate active and sleep
+// stop it, so binary commands are lost and only the one-character commands
+// read by the housekeeping task work. Sleep stops the UART and I2C
+// components, which are saved before sleeping and restored on wake-up
+#define IDLE_MODE MAX30101_SLEEP_WFI
+
+// Period of the UART poll, in us: the 4-byte RX FIFO fills in 347 us at 115200 baud
+#define COMMAND_POLL_US 250
+
+CY_ISR_PROTO(MAX30101_ISR);
+
+static uint32_t CPU_GetTime(void);
+
+static void Sleep_Prepare(void);
+
+static void Sleep_Restore(void);
+
+#if (ACQ_MODE == ACQ_LATENCY)
+    static void Task_Sample(uint32_t arg);
+#else
+    static void Task_Drain(uint32_t arg);
+#endif
+
+#ifndef UART_TRACE
+#if (ACQ_MODE == ACQ_LATENCY)
+    static void Task_Process(uint32_t arg);
+#else
+    static void Task_Pipeline(uint32_t arg);
+    
+    static uint8_t Stage_Unpack(void* state, const MAX30101_Block* in, MAX30101_Block* out);
+    
+    static uint8_t Stage_Stats(void* state, const MAX30101_Block* in, MAX30101_Block* out);
+    
+    static uint8_t Stage_HR(void* state, const MAX30101_Block* in, MAX30101_Block* out);
+    
+    static uint8_t Stage_Output(void* state, const MAX30101_Block* in, MAX30101_Block* out);
+#endif
+    
+    static void Task_ReportHR(uint32_t bpm_x10);
+    
+    static void Task_Telemetry(uint32_t arg);
+    
+    static void Task_Command(uint32_t arg);
+    
+    static void Command_Receive(void);
+    
+    static void Command_Poll(void);
+    
+    static void Command_Send(const uint8_t* bytes, uint8_t length);
+    
+    static void Command_SetStreaming(uint8_t on);
+    
+    static uint8_t Command_GetCounters(uint8_t* payload, uint8_t size);
+    
+    static void Command_Configured(void);
+#endif
+
+static void Task_Housekeeping(uint32_t arg);
+
+// Line buffer of the text output, shared by the tasks (they do not preempt each other)
+static MAX30101_Line line;
+
+#ifdef UART_TRACE
+    static uint8_t raw_bytes[32*MAX30101_MAX_SLOTS*3];
+#else
+    static MAX30101_Fixed_Data data;
+    static MAX30101_SpectralHR heart_rate;
+    static MAX30101_Range adc_range;
+    static MAX30101_Stats channel_stats[MAX30101_FIXED_LEDS];
+    static MAX30101_STATS_STORAGE(channel_window, MAX30101_FIXED_LEDS * STATS_WINDOW);
+    static MAX30101_Stream samples;
+    static MAX30101_STREAM_STORAGE(samples_ring, STREAM_FRAMES, MAX30101_FIXED_LEDS);
+    static uint8_t telemetry_consumer;
+#if (ACQ_MODE == ACQ_LATENCY)
+    static uint8_t process_consumer;
+#else
+    // Raw bytes of each drain, unpacked and scaled, then statistics, heart
+    // rate and the stream read by the telemetry
+    static MAX30101_Pipeline pipe;
+    static const MAX30101_PipeStage pipe_stages[] = {
+        { "unpack", Stage_Unpack, NULL, MAX30101_PIPE_FORMAT(MAX30101_PIPE_RAW, MAX30101_FIXED_LEDS),
+          MAX30101_PIPE_FORMAT(MAX30101_PIPE_SAMPLES, MAX30101_FIXED_LEDS), 0 },
+        { "stats", Stage_Stats, NULL, MAX30101_PIPE_FORMAT(MAX30101_PIPE_SAMPLES, MAX30101_FIXED_LEDS),
+          MAX30101_PIPE_FORMAT(MAX30101_PIPE_SAMPLES, MAX30101_FIXED_LEDS), 1 },
+        { "hr", Stage_HR, NULL, MAX30101_PIPE_FORMAT(MAX30101_PIPE_SAMPLES, MAX30101_FIXED_LEDS),
+          MAX30101_PIPE_FORMAT(MAX30101_PIPE_SAMPLES, MAX30101_FIXED_LEDS), 1 },
+        { "output", Stage_Output, NULL, MAX30101_PIPE_FORMAT(MAX30101_PIPE_SAMPLES, MAX30101_FIXED_LEDS),
+          MAX30101_PIPE_NONE, 0 }
+    };
+    // ALC_OVF read with the drain of each block, for the range update
+    static uint8_t block_alc_overflow[MAX30101_POOL_BLOCKS];
+    // Samples flushed from the FIFO because the pipeline was full
+    static uint32_t pipe_lost;
+#endif
+    
+    // Binary commands from the UART, parsed in the SysTick interrupt
+    static MAX30101_CmdChannel commands;
+    static const MAX30101_CmdHandlers command_handlers = {
+        .send = Command_Send,
+        .set_streaming = Command_SetStreaming,
+        .get_counters = Command_GetCounters,
+        .configured = Command_Configured
+    };
+    static volatile uint8_t streaming = 1;
+    static uint8_t config_checked = MAX30101_OK;
+#endif
+
+int main(void)
+{
+    // Variables
+    void (*print_ptr)(const char*) = &(UART_Debug_PutString);
+    
+    // Configuration: FIFO A Full interrupt at 32 samples (PPG Ready interrupt
+    // in latency mode), FIFO rollover, acquisition mode from
+    // MAX30101_FixedConfig.h (SpO2 mode at 400 Hz, 2 samples averaged,
+    // 69 us pulse width, 4096 nA range)
+    MAX30101_Config config = {
+        .int_en_1 = (ACQ_MODE == ACQ_LATENCY) ? MAX30101_CONF_INT_PPG_RDY : MAX30101_CONF_INT_A_FULL,
+        .int_en_2 = 0x00,
+        .fifo_conf = MAX30101_FIXED_FIFO_CONF | MAX30101_CONF_FIFO_ROLLOVER | MAX30101_CONF_FIFO_A_FULL(32),
+        .mode_conf = MAX30101_FIXED_MODE_CONF,
+        .spo2_conf = MAX30101_FIXED_SPO2_CONF,
+        .led_pa = {0x1F, 0x1F, 0x1F, 0x1F},
+        .pilot_pa = 0x00,
+        .multi_led = {MAX30101_FIXED_MULTI_LED_1, MAX30101_FIXED_MULTI_LED_2},
+        .prox_thresh = 0x00
+    };
+    MAX30101_BootTrace trace = { .get_time = CPU_GetTime };
+    
+    // Enable CPU cycle counter to trace boot phases and acquisition stages
+    MAX30101_Profile_Start();
+    
+    // Initialization: start, reset and configure the sensor without fixed delays
+    UART_Debug_Start();
+#ifdef UART_TRACE
+    // Record configuration written during boot
+    MAX30101_Trace_Start(UART_Debug_PutArray, BCLK__BUS_CLK__MHZ);
+#endif
+    uint8_t error = MAX30101_Boot(&config, &trace);
+    
+    debug_print("**************************\r\n");
+    debug_print("         MAX30101         \r\n");
+    debug_print("**************************\r\n");
+    
+    MAX30101_Format_Clear(&line);
+    MAX30101_Format_String(&line, "Boot trace (CPU cycles, ");
+    MAX30101_Format_Dec(&line, BCLK__BUS_CLK__MHZ);
+    MAX30101_Format_String(&line, " MHz):");
+    debug_print(MAX30101_Format_End(&line));
+    MAX30101_PrintBootTrace(print_ptr, &trace);
+    
+    if (error == MAX30101_OK)
+    {
+        // Check if device is present
+        debug_print("Device found on I2C bus\r\n");
+        Connection_LED_Write(1);
+        
+        // Read revision and part id
+        uint8_t rev_id, part_id = 0;
+        MAX30101_ReadPartID(&part_id);
+        MAX30101_ReadRevisionID(&rev_id);
+        MAX30101_Format_Clear(&line);
+        MAX30101_Format_String(&line, "Revision ID: 0x");
+        MAX30101_Format_Hex(&line, rev_id, 2);
+        debug_print(MAX30101_Format_End(&line));
+        MAX30101_Format_Clear(&line);
+        MAX30101_Format_String(&line, "Part ID: 0x");
+        MAX30101_Format_Hex(&line, part_id, 2);
+        debug_print(MAX30101_Format_End(&line));
+        
+        // The FIFO is read assuming the compiled settings
+        if (MAX30101_Fixed_Check() != MAX30101_OK)
+        {
+            debug_print("Configuration does not match MAX30101_FixedConfig.h\r\n");
+        }
+        
+        debug_print("Registers after configuration\r\n");
+        MAX30101_LogRegisters(print_ptr);
+    }
+    
+    debug_print("\r\n\r\n");
+    
+#ifndef UART_TRACE
+    MAX30101_Range_Init(&adc_range, MAX30101_FIXED_ADC_RANGE, MAX30101_ADC_RANGE_2048, MAX30101_ADC_RANGE_16384,
+                        MAX30101_FIXED_SHIFT, RANGE_DOWN_BLOCKS);
+    MAX30101_SpectralHR_Init(&heart_rate, SAMPLE_RATE_HZ, HR_DECIMATION);
+    for (uint8_t c = 0; c < MAX30101_FIXED_LEDS; c++)
+    {
+        MAX30101_Stats_Init(&channel_stats[c], STATS_WINDOW, &channel_window_samples[c * STATS_WINDOW],
+                            &channel_window_queues[2 * c * STATS_WINDOW]);
+    }
+    MAX30101_Stream_Init(&samples, samples_ring, STREAM_FRAMES, MAX30101_FIXED_LEDS);
+#if (ACQ_MODE == ACQ_LATENCY)
+    MAX30101_Stream_Register(&samples, &process_consumer);
+#else
+    MAX30101_Stream_Register(&samples, &telemetry_consumer);
+    MAX30101_Pool_Init();
+    MAX30101_Pipeline_Init(&pipe, CPU_GetTime);
+    for (uint8_t i = 0; i < sizeof(pipe_stages) / sizeof(pipe_stages[0]); i++)
+    {
+        MAX30101_Pipeline_Add(&pipe, &pipe_stages[i]);
+    }
+#endif
+    MAX30101_Cmd_Init(&commands);
+    // The RX buffer is the 4-byte hardware FIFO: poll it faster than it fills
+    CySysTickStart();
+    CySysTickSetClockSource(CY_SYS_SYSTICK_CLK_SRC_SYSCLK);
+    CySysTickSetReload(BCLK__BUS_CLK__HZ / 1000000u * COMMAND_POLL_US - 1);
+    CySysTickSetCallback(0, Command_Poll);
+#endif
+    
+    // FIFO drain has the highest priority, output and commands run in between
+    MAX30101_SleepConfig sleep = {
+        .mode = IDLE_MODE,
+        .prepare = Sleep_Prepare,
+        .restore = Sleep_Restore,
+        .get_time = CPU_GetTime,
+        // Samples left in the FIFO at A_FULL(32), in cycles
+        .budget = MAX30101_Sleep_Budget(SAMPLE_RATE_HZ, 32) * BCLK__BUS_CLK__MHZ
+    };
+    MAX30101_Sleep_Init(&sleep);
+    MAX30101_Sched_Init(CPU_GetTime, MAX30101_Sleep_Idle);
+    
+    isr_MAX30101_StartEx(MAX30101_ISR);
+    // Flush FIFO
+    MAX30101_FlushFIFO();
+    
+    CyGlobalIntEnable; /* Enable global interrupts. */
+    
+    MAX30101_Sched_Run();
+}
+
+#if (ACQ_MODE == ACQ_THROUGHPUT)
+// Read the FIFO after an A_FULL interrupt (raised at time arg)
+static void Task_Drain(uint32_t arg)
+{
+    uint32_t latency = CPU_GetTime() - arg;
+    uint8_t status = 0;
+    
+    // A single read for A_FULL and ALC_OVF: the register is cleared on read
+    MAX30101_PROFILE_BEGIN(MAX30101_STAGE_STATUS);
+    MAX30101_ReadRegister(MAX30101_INT_ST_1, &status);
+    MAX30101_PROFILE_END(MAX30101_STAGE_STATUS);
+    if (status & MAX30101_CONF_INT_A_FULL)
+    {
+#ifdef UART_TRACE
+        // Record pointers and raw FIFO bytes; the trace has the time stamps
+        (void)latency;
+        uint8_t num_read;
+        MAX30101_PROFILE_BEGIN(MAX30101_STAGE_BURST);
+        MAX30101_Trace_ReadFIFO(MAX30101_FIXED_LEDS, 1, raw_bytes, &num_read);
+        MAX30101_PROFILE_END(MAX30101_STAGE_BURST);
+#else
+        uint8_t rp, ovf, wp;
+        MAX30101_PROFILE_BEGIN(MAX30101_STAGE_POINTERS);
+        MAX30101_ReadFIFOPointers(&wp, &ovf, &rp);
+        MAX30101_PROFILE_END(MAX30101_STAGE_POINTERS);
+        //Calculate the number of readings we need to get from sensor
+        int num_samples = wp - rp;
+        if (num_samples <= 0) 
+            num_samples += 32; //Wrap condition
+        // Margin left by the wake-up and the other tasks
+        MAX30101_Sleep_RecordDrain(num_samples, ovf, latency);
+        // Read FIFO in a single burst into a block, processed by the pipeline
+        MAX30101_Block* block = MAX30101_Pool_Alloc();
+        uint8_t error = MAX30101_ERROR;
+        if (block != NULL)
+        {
+            MAX30101_PROFILE_BEGIN(MAX30101_STAGE_BURST);
+            error = MAX30101_ReadRawFIFOBytes(num_samples, MAX30101_FIXED_LEDS, block->data);
+            MAX30101_PROFILE_END(MAX30101_STAGE_BURST);
+            block->num_samples = num_samples;
+            block->length = num_samples * MAX30101_FIXED_LEDS * MAX30101_FIXED_BYTES_PER_CHANNEL;
+            block_alc_overflow[MAX30101_Pool_Index(block)] = (status & MAX30101_CONF_INT_ALC_OVF) != 0;
+            if (error == MAX30101_OK)
+            {
+                // Released by the pipeline, even if refused
+                error = MAX30101_Pipeline_Push(&pipe, block);
+            }
+            else
+            {
+                MAX30101_Pool_Release(block);
+            }
+        }
+        if (error != MAX30101_OK)
+        {
+            // Pipeline behind: drop the samples and leave room for the next A_FULL
+            pipe_lost += num_samples;
+            MAX30101_FlushFIFO();
+        }
+        MAX30101_Sched_Post(MAX30101_SCHED_PROCESS, Task_Pipeline, 0, MAX30101_SCHED_NO_DEADLINE);
+#endif
+    }
+    MAX30101_Sched_Post(MAX30101_SCHED_HOUSEKEEPING, Task_Housekeeping, 0, MAX30101_SCHED_NO_DEADLINE);
+}
+#endif
+
+#if (ACQ_MODE == ACQ_LATENCY)
+// Read the new sample after a PPG_RDY interrupt (raised at time arg) and process it at once
+static void Task_Sample(uint32_t arg)
+{
+    static uint8_t since_resync = 0;
+    uint8_t num_samples = 1;
+    uint32_t latency = CPU_GetTime() - arg;
+    
+    if ((++since_resync < LATENCY_RESYNC) && (latency <= DRAIN_DEADLINE))
+    {
+        // Address byte and sample bytes only
+        if (MAX30101_Fixed_ReadSample(&data) != MAX30101_OK)
+        {
+            return;
+        }
+    }
+    else
+    {
+        // Clear the status and read the samples left by late reads
+        uint8_t status, rp, ovf, wp;
+        since_resync = 0;
+        MAX30101_PROFILE_BEGIN(MAX30101_STAGE_STATUS);
+        MAX30101_ReadRegister(MAX30101_INT_ST_1, &status);
+        MAX30101_PROFILE_END(MAX30101_STAGE_STATUS);
+        MAX30101_PROFILE_BEGIN(MAX30101_STAGE_POINTERS);
+        MAX30101_ReadFIFOPointers(&wp, &ovf, &rp);
+        MAX30101_PROFILE_END(MAX30101_STAGE_POINTERS);
+        num_samples = (wp - rp) & 0x1F;
+        if ((num_samples == 0) && (ovf != 0))
+        {
+            num_samples = 32;
+        }
+        MAX30101_Sleep_RecordDrain(num_samples, ovf, latency);
+        if ((num_samples == 0) || (MAX30101_Fixed_ReadFIFO(num_samples, &data) != MAX30101_OK))
+        {
+            return;
+        }
+    }
+    for (uint8_t c = 0; c < MAX30101_FIXED_LEDS; c++)
+    {
+        MAX30101_Range_Scale(&adc_range, data.channel[c], data.head, num_samples);
+    }
+    MAX30101_Stream_WriteRing(&samples, data.channel[0], data.head, num_samples);
+    Task_Process(0);
+    MAX30101_Sched_Post(MAX30101_SCHED_HOUSEKEEPING, Task_Housekeeping, 0, MAX30101_SCHED_NO_DEADLINE);
+}
+#endif
+
+#ifndef UART_TRACE
+#if (ACQ_MODE == ACQ_LATENCY)
+// Feed the new samples of the stream to the statistics and the heart rate estimator
+static void Task_Process(uint32_t arg)
+{
+    (void)arg;
+    uint8_t updated = 0;
+    const uint32_t* frame;
+    uint16_t num_frames;
+    MAX30101_PROFILE_BEGIN(MAX30101_STAGE_FILTER);
+    while ((num_frames = MAX30101_Stream_Peek(&samples, process_consumer, &frame)) > 0)
+    {
+        for (uint16_t i = 0; i < num_frames; i++, frame += MAX30101_FIXED_LEDS)
+        {
+            for (uint8_t c = 0; c < MAX30101_FIXED_LEDS; c++)
+            {
+                MAX30101_Stats_Add(&channel_stats[c], frame[c]);
+            }
+            updated |= MAX30101_SpectralHR_Add(&heart_rate, frame[HR_CHANNEL]);
+        }
+        MAX30101_Stream_Consume(&samples, process_consumer, num_frames);
+    }
+    MAX30101_PROFILE_END(MAX30101_STAGE_FILTER);
+    if (updated)
+    {
+        MAX30101_Sched_Post(MAX30101_SCHED_TELEMETRY, Task_ReportHR, heart_rate.bpm_x10, MAX30101_SCHED_NO_DEADLINE);
+    }
+}
+#else
+// Move the drained blocks through the stages
+static void Task_Pipeline(uint32_t arg)
+{
+    (void)arg;
+    MAX30101_Pipeline_Run(&pipe, 0);
+}
+
+// Unpack a drain with the compiled settings, scale it to the 2048 nA range
+// and follow the light. Blocks run in drain order before the next drain
+// (160 ms later): the range update takes the samples still in the FIFO as
+// acquired with the previous range
+static uint8_t Stage_Unpack(void* state, const MAX30101_Block* in, MAX30101_Block* out)
+{
+    (void)state;
+    uint8_t num_samples = in->num_samples;
+    MAX30101_PROFILE_BEGIN(MAX30101_STAGE_UNPACK);
+    MAX30101_Fixed_Unpack(in->data, num_samples, &data);
+    MAX30101_PROFILE_END(MAX30101_STAGE_UNPACK);
+    for (uint8_t c = 0; c < MAX30101_FIXED_LEDS; c++)
+    {
+        MAX30101_Range_Scale(&adc_range, data.channel[c], data.head, num_samples);
+    }
+    MAX30101_Range_Update(&adc_range, num_samples, block_alc_overflow[MAX30101_Pool_Index(in)]);
+    // One frame of channels after the other, oldest first
+    uint32_t* frame = out->samples;
+    for (uint8_t i = num_samples; i > 0; i--, frame += MAX30101_FIXED_LEDS)
+    {
+        uint8_t index = (data.head + 1 - i) & (BUFFER_STORAGE_SIZE - 1);
+        for (uint8_t c = 0; c < MAX30101_FIXED_LEDS; c++)
+        {
+            frame[c] = data.channel[c][index];
+        }
+    }
+    out->length = num_samples * MAX30101_FIXED_LEDS * sizeof(uint32_t);
+    return MAX30101_OK;
+}
+
+// Statistics of each channel
+static uint8_t Stage_Stats(void* state, const MAX30101_Block* in, MAX30101_Block* out)
+{
+    (void)state;
+    (void)out;
+    const uint32_t* frame = in->samples;
+    MAX30101_PROFILE_BEGIN(MAX30101_STAGE_FILTER);
+    for (uint8_t i = 0; i < in->num_samples; i++, frame += MAX30101_FIXED_LEDS)
+    {
+        for (uint8_t c = 0; c < MAX30101_FIXED_LEDS; c++)
+        {
+            MAX30101_Stats_Add(&channel_stats[c], frame[c]);
+        }
+    }
+    MAX30101_PROFILE_END(MAX30101_STAGE_FILTER);
+    return MAX30101_OK;
+}
+
+// Heart rate of HR_CHANNEL, reported when a new estimate is ready
+static uint8_t Stage_HR(void* state, const MAX30101_Block* in, MAX30101_Block* out)
+{
+    (void)state;
+    (void)out;
+    uint8_t updated = 0;
+    const uint32_t* frame = in->samples;
+    MAX30101_PROFILE_BEGIN(MAX30101_STAGE_FILTER);
+    for (uint8_t i = 0; i < in->num_samples; i++, frame += MAX30101_FIXED_LEDS)
+    {
+        updated |= MAX30101_SpectralHR_Add(&heart_rate, frame[HR_CHANNEL]);
+    }
+    MAX30101_PROFILE_END(MAX30101_STAGE_FILTER);
+    if (updated)
+    {
+        MAX30101_Sched_Post(MAX30101_SCHED_TELEMETRY, Task_ReportHR, heart_rate.bpm_x10, MAX30101_SCHED_NO_DEADLINE);
+    }
+    return MAX30101_OK;
+}
+
+// Write the samples to the stream, read in place by the telemetry
+static uint8_t Stage_Output(void* state, const MAX30101_Block* in, MAX30101_Block* out)
+{
+    (void)state;
+    (void)out;
+    const uint32_t* frame = in->samples;
+    for (uint8_t i = 0; i < in->num_samples; i++, frame += MAX30101_FIXED_LEDS)
+    {
+        MAX30101_Stream_Write(&samples, frame);
+    }
+    MAX30101_Sched_Post(MAX30101_SCHED_TELEMETRY, Task_Telemetry, 0, MAX30101_SCHED_NO_DEADLINE);
+    return MAX30101_OK;
+}
+#endif
+
+// Print out heart rate
+static void Task_ReportHR(uint32_t bpm_x10)
+{
+    if (streaming)
+    {
+        MAX30101_Format_Clear(&line);
+        MAX30101_Format_String(&line, "HR: ");
+        MAX30101_Format_Fixed(&line, bpm_x10, 1);
+        MAX30101_Format_String(&line, " bpm (");
+        MAX30101_Format_Dec(&line, heart_rate.quality);
+        MAX30101_Format_String(&line, "%)");
+        debug_print(MAX30101_Format_End(&line));
+    }
+}
+
+#if (TELEMETRY == TELEMETRY_CSV)
+// Print out a CSV row of the next sample, then run again for the others:
+// a row takes about 2.7 ms on the UART, the drain can run in between
+static void Task_Telemetry(uint32_t arg)
+{
+    (void)arg;
+    const uint32_t* frame;
+    if (MAX30101_Stream_Peek(&samples, telemetry_consumer, &frame) == 0)
+    {
+        return;
+    }
+    if (streaming)
+    {
+        // The position skips the frames lost, if any
+        uint32_t position = samples.cursor[telemetry_consumer].position;
+        MAX30101_PROFILE_BEGIN(MAX30101_STAGE_FORMAT);
+        MAX30101_Format_CsvRow(&line, position * 1000u / SAMPLE_RATE_HZ, frame, MAX30101_FIXED_LEDS);
+        MAX30101_PROFILE_END(MAX30101_STAGE_FORMAT);
+        MAX30101_PROFILE_BEGIN(MAX30101_STAGE_OUTPUT);
+        debug_print(line.text);
+        MAX30101_PROFILE_END(MAX30101_STAGE_OUTPUT);
+    }
+    MAX30101_Stream_Consume(&samples, telemetry_consumer, 1);
+    MAX30101_Sched_Post(MAX30101_SCHED_TELEMETRY, Task_Telemetry, 0, MAX30101_SCHED_NO_DEADLINE);
+}
+#else
+// Print out number of new samples
+static void Task_Telemetry(uint32_t arg)
+{
+    (void)arg;
+    uint32_t num_samples = 0;
+    const uint32_t* frame;
+    uint16_t num_frames;
+    MAX30101_PROFILE_BEGIN(MAX30101_STAGE_OUTPUT);
+    while ((num_frames = MAX30101_Stream_Peek(&samples, telemetry_consumer, &frame)) > 0)
+    {
+        num_samples += num_frames;
+        MAX30101_Stream_Consume(&samples, telemetry_consumer, num_frames);
+    }
+    if (streaming)
+    {
+        MAX30101_Format_Clear(&line);
+        MAX30101_Format_Dec(&line, num_samples);
+        debug_print(MAX30101_Format_End(&line));
+    }
+    MAX30101_PROFILE_END(MAX30101_STAGE_OUTPUT);
+}
+#endif
+
+// Execute a binary command
+static void Task_Command(uint32_t arg)
+{
+    (void)arg;
+    MAX30101_Cmd_Execute(&commands, &command_handlers);
+}
+
+// Parse the received bytes, post the command when a frame is complete
+static void Command_Receive(void)
+{
+    while (UART_Debug_GetRxBufferSize() != 0)
+    {
+        if (MAX30101_Cmd_Feed(&commands, UART_Debug_ReadRxData()))
+        {
+            MAX30101_Sched_Post(MAX30101_SCHED_HOUSEKEEPING, Task_Command, 0, MAX30101_SCHED_NO_DEADLINE);
+        }
+    }
+}
+
+// Called by the SysTick interrupt
+static void Command_Poll(void)
+{
+    Command_Receive();
+}
+
+// Send the reply of a command
+static void Command_Send(const uint8_t* bytes, uint8_t length)
+{
+    UART_Debug_PutArray(bytes, length);
+}
+
+// Start or stop the text output
+static void Command_SetStreaming(uint8_t on)
+{
+    streaming = on;
+}
+
+// Counters of the acquisition: drains, samples lost in the FIFO and in the
+// processing (stream in latency mode, pipeline full in throughput mode),
+// configuration check (little endian like the channel counters)
+static uint8_t Command_GetCounters(uint8_t* payload, uint8_t size)
+{
+    MAX30101_SleepStats stats;
+    if (size < 13)
+    {
+        return 0;
+    }
+    MAX30101_Sleep_GetStats(&stats);
+    memcpy(&payload[0], &stats.drains, 4);
+    memcpy(&payload[4], &stats.overflows, 4);
+#if (ACQ_MODE == ACQ_LATENCY)
+    memcpy(&payload[8], &samples.cursor[process_consumer].overruns, 4);
+#else
+    memcpy(&payload[8], &pipe_lost, 4);
+#endif
+    payload[12] = config_checked;
+    return 13;
+}
+
+// The FIFO is read assuming the compiled settings: check them after a change
+static void Command_Configured(void)
+{
+    config_checked = MAX30101_Fixed_Check();
+}
+#endif
+
+// Handle commands
+static void Task_Housekeeping(uint32_t arg)
+{
+    (void)arg;
+#ifdef UART_TRACE
+    char command = UART_Debug_GetChar();
+#else
+    // Without the SysTick poll (idle modes other than WFI), bytes are taken from the FIFO here
+    uint8 interrupts = CyEnterCriticalSection();
+    Command_Receive();
+    CyExitCriticalSection(interrupts);
+    char command = MAX30101_Cmd_GetText(&commands);
+#endif
+    // Send timing report on request
+    if (command == 'p')
+    {
+        MAX30101_Profile_Report(UART_Debug_PutArray);
+        MAX30101_Profile_Reset();
+    }
+    // Print idle statistics on request
+    else if (command == 's')
+    {
+        MAX30101_SleepStats stats;
+        MAX30101_Sleep_GetStats(&stats);
+        MAX30101_Format_Clear(&line);
+        MAX30101_Format_String(&line, "Sleeps: ");
+        MAX30101_Format_Dec(&line, stats.sleeps);
+        MAX30101_Format_String(&line, ", restore: ");
+        MAX30101_Format_Dec(&line, stats.max_restore);
+        MAX30101_Format_String(&line, " cycles");
+        debug_print(MAX30101_Format_End(&line));
+        MAX30101_Format_Clear(&line);
+        MAX30101_Format_String(&line, "Drains: ");
+        MAX30101_Format_Dec(&line, stats.drains);
+        MAX30101_Format_String(&line, ", free: ");
+        MAX30101_Format_Dec(&line, stats.min_free);
+        MAX30101_Format_String(&line, ", lost: ");
+        MAX30101_Format_Dec(&line, stats.overflows);
+        MAX30101_Format_String(&line, ", latency: ");
+        MAX30101_Format_Dec(&line, stats.max_latency);
+        MAX30101_Format_String(&line, " cycles, late: ");
+        MAX30101_Format_Dec(&line, stats.late);
+        debug_print(MAX30101_Format_End(&line));
+        MAX30101_Sleep_ResetStats();
+    }
+#ifndef UART_TRACE
+    // Print statistics of the last second of each channel on request
+    else if (command == 'w')
+    {
+        for (uint8_t c = 0; c < MAX30101_FIXED_LEDS; c++)
+        {
+            MAX30101_Stats* stats = &channel_stats[c];
+            MAX30101_Format_Clear(&line);
+            MAX30101_Format_String(&line, "Ch ");
+            MAX30101_Format_Dec(&line, c);
+            MAX30101_Format_String(&line, ": min ");
+            MAX30101_Format_Dec(&line, MAX30101_Stats_Min(stats));
+            MAX30101_Format_String(&line, " max ");
+            MAX30101_Format_Dec(&line, MAX30101_Stats_Max(stats));
+            MAX30101_Format_String(&line, " mean ");
+            MAX30101_Format_Dec(&line, MAX30101_Stats_Mean(stats) >> MAX30101_STATS_FRAC_BITS);
+            MAX30101_Format_String(&line, " sd ");
+            MAX30101_Format_Dec(&line, MAX30101_Stats_StdDev(stats) >> MAX30101_STATS_FRAC_BITS);
+            debug_print(MAX30101_Format_End(&line));
+        }
+        MAX30101_Format_Clear(&line);
+        MAX30101_Format_String(&line, "Range: ");
+        MAX30101_Format_Dec(&line, 2048u << (MAX30101_Range_Get(&adc_range) >> MAX30101_ADC_RANGE_SHIFT));
+        MAX30101_Format_String(&line, " nA, switches ");
+        MAX30101_Format_Dec(&line, adc_range.switches);
+        MAX30101_Format_String(&line, ", clipped ");
+        MAX30101_Format_Dec(&line, adc_range.clipped);
+        MAX30101_Format_String(&line, ", ALC ");
+        MAX30101_Format_Dec(&line, adc_range.alc_overflows);
+        debug_print(MAX30101_Format_End(&line));
+        for (uint8_t i = 0; i < MAX30101_STREAM_MAX_CONSUMERS; i++)
+        {
+            if (samples.cursor[i].active)
+            {
+                MAX30101_Format_Clear(&line);
+                MAX30101_Format_String(&line, "Consumer ");
+                MAX30101_Format_Dec(&line, i);
+                MAX30101_Format_String(&line, ": max lag ");
+                MAX30101_Format_Dec(&line, samples.cursor[i].max_lag);
+                MAX30101_Format_String(&line, ", lost ");
+                MAX30101_Format_Dec(&line, samples.cursor[i].overruns);
+                debug_print(MAX30101_Format_End(&line));
+            }
+        }
+#if (ACQ_MODE == ACQ_THROUGHPUT)
+        for (uint8_t i = 0; i < pipe.num_stages; i++)
+        {
+            MAX30101_Format_Clear(&line);
+            MAX30101_Format_String(&line, "Stage ");
+            MAX30101_Format_String(&line, pipe.stages[i]->name);
+            MAX30101_Format_String(&line, ": max ");
+            MAX30101_Format_Dec(&line, pipe.stats[i].max_time);
+            MAX30101_Format_String(&line, " cycles, blocked ");
+            MAX30101_Format_Dec(&line, pipe.stats[i].blocked);
+            debug_print(MAX30101_Format_End(&line));
+        }
+        MAX30101_Format_Clear(&line);
+        MAX30101_Format_String(&line, "Pipeline: latency ");
+        MAX30101_Format_Dec(&line, pipe.max_latency);
+        MAX30101_Format_String(&line, " cycles, lost ");
+        MAX30101_Format_Dec(&line, pipe_lost);
+        debug_print(MAX30101_Format_End(&line));
+        MAX30101_Pipeline_ResetStats(&pipe);
+#endif
+    }
+#endif
+}
+
+// Stop components before sleep
+static void Sleep_Prepare(void)
+{
+    // Let the last character out. COMPLETE is cleared on read: if it was
+    // read before, the wait ends at the timeout
+    uint32_t start = CPU_GetTime();
+    uint8_t status;
+    do
+    {
+        status = UART_Debug_ReadTxStatus();
+    } while (((UART_Debug_GetTxBufferSize() != 0) || ((status & UART_Debug_TX_STS_FIFO_EMPTY) == 0) ||
+              ((status & UART_Debug_TX_STS_COMPLETE) == 0)) && ((CPU_GetTime() - start) < SLEEP_TX_TIMEOUT));
+    UART_Debug_Sleep();
+    I2C_Master_Sleep();
+}
+
+// Restart components after sleep
+static void Sleep_Restore(void)
+{
+    I2C_Master_Wakeup();
+    UART_Debug_Wakeup();
+}
+
+CY_ISR(MAX30101_ISR)
+{
+    MAX30101_PROFILE_BEGIN(MAX30101_STAGE_ISR);
+    Connection_LED_Write(!Connection_LED_Read());
+    MAX30101_INT_ClearInterrupt();
+#if (ACQ_MODE == ACQ_LATENCY)
+    MAX30101_Sched_Post(MAX30101_SCHED_DRAIN, Task_Sample, CPU_GetTime(), DRAIN_DEADLINE);
+#else
+    MAX30101_Sched_Post(MAX30101_SCHED_DRAIN, Task_Drain, CPU_GetTime(), DRAIN_DEADLINE);
+#endif
+    MAX30101_PROFILE_END(MAX30101_STAGE_ISR);
+}
+
+// Read CPU cycle counter
+static uint32_t CPU_GetTime(void)
+{
+    return MAX30101_PROFILE_NOW();
+}
+
+/* [] END OF FILE */